@@ -0,0 +1,299 @@
+// Ouzel by Elviss Strazdins
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.hpp"
+#include "storage/Archive.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        constexpr std::size_t fileCount = 10000;
+        constexpr std::size_t threadCount = 4;
+
+        std::uint32_t crc32(const std::vector<std::uint8_t>& data) noexcept
+        {
+            static const auto table = [] {
+                std::vector<std::uint32_t> result(256);
+                for (std::uint32_t i = 0; i < 256; ++i)
+                {
+                    std::uint32_t value = i;
+                    for (int bit = 0; bit < 8; ++bit)
+                        value = (value & 1U) ? 0xEDB88320U ^ (value >> 1) : value >> 1;
+                    result[i] = value;
+                }
+                return result;
+            }();
+
+            std::uint32_t crc = 0xFFFFFFFFU;
+            for (const auto byte : data)
+                crc = table[(crc ^ byte) & 0xFFU] ^ (crc >> 8);
+            return crc ^ 0xFFFFFFFFU;
+        }
+
+        class BitWriter final
+        {
+        public:
+            void write(std::uint32_t value, std::uint32_t count)
+            {
+                for (std::uint32_t i = 0; i < count; ++i)
+                {
+                    if (bitCount == 0) data.push_back(0);
+                    data.back() |= static_cast<std::uint8_t>(((value >> i) & 1U) << bitCount);
+                    bitCount = (bitCount + 1) & 7U;
+                }
+            }
+
+            // Huffman codes are stored starting from the most significant bit
+            void writeCode(std::uint32_t code, std::uint32_t length)
+            {
+                for (std::uint32_t i = length; i > 0; --i)
+                    write((code >> (i - 1)) & 1U, 1);
+            }
+
+            std::vector<std::uint8_t> data;
+
+        private:
+            std::uint32_t bitCount = 0;
+        };
+
+        void writeLiteral(BitWriter& writer, std::uint32_t symbol)
+        {
+            if (symbol < 144) writer.writeCode(0x30 + symbol, 8);
+            else if (symbol < 256) writer.writeCode(0x190 + symbol - 144, 9);
+            else if (symbol < 280) writer.writeCode(symbol - 256, 7);
+            else writer.writeCode(0xC0 + symbol - 280, 8);
+        }
+
+        // greedy LZ77 with the fixed Huffman codes, enough to exercise the inflater
+        std::vector<std::uint8_t> deflate(const std::vector<std::uint8_t>& data)
+        {
+            static constexpr std::uint16_t lengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+            static constexpr std::uint8_t lengthExtraBits[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+            static constexpr std::uint16_t distanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+            static constexpr std::uint8_t distanceExtraBits[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+            BitWriter writer;
+            writer.write(1, 1); // final block
+            writer.write(1, 2); // fixed Huffman codes
+
+            std::vector<std::size_t> heads(4096, SIZE_MAX);
+
+            for (std::size_t position = 0; position < data.size();)
+            {
+                std::size_t matchLength = 0;
+                std::size_t matchDistance = 0;
+
+                if (position + 3 <= data.size())
+                {
+                    const auto hash = ((data[position] << 8) ^ (data[position + 1] << 4) ^ data[position + 2]) & 0xFFFU;
+                    const auto candidate = heads[hash];
+                    heads[hash] = position;
+
+                    if (candidate != SIZE_MAX && position - candidate <= 32768)
+                    {
+                        while (matchLength < 258 && position + matchLength < data.size() &&
+                               data[candidate + matchLength] == data[position + matchLength])
+                            ++matchLength;
+                        matchDistance = position - candidate;
+                    }
+                }
+
+                if (matchLength < 3)
+                {
+                    writeLiteral(writer, data[position]);
+                    ++position;
+                    continue;
+                }
+
+                std::uint32_t lengthSymbol = 28;
+                while (lengthBase[lengthSymbol] > matchLength) --lengthSymbol;
+                writeLiteral(writer, 257 + lengthSymbol);
+                writer.write(static_cast<std::uint32_t>(matchLength - lengthBase[lengthSymbol]), lengthExtraBits[lengthSymbol]);
+
+                std::uint32_t distanceSymbol = 29;
+                while (distanceBase[distanceSymbol] > matchDistance) --distanceSymbol;
+                writer.writeCode(distanceSymbol, 5);
+                writer.write(static_cast<std::uint32_t>(matchDistance - distanceBase[distanceSymbol]), distanceExtraBits[distanceSymbol]);
+
+                position += matchLength;
+            }
+
+            writeLiteral(writer, 256);
+            return writer.data;
+        }
+
+        void append16(std::vector<std::uint8_t>& buffer, std::uint32_t value)
+        {
+            buffer.push_back(static_cast<std::uint8_t>(value & 0xFFU));
+            buffer.push_back(static_cast<std::uint8_t>((value >> 8) & 0xFFU));
+        }
+
+        void append32(std::vector<std::uint8_t>& buffer, std::uint32_t value)
+        {
+            append16(buffer, value & 0xFFFFU);
+            append16(buffer, value >> 16);
+        }
+
+        std::string getFileName(std::size_t index)
+        {
+            return "assets/dir" + std::to_string(index % 100) + "/file" + std::to_string(index) + ".json";
+        }
+
+        std::vector<std::uint8_t> createFileContents(std::size_t index)
+        {
+            static const char* words[] = {"\"name\"", "\"texture\"", "\"position\"", ": ", "[0.5, 1.0]", ", ", "{\n", "}\n", "\"sprite\"", "true"};
+
+            std::vector<std::uint8_t> result;
+            std::uint32_t state = static_cast<std::uint32_t>(index) * 2654435761U + 1U;
+            const auto size = 512 + index % 4096;
+
+            while (result.size() < size)
+            {
+                state = state * 1664525U + 1013904223U;
+                const std::string word = words[(state >> 16) % 10];
+                result.insert(result.end(), word.begin(), word.end());
+            }
+
+            return result;
+        }
+
+        std::filesystem::path createArchive(bool compressed)
+        {
+            const auto path = std::filesystem::temp_directory_path() /
+                (compressed ? "ouzel_bench_deflate.zip" : "ouzel_bench_stored.zip");
+
+            std::vector<std::uint8_t> archive;
+            std::vector<std::uint8_t> directory;
+
+            for (std::size_t i = 0; i < fileCount; ++i)
+            {
+                const auto name = getFileName(i);
+                const auto contents = createFileContents(i);
+                const auto data = compressed ? deflate(contents) : contents;
+                const auto crc = crc32(contents);
+                const auto offset = static_cast<std::uint32_t>(archive.size());
+
+                append32(archive, 0x04034B50U);
+                append16(archive, 20); // version needed
+                append16(archive, 0); // flags
+                append16(archive, compressed ? 8 : 0);
+                append32(archive, 0); // modification time and date
+                append32(archive, crc);
+                append32(archive, static_cast<std::uint32_t>(data.size()));
+                append32(archive, static_cast<std::uint32_t>(contents.size()));
+                append16(archive, static_cast<std::uint32_t>(name.size()));
+                append16(archive, 0); // extra field length
+                archive.insert(archive.end(), name.begin(), name.end());
+                archive.insert(archive.end(), data.begin(), data.end());
+
+                append32(directory, 0x02014B50U);
+                append16(directory, 20); // version made by
+                append16(directory, 20); // version needed
+                append16(directory, 0); // flags
+                append16(directory, compressed ? 8 : 0);
+                append32(directory, 0); // modification time and date
+                append32(directory, crc);
+                append32(directory, static_cast<std::uint32_t>(data.size()));
+                append32(directory, static_cast<std::uint32_t>(contents.size()));
+                append16(directory, static_cast<std::uint32_t>(name.size()));
+                append16(directory, 0); // extra field length
+                append16(directory, 0); // comment length
+                append16(directory, 0); // disk number
+                append16(directory, 0); // internal attributes
+                append32(directory, 0); // external attributes
+                append32(directory, offset);
+                directory.insert(directory.end(), name.begin(), name.end());
+            }
+
+            const auto directoryOffset = static_cast<std::uint32_t>(archive.size());
+            archive.insert(archive.end(), directory.begin(), directory.end());
+
+            append32(archive, 0x06054B50U);
+            append16(archive, 0); // disk number
+            append16(archive, 0); // disk with the central directory
+            append16(archive, static_cast<std::uint32_t>(fileCount));
+            append16(archive, static_cast<std::uint32_t>(fileCount));
+            append32(archive, static_cast<std::uint32_t>(directory.size()));
+            append32(archive, directoryOffset);
+            append16(archive, 0); // comment length
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(archive.data()), static_cast<std::streamsize>(archive.size()));
+
+            return path;
+        }
+
+        // every archive is written only once, so that it is never truncated while mapped
+        const storage::Path& getArchivePath(bool compressed)
+        {
+            static const storage::Path storedPath{createArchive(false).string()};
+            static const storage::Path deflatePath{createArchive(true).string()};
+            return compressed ? deflatePath : storedPath;
+        }
+
+        const storage::Archive& getArchive(bool compressed)
+        {
+            static const storage::Archive storedArchive{getArchivePath(false)};
+            static const storage::Archive deflateArchive{getArchivePath(true)};
+            return compressed ? deflateArchive : storedArchive;
+        }
+
+        const std::vector<std::string>& getFileNames()
+        {
+            static const auto names = [] {
+                std::vector<std::string> result;
+                for (std::size_t i = 0; i < fileCount; ++i)
+                    result.push_back(getFileName(i));
+                return result;
+            }();
+            return names;
+        }
+
+        void readFiles(const storage::Archive& archive, std::size_t first, std::size_t step)
+        {
+            const auto& names = getFileNames();
+            for (std::size_t i = first; i < names.size(); i += step)
+            {
+                const auto data = archive.readFile(names[i]);
+                doNotOptimize(data);
+            }
+        }
+
+        const Registration open{"archive/open 10k", fileCount, [] {
+            const storage::Archive archive{getArchivePath(true)};
+            doNotOptimize(archive);
+        }};
+
+        const Registration lookup{"archive/lookup 10k", fileCount, [] {
+            const auto& archive = getArchive(true);
+            std::size_t found = 0;
+            for (const auto& name : getFileNames())
+                found += archive.fileExists(name) ? 1 : 0;
+            doNotOptimize(found);
+        }};
+
+        const Registration readStored{"archive/read stored 10k", fileCount, [] {
+            readFiles(getArchive(false), 0, 1);
+        }};
+
+        const Registration readDeflate{"archive/read deflate 10k", fileCount, [] {
+            readFiles(getArchive(true), 0, 1);
+        }};
+
+        const Registration readDeflateThreads{"archive/read deflate 10k 4 threads", fileCount, [] {
+            const auto& archive = getArchive(true);
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < threadCount; ++i)
+                threads.emplace_back(readFiles, std::cref(archive), i, threadCount);
+            for (auto& thread : threads)
+                thread.join();
+        }};
+    }
+}
@@ -0,0 +1,67 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_BENCH_BENCHMARK_HPP
+#define OUZEL_BENCH_BENCHMARK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ouzel::bench
+{
+    // named values reported next to the time, e.g. allocations per operation
+    using Counters = std::vector<std::pair<std::string, double>>;
+
+    class Benchmark final
+    {
+    public:
+        // operations is the number of operations done by one call of the function,
+        // results are reported per operation
+        Benchmark(const std::string& initName, std::size_t initOperations,
+                  const std::function<void()>& initFunction,
+                  const std::function<Counters()>& initCounters = nullptr):
+            name(initName), operations(initOperations),
+            function(initFunction), counters(initCounters)
+        {
+        }
+
+        std::string name;
+        std::size_t operations;
+        std::function<void()> function;
+        // called once after the measurement, outside of the timed code
+        std::function<Counters()> counters;
+    };
+
+    inline std::vector<Benchmark>& getBenchmarks()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    class Registration final
+    {
+    public:
+        Registration(const std::string& name, std::size_t operations,
+                     const std::function<void()>& function,
+                     const std::function<Counters()>& counters = nullptr)
+        {
+            getBenchmarks().emplace_back(name, operations, function, counters);
+        }
+    };
+
+    // prevents the compiler from optimizing away the computation of a value
+    template <class T>
+    void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static const void* volatile sink;
+        sink = &value;
+#endif
+    }
+}
+
+#endif // OUZEL_BENCH_BENCHMARK_HPP
@@ -0,0 +1,92 @@
+// Ouzel by Elviss Strazdins
+
+#include <cmath>
+#include <vector>
+#include "Benchmark.hpp"
+#include "audio/dsp/Biquad.hpp"
+#include "audio/dsp/DelayLine.hpp"
+#include "audio/dsp/FeedbackDelayNetwork.hpp"
+#include "audio/dsp/PitchShifter.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        // every benchmark processes blocks of planar stereo samples the way the mixer does
+        constexpr std::uint32_t frames = 512;
+        constexpr std::uint32_t channels = 2;
+        constexpr std::uint32_t sampleRate = 44100;
+        constexpr std::size_t blocks = 100;
+
+        std::vector<float> createBlock(std::uint32_t channelCount)
+        {
+            std::vector<float> samples(frames * channelCount);
+            for (std::size_t i = 0; i < samples.size(); ++i)
+                samples[i] = std::sin(static_cast<float>(i) * 0.05F);
+            return samples;
+        }
+
+        const Registration delay{"dsp/delay", blocks, [] {
+            static std::vector<audio::dsp::DelayLine> lines(channels, audio::dsp::DelayLine(22050));
+            static std::vector<float> samples = createBlock(channels);
+
+            for (std::size_t block = 0; block < blocks; ++block)
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                {
+                    float* channelSamples = &samples[channel * frames];
+                    for (std::uint32_t frame = 0; frame < frames; ++frame)
+                    {
+                        const float input = channelSamples[frame];
+                        channelSamples[frame] = lines[channel].read(std::size_t{22050});
+                        lines[channel].write(input);
+                    }
+                }
+
+            doNotOptimize(samples);
+        }};
+
+        void benchmarkBiquad(std::uint32_t channelCount)
+        {
+            audio::dsp::Biquad filter;
+            filter.setParameters(audio::dsp::Biquad::Type::lowPass, 1000.0F, 0.7071F, sampleRate);
+            filter.setChannels(channelCount);
+            std::vector<float> samples = createBlock(channelCount);
+
+            for (std::size_t block = 0; block < blocks; ++block)
+                filter.process(frames, channelCount, samples.data());
+
+            doNotOptimize(samples);
+        }
+
+        const Registration biquadStereo{"dsp/biquad 2ch", blocks, [] { benchmarkBiquad(2); }};
+        const Registration biquadSurround{"dsp/biquad 8ch", blocks, [] { benchmarkBiquad(8); }};
+
+        const Registration reverb{"dsp/fdn reverb", blocks, [] {
+            static std::vector<audio::dsp::FeedbackDelayNetwork> networks(channels);
+            static std::vector<float> samples = createBlock(channels);
+
+            for (std::uint32_t channel = 0; channel < channels; ++channel)
+                networks[channel].setParameters(0.1F, 0.5F, sampleRate, channel * 23);
+
+            for (std::size_t block = 0; block < blocks; ++block)
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                    networks[channel].process(frames, &samples[channel * frames]);
+
+            doNotOptimize(samples);
+        }};
+
+        const Registration pitchShift{"dsp/pitch shift", blocks, [] {
+            static std::vector<audio::dsp::PitchShifter> shifters(channels);
+            static std::vector<float> samples = createBlock(channels);
+
+            for (auto& shifter : shifters)
+                shifter.setParameters(1.5F, 0.05F, sampleRate);
+
+            for (std::size_t block = 0; block < blocks; ++block)
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                    shifters[channel].process(frames, &samples[channel * frames]);
+
+            doNotOptimize(samples);
+        }};
+    }
+}
@@ -0,0 +1,127 @@
+// Ouzel by Elviss Strazdins
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Benchmark.hpp"
+#include "events/EventDispatcher.hpp"
+#include "events/EventHandler.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        // every animator, particle system and widget registers a handler
+        constexpr std::size_t handlerCount = 10000;
+        constexpr std::size_t mouseHandlerCount = 10;
+
+        std::size_t updateCount = 0;
+
+        std::vector<std::unique_ptr<EventHandler>> createHandlers()
+        {
+            std::vector<std::unique_ptr<EventHandler>> result;
+
+            for (std::size_t i = 0; i < handlerCount; ++i)
+            {
+                auto eventHandler = std::make_unique<EventHandler>(static_cast<EventHandler::Priority>(i % 8));
+                eventHandler->updateHandler = [](const UpdateEvent&) {
+                    ++updateCount;
+                    return false;
+                };
+
+                if (i < mouseHandlerCount)
+                    eventHandler->mouseHandler = [](const MouseEvent&) { return false; };
+
+                result.push_back(std::move(eventHandler));
+            }
+
+            return result;
+        }
+
+        EventDispatcher& getEventDispatcher()
+        {
+            static EventDispatcher eventDispatcher;
+            static const auto eventHandlers = [] {
+                auto result = createHandlers();
+                for (const auto& eventHandler : result)
+                    eventDispatcher.addEventHandler(*eventHandler);
+                eventDispatcher.dispatchEvents();
+                return result;
+            }();
+
+            return eventDispatcher;
+        }
+
+        const Registration update{"events/update 10k handlers", 1, [] {
+            auto event = std::make_unique<UpdateEvent>();
+            event->type = Event::Type::update;
+            doNotOptimize(getEventDispatcher().dispatchEvent(std::move(event)));
+        }};
+
+        const Registration mouseMove{"events/mouse move 10k handlers", 1, [] {
+            auto event = std::make_unique<MouseEvent>();
+            event->type = Event::Type::mouseMove;
+            doNotOptimize(getEventDispatcher().dispatchEvent(std::move(event)));
+        }};
+
+        constexpr std::size_t producerCount = 4;
+        constexpr std::size_t eventsPerProducer = 10000;
+
+        std::atomic<std::size_t> receivedCount{0};
+
+        EventDispatcher& getPostEventDispatcher()
+        {
+            static EventDispatcher eventDispatcher;
+            static const auto eventHandler = [] {
+                auto result = std::make_unique<EventHandler>();
+                result->mouseHandler = [](const MouseEvent&) {
+                    receivedCount.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                };
+                eventDispatcher.addEventHandler(*result);
+                eventDispatcher.dispatchEvents();
+                return result;
+            }();
+
+            return eventDispatcher;
+        }
+
+        // input threads post mouse moves while the game thread dispatches them
+        const Registration post{"events/post from 4 threads", producerCount * eventsPerProducer, [] {
+            auto& eventDispatcher = getPostEventDispatcher();
+            receivedCount = 0;
+
+            std::vector<std::thread> producers;
+            for (std::size_t i = 0; i < producerCount; ++i)
+                producers.emplace_back([&eventDispatcher] {
+                    for (std::size_t j = 0; j < eventsPerProducer; ++j)
+                    {
+                        MouseEvent event;
+                        event.type = Event::Type::mouseMove;
+                        event.position = Vector<float, 2>{static_cast<float>(j), 0.0F};
+                        eventDispatcher.postEvent(event);
+                    }
+                });
+
+            while (receivedCount.load(std::memory_order_relaxed) < producerCount * eventsPerProducer)
+                eventDispatcher.dispatchEvents();
+
+            for (auto& producer : producers)
+                producer.join();
+        }};
+
+        const Registration addRemove{"events/add and remove", handlerCount, [] {
+            static const auto eventHandlers = createHandlers();
+
+            EventDispatcher eventDispatcher;
+            for (const auto& eventHandler : eventHandlers)
+                eventDispatcher.addEventHandler(*eventHandler);
+            eventDispatcher.dispatchEvents();
+
+            for (const auto& eventHandler : eventHandlers)
+                eventHandler->remove();
+            eventDispatcher.dispatchEvents();
+        }};
+    }
+}
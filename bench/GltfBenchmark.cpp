@@ -0,0 +1,176 @@
+// Ouzel by Elviss Strazdins
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "formats/Gltf.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        // a skinned grid with two joints and a rotation animation
+        constexpr std::size_t gridSize = 1000;
+        constexpr std::size_t vertexCount = (gridSize + 1) * (gridSize + 1);
+        constexpr std::size_t indexCount = gridSize * gridSize * 6;
+        constexpr std::size_t keyCount = 100;
+
+        template <class T>
+        void append(std::vector<std::byte>& data, const T& value)
+        {
+            const auto offset = data.size();
+            data.resize(offset + sizeof(T));
+            std::memcpy(data.data() + offset, &value, sizeof(T));
+        }
+
+        void appendUint32(std::vector<std::byte>& data, std::uint32_t value)
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+                data.push_back(static_cast<std::byte>((value >> (i * 8)) & 0xFFU));
+        }
+
+        const std::vector<std::byte>& getGlbFile()
+        {
+            static const auto file = [] {
+                std::vector<std::byte> binary;
+                binary.reserve(vertexCount * 56 + indexCount * 4);
+
+                std::string bufferViews;
+                std::string accessors;
+                std::size_t viewCount = 0;
+
+                const auto addView = [&](std::size_t offset, std::size_t componentType, std::size_t count,
+                                         const char* type, const std::string& extra = {}) {
+                    if (viewCount) bufferViews += ',', accessors += ',';
+                    bufferViews += "{\"buffer\":0,\"byteOffset\":" + std::to_string(offset) +
+                        ",\"byteLength\":" + std::to_string(binary.size() - offset) + '}';
+                    accessors += "{\"bufferView\":" + std::to_string(viewCount) +
+                        ",\"componentType\":" + std::to_string(componentType) +
+                        ",\"count\":" + std::to_string(count) + ",\"type\":\"" + type + '"' + extra + '}';
+                    ++viewCount;
+                };
+
+                auto offset = binary.size();
+                for (std::size_t y = 0; y <= gridSize; ++y)
+                    for (std::size_t x = 0; x <= gridSize; ++x)
+                    {
+                        append(binary, static_cast<float>(x) * 0.1F);
+                        append(binary, static_cast<float>(y) * 0.1F);
+                        append(binary, static_cast<float>(x * y % 7) * 0.01F);
+                    }
+                addView(offset, 5126, vertexCount, "VEC3");
+
+                offset = binary.size();
+                for (std::size_t i = 0; i < vertexCount; ++i)
+                {
+                    append(binary, 0.0F);
+                    append(binary, 0.0F);
+                    append(binary, 1.0F);
+                }
+                addView(offset, 5126, vertexCount, "VEC3");
+
+                offset = binary.size();
+                for (std::size_t y = 0; y <= gridSize; ++y)
+                    for (std::size_t x = 0; x <= gridSize; ++x)
+                    {
+                        append(binary, static_cast<float>(x) / gridSize);
+                        append(binary, static_cast<float>(y) / gridSize);
+                    }
+                addView(offset, 5126, vertexCount, "VEC2");
+
+                offset = binary.size();
+                for (std::size_t i = 0; i < vertexCount; ++i)
+                    appendUint32(binary, 0x00000100U);
+                addView(offset, 5121, vertexCount, "VEC4");
+
+                offset = binary.size();
+                for (std::size_t y = 0; y <= gridSize; ++y)
+                    for (std::size_t x = 0; x <= gridSize; ++x)
+                    {
+                        const auto weight = static_cast<float>(y) / gridSize;
+                        append(binary, 1.0F - weight);
+                        append(binary, weight);
+                        append(binary, 0.0F);
+                        append(binary, 0.0F);
+                    }
+                addView(offset, 5126, vertexCount, "VEC4");
+
+                offset = binary.size();
+                for (std::size_t y = 0; y < gridSize; ++y)
+                    for (std::size_t x = 0; x < gridSize; ++x)
+                    {
+                        const auto a = static_cast<std::uint32_t>(y * (gridSize + 1) + x);
+                        const auto b = a + 1;
+                        const auto c = a + static_cast<std::uint32_t>(gridSize) + 1;
+                        const auto d = c + 1;
+                        for (const auto index : {a, b, d, a, d, c})
+                            append(binary, index);
+                    }
+                addView(offset, 5125, indexCount, "SCALAR");
+
+                offset = binary.size();
+                for (std::size_t joint = 0; joint < 2; ++joint)
+                    for (std::size_t i = 0; i < 16; ++i)
+                        append(binary, (i % 5 == 0) ? 1.0F : (i == 13 && joint == 1) ? -50.0F : 0.0F);
+                addView(offset, 5126, 2, "MAT4");
+
+                offset = binary.size();
+                for (std::size_t i = 0; i < keyCount; ++i)
+                    append(binary, static_cast<float>(i) / 30.0F);
+                addView(offset, 5126, keyCount, "SCALAR");
+
+                offset = binary.size();
+                for (std::size_t i = 0; i < keyCount; ++i)
+                {
+                    append(binary, 0.0F);
+                    append(binary, 0.0F);
+                    append(binary, static_cast<float>(i) / keyCount);
+                    append(binary, 1.0F);
+                }
+                addView(offset, 5126, keyCount, "VEC4");
+
+                auto json = "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0,1]}],"
+                    "\"nodes\":[{\"mesh\":0,\"skin\":0},{\"name\":\"root\",\"children\":[2]},{\"name\":\"tip\",\"translation\":[0,50,0]}],"
+                    "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2,\"JOINTS_0\":3,\"WEIGHTS_0\":4},\"indices\":5}]}],"
+                    "\"skins\":[{\"joints\":[1,2],\"inverseBindMatrices\":6}],"
+                    "\"animations\":[{\"name\":\"bend\",\"samplers\":[{\"input\":7,\"output\":8}],"
+                    "\"channels\":[{\"sampler\":0,\"target\":{\"node\":2,\"path\":\"rotation\"}}]}],"
+                    "\"buffers\":[{\"byteLength\":" + std::to_string(binary.size()) + "}],"
+                    "\"bufferViews\":[" + bufferViews + "],\"accessors\":[" + accessors + "]}";
+
+                while (json.size() % 4) json += ' ';
+                while (binary.size() % 4) binary.push_back(std::byte{0});
+
+                std::vector<std::byte> result;
+                appendUint32(result, gltf::glbMagic);
+                appendUint32(result, 2);
+                appendUint32(result, static_cast<std::uint32_t>(12 + 8 + json.size() + 8 + binary.size()));
+                appendUint32(result, static_cast<std::uint32_t>(json.size()));
+                appendUint32(result, gltf::jsonChunkType);
+                for (const auto c : json) result.push_back(static_cast<std::byte>(c));
+                appendUint32(result, static_cast<std::uint32_t>(binary.size()));
+                appendUint32(result, gltf::binaryChunkType);
+                result.insert(result.end(), binary.begin(), binary.end());
+
+                return result;
+            }();
+
+            return file;
+        }
+
+        Span<const std::byte> getGlbData()
+        {
+            const auto& file = getGlbFile();
+            return Span<const std::byte>{file.data(), file.size()};
+        }
+
+        const Registration parse{"gltf/parse", vertexCount, [] {
+            doNotOptimize(gltf::parse(getGlbData()));
+        }};
+
+        const Registration load{"gltf/load", vertexCount, [] {
+            doNotOptimize(gltf::load(gltf::parse(getGlbData())));
+        }};
+    }
+}
@@ -0,0 +1,73 @@
+// Ouzel by Elviss Strazdins
+
+#include <cmath>
+#include <vector>
+#include "Benchmark.hpp"
+#include "thread/JobSystem.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        // enough work per element that the split overhead matters, but not dominates
+        constexpr std::size_t elementCount = 1000000;
+        constexpr std::size_t grainSize = 4096;
+
+        thread::JobSystem& getJobSystem()
+        {
+            static thread::JobSystem jobSystem;
+            return jobSystem;
+        }
+
+        std::vector<float>& getElements()
+        {
+            static std::vector<float> elements(elementCount, 1.0F);
+            return elements;
+        }
+
+        void transform(std::vector<float>& elements, std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+                elements[i] = std::sqrt(elements[i] * 1.0001F + 0.5F);
+        }
+
+        const Registration serialFor{"jobs/serial for 1M elements", elementCount, [] {
+            auto& elements = getElements();
+            transform(elements, 0, elements.size());
+            doNotOptimize(elements.front());
+        }};
+
+        const Registration parallelFor{"jobs/parallel for 1M elements", elementCount, [] {
+            auto& elements = getElements();
+            getJobSystem().parallelFor(0, elements.size(), grainSize, [&elements](std::size_t begin, std::size_t end) {
+                transform(elements, begin, end);
+            });
+            doNotOptimize(elements.front());
+        }};
+
+        constexpr std::size_t jobCount = 10000;
+
+        // scheduling overhead of jobs that do nothing
+        const Registration emptyJobs{"jobs/empty jobs", jobCount, [] {
+            auto& jobSystem = getJobSystem();
+
+            thread::JobSystem::Counter counter;
+            for (std::size_t i = 0; i < jobCount; ++i)
+                jobSystem.run([]() noexcept {}, counter);
+            jobSystem.wait(counter);
+        }};
+
+        const Registration dependentJobs{"jobs/dependent jobs", jobCount, [] {
+            auto& jobSystem = getJobSystem();
+
+            thread::JobSystem::Counter first;
+            thread::JobSystem::Counter second;
+            for (std::size_t i = 0; i < jobCount / 2; ++i)
+                jobSystem.run([]() noexcept {}, first);
+            for (std::size_t i = 0; i < jobCount / 2; ++i)
+                jobSystem.run([]() noexcept {}, second, first);
+            jobSystem.wait(second);
+            jobSystem.wait(first);
+        }};
+    }
+}
@@ -0,0 +1,57 @@
+// Ouzel by Elviss Strazdins
+
+#include <cstdio>
+#include <string>
+#include "Benchmark.hpp"
+#include "formats/Json.hpp"
+#include "formats/JsonDocument.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        // an indented document shaped like a large glTF file, about 40 MB
+        constexpr std::size_t objectCount = 100000;
+        constexpr std::size_t valueCount = objectCount * 24;
+
+        const std::string& getJsonFile()
+        {
+            static const auto file = [] {
+                std::string result = "{\n    \"asset\": {\"version\": \"2.0\"},\n    \"nodes\": [\n";
+                result.reserve(objectCount * 400);
+
+                char object[512];
+                for (std::size_t i = 0; i < objectCount; ++i)
+                {
+                    std::snprintf(object, sizeof(object),
+                                  "        {\n"
+                                  "            \"name\": \"node_%zu\",\n"
+                                  "            \"mesh\": %zu,\n"
+                                  "            \"children\": [%zu, %zu, %zu],\n"
+                                  "            \"translation\": [%.6f, %.6f, %.6f],\n"
+                                  "            \"rotation\": [0.0, 0.707107, 0.0, 0.707107],\n"
+                                  "            \"scale\": [1.0, 1.0, 1.0],\n"
+                                  "            \"extras\": {\"visible\": true, \"tag\": \"a\\\"quoted\\\" tag\", \"parent\": null}\n"
+                                  "        }%s\n",
+                                  i, i % 100, i * 3 + 1, i * 3 + 2, i * 3 + 3,
+                                  static_cast<double>(i) * 0.5, static_cast<double>(i % 17) * 1.25, -static_cast<double>(i) * 0.125,
+                                  i + 1 < objectCount ? "," : "");
+                    result += object;
+                }
+
+                result += "    ]\n}\n";
+                return result;
+            }();
+
+            return file;
+        }
+
+        const Registration parse{"json/parse", valueCount, [] {
+            doNotOptimize(json::parse(getJsonFile()));
+        }};
+
+        const Registration parseDocument{"json/parse document", valueCount, [] {
+            doNotOptimize(json::parseDocument(std::string_view{getJsonFile()}));
+        }};
+    }
+}
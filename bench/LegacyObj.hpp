@@ -0,0 +1,431 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_BENCH_LEGACYOBJ_HPP
+#define OUZEL_BENCH_LEGACYOBJ_HPP
+
+// The OBJ parser before the rewrite, kept as the baseline of the OBJ benchmarks
+
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "graphics/Vertex.hpp"
+#include "math/Box.hpp"
+#include "utils/Span.hpp"
+
+namespace ouzel::bench::legacy
+{
+    class ParseError final: public std::logic_error
+    {
+    public:
+        explicit ParseError(const std::string& str): std::logic_error(str) {}
+        explicit ParseError(const char* str): std::logic_error(str) {}
+    };
+
+    class Object final
+    {
+    public:
+        std::string name; // empty for the geometry before the first object statement
+        std::string material;
+        std::vector<graphics::Vertex> vertices;
+        std::vector<std::uint32_t> indices;
+        Box<float, 3> boundingBox;
+    };
+
+    class Data final
+    {
+    public:
+        std::vector<std::string> materialLibraries;
+        std::vector<Object> objects;
+    };
+
+    inline namespace detail
+    {
+        constexpr auto isWhitespace(std::byte c) noexcept
+        {
+            return static_cast<char>(c) == ' ' ||
+                static_cast<char>(c) == '\t';
+        }
+
+        constexpr auto isNewline(std::byte c) noexcept
+        {
+            return static_cast<char>(c) == '\r' ||
+                static_cast<char>(c) == '\n';
+        }
+
+        constexpr auto isControlChar(std::byte c) noexcept
+        {
+            return static_cast<std::uint8_t>(c) <= 0x1F;
+        }
+
+        inline void skipWhitespaces(const std::byte*& iterator,
+                                    const std::byte* end) noexcept
+        {
+            while (iterator != end)
+                if (isWhitespace(*iterator))
+                    ++iterator;
+                else
+                    break;
+        }
+
+        inline void skipLine(const std::byte*& iterator,
+                             const std::byte* end) noexcept
+        {
+            while (iterator != end)
+            {
+                if (isNewline(*iterator))
+                {
+                    ++iterator;
+                    break;
+                }
+
+                ++iterator;
+            }
+        }
+
+        inline std::string parseString(const std::byte*& iterator,
+                                       const std::byte* end)
+        {
+            std::string result;
+
+            while (iterator != end && !isControlChar(*iterator) && !isWhitespace(*iterator))
+            {
+                result.push_back(static_cast<char>(*iterator));
+
+                ++iterator;
+            }
+
+            if (result.empty())
+                throw ParseError("Invalid string");
+
+            return result;
+        }
+
+        inline std::int32_t parseInt32(const std::byte*& iterator,
+                                       const std::byte* end)
+        {
+            std::string value;
+            std::uint32_t length = 1;
+
+            if (iterator != end &&
+                static_cast<char>(*iterator) == '-')
+            {
+                value.push_back(static_cast<char>(*iterator));
+                ++length;
+                ++iterator;
+            }
+
+            while (iterator != end &&
+                   static_cast<char>(*iterator) >= '0' &&
+                   static_cast<char>(*iterator) <= '9')
+            {
+                value.push_back(static_cast<char>(*iterator));
+
+                ++iterator;
+            }
+
+            if (value.length() < length) return false;
+
+            return std::stoi(value);
+        }
+
+        inline float parseFloat(const std::byte*& iterator,
+                                const std::byte* end)
+        {
+            std::string value;
+            std::uint32_t length = 1;
+
+            if (iterator != end &&
+                static_cast<char>(*iterator) == '-')
+            {
+                value.push_back(static_cast<char>(*iterator));
+                ++length;
+                ++iterator;
+            }
+
+            while (iterator != end &&
+                   static_cast<char>(*iterator) >= '0' &&
+                   static_cast<char>(*iterator) <= '9')
+            {
+                value.push_back(static_cast<char>(*iterator));
+
+                ++iterator;
+            }
+
+            if (iterator != end &&
+                static_cast<char>(*iterator) == '.')
+            {
+                value.push_back(static_cast<char>(*iterator));
+                ++length;
+                ++iterator;
+
+                while (iterator != end &&
+                       static_cast<char>(*iterator) >= '0' &&
+                       static_cast<char>(*iterator) <= '9')
+                {
+                    value.push_back(static_cast<char>(*iterator));
+
+                    ++iterator;
+                }
+            }
+
+            // parse exponent
+            if (iterator != end &&
+                (static_cast<char>(*iterator) == 'e' ||
+                 static_cast<char>(*iterator) == 'E'))
+            {
+                value.push_back(static_cast<char>(*iterator));
+                if (++iterator == end)
+                    throw ParseError("Invalid exponent");
+
+                if (static_cast<char>(*iterator) == '+' ||
+                    static_cast<char>(*iterator) == '-')
+                    value.push_back(static_cast<char>(*iterator++));
+
+                if (iterator == end ||
+                    static_cast<char>(*iterator) < '0' ||
+                    static_cast<char>(*iterator) > '9')
+                    throw ParseError("Invalid exponent");
+
+                while (iterator != end &&
+                       static_cast<char>(*iterator) >= '0' &&
+                       static_cast<char>(*iterator) <= '9')
+                {
+                    value.push_back(static_cast<char>(*iterator));
+                    ++iterator;
+                }
+            }
+
+            if (value.length() < length) return false;
+
+            return std::stof(value);
+        }
+
+        inline bool parseToken(Span<const std::byte> str,
+                               const std::byte*& iterator,
+                               char token)
+        {
+            if (iterator == str.end() || static_cast<char>(*iterator) != token) return false;
+
+            ++iterator;
+
+            return true;
+        }
+    }
+
+    inline Data parse(Span<const std::byte> data)
+    {
+        Data result;
+        Object object;
+        std::vector<Vector<float, 3>> positions;
+        std::vector<Vector<float, 2>> texCoords;
+        std::vector<Vector<float, 3>> normals;
+        std::map<std::tuple<std::uint32_t, std::uint32_t, std::uint32_t>, std::uint32_t> vertexMap;
+
+        std::uint32_t objectCount = 0;
+
+        auto iterator = data.begin();
+
+        while (iterator != data.end())
+        {
+            if (isNewline(*iterator))
+            {
+                // skip empty lines
+                ++iterator;
+            }
+            else if (static_cast<char>(*iterator) == '#')
+            {
+                // skip the comment
+                skipLine(iterator, data.end());
+            }
+            else
+            {
+                skipWhitespaces(iterator, data.end());
+                const auto keyword = parseString(iterator, data.end());
+
+                if (keyword == "mtllib")
+                {
+                    skipWhitespaces(iterator, data.end());
+                    const auto filename = parseString(iterator, data.end());
+
+                    skipLine(iterator, data.end());
+
+                    result.materialLibraries.push_back(filename);
+                }
+                else if (keyword == "usemtl")
+                {
+                    skipWhitespaces(iterator, data.end());
+                    object.material = parseString(iterator, data.end());
+
+                    skipLine(iterator, data.end());
+                }
+                else if (keyword == "o")
+                {
+                    if (objectCount)
+                        result.objects.push_back(std::move(object));
+
+                    object = Object{};
+                    vertexMap.clear();
+
+                    skipWhitespaces(iterator, data.end());
+                    object.name = parseString(iterator, data.end());
+
+                    skipLine(iterator, data.end());
+
+                    ++objectCount;
+                }
+                else if (keyword == "v")
+                {
+                    Vector<float, 3> position;
+
+                    skipWhitespaces(iterator, data.end());
+                    position.v[0] = parseFloat(iterator, data.end());
+                    skipWhitespaces(iterator, data.end());
+                    position.v[1] = parseFloat(iterator, data.end());
+                    skipWhitespaces(iterator, data.end());
+                    position.v[2] = parseFloat(iterator, data.end());
+
+                    skipLine(iterator, data.end());
+
+                    positions.push_back(position);
+                }
+                else if (keyword == "vt")
+                {
+                    Vector<float, 2> texCoord;
+
+                    skipWhitespaces(iterator, data.end());
+                    texCoord.v[0] = parseFloat(iterator, data.end());
+                    skipWhitespaces(iterator, data.end());
+                    texCoord.v[1] = parseFloat(iterator, data.end());
+
+                    skipLine(iterator, data.end());
+
+                    texCoords.push_back(texCoord);
+                }
+                else if (keyword == "vn")
+                {
+                    Vector<float, 3> normal;
+
+                    skipWhitespaces(iterator, data.end());
+                    normal.v[0] = parseFloat(iterator, data.end());
+                    skipWhitespaces(iterator, data.end());
+                    normal.v[1] = parseFloat(iterator, data.end());
+                    skipWhitespaces(iterator, data.end());
+                    normal.v[2] = parseFloat(iterator, data.end());
+
+                    skipLine(iterator, data.end());
+
+                    normals.push_back(normal);
+                }
+                else if (keyword == "f")
+                {
+                    std::vector<std::uint32_t> vertexIndices;
+
+                    auto i = std::make_tuple<std::uint32_t, std::uint32_t, std::uint32_t>(0, 0, 0);
+                    std::int32_t positionIndex = 0;
+                    std::int32_t texCoordIndex = 0;
+                    std::int32_t normalIndex = 0;
+
+                    while (iterator != data.end())
+                    {
+                        if (isNewline(*iterator)) break;
+
+                        skipWhitespaces(iterator, data.end());
+                        positionIndex = parseInt32(iterator, data.end());
+
+                        if (positionIndex < 0)
+                            positionIndex = static_cast<std::int32_t>(positions.size()) + positionIndex + 1;
+
+                        if (positionIndex < 1 || positionIndex > static_cast<std::int32_t>(positions.size()))
+                            throw ParseError("Invalid position index");
+
+                        std::get<0>(i) = static_cast<std::uint32_t>(positionIndex);
+
+                        // has texture coordinates
+                        if (parseToken(data, iterator, '/'))
+                        {
+                            // two slashes in a row indicates no texture coordinates
+                            if (iterator != data.end() &&
+                                static_cast<char>(*iterator) != '/')
+                            {
+                                texCoordIndex = parseInt32(iterator, data.end());
+
+                                if (texCoordIndex < 0)
+                                    texCoordIndex = static_cast<std::int32_t>(texCoords.size()) + texCoordIndex + 1;
+
+                                if (texCoordIndex < 1 || texCoordIndex > static_cast<std::int32_t>(texCoords.size()))
+                                    throw ParseError("Invalid texture coordinate index");
+
+                                std::get<1>(i) = static_cast<std::uint32_t>(texCoordIndex);
+                            }
+
+                            // has normal
+                            if (parseToken(data, iterator, '/'))
+                            {
+                                normalIndex = parseInt32(iterator, data.end());
+
+                                if (normalIndex < 0)
+                                    normalIndex = static_cast<std::int32_t>(normals.size()) + normalIndex + 1;
+
+                                if (normalIndex < 1 || normalIndex > static_cast<std::int32_t>(normals.size()))
+                                    throw ParseError("Invalid normal index");
+
+                                std::get<2>(i) = static_cast<std::uint32_t>(normalIndex);
+                            }
+                        }
+
+                        std::uint32_t index = 0;
+
+                        auto vertexIterator = vertexMap.find(i);
+                        if (vertexIterator == vertexMap.end())
+                        {
+                            index = static_cast<std::uint32_t>(object.vertices.size());
+                            vertexMap[i] = index;
+
+                            graphics::Vertex vertex;
+                            if (std::get<0>(i) >= 1) vertex.position = positions[std::get<0>(i) - 1];
+                            if (std::get<1>(i) >= 1) vertex.texCoords[0] = texCoords[std::get<1>(i) - 1];
+                            vertex.color = Color::white();
+                            if (std::get<2>(i) >= 1) vertex.normal = normals[std::get<2>(i) - 1];
+                            object.vertices.push_back(vertex);
+                            object.boundingBox.insertPoint(vertex.position);
+                        }
+                        else
+                            index = vertexIterator->second;
+
+                        vertexIndices.push_back(index);
+                    }
+
+                    if (vertexIndices.size() < 3)
+                        throw ParseError("Invalid face count");
+                    else if (vertexIndices.size() == 3)
+                        for (const auto vertexIndex : vertexIndices)
+                            object.indices.push_back(vertexIndex);
+                    else
+                        for (std::uint32_t index = 0; index < vertexIndices.size() - 2; ++index)
+                        {
+                            object.indices.push_back(vertexIndices[0]);
+                            object.indices.push_back(vertexIndices[index + 1]);
+                            object.indices.push_back(vertexIndices[index + 2]);
+                        }
+                }
+                else
+                {
+                    // skip all unknown commands
+                    skipLine(iterator, data.end());
+                }
+
+                if (!objectCount) ++objectCount; // if we got at least one attribute, we have an object
+            }
+        }
+
+        if (objectCount)
+            result.objects.push_back(std::move(object));
+
+        return result;
+    }
+}
+
+#endif // OUZEL_BENCH_LEGACYOBJ_HPP
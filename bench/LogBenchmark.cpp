@@ -0,0 +1,26 @@
+// Ouzel by Elviss Strazdins
+
+#include "Benchmark.hpp"
+#include "utils/Log.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        Logger& getLogger()
+        {
+            static Logger result{Log::Level::warning};
+            return result;
+        }
+
+        // formatting is skipped for the levels above the threshold
+        const Registration filtered{"log/filtered message", 1, [] {
+            getLogger().log(Log::Level::info) << "Frame " << 1234 << " took " << 16.6F << " ms";
+        }};
+
+        // only the first messages of every interval reach the ring buffer
+        const Registration repeated{"log/repeated message", 1, [] {
+            getLogger().log(Log::Level::warning) << "Texture " << 42 << " is missing";
+        }};
+    }
+}
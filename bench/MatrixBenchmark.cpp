@@ -0,0 +1,87 @@
+// Ouzel by Elviss Strazdins
+
+#include <vector>
+#include "Benchmark.hpp"
+#include "math/Matrix.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        // roughly the number of transforms of a large scene
+        constexpr std::size_t matrixCount = 10000;
+
+        std::vector<Matrix<float, 4>>& getMatrices()
+        {
+            static std::vector<Matrix<float, 4>> matrices = [] {
+                std::vector<Matrix<float, 4>> result(matrixCount);
+                for (std::size_t i = 0; i < matrixCount; ++i)
+                {
+                    const auto f = static_cast<float>(i);
+                    result[i] = Matrix<float, 4>{1.0F, 0.1F * f, 0.0F, 0.0F,
+                                                 0.0F, 1.0F, 0.2F, 0.0F,
+                                                 0.3F, 0.0F, 1.0F, 0.0F,
+                                                 f, -f, 0.5F * f, 1.0F};
+                }
+                return result;
+            }();
+
+            return matrices;
+        }
+
+        // a rotation, so that the matrices stay bounded over the repeated runs
+        Matrix<float, 4> getParent() noexcept
+        {
+            Matrix<float, 4> result;
+            result.setRotationZ(0.01F);
+            return result;
+        }
+
+        // the textbook loop as a reference for the unrolled engine code
+        void multiplyScalar(const Matrix<float, 4>& a, const Matrix<float, 4>& b, Matrix<float, 4>& dst) noexcept
+        {
+            Matrix<float, 4> product;
+            for (std::size_t column = 0; column < 4; ++column)
+                for (std::size_t row = 0; row < 4; ++row)
+                {
+                    float sum = 0.0F;
+                    for (std::size_t i = 0; i < 4; ++i)
+                        sum += a.m[i * 4 + row] * b.m[column * 4 + i];
+                    product.m[column * 4 + row] = sum;
+                }
+
+            dst = product;
+        }
+
+        const Registration multiply{"matrix/multiply", matrixCount, [] {
+            auto& matrices = getMatrices();
+            const auto parent = getParent();
+            for (auto& matrix : matrices)
+                parent.multiply(matrix, matrix);
+            doNotOptimize(matrices.front());
+        }};
+
+        const Registration multiplyScalarLoop{"matrix/multiply scalar loop", matrixCount, [] {
+            auto& matrices = getMatrices();
+            const auto parent = getParent();
+            for (auto& matrix : matrices)
+                multiplyScalar(parent, matrix, matrix);
+            doNotOptimize(matrices.front());
+        }};
+
+        const Registration transformPoints{"matrix/transform points", matrixCount, [] {
+            static std::vector<Vector<float, 3>> points(matrixCount, Vector<float, 3>{1.0F, 2.0F, 3.0F});
+            const auto& matrices = getMatrices();
+            for (std::size_t i = 0; i < matrixCount; ++i)
+                matrices[i].transformPoint(points[i]);
+            doNotOptimize(points.front());
+        }};
+
+        const Registration invert{"matrix/invert", matrixCount, [] {
+            auto& matrices = getMatrices();
+            for (auto& matrix : matrices)
+                matrix.invert();
+            doNotOptimize(matrices.front());
+        }};
+    }
+}
@@ -0,0 +1,41 @@
+// Ouzel by Elviss Strazdins
+
+#include <vector>
+#include "Benchmark.hpp"
+#include "graphics/MipMaps.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        constexpr std::uint32_t textureSize = 1024;
+
+        const std::vector<std::uint8_t>& getPixels()
+        {
+            static const auto pixels = [] {
+                std::vector<std::uint8_t> result(textureSize * textureSize * 4);
+                for (std::size_t i = 0; i < result.size(); ++i)
+                    result[i] = static_cast<std::uint8_t>((i * 7) ^ (i >> 9));
+                return result;
+            }();
+
+            return pixels;
+        }
+
+        void benchmarkMipMaps(graphics::PixelFormat pixelFormat)
+        {
+            const auto levels = graphics::generateMipMaps(Size<std::uint32_t, 2>{textureSize, textureSize},
+                                                          getPixels(), 0, pixelFormat);
+            doNotOptimize(levels.back().second.front());
+        }
+
+        // operations are the pixels of the base level
+        const Registration rgba8{"mipmaps/rgba8 1024x1024", textureSize * textureSize, [] {
+            benchmarkMipMaps(graphics::PixelFormat::rgba8UnsignedNorm);
+        }};
+
+        const Registration rgba8Srgb{"mipmaps/rgba8 srgb 1024x1024", textureSize * textureSize, [] {
+            benchmarkMipMaps(graphics::PixelFormat::rgba8UnsignedNormSRGB);
+        }};
+    }
+}
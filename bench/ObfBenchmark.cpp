@@ -0,0 +1,59 @@
+// Ouzel by Elviss Strazdins
+
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "formats/Obf.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        // shaped like a cooked scene description
+        constexpr std::size_t nodeCount = 10000;
+
+        const obf::Value& getValue()
+        {
+            static const auto value = [] {
+                obf::Value result = obf::Value::Type::array;
+                for (std::size_t i = 0; i < nodeCount; ++i)
+                {
+                    obf::Value node = obf::Value::Type::dictionary;
+                    node["name"] = "node_" + std::to_string(i);
+                    node["mesh"] = static_cast<std::uint32_t>(i % 100);
+                    node["x"] = static_cast<float>(i) * 0.5F;
+                    node["y"] = static_cast<float>(i % 17) * 1.25F;
+                    node["z"] = -static_cast<double>(i) * 0.125;
+                    node["data"] = obf::Value::ByteArray(16, static_cast<std::uint8_t>(i));
+                    result.append(node);
+                }
+                return result;
+            }();
+
+            return value;
+        }
+
+        const std::vector<std::uint8_t>& getBuffer()
+        {
+            static const auto buffer = [] {
+                std::vector<std::uint8_t> result;
+                getValue().encode(result);
+                return result;
+            }();
+
+            return buffer;
+        }
+
+        const Registration encode{"obf/encode", nodeCount, [] {
+            std::vector<std::uint8_t> buffer;
+            getValue().encode(buffer);
+            doNotOptimize(buffer.back());
+        }};
+
+        const Registration decode{"obf/decode", nodeCount, [] {
+            obf::Value value;
+            value.decode(getBuffer(), 0);
+            doNotOptimize(value);
+        }};
+    }
+}
@@ -0,0 +1,160 @@
+// Ouzel by Elviss Strazdins
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.hpp"
+#include "LegacyObj.hpp"
+#include "formats/Obj.hpp"
+#include "thread/JobSystem.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        // a grid of quads with positions, texture coordinates and normals, about 390 MB of text
+        constexpr std::size_t gridSize = 1500;
+        constexpr std::size_t lineCount = (gridSize + 1) * (gridSize + 1) * 3 + gridSize * gridSize;
+
+        const std::string& getObjFile()
+        {
+            static const auto file = [] {
+                std::string result;
+                result.reserve(lineCount * 80);
+
+                char line[256];
+                for (std::size_t y = 0; y <= gridSize; ++y)
+                    for (std::size_t x = 0; x <= gridSize; ++x)
+                    {
+                        std::snprintf(line, sizeof(line), "v %f %f %f\nvt %f %f\nvn 0.000000 1.000000 0.000000\n",
+                                      static_cast<double>(x) * 0.1, static_cast<double>(y) * 0.1,
+                                      static_cast<double>(x * y % 7) * 0.01,
+                                      static_cast<double>(x) / gridSize, static_cast<double>(y) / gridSize);
+                        result += line;
+                    }
+
+                for (std::size_t y = 0; y < gridSize; ++y)
+                    for (std::size_t x = 0; x < gridSize; ++x)
+                    {
+                        const auto a = y * (gridSize + 1) + x + 1;
+                        const auto b = a + 1;
+                        const auto c = a + gridSize + 1;
+                        const auto d = c + 1;
+                        std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n",
+                                      a, a, a, b, b, b, d, d, d, c, c, c);
+                        result += line;
+                    }
+
+                return result;
+            }();
+
+            return file;
+        }
+
+        Span<const std::byte> getObjData()
+        {
+            const auto& file = getObjFile();
+            return Span<const std::byte>{reinterpret_cast<const std::byte*>(file.data()), file.size()};
+        }
+
+        // fixed and scientific numbers with up to 9 significant digits and 9 digit representations
+        // of random floats, as written by exporters, and numbers close to the midpoint of two floats,
+        // which are rounded incorrectly if they are rounded to double first
+        constexpr std::size_t floatCount = 1000000;
+
+        const std::vector<std::string>& getFloatStrings()
+        {
+            static const auto strings = [] {
+                std::vector<std::string> result;
+                result.reserve(floatCount);
+
+                std::mt19937 generator{1};
+                std::uniform_real_distribution<double> distribution{-1000.0, 1000.0};
+
+                char buffer[64];
+                for (std::size_t i = 0; i < floatCount; ++i)
+                {
+                    const auto value = distribution(generator) / (i % 7 == 0 ? 1e5 : 1.0);
+                    const auto precision = static_cast<int>(i % 10);
+
+                    switch (i % 4)
+                    {
+                        case 0: std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value); break;
+                        case 1: std::snprintf(buffer, sizeof(buffer), "%.*e", precision, value); break;
+                        case 2: std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(static_cast<float>(value))); break;
+                        default:
+                        {
+                            const auto lower = static_cast<float>(value);
+                            const auto upper = std::nextafter(lower, std::numeric_limits<float>::max());
+                            const auto midpoint = (static_cast<double>(lower) + static_cast<double>(upper)) / 2.0;
+                            std::snprintf(buffer, sizeof(buffer), "%.*g", 17 + precision % 3, midpoint);
+                            break;
+                        }
+                    }
+
+                    result.emplace_back(buffer);
+                }
+
+                return result;
+            }();
+
+            return strings;
+        }
+
+        float parseFloat(const std::string& str)
+        {
+            auto iterator = reinterpret_cast<const std::byte*>(str.data());
+            return obj::parseFloat(iterator, iterator + str.size());
+        }
+
+        // the results must be bit-identical to strtof
+        Counters countFloatMismatches()
+        {
+            std::size_t mismatchCount = 0;
+
+            for (const auto& str : getFloatStrings())
+            {
+                const auto value = parseFloat(str);
+                const auto expected = std::strtof(str.c_str(), nullptr);
+                if (std::memcmp(&value, &expected, sizeof(float)) != 0)
+                {
+                    if (mismatchCount == 0) std::printf("obj/parse float: %s parsed as %.9g, strtof %.9g\n",
+                                                        str.c_str(), static_cast<double>(value), static_cast<double>(expected));
+                    ++mismatchCount;
+                }
+            }
+
+            return {{"strtof mismatches", static_cast<double>(mismatchCount)}};
+        }
+
+        const Registration floatParse{"obj/parse float", floatCount, [] {
+            float sum = 0.0F;
+            for (const auto& str : getFloatStrings())
+                sum += parseFloat(str);
+            doNotOptimize(sum);
+        }, countFloatMismatches};
+
+        const Registration legacyParse{"obj/legacy parse", lineCount, [] {
+            doNotOptimize(legacy::parse(getObjData()));
+        }};
+
+        const Registration parse{"obj/parse", lineCount, [] {
+            doNotOptimize(obj::parse(getObjData()));
+        }};
+
+        const Registration parallelParse{"obj/parse parallel", lineCount, [] {
+            doNotOptimize(obj::parse(getObjData(), std::thread::hardware_concurrency()));
+        }};
+
+        const Registration jobParse{"obj/parse jobs", lineCount, [] {
+            static thread::JobSystem jobSystem;
+            doNotOptimize(obj::parse(getObjData(), jobSystem));
+        }};
+    }
+}
@@ -0,0 +1,33 @@
+// Ouzel by Elviss Strazdins
+
+#include "Benchmark.hpp"
+#include "utils/Profiler.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        constexpr std::size_t scopeCount = 10000;
+
+        void runScopes()
+        {
+            for (std::size_t i = 0; i < scopeCount; ++i)
+            {
+                OUZEL_PROFILE_SCOPE("bench");
+                doNotOptimize(i);
+            }
+        }
+
+        // the cost of a marker that is compiled in when recording is turned off
+        const Registration disabledScope{"profiler/disabled scope", scopeCount, [] {
+            profiler.setEnabled(false);
+            runScopes();
+        }};
+
+        const Registration enabledScope{"profiler/enabled scope", scopeCount, [] {
+            profiler.setEnabled(true);
+            runScopes();
+            profiler.setEnabled(false);
+        }};
+    }
+}
@@ -0,0 +1,501 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#if defined(_WIN32)
+#  include <malloc.h>
+#endif
+#include "Benchmark.hpp"
+#include "assets/Bundle.hpp"
+#include "core/headless/EngineHeadless.hpp"
+#include "gui/Font.hpp"
+#include "scene/Actor.hpp"
+#include "scene/Camera.hpp"
+#include "scene/Layer.hpp"
+#include "scene/ParticleSystem.hpp"
+#include "scene/Scene.hpp"
+#include "scene/SpriteRenderer.hpp"
+#include "scene/TextRenderer.hpp"
+#include "utils/Profiler.hpp"
+
+namespace
+{
+    std::atomic<std::size_t> allocationCount{0};
+
+    void* allocate(std::size_t size)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (const auto pointer = std::malloc(size != 0 ? size : 1))
+            return pointer;
+
+        throw std::bad_alloc();
+    }
+
+    void* allocate(std::size_t size, std::align_val_t alignment)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        const auto alignmentSize = static_cast<std::size_t>(alignment);
+#if defined(_WIN32)
+        if (const auto pointer = _aligned_malloc(size != 0 ? size : 1, alignmentSize))
+            return pointer;
+#else
+        // aligned_alloc requires the size to be a multiple of the alignment
+        const auto alignedSize = (std::max(size, std::size_t{1}) + alignmentSize - 1) / alignmentSize * alignmentSize;
+        if (const auto pointer = std::aligned_alloc(alignmentSize, alignedSize))
+            return pointer;
+#endif
+
+        throw std::bad_alloc();
+    }
+
+    void deallocateAligned(void* pointer) noexcept
+    {
+#if defined(_WIN32)
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+// counts the allocations of the scene-bench executable, the scene benchmarks report them per frame,
+// all the forms are replaced, so that every allocation is released by its matching function
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocate(size, alignment); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { deallocateAligned(pointer); }
+
+namespace ouzel
+{
+    // referenced by the engine, but the headless engine does not start an application
+    std::unique_ptr<Application> main(const std::vector<std::string>&)
+    {
+        return nullptr;
+    }
+}
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        constexpr auto timeStep = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>{1.0 / 60.0});
+        constexpr float contentWidth = 800.0F;
+        constexpr float contentHeight = 600.0F;
+        // the profiler buffers hold the samples of at least this many frames of every scene
+        constexpr std::size_t recordedFrameCount = 64;
+
+        // monospaced font that draws every character as a quad of the white pixel texture,
+        // so that the text benchmark does not need font files
+        class BlockFont final: public gui::Font
+        {
+        public:
+            explicit BlockFont(const std::shared_ptr<graphics::Texture>& initTexture):
+                texture{initTexture}
+            {
+            }
+
+            RenderData getRenderData(const std::string& text,
+                                     Color color,
+                                     float fontSize,
+                                     const Vector<float, 2>& anchor) const final
+            {
+                const auto height = 16.0F * fontSize;
+                const auto advance = 10.0F * fontSize;
+                const auto width = advance * static_cast<float>(text.size());
+                const Vector<float, 3> normal{0.0F, 0.0F, -1.0F};
+
+                std::vector<std::uint16_t> indices;
+                std::vector<graphics::Vertex> vertices;
+                indices.reserve(text.size() * 6);
+                vertices.reserve(text.size() * 4);
+
+                for (std::size_t i = 0; i < text.size(); ++i)
+                {
+                    const auto left = static_cast<float>(i) * advance - anchor.v[0] * width;
+                    const auto bottom = -anchor.v[1] * height;
+                    const auto first = static_cast<std::uint16_t>(vertices.size());
+
+                    indices.insert(indices.end(), {
+                        first, static_cast<std::uint16_t>(first + 1), static_cast<std::uint16_t>(first + 2),
+                        static_cast<std::uint16_t>(first + 1), static_cast<std::uint16_t>(first + 3), static_cast<std::uint16_t>(first + 2)
+                    });
+
+                    vertices.emplace_back(Vector<float, 3>{left, bottom, 0.0F}, color, Vector<float, 2>{0.0F, 1.0F}, normal);
+                    vertices.emplace_back(Vector<float, 3>{left + advance, bottom, 0.0F}, color, Vector<float, 2>{1.0F, 1.0F}, normal);
+                    vertices.emplace_back(Vector<float, 3>{left, bottom + height, 0.0F}, color, Vector<float, 2>{0.0F, 0.0F}, normal);
+                    vertices.emplace_back(Vector<float, 3>{left + advance, bottom + height, 0.0F}, color, Vector<float, 2>{1.0F, 0.0F}, normal);
+                }
+
+                return {std::move(indices), std::move(vertices), texture};
+            }
+
+        private:
+            std::shared_ptr<graphics::Texture> texture;
+        };
+
+        // the actor is owned by its parent, the component is added first, because components
+        // get the layer only when their actor is added to it
+        scene::Actor& addActor(scene::ActorContainer& parent, std::unique_ptr<scene::Component> component)
+        {
+            auto actor = std::make_unique<scene::Actor>();
+            actor->addComponent(std::move(component));
+            auto& result = *actor;
+            parent.addChild(std::move(actor));
+            return result;
+        }
+
+        scene::Actor& addSprite(scene::ActorContainer& parent, const std::shared_ptr<graphics::Texture>& texture)
+        {
+            auto& actor = addActor(parent, std::make_unique<scene::SpriteRenderer>(texture));
+            actor.setScale(Vector<float, 3>{8.0F, 8.0F, 1.0F});
+            return actor;
+        }
+
+        // a scene with the given number of layers, every layer has cameraCount cameras
+        // that split the window into vertical strips
+        class StressScene: public scene::Scene
+        {
+        public:
+            explicit StressScene(std::size_t layerCount = 1, std::size_t cameraCount = 1)
+            {
+                for (std::size_t l = 0; l < layerCount; ++l)
+                {
+                    auto& layer = *layers.emplace_back(std::make_unique<scene::Layer>());
+
+                    for (std::size_t c = 0; c < cameraCount; ++c)
+                    {
+                        const auto width = 1.0F / static_cast<float>(cameraCount);
+
+                        auto camera = std::make_unique<scene::Camera>();
+                        camera->setScaleMode(scene::Camera::ScaleMode::showAll);
+                        camera->setTargetContentSize(Size<float, 2>{contentWidth, contentHeight});
+                        camera->setViewport(Rect<float>{static_cast<float>(c) * width, 0.0F, width, 1.0F});
+
+                        addActor(layer, std::move(camera));
+                    }
+
+                    addLayer(layer);
+                }
+
+                engine->getEventDispatcher().addEventHandler(handler);
+            }
+
+            void step()
+            {
+                auto& headlessEngine = static_cast<core::headless::Engine&>(*engine);
+
+                auto& frame = frames[frameCount % frames.size()];
+
+                const auto allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+                frame.statistics = headlessEngine.step(timeStep);
+                frame.allocationCount = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+                ++frameCount;
+            }
+
+            // averages of the last recorded frames, the split of the draw time into the visit
+            // and the command recording comes from the profiler, which covers the same frames,
+            // the profiler frame of the last step is not finished, so it is left out
+            Counters getCounters() const
+            {
+                if (frameCount < 2) return Counters{};
+                const auto count = std::min(frameCount - 1, frames.size() - 1);
+
+                std::chrono::nanoseconds updateTime{0};
+                std::chrono::nanoseconds audioTime{0};
+                std::chrono::nanoseconds drawTime{0};
+                std::chrono::nanoseconds submitTime{0};
+                double drawCallCount = 0.0;
+                double frameAllocationCount = 0.0;
+
+                for (std::size_t i = frameCount - 1 - count; i < frameCount - 1; ++i)
+                {
+                    const auto& frame = frames[i % frames.size()];
+                    updateTime += frame.statistics.updateTime;
+                    audioTime += frame.statistics.audioTime;
+                    drawTime += frame.statistics.drawTime;
+                    submitTime += frame.statistics.submitTime;
+                    drawCallCount += frame.statistics.drawCallCount;
+                    frameAllocationCount += static_cast<double>(frame.allocationCount);
+                }
+
+                std::chrono::nanoseconds visitTime{0};
+                std::chrono::nanoseconds recordTime{0};
+                for (const auto& summary : profiler.getSummary(count))
+                    if (std::string_view{summary.name} == "Layer::visit")
+                        visitTime += summary.averageTime;
+                    else if (std::string_view{summary.name} == "Layer::draw")
+                        recordTime += summary.averageTime;
+
+                const auto toMicroseconds = [](std::chrono::nanoseconds time, std::size_t divisor) {
+                    return std::chrono::duration<double, std::micro>(time).count() / static_cast<double>(divisor);
+                };
+
+                return {
+                    {"update us/frame", toMicroseconds(updateTime, count)},
+                    {"audio us/frame", toMicroseconds(audioTime, count)},
+                    {"draw us/frame", toMicroseconds(drawTime, count)},
+                    {"  visit us/frame", toMicroseconds(visitTime, 1)},
+                    {"  record us/frame", toMicroseconds(recordTime, 1)},
+                    {"submit us/frame", toMicroseconds(submitTime, count)},
+                    {"draw calls/frame", drawCallCount / static_cast<double>(count)},
+                    {"allocations/frame", frameAllocationCount / static_cast<double>(count)}
+                };
+            }
+
+        protected:
+            scene::Layer& getLayer(std::size_t index) { return *layers[index]; }
+
+            Vector<float, 2> getRandomPosition()
+            {
+                std::uniform_real_distribution<float> x{-contentWidth / 2.0F, contentWidth / 2.0F};
+                std::uniform_real_distribution<float> y{-contentHeight / 2.0F, contentHeight / 2.0F};
+                return Vector<float, 2>{x(random), y(random)};
+            }
+
+            std::shared_ptr<graphics::Texture> whitePixelTexture = engine->getCache().getTexture(textureWhitePixel);
+            EventHandler handler;
+
+        private:
+            std::vector<std::unique_ptr<scene::Layer>> layers;
+            std::mt19937 random{1}; // the same scene in every run
+
+            struct Frame final
+            {
+                core::headless::Engine::FrameStatistics statistics;
+                std::size_t allocationCount = 0;
+            };
+
+            std::array<Frame, recordedFrameCount> frames;
+            std::size_t frameCount = 0;
+        };
+
+        // sprites that rotate every frame, so that all the transforms are recalculated
+        class SpriteScene final: public StressScene
+        {
+        public:
+            static constexpr std::size_t spriteCount = 10000;
+
+            SpriteScene()
+            {
+                sprites.reserve(spriteCount);
+
+                for (std::size_t i = 0; i < spriteCount; ++i)
+                {
+                    auto& sprite = addSprite(getLayer(0), whitePixelTexture);
+                    sprite.setPosition(getRandomPosition());
+                    sprites.push_back(&sprite);
+                }
+
+                handler.updateHandler = [this](const UpdateEvent& event) {
+                    for (const auto sprite : sprites)
+                        sprite->setRotation(sprite->getRotation().getEulerAngleZ() + event.delta);
+                    return false;
+                };
+            }
+
+        private:
+            std::vector<scene::Actor*> sprites;
+        };
+
+        class ParticleScene final: public StressScene
+        {
+        public:
+            static constexpr std::size_t particleSystemCount = 100;
+
+            ParticleScene()
+            {
+                scene::ParticleSystemData data;
+                data.maxParticles = 250;
+                data.duration = -1.0F; // infinite
+                data.particleLifespan = 2.0F;
+                data.speed = 100.0F;
+                data.angle = 90.0F;
+                data.angleVariance = 30.0F;
+                data.gravity = Vector<float, 2>{0.0F, -50.0F};
+                data.startParticleSize = 8.0F;
+                data.finishParticleSize = 2.0F;
+                data.startColorRed = data.startColorGreen = data.startColorBlue = data.startColorAlpha = 1.0F;
+                data.finishColorRed = data.finishColorGreen = data.finishColorBlue = 1.0F;
+                data.emissionRate = 125.0F;
+                data.texture = whitePixelTexture;
+
+                for (std::size_t i = 0; i < particleSystemCount; ++i)
+                {
+                    addActor(getLayer(0), std::make_unique<scene::ParticleSystem>(data)).setPosition(getRandomPosition());
+                }
+            }
+        };
+
+        // labels of which a tenth change their text every frame
+        class TextScene final: public StressScene
+        {
+        public:
+            static constexpr std::size_t labelCount = 1000;
+
+            TextScene()
+            {
+                labels.reserve(labelCount);
+
+                for (std::size_t i = 0; i < labelCount; ++i)
+                {
+                    auto label = std::make_unique<scene::TextRenderer>("block", 1.0F, "Label " + std::to_string(i));
+                    labels.push_back(label.get());
+
+                    addActor(getLayer(0), std::move(label)).setPosition(getRandomPosition());
+                }
+
+                handler.updateHandler = [this](const UpdateEvent&) {
+                    for (std::size_t i = frame % 10; i < labels.size(); i += 10)
+                        labels[i]->setText("Frame " + std::to_string(frame));
+                    ++frame;
+                    return false;
+                };
+            }
+
+        private:
+            std::vector<scene::TextRenderer*> labels;
+            std::size_t frame = 0;
+        };
+
+        // chains of nested actors with rotating roots, so that every frame the transforms
+        // are propagated through the whole depth
+        class HierarchyScene final: public StressScene
+        {
+        public:
+            static constexpr std::size_t chainCount = 16;
+            static constexpr std::size_t depth = 256;
+
+            HierarchyScene()
+            {
+                for (std::size_t c = 0; c < chainCount; ++c)
+                {
+                    auto& root = addSprite(getLayer(0), whitePixelTexture);
+                    root.setPosition(getRandomPosition());
+                    roots.push_back(&root);
+
+                    scene::Actor* parent = &root;
+                    for (std::size_t d = 1; d < depth; ++d)
+                    {
+                        auto& child = addSprite(*parent, whitePixelTexture);
+                        child.setPosition(Vector<float, 2>{1.0F, 0.0F});
+                        child.setScale(Vector<float, 3>{1.0F, 1.0F, 1.0F});
+                        child.setRotation(0.01F);
+                        parent = &child;
+                    }
+                }
+
+                handler.updateHandler = [this](const UpdateEvent& event) {
+                    for (const auto root : roots)
+                        root->setRotation(root->getRotation().getEulerAngleZ() + event.delta);
+                    return false;
+                };
+            }
+
+        private:
+            std::vector<scene::Actor*> roots;
+        };
+
+        // the same static sprites are visited once per camera of every layer
+        class LayerScene final: public StressScene
+        {
+        public:
+            static constexpr std::size_t layerCount = 8;
+            static constexpr std::size_t cameraCount = 4;
+            static constexpr std::size_t spriteCount = 500; // per layer
+
+            LayerScene():
+                StressScene{layerCount, cameraCount}
+            {
+                for (std::size_t l = 0; l < layerCount; ++l)
+                    for (std::size_t i = 0; i < spriteCount; ++i)
+                        addSprite(getLayer(l), whitePixelTexture).setPosition(getRandomPosition());
+            }
+        };
+
+        // the engine is created on first use and only one scene exists at a time, so that
+        // the update handlers of the previous benchmark do not run
+        class Context final
+        {
+        public:
+            Context()
+            {
+                profiler.setEnabled(true);
+                bundle.setFont("block", std::make_unique<BlockFont>(headlessEngine.getCache().getTexture(textureWhitePixel)));
+            }
+
+            template <class T>
+            T& getScene()
+            {
+                if (auto result = dynamic_cast<T*>(currentScene.get()))
+                    return *result;
+
+                currentScene.reset();
+                auto result = std::make_unique<T>();
+                auto& scene = *result;
+                headlessEngine.getSceneManager().setScene(scene);
+                currentScene = std::move(result);
+                return scene;
+            }
+
+            const StressScene* getCurrentScene() const noexcept { return currentScene.get(); }
+
+        private:
+            core::headless::Engine headlessEngine;
+            assets::Bundle bundle{headlessEngine.getCache(), headlessEngine.getFileSystem()};
+            std::unique_ptr<StressScene> currentScene;
+        };
+
+        Context& getContext()
+        {
+            static Context context;
+            return context;
+        }
+
+        Counters getCounters()
+        {
+            const auto scene = getContext().getCurrentScene();
+            return scene ? scene->getCounters() : Counters{};
+        }
+
+        const Registration sprites{"scene/10000 sprites frame", 1, [] {
+            getContext().getScene<SpriteScene>().step();
+        }, getCounters};
+
+        const Registration particleSystems{"scene/100 particle systems frame", 1, [] {
+            getContext().getScene<ParticleScene>().step();
+        }, getCounters};
+
+        const Registration textLabels{"scene/1000 text labels frame", 1, [] {
+            getContext().getScene<TextScene>().step();
+        }, getCounters};
+
+        const Registration deepHierarchy{"scene/16x256 hierarchy frame", 1, [] {
+            getContext().getScene<HierarchyScene>().step();
+        }, getCounters};
+
+        const Registration layersAndCameras{"scene/8 layers x 4 cameras frame", 1, [] {
+            getContext().getScene<LayerScene>().step();
+        }, getCounters};
+    }
+}
@@ -0,0 +1,53 @@
+// Ouzel by Elviss Strazdins
+
+#include <cstdio>
+#include <string>
+#include "Benchmark.hpp"
+#include "formats/Xml.hpp"
+
+namespace ouzel::bench
+{
+    namespace
+    {
+        // shaped like a COLLADA or plist file, about 3 MB
+        constexpr std::size_t elementCount = 20000;
+
+        const std::string& getXmlFile()
+        {
+            static const auto file = [] {
+                std::string result = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<library>\n";
+                result.reserve(elementCount * 160);
+
+                char element[256];
+                for (std::size_t i = 0; i < elementCount; ++i)
+                {
+                    std::snprintf(element, sizeof(element),
+                                  "    <node id=\"node_%zu\" name=\"Node &amp; %zu\">\n"
+                                  "        <!-- node %zu -->\n"
+                                  "        <translate>%.6f %.6f %.6f</translate>\n"
+                                  "    </node>\n",
+                                  i, i, i,
+                                  static_cast<double>(i) * 0.5, static_cast<double>(i % 17) * 1.25, -static_cast<double>(i) * 0.125);
+                    result += element;
+                }
+
+                result += "</library>\n";
+                return result;
+            }();
+
+            return file;
+        }
+
+        const Registration parse{"xml/parse", elementCount, [] {
+            const auto& file = getXmlFile();
+            const auto data = xml::parse(file.begin(), file.end());
+            doNotOptimize(data);
+        }};
+
+        const Registration encode{"xml/encode", elementCount, [] {
+            static const auto data = xml::parse(getXmlFile().begin(), getXmlFile().end());
+            const auto result = xml::encode(data);
+            doNotOptimize(result);
+        }};
+    }
+}
@@ -0,0 +1,172 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "Benchmark.hpp"
+#include "formats/Json.hpp"
+
+namespace
+{
+    constexpr std::size_t warmUpRuns = 3;
+
+    struct Options final
+    {
+        const char* filter = nullptr; // substring of the benchmark names
+        const char* jsonFile = nullptr;
+        std::size_t repetitions = 15;
+        std::chrono::milliseconds minimumTime{5}; // of one repetition
+    };
+
+    struct Result final
+    {
+        std::size_t iterations; // calls of the benchmark function per repetition
+        std::vector<double> times; // ns per operation of every repetition, sorted
+    };
+
+    void printUsage(const char* executable)
+    {
+        std::fprintf(stderr, "Usage: %s [--json <file>] [--repetitions <count>] [--min-time <ms>] [filter]\n", executable);
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const auto hasValue = i + 1 < argc;
+
+            if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+                options.jsonFile = argv[++i];
+            else if (std::strcmp(argv[i], "--repetitions") == 0 && hasValue)
+                options.repetitions = std::max(std::strtoul(argv[++i], nullptr, 10), 1UL);
+            else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+                options.minimumTime = std::chrono::milliseconds{std::strtol(argv[++i], nullptr, 10)};
+            else if (argv[i][0] != '-' && !options.filter)
+                options.filter = argv[i];
+            else
+                return false;
+        }
+
+        return true;
+    }
+
+    std::chrono::steady_clock::duration measure(const ouzel::bench::Benchmark& benchmark, std::size_t iterations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            benchmark.function();
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    // short benchmarks are called several times per repetition, so that the timer resolution
+    // and the clock overhead do not dominate
+    Result run(const ouzel::bench::Benchmark& benchmark, const Options& options)
+    {
+        Result result{1, {}};
+
+        const auto firstTime = measure(benchmark, 1);
+        if (firstTime < options.minimumTime)
+            result.iterations = static_cast<std::size_t>(std::chrono::duration<double>(options.minimumTime) /
+                                                         std::chrono::duration<double>(std::max(firstTime, std::chrono::steady_clock::duration{1}))) + 1;
+
+        for (std::size_t i = 1; i < warmUpRuns; ++i)
+            measure(benchmark, result.iterations);
+
+        result.times.reserve(options.repetitions);
+
+        for (std::size_t i = 0; i < options.repetitions; ++i)
+        {
+            const auto time = measure(benchmark, result.iterations);
+            result.times.push_back(std::chrono::duration<double, std::nano>(time).count() /
+                                   static_cast<double>(result.iterations * benchmark.operations));
+        }
+
+        std::sort(result.times.begin(), result.times.end());
+
+        return result;
+    }
+
+    // nearest rank of the sorted times
+    double getPercentile(const std::vector<double>& times, double percentile)
+    {
+        const auto index = static_cast<std::size_t>(std::lround(percentile / 100.0 * static_cast<double>(times.size() - 1)));
+        return times[index];
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace ouzel;
+    using namespace ouzel::bench;
+
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    json::Value results = json::Value::Array{};
+
+    std::printf("%-40s %14s %14s %14s\n", "benchmark", "median ns/op", "p90 ns/op", "min ns/op");
+
+    for (const auto& benchmark : getBenchmarks())
+    {
+        if (options.filter && !std::strstr(benchmark.name.c_str(), options.filter))
+            continue;
+
+        const auto result = run(benchmark, options);
+
+        std::printf("%-40s %14.1f %14.1f %14.1f\n", benchmark.name.c_str(),
+                    getPercentile(result.times, 50.0), getPercentile(result.times, 90.0), result.times.front());
+
+        json::Value entry = json::Value::Object{};
+        entry["name"] = benchmark.name;
+        entry["operations"] = benchmark.operations;
+        entry["iterations"] = result.iterations;
+        entry["repetitions"] = result.times.size();
+        entry["min"] = result.times.front();
+        entry["p10"] = getPercentile(result.times, 10.0);
+        entry["median"] = getPercentile(result.times, 50.0);
+        entry["p90"] = getPercentile(result.times, 90.0);
+        entry["max"] = result.times.back();
+
+        if (benchmark.counters)
+        {
+            json::Value counters = json::Value::Object{};
+
+            for (const auto& [name, value] : benchmark.counters())
+            {
+                std::printf("  %-38s %14.1f\n", name.c_str(), value);
+                counters[name] = value;
+            }
+
+            entry["counters"] = counters;
+        }
+
+        results.pushBack(entry);
+    }
+
+    if (options.jsonFile)
+    {
+        json::Value output = json::Value::Object{};
+        output["unit"] = "ns/op";
+        output["benchmarks"] = results;
+
+        std::ofstream file(options.jsonFile, std::ios::binary);
+        file << json::encode(output, true);
+
+        if (!file)
+        {
+            std::fprintf(stderr, "Failed to write %s\n", options.jsonFile);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
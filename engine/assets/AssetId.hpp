@@ -0,0 +1,56 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_ASSETS_ASSETID_HPP
+#define OUZEL_ASSETS_ASSETID_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "../hash/Fnv1.hpp"
+
+namespace ouzel::assets
+{
+    class IdCollisionError final: public std::runtime_error
+    {
+    public:
+        explicit IdCollisionError(const std::string& str): std::runtime_error(str) {}
+        explicit IdCollisionError(const char* str): std::runtime_error(str) {}
+    };
+
+    // 64-bit FNV-1 hash of the asset name, string literals are hashed at compile time
+    class AssetId final
+    {
+    public:
+        constexpr AssetId() noexcept = default;
+        constexpr AssetId(std::string_view name) noexcept:
+            value{hash::fnv1::hashBytes<std::uint64_t>(name.data(), name.size())}
+        {
+        }
+        constexpr AssetId(const char* name) noexcept:
+            AssetId{std::string_view{name}}
+        {
+        }
+        AssetId(const std::string& name) noexcept:
+            AssetId{std::string_view{name}}
+        {
+        }
+
+        constexpr auto getValue() const noexcept { return value; }
+
+        constexpr bool operator==(const AssetId& other) const noexcept
+        {
+            return value == other.value;
+        }
+
+        constexpr bool operator!=(const AssetId& other) const noexcept
+        {
+            return value != other.value;
+        }
+
+    private:
+        std::uint64_t value = hash::fnv1::Constants<std::uint64_t>::offsetBasis;
+    };
+}
+
+#endif // OUZEL_ASSETS_ASSETID_HPP
@@ -0,0 +1,191 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_ASSETS_ASSETMAP_HPP
+#define OUZEL_ASSETS_ASSETMAP_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "AssetId.hpp"
+
+namespace ouzel::assets
+{
+    // Open addressing hash table with linear probing, keyed by the asset id.
+    // The names are kept only to detect id collisions when the assets are added.
+    template <class T>
+    class AssetMap final
+    {
+    public:
+        class Slot final
+        {
+        public:
+            bool occupied = false;
+            AssetId id;
+            std::string name;
+            T value{};
+        };
+
+        template <class SlotType>
+        class Iterator final
+        {
+        public:
+            Iterator(SlotType* initSlot, SlotType* initEnd) noexcept:
+                slot{initSlot}, end{initEnd}
+            {
+                skipEmpty();
+            }
+
+            SlotType& operator*() const noexcept { return *slot; }
+            SlotType* operator->() const noexcept { return slot; }
+
+            Iterator& operator++() noexcept
+            {
+                ++slot;
+                skipEmpty();
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const noexcept { return slot == other.slot; }
+            bool operator!=(const Iterator& other) const noexcept { return slot != other.slot; }
+
+        private:
+            void skipEmpty() noexcept
+            {
+                while (slot != end && !slot->occupied) ++slot;
+            }
+
+            SlotType* slot;
+            SlotType* end;
+        };
+
+        auto begin() noexcept { return Iterator<Slot>{slots.data(), slots.data() + slots.size()}; }
+        auto end() noexcept { return Iterator<Slot>{slots.data() + slots.size(), slots.data() + slots.size()}; }
+        auto begin() const noexcept { return Iterator<const Slot>{slots.data(), slots.data() + slots.size()}; }
+        auto end() const noexcept { return Iterator<const Slot>{slots.data() + slots.size(), slots.data() + slots.size()}; }
+
+        auto size() const noexcept { return count; }
+        auto empty() const noexcept { return count == 0; }
+
+        T* find(AssetId id) noexcept
+        {
+            const auto slot = findSlot(id);
+            return slot ? &slot->value : nullptr;
+        }
+
+        const T* find(AssetId id) const noexcept
+        {
+            const auto slot = const_cast<AssetMap*>(this)->findSlot(id);
+            return slot ? &slot->value : nullptr;
+        }
+
+        // Returns the name the id was registered with or nullptr
+        const std::string* findName(AssetId id) const noexcept
+        {
+            const auto slot = const_cast<AssetMap*>(this)->findSlot(id);
+            return slot ? &slot->name : nullptr;
+        }
+
+        // Replaces the value if an asset with the same name exists
+        T& insert(const std::string& name, T value)
+        {
+            const AssetId id{name};
+
+            if (const auto slot = findSlot(id))
+            {
+                if (slot->name != name)
+                    throw IdCollisionError("Asset \"" + name + "\" has the same id as \"" + slot->name + '"');
+
+                slot->value = std::move(value);
+                return slot->value;
+            }
+
+            // keep the load factor under 3/4
+            if ((count + 1) * 4 > slots.size() * 3)
+                rehash(slots.empty() ? 16 : slots.size() * 2);
+
+            auto index = getIndex(id);
+            while (slots[index].occupied)
+                index = (index + 1) & (slots.size() - 1);
+
+            auto& slot = slots[index];
+            slot.occupied = true;
+            slot.id = id;
+            slot.name = name;
+            slot.value = std::move(value);
+            ++count;
+
+            return slot.value;
+        }
+
+        bool erase(AssetId id)
+        {
+            const auto slot = findSlot(id);
+            if (!slot) return false;
+
+            // shift the following entries of the cluster back, so that no tombstones are needed
+            const auto mask = slots.size() - 1;
+            auto hole = static_cast<std::size_t>(slot - slots.data());
+
+            for (auto index = (hole + 1) & mask; slots[index].occupied; index = (index + 1) & mask)
+            {
+                const auto home = getIndex(slots[index].id);
+                // move the entry only if its home slot is not between the hole and its position
+                if (((index - home) & mask) >= ((index - hole) & mask))
+                {
+                    slots[hole] = std::move(slots[index]);
+                    hole = index;
+                }
+            }
+
+            slots[hole] = Slot{};
+            --count;
+
+            return true;
+        }
+
+        void clear()
+        {
+            slots.clear();
+            count = 0;
+        }
+
+    private:
+        std::size_t getIndex(AssetId id) const noexcept
+        {
+            const auto value = id.getValue();
+            return static_cast<std::size_t>(value ^ (value >> 32)) & (slots.size() - 1);
+        }
+
+        Slot* findSlot(AssetId id) noexcept
+        {
+            if (slots.empty()) return nullptr;
+
+            for (auto index = getIndex(id); slots[index].occupied; index = (index + 1) & (slots.size() - 1))
+                if (slots[index].id == id)
+                    return &slots[index];
+
+            return nullptr;
+        }
+
+        void rehash(std::size_t newSize)
+        {
+            std::vector<Slot> oldSlots(newSize);
+            slots.swap(oldSlots);
+
+            for (auto& oldSlot : oldSlots)
+                if (oldSlot.occupied)
+                {
+                    auto index = getIndex(oldSlot.id);
+                    while (slots[index].occupied)
+                        index = (index + 1) & (slots.size() - 1);
+                    slots[index] = std::move(oldSlot);
+                }
+        }
+
+        std::vector<Slot> slots;
+        std::size_t count = 0;
+    };
+}
+
+#endif // OUZEL_ASSETS_ASSETMAP_HPP
@@ -1,11 +1,12 @@
 // Ouzel by Elviss Strazdins
 
+#include <algorithm>
 #include <cctype>
 #include <stdexcept>
 #include "Bundle.hpp"
 #include "Cache.hpp"
 #include "Loader.hpp"
-#include "../formats/Json.hpp"
+#include "../formats/JsonDocument.hpp"
 
 namespace ouzel::assets
 {
@@ -17,79 +18,161 @@ namespace ouzel::assets
 
     Bundle::~Bundle()
     {
+        cache.cancelLoads(this);
         cache.removeBundle(this);
     }
 
     void Bundle::loadAsset(Loader::Type loaderType, const std::string& name,
                            const std::string& filename, bool mipmaps)
     {
-        const auto data = fileSystem.readFile(filename);
+        const auto file = fileSystem.mapFile(filename);
 
         const auto& loaders = cache.getLoaders();
+        const Asset asset{loaderType, name, filename, mipmaps};
 
-        for (auto i = loaders.rbegin(); i != loaders.rend(); ++i)
-        {
-            Loader* loader = i->get();
-            if (loader->getType() == loaderType &&
-                loader->loadAsset(*this, name, data, mipmaps))
-                return;
-        }
+        const bool loaded = load(asset, [&loaders, &asset, &file, this]() {
+            for (auto i = loaders.rbegin(); i != loaders.rend(); ++i)
+            {
+                Loader* loader = i->get();
+                if (loader->getType() == asset.type &&
+                    loader->loadAsset(*this, asset.name, file.getSpan(), asset.mipmaps))
+                    return true;
+            }
+
+            return false;
+        });
 
-        throw std::runtime_error("Failed to load asset " + filename);
+        if (!loaded)
+            throw std::runtime_error("Failed to load asset " + filename);
     }
 
-    void Bundle::loadAssets(const std::string& filename)
+    namespace
     {
-        const auto data = json::parse(fileSystem.readFile(filename));
+        std::size_t getGpuSize(const graphics::Texture& texture) noexcept
+        {
+            const auto pixelSize = graphics::getPixelSize(texture.getPixelFormat());
+            const auto mipmaps = texture.getMipmaps();
+
+            std::size_t result = 0;
+            auto width = static_cast<std::size_t>(texture.getSize().v[0]);
+            auto height = static_cast<std::size_t>(texture.getSize().v[1]);
+
+            // zero mipmaps means the full chain
+            for (std::uint32_t level = 0; width > 0 && height > 0; ++level)
+            {
+                result += width * height * pixelSize;
+                if ((width == 1 && height == 1) || (mipmaps != 0 && level + 1 >= mipmaps)) break;
+                width = std::max(width / 2, std::size_t{1});
+                height = std::max(height / 2, std::size_t{1});
+            }
 
-        for (const auto& asset : data["assets"])
+            return result;
+        }
+
+        std::size_t getGpuSize(const scene::SpriteData& spriteData) noexcept
         {
-            const auto file = asset["filename"].as<std::string>();
-            const auto name = asset.hasMember("name") ? asset["name"].as<std::string>() : file;
-            const auto mipmaps = asset.hasMember("mipmaps") ? asset["mipmaps"].as<bool>() : true;
-            loadAsset(static_cast<Loader::Type>(asset["type"].as<std::uint32_t>()), name, file, mipmaps);
+            std::size_t result = 0;
+            for (const auto& [name, animation] : spriteData.animations)
+                for (const auto& frame : animation.frames)
+                {
+                    if (frame.getIndexBuffer()) result += frame.getIndexBuffer()->getSize();
+                    if (frame.getVertexBuffer()) result += frame.getVertexBuffer()->getSize();
+                }
+
+            return result;
+        }
+
+        std::size_t getCpuSize(const scene::SpriteData& spriteData) noexcept
+        {
+            std::size_t result = sizeof(scene::SpriteData);
+            for (const auto& [name, animation] : spriteData.animations)
+                result += sizeof(animation) + name.size() +
+                    animation.frames.size() * sizeof(scene::SpriteData::Frame);
+
+            return result;
+        }
+        std::vector<Asset> readManifest(const storage::MappedFile& manifest)
+        {
+            const auto document = json::parseDocument(manifest.getSpan());
+
+            std::vector<Asset> assets;
+
+            for (const auto& asset : document.getRoot()["assets"])
+            {
+                const auto file = asset["filename"].as<std::string>();
+                const auto name = asset.hasMember("name") ? asset["name"].as<std::string>() : file;
+                const auto mipmaps = asset.hasMember("mipmaps") ? asset["mipmaps"].as<bool>() : true;
+                assets.emplace_back(static_cast<Loader::Type>(asset["type"].as<std::uint32_t>()), name, file, mipmaps);
+            }
+
+            return assets;
         }
     }
 
+    void Bundle::loadAssets(const std::string& filename)
+    {
+        loadAssets(readManifest(fileSystem.mapFile(filename)));
+    }
+
     void Bundle::loadAssets(const std::vector<Asset>& assets)
     {
         for (const Asset& asset : assets)
             loadAsset(asset.type, asset.name, asset.filename, asset.mipmaps);
     }
 
-    std::shared_ptr<graphics::Texture> Bundle::getTexture(const std::string& name) const
+    std::shared_ptr<LoadTask> Bundle::loadAssetsAsync(const std::string& filename)
+    {
+        return loadAssetsAsync(readManifest(fileSystem.mapFile(filename)));
+    }
+
+    std::shared_ptr<LoadTask> Bundle::loadAssetsAsync(const std::vector<Asset>& assets)
     {
-        const auto i = textures.find(name);
+        auto task = std::make_shared<LoadTask>(*this, fileSystem, cache.getLoaders(), assets);
+        cache.startLoad(task);
+        return task;
+    }
 
-        if (i != textures.end())
-            return i->second;
+    template <class T>
+    void Bundle::checkId(AssetMap<T> Bundle::* assets, const std::string& name) const
+    {
+        // the same name may be used in several bundles, but not the same id for different names
+        const AssetId id{name};
+        for (const Bundle* bundle : cache.getBundles())
+            if (bundle != this)
+                if (const auto otherName = (bundle->*assets).findName(id))
+                    if (*otherName != name)
+                        throw IdCollisionError("Asset \"" + name + "\" has the same id as \"" + *otherName + '"');
+    }
 
-        return nullptr;
+    std::shared_ptr<graphics::Texture> Bundle::getTexture(AssetId id) const
+    {
+        const auto asset = textures.find(id);
+        return asset ? *asset : nullptr;
     }
 
     void Bundle::setTexture(const std::string& name, const std::shared_ptr<graphics::Texture>& texture)
     {
-        textures[name] = texture;
+        checkId(&Bundle::textures, name);
+        textures.insert(name, texture);
+        updateResidency(textureResidency, Loader::Type::image, name, 0, texture ? getGpuSize(*texture) : 0);
     }
 
     void Bundle::releaseTextures()
     {
         textures.clear();
+        textureResidency.clear();
     }
 
-    const graphics::Shader* Bundle::getShader(const std::string& name) const
+    const graphics::Shader* Bundle::getShader(AssetId id) const
     {
-        const auto i = shaders.find(name);
-
-        if (i != shaders.end())
-            return i->second.get();
-
-        return nullptr;
+        const auto asset = shaders.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setShader(const std::string& name, std::unique_ptr<graphics::Shader> shader)
     {
-        shaders[name] = std::move(shader);
+        checkId(&Bundle::shaders, name);
+        shaders.insert(name, std::move(shader));
     }
 
     void Bundle::releaseShaders()
@@ -97,19 +180,16 @@ namespace ouzel::assets
         shaders.clear();
     }
 
-    const graphics::BlendState* Bundle::getBlendState(const std::string& name) const
+    const graphics::BlendState* Bundle::getBlendState(AssetId id) const
     {
-        const auto i = blendStates.find(name);
-
-        if (i != blendStates.end())
-            return i->second.get();
-
-        return nullptr;
+        const auto asset = blendStates.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setBlendState(const std::string& name, std::unique_ptr<graphics::BlendState> blendState)
     {
-        blendStates[name] = std::move(blendState);
+        checkId(&Bundle::blendStates, name);
+        blendStates.insert(name, std::move(blendState));
     }
 
     void Bundle::releaseBlendStates()
@@ -117,19 +197,16 @@ namespace ouzel::assets
         blendStates.clear();
     }
 
-    const graphics::DepthStencilState* Bundle::getDepthStencilState(const std::string& name) const
+    const graphics::DepthStencilState* Bundle::getDepthStencilState(AssetId id) const
     {
-        const auto i = depthStencilStates.find(name);
-
-        if (i != depthStencilStates.end())
-            return i->second.get();
-
-        return nullptr;
+        const auto asset = depthStencilStates.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setDepthStencilState(const std::string& name, std::unique_ptr<graphics::DepthStencilState> depthStencilState)
     {
-        depthStencilStates[name] = std::move(depthStencilState);
+        checkId(&Bundle::depthStencilStates, name);
+        depthStencilStates.insert(name, std::move(depthStencilState));
     }
 
     void Bundle::releaseDepthStencilStates()
@@ -185,66 +262,63 @@ namespace ouzel::assets
 
                 newSpriteData.animations[""] = std::move(animation);
 
-                spriteData[filename] = newSpriteData;
+                setSpriteData(filename, newSpriteData);
             }
         }
         else
             loadAsset(Loader::Type::sprite, filename, filename, mipmaps);
     }
 
-    const scene::SpriteData* Bundle::getSpriteData(const std::string& name) const
+    const scene::SpriteData* Bundle::getSpriteData(AssetId id) const
     {
-        const auto i = spriteData.find(name);
-
-        if (i != spriteData.end())
-            return &i->second;
-
-        return nullptr;
+        const auto asset = spriteData.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setSpriteData(const std::string& name, const scene::SpriteData& newSpriteData)
     {
-        spriteData[name] = newSpriteData;
+        checkId(&Bundle::spriteData, name);
+        spriteData.insert(name, std::make_unique<scene::SpriteData>(newSpriteData));
+        updateResidency(spriteDataResidency, Loader::Type::sprite, name,
+                        getCpuSize(newSpriteData), getGpuSize(newSpriteData));
     }
 
     void Bundle::releaseSpriteData()
     {
         spriteData.clear();
+        spriteDataResidency.clear();
     }
 
-    const scene::ParticleSystemData* Bundle::getParticleSystemData(const std::string& name) const
+    const scene::ParticleSystemData* Bundle::getParticleSystemData(AssetId id) const
     {
-        const auto i = particleSystemData.find(name);
-
-        if (i != particleSystemData.end())
-            return &i->second;
-
-        return nullptr;
+        const auto asset = particleSystemData.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setParticleSystemData(const std::string& name, const scene::ParticleSystemData& newParticleSystemData)
     {
-        particleSystemData[name] = newParticleSystemData;
+        checkId(&Bundle::particleSystemData, name);
+        particleSystemData.insert(name, std::make_unique<scene::ParticleSystemData>(newParticleSystemData));
+        updateResidency(particleSystemDataResidency, Loader::Type::particleSystem, name,
+                        sizeof(scene::ParticleSystemData), 0);
     }
 
     void Bundle::releaseParticleSystemData()
     {
         particleSystemData.clear();
+        particleSystemDataResidency.clear();
     }
 
-    const gui::Font* Bundle::getFont(const std::string& name) const
+    const gui::Font* Bundle::getFont(AssetId id) const
     {
-        const auto i = fonts.find(name);
-
-        if (i != fonts.end())
-            return i->second.get();
-
-        return nullptr;
+        const auto asset = fonts.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setFont(const std::string& name, std::unique_ptr<gui::Font> font)
     {
-        fonts[name] = std::move(font);
+        checkId(&Bundle::fonts, name);
+        fonts.insert(name, std::move(font));
     }
 
     void Bundle::releaseFonts()
@@ -252,19 +326,16 @@ namespace ouzel::assets
         fonts.clear();
     }
 
-    const audio::Cue* Bundle::getCue(const std::string& name) const
+    const audio::Cue* Bundle::getCue(AssetId id) const
     {
-        const auto i = cues.find(name);
-
-        if (i != cues.end())
-            return i->second.get();
-
-        return nullptr;
+        const auto asset = cues.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setCue(const std::string& name, std::unique_ptr<audio::Cue> cue)
     {
-        cues[name] = std::move(cue);
+        checkId(&Bundle::cues, name);
+        cues.insert(name, std::move(cue));
     }
 
     void Bundle::releaseCues()
@@ -272,19 +343,16 @@ namespace ouzel::assets
         cues.clear();
     }
 
-    const audio::Sound* Bundle::getSound(const std::string& name) const
+    const audio::Sound* Bundle::getSound(AssetId id) const
     {
-        const auto i = sounds.find(name);
-
-        if (i != sounds.end())
-            return i->second.get();
-
-        return nullptr;
+        const auto asset = sounds.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setSound(const std::string& name, std::unique_ptr<audio::Sound> sound)
     {
-        sounds[name] = std::move(sound);
+        checkId(&Bundle::sounds, name);
+        sounds.insert(name, std::move(sound));
     }
 
     void Bundle::releaseSounds()
@@ -292,19 +360,16 @@ namespace ouzel::assets
         sounds.clear();
     }
 
-    const graphics::Material* Bundle::getMaterial(const std::string& name) const
+    const graphics::Material* Bundle::getMaterial(AssetId id) const
     {
-        const auto i = materials.find(name);
-
-        if (i != materials.end())
-            return i->second.get();
-
-        return nullptr;
+        const auto asset = materials.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setMaterial(const std::string& name, std::unique_ptr<graphics::Material> material)
     {
-        materials[name] = std::move(material);
+        checkId(&Bundle::materials, name);
+        materials.insert(name, std::move(material));
     }
 
     void Bundle::releaseMaterials()
@@ -312,19 +377,16 @@ namespace ouzel::assets
         materials.clear();
     }
 
-    const scene::SkinnedMeshData* Bundle::getSkinnedMeshData(const std::string& name) const
+    const scene::SkinnedMeshData* Bundle::getSkinnedMeshData(AssetId id) const
     {
-        const auto i = skinnedMeshData.find(name);
-
-        if (i != skinnedMeshData.end())
-            return &i->second;
-
-        return nullptr;
+        const auto asset = skinnedMeshData.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setSkinnedMeshData(const std::string& name, scene::SkinnedMeshData&& newSkinnedMeshData)
     {
-        skinnedMeshData[name] = std::move(newSkinnedMeshData);
+        checkId(&Bundle::skinnedMeshData, name);
+        skinnedMeshData.insert(name, std::make_unique<scene::SkinnedMeshData>(std::move(newSkinnedMeshData)));
     }
 
     void Bundle::releaseSkinnedMeshData()
@@ -332,23 +394,88 @@ namespace ouzel::assets
         skinnedMeshData.clear();
     }
 
-    const scene::StaticMeshData* Bundle::getStaticMeshData(const std::string& name) const
+    const scene::StaticMeshData* Bundle::getStaticMeshData(AssetId id) const
     {
-        const auto i = staticMeshData.find(name);
-
-        if (i != staticMeshData.end())
-            return &i->second;
-
-        return nullptr;
+        const auto asset = staticMeshData.find(id);
+        return asset ? asset->get() : nullptr;
     }
 
     void Bundle::setStaticMeshData(const std::string& name, scene::StaticMeshData&& newStaticMeshData)
     {
-        staticMeshData[name] = std::move(newStaticMeshData);
+        checkId(&Bundle::staticMeshData, name);
+        staticMeshData.insert(name, std::make_unique<scene::StaticMeshData>(std::move(newStaticMeshData)));
     }
 
     void Bundle::releaseStaticMeshData()
     {
         staticMeshData.clear();
     }
+
+    void Bundle::updateResidency(AssetMap<Residency>& residency, Loader::Type type, const std::string& name,
+                                 std::size_t cpuSize, std::size_t gpuSize)
+    {
+        auto entry = residency.find(name);
+        if (!entry) entry = &residency.insert(name, Residency{});
+
+        // assets that were not created by a loader can not be reloaded
+        if (loadingAsset && loadingAsset->type == type && loadingAsset->name == name)
+        {
+            entry->filename = loadingAsset->filename;
+            entry->mipmaps = loadingAsset->mipmaps;
+        }
+        else
+            entry->filename.clear();
+
+        entry->type = type;
+        entry->resident = true;
+        entry->cpuSize = cpuSize;
+        entry->gpuSize = gpuSize;
+        entry->lastUse = cache.frame;
+    }
+
+    AssetMap<Residency>* Bundle::getResidency(Loader::Type type) noexcept
+    {
+        switch (type)
+        {
+            case Loader::Type::image: return &textureResidency;
+            case Loader::Type::sprite: return &spriteDataResidency;
+            case Loader::Type::particleSystem: return &particleSystemDataResidency;
+            default: return nullptr;
+        }
+    }
+
+    const AssetMap<Residency>* Bundle::getResidency(Loader::Type type) const noexcept
+    {
+        return const_cast<Bundle*>(this)->getResidency(type);
+    }
+
+    std::size_t Bundle::getReferenceCount(Loader::Type type, AssetId id) const noexcept
+    {
+        // the sprites and particle systems copy the data, only the textures are shared
+        if (type != Loader::Type::image) return 0;
+
+        const auto texture = textures.find(id);
+        return texture && *texture ? static_cast<std::size_t>(texture->use_count() - 1) : 0;
+    }
+
+    void Bundle::evict(Loader::Type type, AssetId id)
+    {
+        const auto residency = getResidency(type);
+        if (!residency) return;
+
+        if (const auto entry = residency->find(id))
+        {
+            entry->resident = false;
+            entry->cpuSize = 0;
+            entry->gpuSize = 0;
+        }
+
+        switch (type)
+        {
+            case Loader::Type::image: textures.erase(id); break;
+            case Loader::Type::sprite: spriteData.erase(id); break;
+            case Loader::Type::particleSystem: particleSystemData.erase(id); break;
+            default: break;
+        }
+    }
 }
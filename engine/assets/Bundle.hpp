@@ -3,10 +3,14 @@
 #ifndef OUZEL_ASSETS_BUNDLE_HPP
 #define OUZEL_ASSETS_BUNDLE_HPP
 
-#include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include "AssetId.hpp"
+#include "AssetMap.hpp"
 #include "Loader.hpp"
+#include "LoadTask.hpp"
+#include "Residency.hpp"
 #include "../audio/Cue.hpp"
 #include "../audio/Sound.hpp"
 #include "../graphics/BlendState.hpp"
@@ -48,6 +52,7 @@ namespace ouzel::assets
     class Bundle final
     {
         friend Cache;
+        friend LoadTask;
     public:
         Bundle(Cache& initCache, storage::FileSystem& initFileSystem);
         ~Bundle();
@@ -63,54 +68,58 @@ namespace ouzel::assets
         void loadAssets(const std::string& filename);
         void loadAssets(const std::vector<Asset>& assets);
 
-        std::shared_ptr<graphics::Texture> getTexture(const std::string& name) const;
+        // Returns immediately, the assets are added to the bundle by Cache::update
+        std::shared_ptr<LoadTask> loadAssetsAsync(const std::string& filename);
+        std::shared_ptr<LoadTask> loadAssetsAsync(const std::vector<Asset>& assets);
+
+        std::shared_ptr<graphics::Texture> getTexture(AssetId id) const;
         void setTexture(const std::string& name, const std::shared_ptr<graphics::Texture>& texture);
         void releaseTextures();
 
-        const graphics::Shader* getShader(const std::string& shaderName) const;
+        const graphics::Shader* getShader(AssetId id) const;
         void setShader(const std::string& name, std::unique_ptr<graphics::Shader> shader);
         void releaseShaders();
 
-        const graphics::BlendState* getBlendState(const std::string& name) const;
+        const graphics::BlendState* getBlendState(AssetId id) const;
         void setBlendState(const std::string& name, std::unique_ptr<graphics::BlendState> blendState);
         void releaseBlendStates();
 
-        const graphics::DepthStencilState* getDepthStencilState(const std::string& name) const;
+        const graphics::DepthStencilState* getDepthStencilState(AssetId id) const;
         void setDepthStencilState(const std::string& name, std::unique_ptr<graphics::DepthStencilState> depthStencilState);
         void releaseDepthStencilStates();
 
         void preloadSpriteData(const std::string& filename, bool mipmaps = true,
                                std::uint32_t spritesX = 1, std::uint32_t spritesY = 1,
                                const Vector<float, 2>& pivot = Vector<float, 2>{0.5F, 0.5F});
-        const scene::SpriteData* getSpriteData(const std::string& name) const;
+        const scene::SpriteData* getSpriteData(AssetId id) const;
         void setSpriteData(const std::string& name, const scene::SpriteData& newSpriteData);
         void releaseSpriteData();
 
-        const scene::ParticleSystemData* getParticleSystemData(const std::string& name) const;
+        const scene::ParticleSystemData* getParticleSystemData(AssetId id) const;
         void setParticleSystemData(const std::string& name, const scene::ParticleSystemData& newParticleSystemData);
         void releaseParticleSystemData();
 
-        const gui::Font* getFont(const std::string& name) const;
+        const gui::Font* getFont(AssetId id) const;
         void setFont(const std::string& name, std::unique_ptr<gui::Font> font);
         void releaseFonts();
 
-        const audio::Cue* getCue(const std::string& name) const;
+        const audio::Cue* getCue(AssetId id) const;
         void setCue(const std::string& name, std::unique_ptr<audio::Cue> cue);
         void releaseCues();
 
-        const audio::Sound* getSound(const std::string& name) const;
+        const audio::Sound* getSound(AssetId id) const;
         void setSound(const std::string& name, std::unique_ptr<audio::Sound> sound);
         void releaseSounds();
 
-        const graphics::Material* getMaterial(const std::string& name) const;
+        const graphics::Material* getMaterial(AssetId id) const;
         void setMaterial(const std::string& name, std::unique_ptr<graphics::Material> material);
         void releaseMaterials();
 
-        const scene::SkinnedMeshData* getSkinnedMeshData(const std::string& name) const;
+        const scene::SkinnedMeshData* getSkinnedMeshData(AssetId id) const;
         void setSkinnedMeshData(const std::string& name, scene::SkinnedMeshData&& newSkinnedMeshData);
         void releaseSkinnedMeshData();
 
-        const scene::StaticMeshData* getStaticMeshData(const std::string& name) const;
+        const scene::StaticMeshData* getStaticMeshData(AssetId id) const;
         void setStaticMeshData(const std::string& name, scene::StaticMeshData&& newStaticMeshData);
         void releaseStaticMeshData();
 
@@ -118,18 +127,55 @@ namespace ouzel::assets
         Cache& cache;
         storage::FileSystem& fileSystem;
 
-        std::map<std::string, std::shared_ptr<graphics::Texture>> textures;
-        std::map<std::string, std::unique_ptr<graphics::Shader>> shaders;
-        std::map<std::string, scene::ParticleSystemData> particleSystemData;
-        std::map<std::string, std::unique_ptr<graphics::BlendState>> blendStates;
-        std::map<std::string, std::unique_ptr<graphics::DepthStencilState>> depthStencilStates;
-        std::map<std::string, scene::SpriteData> spriteData;
-        std::map<std::string, std::unique_ptr<gui::Font>> fonts;
-        std::map<std::string, std::unique_ptr<audio::Cue>> cues;
-        std::map<std::string, std::unique_ptr<audio::Sound>> sounds;
-        std::map<std::string, std::unique_ptr<graphics::Material>> materials;
-        std::map<std::string, scene::SkinnedMeshData> skinnedMeshData;
-        std::map<std::string, scene::StaticMeshData> staticMeshData;
+        template <class T>
+        void checkId(AssetMap<T> Bundle::* assets, const std::string& name) const;
+
+        // remembers the asset that the loader is creating, so that it can be reloaded after an eviction
+        template <class Function>
+        bool load(const Asset& asset, Function function)
+        {
+            const auto previousAsset = std::exchange(loadingAsset, &asset);
+            try
+            {
+                const bool result = function();
+                loadingAsset = previousAsset;
+                return result;
+            }
+            catch (...)
+            {
+                loadingAsset = previousAsset;
+                throw;
+            }
+        }
+
+        void updateResidency(AssetMap<Residency>& residency, Loader::Type type, const std::string& name,
+                             std::size_t cpuSize, std::size_t gpuSize);
+
+        // only the textures, sprites and particle systems are tracked, the rest of the assets
+        // are referenced by raw pointers and can not be evicted
+        AssetMap<Residency>* getResidency(Loader::Type type) noexcept;
+        const AssetMap<Residency>* getResidency(Loader::Type type) const noexcept;
+        std::size_t getReferenceCount(Loader::Type type, AssetId id) const noexcept;
+        void evict(Loader::Type type, AssetId id);
+
+        const Asset* loadingAsset = nullptr;
+
+        AssetMap<std::shared_ptr<graphics::Texture>> textures;
+        AssetMap<std::unique_ptr<graphics::Shader>> shaders;
+        AssetMap<std::unique_ptr<scene::ParticleSystemData>> particleSystemData;
+        AssetMap<std::unique_ptr<graphics::BlendState>> blendStates;
+        AssetMap<std::unique_ptr<graphics::DepthStencilState>> depthStencilStates;
+        AssetMap<std::unique_ptr<scene::SpriteData>> spriteData;
+        AssetMap<std::unique_ptr<gui::Font>> fonts;
+        AssetMap<std::unique_ptr<audio::Cue>> cues;
+        AssetMap<std::unique_ptr<audio::Sound>> sounds;
+        AssetMap<std::unique_ptr<graphics::Material>> materials;
+        AssetMap<std::unique_ptr<scene::SkinnedMeshData>> skinnedMeshData;
+        AssetMap<std::unique_ptr<scene::StaticMeshData>> staticMeshData;
+
+        AssetMap<Residency> textureResidency;
+        AssetMap<Residency> spriteDataResidency;
+        AssetMap<Residency> particleSystemDataResidency;
     };
 }
 
@@ -1,9 +1,14 @@
 // Ouzel by Elviss Strazdins
 
 #include <algorithm>
+#include <thread>
 #include "Cache.hpp"
 #include "BmfLoader.hpp"
 #include "ColladaLoader.hpp"
+#include "CookedFontLoader.hpp"
+#include "CookedMeshLoader.hpp"
+#include "CookedSpriteLoader.hpp"
+#include "CookedTextureLoader.hpp"
 #include "CueLoader.hpp"
 #include "GltfLoader.hpp"
 #include "ImageLoader.hpp"
@@ -17,6 +22,7 @@
 #include "../graphics/Graphics.hpp"
 #include "../gui/BMFont.hpp"
 #include "../gui/TTFont.hpp"
+#include "../utils/Log.hpp"
 
 namespace ouzel::assets
 {
@@ -34,9 +40,215 @@ namespace ouzel::assets
         addLoader(std::make_unique<TtfLoader>(*this));
         addLoader(std::make_unique<VorbisLoader>(*this));
         addLoader(std::make_unique<WaveLoader>(*this));
+
+        // the loaders are tried in the reverse order, so the cooked formats are checked first
+        addLoader(std::make_unique<CookedFontLoader>(*this));
+        addLoader(std::make_unique<CookedMeshLoader>(*this));
+        addLoader(std::make_unique<CookedSpriteLoader>(*this));
+        addLoader(std::make_unique<CookedTextureLoader>(*this));
+    }
+
+    Cache::~Cache()
+    {
+        std::unique_lock lock(jobMutex);
+        running = false;
+        lock.unlock();
+        jobCondition.notify_all();
+
+        for (auto& worker : workers)
+            if (worker.isJoinable()) worker.join();
+    }
+
+    void Cache::update()
+    {
+        const auto deadline = std::chrono::steady_clock::now() + loadBudget;
+
+        for (auto i = loadTasks.begin(); i != loadTasks.end();)
+            if ((*i)->finish(deadline))
+                i = loadTasks.erase(i);
+            else
+                ++i;
+
+        for (const auto& [type, residency] : residencies)
+            if (residency.budget != 0)
+                evict(type, residency.budget);
+
+        ++frame;
+    }
+
+    std::size_t Cache::getBudget(Loader::Type type) const
+    {
+        const auto i = residencies.find(type);
+        return i == residencies.end() ? 0 : i->second.budget;
+    }
+
+    void Cache::setBudget(Loader::Type type, std::size_t budget)
+    {
+        residencies[type].budget = budget;
+    }
+
+    ResidencyStatistics Cache::getStatistics(Loader::Type type) const
+    {
+        ResidencyStatistics result;
+
+        if (const auto i = residencies.find(type); i != residencies.end())
+        {
+            result.budget = i->second.budget;
+            result.evictions = i->second.evictions;
+            result.reloads = i->second.reloads;
+        }
+
+        for (const Bundle* bundle : bundles)
+        {
+            const auto residency = bundle->getResidency(type);
+            if (!residency) continue;
+
+            for (const auto& slot : *residency)
+                if (slot.value.resident)
+                {
+                    ++result.residentCount;
+                    if (bundle->getReferenceCount(type, slot.id) != 0) ++result.referencedCount;
+                    result.cpuSize += slot.value.cpuSize;
+                    result.gpuSize += slot.value.gpuSize;
+                }
+                else
+                    ++result.evictedCount;
+        }
+
+        return result;
+    }
+
+    void Cache::evict(Loader::Type type, std::size_t budget)
+    {
+        class Candidate final
+        {
+        public:
+            std::uint64_t lastUse;
+            Bundle* bundle;
+            AssetId id;
+            std::size_t size;
+        };
+
+        std::vector<Candidate> candidates;
+        std::size_t size = 0;
+
+        for (Bundle* bundle : bundles)
+            if (const auto residency = bundle->getResidency(type))
+                for (const auto& slot : *residency)
+                    if (slot.value.resident)
+                    {
+                        const auto assetSize = slot.value.cpuSize + slot.value.gpuSize;
+                        size += assetSize;
+
+                        // assets used in this frame, referenced or not loaded from a file stay resident
+                        if (slot.value.lastUse != frame &&
+                            !slot.value.filename.empty() &&
+                            bundle->getReferenceCount(type, slot.id) == 0)
+                            candidates.push_back(Candidate{slot.value.lastUse, bundle, slot.id, assetSize});
+                    }
+
+        if (size <= budget) return;
+
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) noexcept {
+            return a.lastUse < b.lastUse;
+        });
+
+        auto& residency = residencies[type];
+        for (const auto& candidate : candidates)
+        {
+            if (size <= budget) break;
+
+            candidate.bundle->evict(type, candidate.id);
+            size -= candidate.size;
+            ++residency.evictions;
+        }
     }
 
-    void Cache::addBundle(const Bundle* bundle)
+    template <class T>
+    T Cache::getResident(Loader::Type type, AssetId id, T (Bundle::*getAsset)(AssetId) const)
+    {
+        for (Bundle* bundle : bundles)
+            if (auto asset = (bundle->*getAsset)(id))
+            {
+                if (const auto entry = bundle->getResidency(type)->find(id))
+                    entry->lastUse = frame;
+                return asset;
+            }
+
+        // reload the evicted asset from the bundle that loaded it
+        for (Bundle* bundle : bundles)
+            if (const auto entry = bundle->getResidency(type)->find(id); entry && !entry->resident)
+            {
+                const auto name = *bundle->getResidency(type)->findName(id);
+                const auto filename = entry->filename;
+                const auto mipmaps = entry->mipmaps;
+
+                try
+                {
+                    bundle->loadAsset(type, name, filename, mipmaps);
+                    ++residencies[type].reloads;
+                }
+                catch (const std::exception& e)
+                {
+                    logger.log(Log::Level::error) << "Failed to reload " << filename << ": " << e.what();
+                    return T{};
+                }
+
+                return (bundle->*getAsset)(id);
+            }
+
+        return T{};
+    }
+
+    void Cache::startLoad(const std::shared_ptr<LoadTask>& task)
+    {
+        if (workers.empty())
+        {
+            const auto workerCount = std::clamp(std::thread::hardware_concurrency() / 2U, 1U, 4U);
+            for (std::uint32_t i = 0; i < workerCount; ++i)
+                workers.emplace_back(&Cache::workerMain, this);
+        }
+
+        loadTasks.push_back(task);
+
+        std::unique_lock lock(jobMutex);
+        for (std::size_t i = 0; i < task->getAssetCount(); ++i)
+            jobs.push([task, i]() { task->prepare(i); });
+        lock.unlock();
+        jobCondition.notify_all();
+    }
+
+    void Cache::cancelLoads(const Bundle* bundle)
+    {
+        for (auto i = loadTasks.begin(); i != loadTasks.end();)
+            if ((*i)->bundle == bundle)
+            {
+                (*i)->cancel();
+                i = loadTasks.erase(i);
+            }
+            else
+                ++i;
+    }
+
+    void Cache::workerMain()
+    {
+        thread::setCurrentThreadName("Asset loader");
+
+        for (;;)
+        {
+            std::unique_lock lock(jobMutex);
+            jobCondition.wait(lock, [this]() noexcept { return !running || !jobs.empty(); });
+            if (!running) break;
+
+            const auto job = std::move(jobs.front());
+            jobs.pop();
+            lock.unlock();
+
+            job();
+        }
+    }
+
+    void Cache::addBundle(Bundle* bundle)
     {
         const auto i = std::find(bundles.begin(), bundles.end(), bundle);
         if (i == bundles.end())
@@ -66,109 +278,97 @@ namespace ouzel::assets
             loaders.erase(i);
     }
 
-    std::shared_ptr<graphics::Texture> Cache::getTexture(const std::string& name) const
+    std::shared_ptr<graphics::Texture> Cache::getTexture(AssetId id)
     {
-        for (const Bundle* bundle : bundles)
-            if (const auto texture = bundle->getTexture(name))
-                return texture;
-
-        return nullptr;
+        return getResident(Loader::Type::image, id, &Bundle::getTexture);
     }
 
-    const graphics::Shader* Cache::getShader(const std::string& name) const
+    const graphics::Shader* Cache::getShader(AssetId id) const
     {
         for (const Bundle* bundle : bundles)
-            if (const auto shader = bundle->getShader(name))
+            if (const auto shader = bundle->getShader(id))
                 return shader;
 
         return nullptr;
     }
 
-    const graphics::BlendState* Cache::getBlendState(const std::string& name) const
+    const graphics::BlendState* Cache::getBlendState(AssetId id) const
     {
         for (const Bundle* bundle : bundles)
-            if (const auto blendState = bundle->getBlendState(name))
+            if (const auto blendState = bundle->getBlendState(id))
                 return blendState;
 
         return nullptr;
     }
 
-    const graphics::DepthStencilState* Cache::getDepthStencilState(const std::string& name) const
+    const graphics::DepthStencilState* Cache::getDepthStencilState(AssetId id) const
     {
         for (const Bundle* bundle : bundles)
-            if (const auto depthStencilState = bundle->getDepthStencilState(name))
+            if (const auto depthStencilState = bundle->getDepthStencilState(id))
                 return depthStencilState;
 
         return nullptr;
     }
 
-    const scene::SpriteData* Cache::getSpriteData(const std::string& name) const
+    const scene::SpriteData* Cache::getSpriteData(AssetId id)
     {
-        for (const Bundle* bundle : bundles)
-            if (const auto spriteData = bundle->getSpriteData(name))
-                return spriteData;
-
-        return nullptr;
+        return getResident(Loader::Type::sprite, id, &Bundle::getSpriteData);
     }
 
-    const scene::ParticleSystemData* Cache::getParticleSystemData(const std::string& name) const
+    const scene::ParticleSystemData* Cache::getParticleSystemData(AssetId id)
     {
-        for (const Bundle* bundle : bundles)
-            if (const auto particleSystemData = bundle->getParticleSystemData(name))
-                return particleSystemData;
-
-        return nullptr;
+        return getResident(Loader::Type::particleSystem, id, &Bundle::getParticleSystemData);
     }
 
-    const gui::Font* Cache::getFont(const std::string& name) const
+    const gui::Font* Cache::getFont(AssetId id) const
     {
         for (const Bundle* bundle : bundles)
-            if (const auto font = bundle->getFont(name))
+            if (const auto font = bundle->getFont(id))
                 return font;
 
         return nullptr;
     }
 
-    const audio::Cue* Cache::getCue(const std::string& name) const
+    const audio::Cue* Cache::getCue(AssetId id) const
     {
         for (const Bundle* bundle : bundles)
-            if (const auto cue = bundle->getCue(name))
+            if (const auto cue = bundle->getCue(id))
                 return cue;
 
         return nullptr;
     }
 
-    const audio::Sound* Cache::getSound(const std::string& name) const
+    const audio::Sound* Cache::getSound(AssetId id) const
     {
         for (const Bundle* bundle : bundles)
-            if (const auto sound = bundle->getSound(name))
+            if (const auto sound = bundle->getSound(id))
                 return sound;
 
         return nullptr;
     }
 
-    const graphics::Material* Cache::getMaterial(const std::string& name) const
+    const graphics::Material* Cache::getMaterial(AssetId id) const
     {
         for (const Bundle* bundle : bundles)
-            if (const auto material = bundle->getMaterial(name))
+            if (const auto material = bundle->getMaterial(id))
                 return material;
 
         return nullptr;
     }
 
-    const scene::SkinnedMeshData* Cache::getSkinnedMeshData(const std::string& name) const
+    const scene::SkinnedMeshData* Cache::getSkinnedMeshData(AssetId id) const
     {
         for (const Bundle* bundle : bundles)
-            if (const auto meshData = bundle->getSkinnedMeshData(name))
+            if (const auto meshData = bundle->getSkinnedMeshData(id))
                 return meshData;
 
         return nullptr;
     }
 
-    const scene::StaticMeshData* Cache::getStaticMeshData(const std::string& name) const
+    const scene::StaticMeshData* Cache::getStaticMeshData(AssetId id) const
     {
         for (const Bundle* bundle : bundles)
-            if (const auto meshData = bundle->getStaticMeshData(name))
+            if (const auto meshData = bundle->getStaticMeshData(id))
                 return meshData;
 
         return nullptr;
@@ -3,9 +3,20 @@
 #ifndef OUZEL_ASSETS_CACHE_HPP
 #define OUZEL_ASSETS_CACHE_HPP
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
+#include <vector>
+#include "AssetId.hpp"
 #include "Bundle.hpp"
+#include "LoadTask.hpp"
+#include "Residency.hpp"
+#include "../thread/Thread.hpp"
 
 namespace ouzel::assets
 {
@@ -17,6 +28,7 @@ namespace ouzel::assets
         friend Bundle;
     public:
         Cache();
+        ~Cache();
 
         Cache(const Cache&) = delete;
         Cache& operator=(const Cache&) = delete;
@@ -27,28 +39,73 @@ namespace ouzel::assets
         auto& getBundles() const noexcept { return bundles; }
         auto& getLoaders() const noexcept { return loaders; }
 
-        std::shared_ptr<graphics::Texture> getTexture(const std::string& name) const;
-        const graphics::Shader* getShader(const std::string& name) const;
-        const graphics::BlendState* getBlendState(const std::string& name) const;
-        const graphics::DepthStencilState* getDepthStencilState(const std::string& name) const;
-        const scene::SpriteData* getSpriteData(const std::string& name) const;
-        const scene::ParticleSystemData* getParticleSystemData(const std::string& name) const;
-        const gui::Font* getFont(const std::string& name) const;
-        const audio::Cue* getCue(const std::string& name) const;
-        const audio::Sound* getSound(const std::string& name) const;
-        const graphics::Material* getMaterial(const std::string& name) const;
-        const scene::SkinnedMeshData* getSkinnedMeshData(const std::string& name) const;
-        const scene::StaticMeshData* getStaticMeshData(const std::string& name) const;
+        // finishes the asynchronous loads, called by the engine every frame
+        void update();
+
+        // main thread time that the asynchronous loads may use every frame
+        auto getLoadBudget() const noexcept { return loadBudget; }
+        void setLoadBudget(std::chrono::steady_clock::duration newLoadBudget) noexcept { loadBudget = newLoadBudget; }
+        auto getLoadCount() const noexcept { return loadTasks.size(); }
+
+        // memory that the resident assets of the type may use, zero means no limit;
+        // the least recently used unreferenced textures, sprites and particle systems
+        // are evicted by update and reloaded when they are requested again
+        std::size_t getBudget(Loader::Type type) const;
+        void setBudget(Loader::Type type, std::size_t budget);
+        ResidencyStatistics getStatistics(Loader::Type type) const;
+        auto getFrame() const noexcept { return frame; }
+
+        std::shared_ptr<graphics::Texture> getTexture(AssetId id);
+        const graphics::Shader* getShader(AssetId id) const;
+        const graphics::BlendState* getBlendState(AssetId id) const;
+        const graphics::DepthStencilState* getDepthStencilState(AssetId id) const;
+        const scene::SpriteData* getSpriteData(AssetId id);
+        const scene::ParticleSystemData* getParticleSystemData(AssetId id);
+        const gui::Font* getFont(AssetId id) const;
+        const audio::Cue* getCue(AssetId id) const;
+        const audio::Sound* getSound(AssetId id) const;
+        const graphics::Material* getMaterial(AssetId id) const;
+        const scene::SkinnedMeshData* getSkinnedMeshData(AssetId id) const;
+        const scene::StaticMeshData* getStaticMeshData(AssetId id) const;
 
     private:
-        void addBundle(const Bundle* bundle);
+        void addBundle(Bundle* bundle);
         void removeBundle(const Bundle* bundle);
 
         void addLoader(std::unique_ptr<Loader> loader);
         void removeLoader(const Loader* loader);
 
-        std::vector<const Bundle*> bundles;
+        void startLoad(const std::shared_ptr<LoadTask>& task);
+        void cancelLoads(const Bundle* bundle);
+        void workerMain();
+
+        template <class T>
+        T getResident(Loader::Type type, AssetId id, T (Bundle::*getAsset)(AssetId) const);
+        void evict(Loader::Type type, std::size_t budget);
+
+        std::vector<Bundle*> bundles;
         std::vector<std::unique_ptr<Loader>> loaders;
+
+        std::vector<std::shared_ptr<LoadTask>> loadTasks;
+        std::chrono::steady_clock::duration loadBudget = std::chrono::milliseconds(4);
+
+        class TypeResidency final
+        {
+        public:
+            std::size_t budget = 0;
+            std::size_t evictions = 0;
+            std::size_t reloads = 0;
+        };
+
+        std::uint64_t frame = 0;
+        std::map<Loader::Type, TypeResidency> residencies;
+
+        // the loader threads are started by the first asynchronous load
+        std::vector<thread::Thread> workers;
+        std::mutex jobMutex;
+        std::condition_variable jobCondition;
+        std::queue<std::function<void()>> jobs;
+        bool running = true;
     };
 }
 
@@ -1,13 +1,147 @@
 // Ouzel by Elviss Strazdins
 
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
+#include <string_view>
+#include <unordered_map>
 #include "ColladaLoader.hpp"
 #include "Bundle.hpp"
+#include "../core/Engine.hpp"
 #include "../scene/SkinnedMeshRenderer.hpp"
 #include "../formats/Xml.hpp"
+#include "../utils/Utils.hpp"
 
 namespace ouzel::assets
 {
+    namespace
+    {
+        class Source final
+        {
+        public:
+            std::vector<float> values;
+            std::size_t stride = 1;
+        };
+
+        class Input final
+        {
+        public:
+            std::string_view semantic;
+            std::string_view source;
+            std::size_t offset = 0;
+            std::size_t set = 0;
+        };
+
+        // vertices are compared by their bytes, which is possible because they have no padding
+        static_assert(sizeof(graphics::Vertex) == sizeof(Vector<float, 3>) * 2 + sizeof(Color) + sizeof(Vector<float, 2>) * 2);
+
+        class VertexHash final
+        {
+        public:
+            std::size_t operator()(const graphics::Vertex& vertex) const noexcept
+            {
+                return std::hash<std::string_view>{}(std::string_view{reinterpret_cast<const char*>(&vertex), sizeof(vertex)});
+            }
+        };
+
+        class VertexEqual final
+        {
+        public:
+            bool operator()(const graphics::Vertex& a, const graphics::Vertex& b) const noexcept
+            {
+                return std::memcmp(&a, &b, sizeof(graphics::Vertex)) == 0;
+            }
+        };
+
+        class Primitive final
+        {
+        public:
+            // returns the index of the vertex, identical corners share one vertex
+            std::uint32_t addVertex(const graphics::Vertex& vertex)
+            {
+                const auto [i, inserted] = vertexIndices.try_emplace(vertex, static_cast<std::uint32_t>(vertices.size()));
+                if (inserted)
+                {
+                    vertices.push_back(vertex);
+                    boundingBox.insertPoint(vertex.position);
+                }
+                return i->second;
+            }
+
+            std::vector<Input> inputs;
+            std::vector<std::uint32_t> vertexCounts; // polylist only
+            std::vector<graphics::Vertex> vertices;
+            std::vector<std::uint32_t> indices;
+            std::unordered_map<graphics::Vertex, std::uint32_t, VertexHash, VertexEqual> vertexIndices;
+            Box<float, 3> boundingBox;
+        };
+
+        constexpr bool isWhitespace(const char c) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        std::string_view getId(std::string_view reference)
+        {
+            if (reference.empty() || reference[0] != '#')
+                throw std::runtime_error("Only local references are supported");
+            return reference.substr(1);
+        }
+
+        std::size_t parseSize(std::string_view str)
+        {
+            std::size_t result = 0;
+            for (const auto c : str)
+                if (c >= '0' && c <= '9')
+                    result = result * 10 + static_cast<std::size_t>(c - '0');
+                else
+                    throw std::runtime_error("Invalid number");
+            return result;
+        }
+
+        // Calls the function for every whitespace separated unsigned integer in the text
+        template <class Function>
+        void forEachInteger(std::string_view text, Function function)
+        {
+            auto iterator = text.begin();
+            for (;;)
+            {
+                while (iterator != text.end() && isWhitespace(*iterator)) ++iterator;
+                if (iterator == text.end()) break;
+
+                std::uint32_t value = 0;
+                for (; iterator != text.end() && !isWhitespace(*iterator); ++iterator)
+                    if (*iterator >= '0' && *iterator <= '9')
+                        value = value * 10 + static_cast<std::uint32_t>(*iterator - '0');
+                    else
+                        throw std::runtime_error("Invalid integer");
+
+                function(value);
+            }
+        }
+
+        void parseFloats(std::string_view text, std::vector<float>& result)
+        {
+            // the text of an element is always followed by a tag, so strtof stops inside the buffer
+            auto iterator = text.data();
+            const auto end = text.data() + text.size();
+
+            for (;;)
+            {
+                while (iterator != end && isWhitespace(*iterator)) ++iterator;
+                if (iterator == end) break;
+
+                char* numberEnd;
+                result.push_back(std::strtof(iterator, &numberEnd));
+                if (numberEnd == iterator || numberEnd > end)
+                    throw std::runtime_error("Invalid float");
+
+                iterator = numberEnd;
+            }
+        }
+    }
+
     ColladaLoader::ColladaLoader(Cache& initCache):
         Loader(initCache, Type::skinnedMesh)
     {
@@ -15,22 +149,239 @@ namespace ouzel::assets
 
     bool ColladaLoader::loadAsset(Bundle& bundle,
                                   const std::string& name,
-                                  const std::vector<std::byte>& data,
+                                  Span<const std::byte> data,
                                   bool)
     {
-        const auto colladaData = xml::parse(data);
+        xml::Reader reader{data};
 
-        if (colladaData.getChildren().empty())
-            throw std::runtime_error("Invalid Collada file");
+        // the geometry is read while the document is streamed, so only the source arrays are kept
+        std::unordered_map<std::string_view, Source> sources;
+        std::unordered_map<std::string_view, std::vector<Input>> vertexInputs;
+
+        std::string_view sourceId;
+        std::string_view verticesId;
+        Input input;
+        std::unique_ptr<Primitive> primitive;
+        std::vector<std::uint32_t> polygon;
+        std::size_t polygonIndex = 0;
+
+        scene::SkinnedMeshData meshData;
+
+        const auto emitPart = [&meshData](Primitive& finished) {
+            if (finished.indices.empty()) return;
+
+            scene::SkinnedMeshData::Part part;
+            part.indexCount = static_cast<std::uint32_t>(finished.indices.size());
 
-        const auto rootNode = colladaData.getChildren().front();
+            if (finished.vertices.size() <= std::size_t{std::numeric_limits<std::uint16_t>::max()} + 1)
+            {
+                std::vector<std::uint16_t> convertedIndices;
+                convertedIndices.reserve(finished.indices.size());
 
-        if (rootNode.getValue() != "COLLADA")
+                for (const auto index : finished.indices)
+                    convertedIndices.push_back(static_cast<std::uint16_t>(index));
+
+                part.indexSize = sizeof(std::uint16_t);
+                part.indexBuffer = graphics::Buffer(*engine->getGraphics(),
+                                                    graphics::BufferType::index,
+                                                    graphics::Flags::none,
+                                                    convertedIndices.data(),
+                                                    static_cast<std::uint32_t>(getVectorSize(convertedIndices)));
+            }
+            else
+            {
+                part.indexSize = sizeof(std::uint32_t);
+                part.indexBuffer = graphics::Buffer(*engine->getGraphics(),
+                                                    graphics::BufferType::index,
+                                                    graphics::Flags::none,
+                                                    finished.indices.data(),
+                                                    static_cast<std::uint32_t>(getVectorSize(finished.indices)));
+            }
+
+            part.vertexBuffer = graphics::Buffer(*engine->getGraphics(),
+                                                 graphics::BufferType::vertex,
+                                                 graphics::Flags::none,
+                                                 finished.vertices.data(),
+                                                 static_cast<std::uint32_t>(getVectorSize(finished.vertices)));
+
+            meshData.boundingBox.merge(finished.boundingBox);
+            meshData.parts.push_back(std::move(part));
+        };
+
+        const auto readInput = [&sources](const Input& source, std::size_t index, graphics::Vertex& vertex) {
+            const auto i = sources.find(source.source);
+            if (i == sources.end())
+                throw std::runtime_error("Source not found");
+
+            const auto& values = i->second.values;
+            const auto offset = index * i->second.stride;
+            const auto get = [&values, offset](std::size_t component) {
+                return offset + component < values.size() ? values[offset + component] : 0.0F;
+            };
+
+            if (offset >= values.size())
+                throw std::runtime_error("Index out of range");
+
+            if (source.semantic == "POSITION")
+                vertex.position = Vector<float, 3>{get(0), get(1), get(2)};
+            else if (source.semantic == "NORMAL")
+                vertex.normal = Vector<float, 3>{get(0), get(1), get(2)};
+            else if (source.semantic == "TEXCOORD" && source.set < 2)
+                vertex.texCoords[source.set] = Vector<float, 2>{get(0), get(1)};
+            else if (source.semantic == "COLOR")
+                vertex.color = Color{get(0), get(1), get(2), i->second.stride > 3 ? get(3) : 1.0F};
+        };
+
+        // skip the XML declaration and the comments
+        while (reader.next() != xml::Reader::Event::startElement);
+
+        if (reader.getName() != "COLLADA")
             throw std::runtime_error("Invalid Collada file");
 
-        scene::SkinnedMeshData meshData;
+        for (auto event = reader.next(); event != xml::Reader::Event::end; event = reader.next())
+        {
+            const auto element = reader.getElement();
+
+            switch (event)
+            {
+                case xml::Reader::Event::startElement:
+                {
+                    const auto tag = reader.getName();
+
+                    if (tag == "input")
+                        input = Input{};
+                    else if (tag == "triangles" || tag == "polylist")
+                    {
+                        primitive = std::make_unique<Primitive>();
+                        polygonIndex = 0;
+                    }
+                    else if (tag == "library_animations" || tag == "library_images" ||
+                             tag == "library_effects" || tag == "library_visual_scenes")
+                        reader.skipElement();
+                    break;
+                }
+
+                case xml::Reader::Event::attribute:
+                {
+                    const auto attribute = reader.getName();
+                    const auto value = reader.getValue();
+
+                    if (element == "source" && attribute == "id")
+                    {
+                        sourceId = value;
+                        sources[sourceId] = Source{};
+                    }
+                    else if (element == "float_array" && attribute == "count")
+                        sources[sourceId].values.reserve(parseSize(value));
+                    else if (element == "accessor" && attribute == "stride")
+                        sources[sourceId].stride = std::max(parseSize(value), std::size_t{1});
+                    else if (element == "vertices" && attribute == "id")
+                        verticesId = value;
+                    else if (element == "input")
+                    {
+                        if (attribute == "semantic") input.semantic = value;
+                        else if (attribute == "source") input.source = getId(value);
+                        else if (attribute == "offset") input.offset = parseSize(value);
+                        else if (attribute == "set") input.set = parseSize(value);
+                    }
+                    else if ((element == "triangles" || element == "polylist") && attribute == "count" && primitive)
+                        primitive->indices.reserve(parseSize(value) * 3);
+                    break;
+                }
+
+                case xml::Reader::Event::text:
+                {
+                    const auto text = reader.getValue();
+
+                    if (element == "float_array")
+                        parseFloats(text, sources[sourceId].values);
+                    else if (element == "vcount" && primitive)
+                        forEachInteger(text, [&primitive](std::uint32_t count) {
+                            primitive->vertexCounts.push_back(count);
+                        });
+                    else if (element == "p" && primitive)
+                    {
+                        std::size_t stride = 0;
+                        for (const auto& primitiveInput : primitive->inputs)
+                            stride = std::max(stride, primitiveInput.offset + 1);
+                        if (stride == 0)
+                            throw std::runtime_error("Primitive has no inputs");
+
+                        const auto polylist = !primitive->vertexCounts.empty();
+                        std::size_t component = 0;
+                        graphics::Vertex vertex;
+                        vertex.color = Color::white();
+
+                        // the indices are turned into vertices as they are read
+                        forEachInteger(text, [&](std::uint32_t index) {
+                            for (const auto& primitiveInput : primitive->inputs)
+                                if (primitiveInput.offset == component)
+                                {
+                                    if (primitiveInput.semantic == "VERTEX")
+                                    {
+                                        const auto inputs = vertexInputs.find(primitiveInput.source);
+                                        if (inputs == vertexInputs.end())
+                                            throw std::runtime_error("Vertices not found");
+
+                                        for (const auto& vertexInput : inputs->second)
+                                            readInput(vertexInput, index, vertex);
+                                    }
+                                    else
+                                        readInput(primitiveInput, index, vertex);
+                                }
+
+                            if (++component < stride) return;
+                            component = 0;
+
+                            polygon.push_back(primitive->addVertex(vertex));
+                            vertex = graphics::Vertex{};
+                            vertex.color = Color::white();
+
+                            const auto polygonSize = polylist ?
+                                (polygonIndex < primitive->vertexCounts.size() ? primitive->vertexCounts[polygonIndex] : 0U) :
+                                3U;
+
+                            if (polygon.size() == polygonSize)
+                            {
+                                // triangulate the polygon as a fan
+                                for (std::size_t i = 2; i < polygon.size(); ++i)
+                                    primitive->indices.insert(primitive->indices.end(),
+                                                              {polygon[0], polygon[i - 1], polygon[i]});
+                                polygon.clear();
+                                ++polygonIndex;
+                            }
+                            else if (polygon.size() > polygonSize)
+                                throw std::runtime_error("Invalid polygon");
+                        });
+                    }
+                    break;
+                }
+
+                case xml::Reader::Event::endElement:
+                {
+                    const auto tag = reader.getName();
+
+                    if (tag == "input")
+                    {
+                        // the vertex inputs refer to sources, the primitive inputs can also refer to vertices
+                        if (element == "vertices")
+                            vertexInputs[verticesId].push_back(input);
+                        else if ((element == "triangles" || element == "polylist") && primitive)
+                            primitive->inputs.push_back(input);
+                    }
+                    else if ((tag == "triangles" || tag == "polylist") && primitive)
+                    {
+                        emitPart(*primitive);
+                        primitive.reset();
+                        polygon.clear();
+                    }
+                    break;
+                }
 
-        // TODO: load the model
+                default:
+                    break;
+            }
+        }
 
         bundle.setSkinnedMeshData(name, std::move(meshData));
 
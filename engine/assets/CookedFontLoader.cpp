@@ -0,0 +1,80 @@
+// Ouzel by Elviss Strazdins
+
+#include "CookedFontLoader.hpp"
+#include "Bundle.hpp"
+#include "Cache.hpp"
+#include "../formats/Cooked.hpp"
+#include "../gui/BMFont.hpp"
+
+namespace ouzel::assets
+{
+    CookedFontLoader::CookedFontLoader(Cache& initCache):
+        Loader(initCache, Type::font)
+    {
+    }
+
+    bool CookedFontLoader::loadAsset(Bundle& bundle,
+                                     const std::string& name,
+                                     Span<const std::byte> data,
+                                     bool mipmaps)
+    {
+        if (!cooked::Reader::check(data, cooked::fontMagic))
+            return false;
+
+        cooked::Reader reader{data};
+        reader.skipHeader();
+
+        const auto textureName = reader.readString();
+        const auto textureFilename = reader.readString();
+
+        auto texture = cache.getTexture(textureName);
+        if (!texture)
+        {
+            bundle.loadAsset(Type::image, textureName, textureFilename, mipmaps);
+            texture = cache.getTexture(textureName);
+        }
+
+        const auto lineHeight = reader.readUint16();
+        const auto base = reader.readUint16();
+        const auto width = reader.readUint16();
+        const auto height = reader.readUint16();
+        const auto pages = reader.readUint16();
+        const auto outline = reader.readUint16();
+
+        std::unordered_map<char32_t, gui::BMFont::CharDescriptor> chars;
+        const auto charCount = reader.readUint32();
+        chars.reserve(charCount);
+
+        for (std::uint32_t i = 0; i < charCount; ++i)
+        {
+            const auto id = static_cast<char32_t>(reader.readUint32());
+
+            gui::BMFont::CharDescriptor c;
+            c.x = reader.readInt16();
+            c.y = reader.readInt16();
+            c.width = reader.readInt16();
+            c.height = reader.readInt16();
+            c.xOffset = reader.readInt16();
+            c.yOffset = reader.readInt16();
+            c.xAdvance = reader.readInt16();
+            c.page = reader.readInt16();
+            chars[id] = c;
+        }
+
+        std::map<std::pair<char32_t, char32_t>, std::int16_t> kern;
+        const auto kernCount = reader.readUint32();
+
+        for (std::uint32_t i = 0; i < kernCount; ++i)
+        {
+            const auto first = static_cast<char32_t>(reader.readUint32());
+            const auto second = static_cast<char32_t>(reader.readUint32());
+            kern[std::pair(first, second)] = reader.readInt16();
+        }
+
+        bundle.setFont(name, std::make_unique<gui::BMFont>(lineHeight, base, width, height, pages, outline,
+                                                           std::move(chars), std::move(kern),
+                                                           std::move(texture)));
+
+        return true;
+    }
+}
@@ -0,0 +1,21 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_ASSETS_COOKEDFONTLOADER_HPP
+#define OUZEL_ASSETS_COOKEDFONTLOADER_HPP
+
+#include "Loader.hpp"
+
+namespace ouzel::assets
+{
+    class CookedFontLoader final: public Loader
+    {
+    public:
+        explicit CookedFontLoader(Cache& initCache);
+        bool loadAsset(Bundle& bundle,
+                       const std::string& name,
+                       Span<const std::byte> data,
+                       bool mipmaps = true) final;
+    };
+}
+
+#endif // OUZEL_ASSETS_COOKEDFONTLOADER_HPP
@@ -0,0 +1,78 @@
+// Ouzel by Elviss Strazdins
+
+#include "CookedMeshLoader.hpp"
+#include "Bundle.hpp"
+#include "Cache.hpp"
+#include "../core/Engine.hpp"
+#include "../formats/Cooked.hpp"
+#include "../graphics/Vertex.hpp"
+#include "../scene/StaticMeshRenderer.hpp"
+
+namespace ouzel::assets
+{
+    CookedMeshLoader::CookedMeshLoader(Cache& initCache):
+        Loader(initCache, Type::staticMesh)
+    {
+    }
+
+    bool CookedMeshLoader::loadAsset(Bundle& bundle,
+                                     const std::string&,
+                                     Span<const std::byte> data,
+                                     bool mipmaps)
+    {
+        if (!cooked::Reader::check(data, cooked::staticMeshMagic))
+            return false;
+
+        cooked::Reader reader{data};
+        reader.skipHeader();
+
+        const auto libraryCount = reader.readUint32();
+        for (std::uint32_t i = 0; i < libraryCount; ++i)
+        {
+            const auto filename = reader.readString();
+            bundle.loadAsset(Type::material, filename, filename, mipmaps);
+        }
+
+        const auto meshCount = reader.readUint32();
+        for (std::uint32_t i = 0; i < meshCount; ++i)
+        {
+            const auto meshName = reader.readString();
+            const auto materialName = reader.readString();
+
+            scene::StaticMeshData meshData;
+            meshData.material = materialName.empty() ? nullptr : cache.getMaterial(materialName);
+
+            for (std::size_t c = 0; c < 3; ++c) meshData.boundingBox.min.v[c] = reader.readFloat();
+            for (std::size_t c = 0; c < 3; ++c) meshData.boundingBox.max.v[c] = reader.readFloat();
+
+            meshData.indexSize = reader.readUint32();
+            if (meshData.indexSize != sizeof(std::uint16_t) &&
+                meshData.indexSize != sizeof(std::uint32_t))
+                throw cooked::DecodeError("Invalid index size");
+
+            const auto indexData = reader.readBlob();
+            meshData.indexCount = static_cast<std::uint32_t>(indexData.size() / meshData.indexSize);
+
+            if (reader.readUint32() != sizeof(graphics::Vertex))
+                throw cooked::DecodeError("Vertex layout does not match");
+
+            const auto vertexData = reader.readBlob();
+
+            meshData.indexBuffer = graphics::Buffer(*engine->getGraphics(),
+                                                    graphics::BufferType::index,
+                                                    graphics::Flags::none,
+                                                    indexData.data(),
+                                                    static_cast<std::uint32_t>(indexData.size()));
+
+            meshData.vertexBuffer = graphics::Buffer(*engine->getGraphics(),
+                                                     graphics::BufferType::vertex,
+                                                     graphics::Flags::none,
+                                                     vertexData.data(),
+                                                     static_cast<std::uint32_t>(vertexData.size()));
+
+            bundle.setStaticMeshData(meshName, std::move(meshData));
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,75 @@
+// Ouzel by Elviss Strazdins
+
+#include "CookedSpriteLoader.hpp"
+#include "Bundle.hpp"
+#include "Cache.hpp"
+#include "../formats/Cooked.hpp"
+#include "../scene/SpriteRenderer.hpp"
+
+namespace ouzel::assets
+{
+    CookedSpriteLoader::CookedSpriteLoader(Cache& initCache):
+        Loader(initCache, Type::sprite)
+    {
+    }
+
+    bool CookedSpriteLoader::loadAsset(Bundle& bundle,
+                                       const std::string& name,
+                                       Span<const std::byte> data,
+                                       bool mipmaps)
+    {
+        if (!cooked::Reader::check(data, cooked::spriteMagic))
+            return false;
+
+        cooked::Reader reader{data};
+        reader.skipHeader();
+
+        scene::SpriteData spriteData;
+
+        const auto textureName = reader.readString();
+        const auto textureFilename = reader.readString();
+
+        spriteData.texture = cache.getTexture(textureName);
+        if (!spriteData.texture)
+        {
+            bundle.loadAsset(Type::image, textureName, textureFilename, mipmaps);
+            spriteData.texture = cache.getTexture(textureName);
+        }
+
+        if (!spriteData.texture)
+            return false;
+
+        const auto animationCount = reader.readUint32();
+        for (std::uint32_t i = 0; i < animationCount; ++i)
+        {
+            const auto animationName = reader.readString();
+
+            scene::SpriteData::Animation animation;
+            animation.name = animationName;
+            animation.frameInterval = reader.readFloat();
+
+            const auto frameCount = reader.readUint32();
+            animation.frames.reserve(frameCount);
+
+            for (std::uint32_t f = 0; f < frameCount; ++f)
+            {
+                const auto frameName = reader.readString();
+
+                Box<float, 2> boundingBox;
+                for (std::size_t c = 0; c < 2; ++c) boundingBox.min.v[c] = reader.readFloat();
+                for (std::size_t c = 0; c < 2; ++c) boundingBox.max.v[c] = reader.readFloat();
+
+                const auto indexData = reader.readBlob();
+                const auto vertexData = reader.readBlob();
+
+                animation.frames.emplace_back(frameName, boundingBox, indexData, vertexData);
+            }
+
+            spriteData.animations[animationName] = std::move(animation);
+        }
+
+        bundle.setSpriteData(name, spriteData);
+
+        return true;
+    }
+}
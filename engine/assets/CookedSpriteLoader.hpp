@@ -0,0 +1,21 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_ASSETS_COOKEDSPRITELOADER_HPP
+#define OUZEL_ASSETS_COOKEDSPRITELOADER_HPP
+
+#include "Loader.hpp"
+
+namespace ouzel::assets
+{
+    class CookedSpriteLoader final: public Loader
+    {
+    public:
+        explicit CookedSpriteLoader(Cache& initCache);
+        bool loadAsset(Bundle& bundle,
+                       const std::string& name,
+                       Span<const std::byte> data,
+                       bool mipmaps = true) final;
+    };
+}
+
+#endif // OUZEL_ASSETS_COOKEDSPRITELOADER_HPP
@@ -0,0 +1,96 @@
+// Ouzel by Elviss Strazdins
+
+#include "CookedTextureLoader.hpp"
+#include "Bundle.hpp"
+#include "../core/Engine.hpp"
+#include "../formats/Cooked.hpp"
+#include "../graphics/Texture.hpp"
+
+namespace ouzel::assets
+{
+    CookedTextureLoader::CookedTextureLoader(Cache& initCache):
+        Loader(initCache, Type::image)
+    {
+    }
+
+    namespace
+    {
+        class PreparedTexture final: public Loader::Prepared
+        {
+        public:
+            graphics::PixelFormat pixelFormat = graphics::PixelFormat::rgba8UnsignedNorm;
+            Size<std::uint32_t, 2> size;
+            std::vector<std::pair<Size<std::uint32_t, 2>, std::vector<std::uint8_t>>> levels;
+        };
+    }
+
+    bool CookedTextureLoader::loadAsset(Bundle& bundle,
+                                        const std::string& name,
+                                        Span<const std::byte> data,
+                                        bool mipmaps)
+    {
+        return finishAsset(bundle, name, prepareAsset(name, data, mipmaps), mipmaps);
+    }
+
+    std::unique_ptr<Loader::Prepared> CookedTextureLoader::prepareAsset(const std::string&,
+                                                                        Span<const std::byte> data,
+                                                                        bool mipmaps)
+    {
+        if (!cooked::Reader::check(data, cooked::textureMagic))
+            return nullptr;
+
+        cooked::Reader reader{data};
+        reader.skipHeader();
+
+        auto result = std::make_unique<PreparedTexture>();
+        result->pixelFormat = static_cast<graphics::PixelFormat>(reader.readUint32());
+        result->size.v[0] = reader.readUint32();
+        result->size.v[1] = reader.readUint32();
+
+        const auto pixelSize = graphics::getPixelSize(result->pixelFormat);
+        if (pixelSize == 0)
+            throw cooked::DecodeError("Invalid pixel format");
+
+        auto levelCount = reader.readUint32();
+        if (levelCount == 0)
+            throw cooked::DecodeError("Texture has no levels");
+        if (!mipmaps) levelCount = 1;
+
+        result->levels.reserve(levelCount);
+
+        for (std::uint32_t level = 0; level < levelCount; ++level)
+        {
+            Size<std::uint32_t, 2> levelSize;
+            levelSize.v[0] = reader.readUint32();
+            levelSize.v[1] = reader.readUint32();
+
+            const auto pixels = reader.readBlob();
+            if (pixels.size() != static_cast<std::size_t>(levelSize.v[0]) * levelSize.v[1] * pixelSize)
+                throw cooked::DecodeError("Invalid texture level size");
+
+            result->levels.emplace_back(levelSize,
+                                        std::vector<std::uint8_t>(reinterpret_cast<const std::uint8_t*>(pixels.begin()),
+                                                                  reinterpret_cast<const std::uint8_t*>(pixels.end())));
+        }
+
+        return result;
+    }
+
+    bool CookedTextureLoader::finishAsset(Bundle& bundle,
+                                          const std::string& name,
+                                          std::unique_ptr<Prepared> prepared,
+                                          bool)
+    {
+        if (!prepared) return false;
+
+        const auto& texture = static_cast<PreparedTexture&>(*prepared);
+
+        bundle.setTexture(name, std::make_shared<graphics::Texture>(*engine->getGraphics(),
+                                                                    texture.levels,
+                                                                    texture.size,
+                                                                    graphics::Flags::none,
+                                                                    texture.pixelFormat));
+
+        return true;
+    }
+}
@@ -0,0 +1,29 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_ASSETS_COOKEDTEXTURELOADER_HPP
+#define OUZEL_ASSETS_COOKEDTEXTURELOADER_HPP
+
+#include "Loader.hpp"
+
+namespace ouzel::assets
+{
+    class CookedTextureLoader final: public Loader
+    {
+    public:
+        explicit CookedTextureLoader(Cache& initCache);
+        bool loadAsset(Bundle& bundle,
+                       const std::string& name,
+                       Span<const std::byte> data,
+                       bool mipmaps = true) final;
+
+        std::unique_ptr<Prepared> prepareAsset(const std::string& name,
+                                               Span<const std::byte> data,
+                                               bool mipmaps = true) final;
+        bool finishAsset(Bundle& bundle,
+                         const std::string& name,
+                         std::unique_ptr<Prepared> prepared,
+                         bool mipmaps = true) final;
+    };
+}
+
+#endif // OUZEL_ASSETS_COOKEDTEXTURELOADER_HPP
@@ -112,7 +112,7 @@ namespace ouzel::assets
 
     bool CueLoader::loadAsset(Bundle& bundle,
                               const std::string& name,
-                              const std::vector<std::byte>& data,
+                              Span<const std::byte> data,
                               bool)
     {
         audio::SourceDefinition sourceDefinition;
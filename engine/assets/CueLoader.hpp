@@ -13,7 +13,7 @@ namespace ouzel::assets
         explicit CueLoader(Cache& initCache);
         bool loadAsset(Bundle& bundle,
                        const std::string& name,
-                       const std::vector<std::byte>& data,
+                       Span<const std::byte> data,
                        bool mipmaps = true) final;
     };
 }
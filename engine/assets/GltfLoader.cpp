@@ -2,8 +2,11 @@
 
 #include "GltfLoader.hpp"
 #include "Bundle.hpp"
+#include "Cache.hpp"
+#include "../core/Engine.hpp"
+#include "../formats/Gltf.hpp"
 #include "../scene/SkinnedMeshRenderer.hpp"
-#include "../formats/Json.hpp"
+#include "../utils/Utils.hpp"
 
 namespace ouzel::assets
 {
@@ -14,20 +17,124 @@ namespace ouzel::assets
 
     bool GltfLoader::loadAsset(Bundle& bundle,
                                const std::string& name,
-                               const std::vector<std::byte>& data,
+                               Span<const std::byte> data,
                                bool mipmaps)
     {
-        const auto d = json::parse(data);
+        // the buffers of a GLB file point into the data, so the index data is not copied while parsing
+        const auto document = gltf::parse(data, [](const std::string& uri) {
+            return engine->getFileSystem().readFile(uri);
+        });
+        const auto model = gltf::load(document);
 
-        const auto& nodesValue = d["nodes"];
-        const auto& meshesValue = d["meshes"];
+        std::vector<std::shared_ptr<graphics::Texture>> textures(model.images.size());
+        for (std::size_t i = 0; i < model.images.size(); ++i)
+        {
+            const auto& image = model.images[i];
 
-        (void)mipmaps;
-        (void)nodesValue;
-        (void)meshesValue;
+            if (image.uri.empty())
+            {
+                const auto imageName = name + "#image" + std::to_string(i);
 
-        scene::SkinnedMeshData skinnedMeshData;
-        bundle.setSkinnedMeshData(name, std::move(skinnedMeshData));
+                // try the loaders in the reverse order, the same as the bundle does
+                for (auto loader = cache.getLoaders().rbegin(); loader != cache.getLoaders().rend(); ++loader)
+                    if ((*loader)->getType() == Type::image &&
+                        (*loader)->loadAsset(bundle, imageName, image.data, mipmaps))
+                        break;
+
+                textures[i] = bundle.getTexture(imageName);
+            }
+            else
+            {
+                bundle.loadAsset(Type::image, image.uri, image.uri, mipmaps);
+                textures[i] = cache.getTexture(image.uri);
+            }
+        }
+
+        std::vector<std::shared_ptr<graphics::Material>> materials;
+        materials.reserve(model.materials.size());
+
+        for (const auto& modelMaterial : model.materials)
+        {
+            auto material = std::make_shared<graphics::Material>();
+            material->blendState = cache.getBlendState(blendAlpha);
+            material->shader = cache.getShader(shaderTexture);
+            material->textures[0] = modelMaterial.baseColorImage == gltf::none ?
+                cache.getTexture(textureWhitePixel) :
+                textures[modelMaterial.baseColorImage];
+            material->diffuseColor = modelMaterial.baseColor;
+            material->opacity = modelMaterial.opacity;
+            material->cullMode = modelMaterial.doubleSided ? graphics::CullMode::none : graphics::CullMode::back;
+            materials.push_back(std::move(material));
+        }
+
+        scene::SkinnedMeshData meshData;
+
+        for (const auto& node : model.nodes)
+        {
+            scene::SkinnedMeshData::Bone bone;
+            bone.name = node.name;
+            bone.parent = node.parent;
+            bone.position = node.translation;
+            bone.rotation = node.rotation;
+            bone.scale = node.scale;
+            meshData.bones.push_back(std::move(bone));
+        }
+
+        for (const auto& modelSkin : model.skins)
+        {
+            scene::SkinnedMeshData::Skin skin;
+            skin.bones = modelSkin.joints;
+            skin.inverseBindMatrices = modelSkin.inverseBindMatrices;
+            meshData.skins.push_back(std::move(skin));
+        }
+
+        for (const auto& primitive : model.primitives)
+        {
+            scene::SkinnedMeshData::Part part;
+            part.indexCount = primitive.indexCount;
+            part.indexSize = primitive.indexSize;
+            // the data is released after loading, so the indices are copied once and handed to the render thread
+            const auto indexData = reinterpret_cast<const std::uint8_t*>(primitive.indexData.data());
+            part.indexBuffer = graphics::Buffer(*engine->getGraphics(),
+                                                graphics::BufferType::index,
+                                                graphics::Flags::none,
+                                                std::vector<std::uint8_t>(indexData, indexData + primitive.indexData.size()));
+            part.vertexBuffer = graphics::Buffer(*engine->getGraphics(),
+                                                 graphics::BufferType::vertex,
+                                                 graphics::Flags::none,
+                                                 primitive.vertices.data(),
+                                                 static_cast<std::uint32_t>(getVectorSize(primitive.vertices)));
+            if (primitive.material != gltf::none)
+                part.material = materials[primitive.material];
+            part.skin = primitive.skin;
+            part.joints = primitive.joints;
+            part.weights = primitive.weights;
+
+            meshData.boundingBox.merge(primitive.boundingBox);
+            meshData.parts.push_back(std::move(part));
+        }
+
+        for (const auto& modelAnimation : model.animations)
+        {
+            scene::SkinnedMeshData::Animation animation;
+            animation.name = modelAnimation.name;
+            animation.duration = modelAnimation.duration;
+
+            for (const auto& modelChannel : modelAnimation.channels)
+            {
+                scene::SkinnedMeshData::Channel channel;
+                channel.bone = modelChannel.node;
+                channel.path = static_cast<scene::SkinnedMeshData::Channel::Path>(modelChannel.path);
+                channel.interpolation = static_cast<scene::SkinnedMeshData::Channel::Interpolation>(modelChannel.interpolation);
+                channel.times = modelChannel.times;
+                channel.values = modelChannel.values;
+                animation.channels.push_back(std::move(channel));
+            }
+
+            meshData.animations.push_back(std::move(animation));
+        }
+
+        bundle.setSkinnedMeshData(name, std::move(meshData));
 
         return true;
     }
@@ -49,10 +49,31 @@ namespace ouzel::assets
     {
     }
 
+    namespace
+    {
+        class PreparedImage final: public Loader::Prepared
+        {
+        public:
+            explicit PreparedImage(graphics::Image&& initImage):
+                image(std::move(initImage))
+            {
+            }
+
+            graphics::Image image;
+        };
+    }
+
     bool ImageLoader::loadAsset(Bundle& bundle,
                                 const std::string& name,
-                                const std::vector<std::byte>& data,
+                                Span<const std::byte> data,
                                 bool mipmaps)
+    {
+        return finishAsset(bundle, name, prepareAsset(name, data, mipmaps), mipmaps);
+    }
+
+    std::unique_ptr<Loader::Prepared> ImageLoader::prepareAsset(const std::string&,
+                                                                Span<const std::byte> data,
+                                                                bool)
     {
         int width;
         int height;
@@ -146,10 +167,20 @@ namespace ouzel::assets
                 throw std::runtime_error("Unsupported pixel format");
         }
 
-        graphics::Image image(pixelFormat,
-                              Size<std::uint32_t, 2>(static_cast<std::uint32_t>(width),
-                                                     static_cast<std::uint32_t>(height)),
-                              imageData);
+        return std::make_unique<PreparedImage>(graphics::Image{pixelFormat,
+                                                               Size<std::uint32_t, 2>(static_cast<std::uint32_t>(width),
+                                                                                      static_cast<std::uint32_t>(height)),
+                                                               imageData});
+    }
+
+    bool ImageLoader::finishAsset(Bundle& bundle,
+                                  const std::string& name,
+                                  std::unique_ptr<Prepared> prepared,
+                                  bool mipmaps)
+    {
+        if (!prepared) return false;
+
+        const auto& image = static_cast<PreparedImage&>(*prepared).image;
 
         auto texture = std::make_shared<graphics::Texture>(*engine->getGraphics(),
                                                            image.getData(),
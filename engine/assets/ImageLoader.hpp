@@ -13,8 +13,16 @@ namespace ouzel::assets
         explicit ImageLoader(Cache& initCache);
         bool loadAsset(Bundle& bundle,
                        const std::string& name,
-                       const std::vector<std::byte>& data,
+                       Span<const std::byte> data,
                        bool mipmaps = true) final;
+
+        std::unique_ptr<Prepared> prepareAsset(const std::string& name,
+                                               Span<const std::byte> data,
+                                               bool mipmaps = true) final;
+        bool finishAsset(Bundle& bundle,
+                         const std::string& name,
+                         std::unique_ptr<Prepared> prepared,
+                         bool mipmaps = true) final;
     };
 }
 
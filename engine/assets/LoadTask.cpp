@@ -0,0 +1,254 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <stdexcept>
+#include "LoadTask.hpp"
+#include "Bundle.hpp"
+#include "../storage/FileSystem.hpp"
+#include "../utils/Log.hpp"
+
+namespace ouzel::assets
+{
+    namespace
+    {
+        // assets of a rank may only reference the assets of the lower ranks
+        constexpr std::uint32_t getRank(Loader::Type type) noexcept
+        {
+            switch (type)
+            {
+                case Loader::Type::bank:
+                case Loader::Type::image:
+                case Loader::Type::sound:
+                    return 0;
+                case Loader::Type::font:
+                case Loader::Type::material:
+                case Loader::Type::particleSystem:
+                case Loader::Type::sprite:
+                case Loader::Type::cue:
+                    return 1;
+                case Loader::Type::staticMesh:
+                case Loader::Type::skinnedMesh:
+                    return 2;
+            }
+
+            return 2;
+        }
+    }
+
+    LoadTask::LoadTask(Bundle& initBundle,
+                       storage::FileSystem& initFileSystem,
+                       const std::vector<std::unique_ptr<Loader>>& initLoaders,
+                       const std::vector<Asset>& assets):
+        bundle(&initBundle),
+        fileSystem(initFileSystem),
+        loaders(initLoaders),
+        items(assets.size()),
+        startTime(std::chrono::steady_clock::now()),
+        report(promise.get_future().share())
+    {
+        result.entries.resize(assets.size());
+
+        for (std::size_t i = 0; i < assets.size(); ++i)
+        {
+            Item& item = items[i];
+            item.index = i;
+            item.rank = getRank(assets[i].type);
+            item.name = assets[i].name;
+            item.filename = assets[i].filename;
+            item.type = assets[i].type;
+            item.mipmaps = assets[i].mipmaps;
+
+            LoadReport::Entry& entry = result.entries[i];
+            entry.name = assets[i].name;
+            entry.filename = assets[i].filename;
+            entry.type = assets[i].type;
+        }
+
+        std::stable_sort(items.begin(), items.end(), [](const Item& a, const Item& b) noexcept {
+            return a.rank < b.rank;
+        });
+    }
+
+    float LoadTask::getProgress() const noexcept
+    {
+        if (items.empty()) return isDone() ? 1.0F : 0.0F;
+
+        return static_cast<float>(getPreparedCount() + getFinishedCount()) /
+            static_cast<float>(items.size() * 2);
+    }
+
+    void LoadTask::prepare(std::size_t index)
+    {
+        Item& item = items[index];
+
+        storage::MappedFile file;
+        Loader* preparedBy = nullptr;
+        std::unique_ptr<Loader::Prepared> preparedData;
+        std::string error;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        if (!isDone())
+        {
+            try
+            {
+                file = fileSystem.mapFile(item.filename);
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+        }
+
+        const auto readEnd = std::chrono::steady_clock::now();
+
+        if (!isDone() && error.empty())
+            for (auto i = loaders.rbegin(); i != loaders.rend(); ++i)
+            {
+                Loader* loader = i->get();
+                if (loader->getType() != item.type) continue;
+
+                // a failed decode is retried on the main thread, which reports the error
+                try
+                {
+                    preparedData = loader->prepareAsset(item.name, file.getSpan(), item.mipmaps);
+                }
+                catch (const std::exception&)
+                {
+                    preparedData.reset();
+                }
+
+                if (preparedData)
+                {
+                    preparedBy = loader;
+                    file = storage::MappedFile{};
+                    break;
+                }
+            }
+
+        const auto prepareEnd = std::chrono::steady_clock::now();
+
+        std::lock_guard lock(mutex);
+        item.file = std::move(file);
+        item.preparedBy = preparedBy;
+        item.preparedData = std::move(preparedData);
+        item.error = std::move(error);
+        item.readTime = readEnd - start;
+        item.prepareTime = prepareEnd - readEnd;
+        item.prepared = true;
+        preparedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool LoadTask::finish(std::chrono::steady_clock::time_point deadline)
+    {
+        bool first = true;
+
+        while (rankBegin < items.size())
+        {
+            const auto rank = items[rankBegin].rank;
+            auto rankEnd = rankBegin;
+            while (rankEnd < items.size() && items[rankEnd].rank == rank) ++rankEnd;
+
+            bool rankFinished = true;
+
+            for (auto i = rankBegin; i < rankEnd; ++i)
+            {
+                Item& item = items[i];
+                if (item.finished) continue;
+
+                {
+                    std::lock_guard lock(mutex);
+                    if (!item.prepared)
+                    {
+                        rankFinished = false;
+                        continue;
+                    }
+                }
+
+                // always make progress, even if the budget was spent by the previous tasks
+                const auto start = std::chrono::steady_clock::now();
+                if (!first && start >= deadline) return false;
+                first = false;
+
+                if (item.error.empty())
+                {
+                    try
+                    {
+                        const Asset asset{item.type, item.name, item.filename, item.mipmaps};
+
+                        const bool loaded = bundle->load(asset, [this, &item]() {
+                            if (item.preparedBy)
+                                return item.preparedBy->finishAsset(*bundle, item.name,
+                                                                    std::move(item.preparedData),
+                                                                    item.mipmaps);
+
+                            for (auto l = loaders.rbegin(); l != loaders.rend(); ++l)
+                            {
+                                Loader* loader = l->get();
+                                if (loader->getType() == item.type &&
+                                    loader->loadAsset(*bundle, item.name, item.file.getSpan(), item.mipmaps))
+                                    return true;
+                            }
+
+                            return false;
+                        });
+
+                        if (!loaded)
+                            throw std::runtime_error("Failed to load asset " + item.filename);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        item.error = e.what();
+                    }
+                }
+
+                item.file = storage::MappedFile{};
+                item.finished = true;
+
+                LoadReport::Entry& entry = result.entries[item.index];
+                entry.readTime = item.readTime;
+                entry.prepareTime = item.prepareTime;
+                entry.finishTime = std::chrono::steady_clock::now() - start;
+                entry.succeeded = item.error.empty();
+                entry.error = item.error;
+
+                if (!entry.succeeded)
+                {
+                    ++result.failedCount;
+                    logger.log(Log::Level::error) << "Failed to load " << item.filename << ": " << item.error;
+                }
+
+                finishedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (!rankFinished) return false;
+
+            rankBegin = rankEnd;
+        }
+
+        complete();
+        return true;
+    }
+
+    void LoadTask::cancel()
+    {
+        bundle = nullptr;
+
+        for (const Item& item : items)
+            if (!item.finished)
+            {
+                LoadReport::Entry& entry = result.entries[item.index];
+                entry.error = "Load cancelled";
+                ++result.failedCount;
+            }
+
+        complete();
+    }
+
+    void LoadTask::complete()
+    {
+        result.totalTime = std::chrono::steady_clock::now() - startTime;
+        done.store(true, std::memory_order_release);
+        promise.set_value(std::move(result));
+    }
+}
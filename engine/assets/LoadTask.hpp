@@ -0,0 +1,130 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_ASSETS_LOADTASK_HPP
+#define OUZEL_ASSETS_LOADTASK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Loader.hpp"
+#include "../storage/MappedFile.hpp"
+
+namespace ouzel::storage
+{
+    class FileSystem;
+}
+
+namespace ouzel::assets
+{
+    class Asset;
+    class Bundle;
+    class Cache;
+
+    class LoadReport final
+    {
+    public:
+        class Entry final
+        {
+        public:
+            std::string name;
+            std::string filename;
+            Loader::Type type = Loader::Type::image;
+            bool succeeded = false;
+            std::string error;
+
+            std::chrono::nanoseconds readTime{0}; // loader thread
+            std::chrono::nanoseconds prepareTime{0}; // loader thread
+            std::chrono::nanoseconds finishTime{0}; // main thread
+        };
+
+        std::vector<Entry> entries; // in the order of the manifest
+        std::size_t failedCount = 0;
+        std::chrono::nanoseconds totalTime{0};
+    };
+
+    // Assets of a manifest that are being loaded in the background. Files are read and
+    // decoded on the loader threads of the cache, the engine objects are created on the
+    // main thread by Cache::update in dependency order (textures and sounds before the
+    // materials, sprites and fonts that use them, those before the meshes).
+    class LoadTask final
+    {
+        friend Cache;
+    public:
+        LoadTask(Bundle& initBundle,
+                 storage::FileSystem& initFileSystem,
+                 const std::vector<std::unique_ptr<Loader>>& initLoaders,
+                 const std::vector<Asset>& assets);
+
+        LoadTask(const LoadTask&) = delete;
+        LoadTask& operator=(const LoadTask&) = delete;
+
+        LoadTask(LoadTask&&) = delete;
+        LoadTask& operator=(LoadTask&&) = delete;
+
+        auto getAssetCount() const noexcept { return items.size(); }
+        std::size_t getPreparedCount() const noexcept { return preparedCount.load(std::memory_order_relaxed); }
+        std::size_t getFinishedCount() const noexcept { return finishedCount.load(std::memory_order_relaxed); }
+
+        // 0..1, reading and decoding counts as the first half of the work of every asset
+        float getProgress() const noexcept;
+        bool isDone() const noexcept { return done.load(std::memory_order_acquire); }
+
+        // becomes ready after the last asset has been added to the bundle
+        auto& getReport() const noexcept { return report; }
+
+    private:
+        class Item final
+        {
+        public:
+            std::size_t index = 0; // position in the manifest
+            std::uint32_t rank = 0;
+            std::string name;
+            std::string filename;
+            Loader::Type type = Loader::Type::image;
+            bool mipmaps = true;
+
+            bool prepared = false; // guarded by the mutex
+            storage::MappedFile file;
+            Loader* preparedBy = nullptr;
+            std::unique_ptr<Loader::Prepared> preparedData;
+            std::string error;
+            std::chrono::nanoseconds readTime{0};
+            std::chrono::nanoseconds prepareTime{0};
+
+            bool finished = false;
+        };
+
+        // loader thread
+        void prepare(std::size_t item);
+
+        // main thread, returns true after the last asset has been finished
+        bool finish(std::chrono::steady_clock::time_point deadline);
+        void cancel();
+        void complete();
+
+        Bundle* bundle;
+        storage::FileSystem& fileSystem;
+        const std::vector<std::unique_ptr<Loader>>& loaders;
+
+        std::vector<Item> items; // sorted by rank
+        std::size_t rankBegin = 0;
+
+        std::mutex mutex;
+        std::atomic<std::size_t> preparedCount{0};
+        std::atomic<std::size_t> finishedCount{0};
+        std::atomic_bool done{false};
+
+        std::chrono::steady_clock::time_point startTime;
+        LoadReport result;
+        std::promise<LoadReport> promise;
+        std::shared_future<LoadReport> report;
+    };
+}
+
+#endif // OUZEL_ASSETS_LOADTASK_HPP
@@ -4,8 +4,9 @@
 #define OUZEL_ASSETS_LOADER_HPP
 
 #include <cstddef>
+#include <memory>
 #include <string>
-#include <vector>
+#include "../utils/Span.hpp"
 
 namespace ouzel::assets
 {
@@ -29,6 +30,13 @@ namespace ouzel::assets
             cue
         };
 
+        // Decoded data of an asset that is turned into engine objects on the main thread
+        class Prepared
+        {
+        public:
+            virtual ~Prepared() = default;
+        };
+
         Loader(Cache& initCache, Type initType):
             cache(initCache), type(initType)
         {
@@ -46,9 +54,27 @@ namespace ouzel::assets
 
         virtual bool loadAsset(Bundle& bundle,
                                const std::string& name,
-                               const std::vector<std::byte>& data,
+                               Span<const std::byte> data,
                                bool mipmaps = true) = 0;
 
+        // Called on a loader thread, so it must not touch the engine subsystems.
+        // Returns nullptr if the data can not be prepared off the main thread.
+        virtual std::unique_ptr<Prepared> prepareAsset(const std::string&,
+                                                       Span<const std::byte>,
+                                                       bool = true)
+        {
+            return nullptr;
+        }
+
+        // Called on the main thread with the result of prepareAsset
+        virtual bool finishAsset(Bundle&,
+                                 const std::string&,
+                                 std::unique_ptr<Prepared>,
+                                 bool = true)
+        {
+            return false;
+        }
+
     protected:
         Cache& cache;
         Type type;
@@ -29,8 +29,8 @@ namespace ouzel::assets
             return static_cast<std::uint8_t>(c) <= 0x1F;
         }
 
-        void skipWhitespaces(std::vector<std::byte>::const_iterator& iterator,
-                             std::vector<std::byte>::const_iterator end) noexcept
+        void skipWhitespaces(const std::byte*& iterator,
+                             const std::byte* end) noexcept
         {
             while (iterator != end)
                 if (isWhitespace(*iterator))
@@ -39,8 +39,8 @@ namespace ouzel::assets
                     break;
         }
 
-        void skipLine(std::vector<std::byte>::const_iterator& iterator,
-                      std::vector<std::byte>::const_iterator end) noexcept
+        void skipLine(const std::byte*& iterator,
+                      const std::byte* end) noexcept
         {
             while (iterator != end)
             {
@@ -54,8 +54,8 @@ namespace ouzel::assets
             }
         }
 
-        std::string parseString(std::vector<std::byte>::const_iterator& iterator,
-                                std::vector<std::byte>::const_iterator end)
+        std::string parseString(const std::byte*& iterator,
+                                const std::byte* end)
         {
             std::string result;
 
@@ -71,8 +71,8 @@ namespace ouzel::assets
             return result;
         }
 
-        float parseFloat(std::vector<std::byte>::const_iterator& iterator,
-                         std::vector<std::byte>::const_iterator end)
+        float parseFloat(const std::byte*& iterator,
+                         const std::byte* end)
         {
             std::string value;
             std::uint32_t length = 1;
@@ -151,7 +151,7 @@ namespace ouzel::assets
 
     bool MtlLoader::loadAsset(Bundle& bundle,
                               const std::string& name,
-                              const std::vector<std::byte>& data,
+                              Span<const std::byte> data,
                               bool mipmaps)
     {
         std::string materialName = name;
@@ -162,7 +162,7 @@ namespace ouzel::assets
 
         std::uint32_t materialCount = 0;
 
-        auto iterator = data.cbegin();
+        auto iterator = data.begin();
 
         while (iterator != data.end())
         {
@@ -15,7 +15,7 @@ namespace ouzel::assets
 
     bool ParticleSystemLoader::loadAsset(Bundle& bundle,
                                          const std::string& name,
-                                         const std::vector<std::byte>& data,
+                                         Span<const std::byte> data,
                                          bool mipmaps)
     {
         scene::ParticleSystemData particleSystemData;
@@ -0,0 +1,41 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_ASSETS_RESIDENCY_HPP
+#define OUZEL_ASSETS_RESIDENCY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Loader.hpp"
+
+namespace ouzel::assets
+{
+    // Memory used by an asset and the file it can be reloaded from after it was evicted
+    class Residency final
+    {
+    public:
+        Loader::Type type = Loader::Type::image;
+        std::string filename; // empty if the asset was not loaded from a file
+        bool mipmaps = true;
+
+        bool resident = true;
+        std::size_t cpuSize = 0;
+        std::size_t gpuSize = 0;
+        std::uint64_t lastUse = 0; // frame of the cache
+    };
+
+    class ResidencyStatistics final
+    {
+    public:
+        std::size_t budget = 0;
+        std::size_t residentCount = 0;
+        std::size_t referencedCount = 0;
+        std::size_t evictedCount = 0; // reloaded on the next access
+        std::size_t cpuSize = 0;
+        std::size_t gpuSize = 0;
+        std::size_t evictions = 0;
+        std::size_t reloads = 0;
+    };
+}
+
+#endif // OUZEL_ASSETS_RESIDENCY_HPP
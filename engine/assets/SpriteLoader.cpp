@@ -16,7 +16,7 @@ namespace ouzel::assets
 
     bool SpriteLoader::loadAsset(Bundle& bundle,
                                  const std::string& name,
-                                 const std::vector<std::byte>& data,
+                                 Span<const std::byte> data,
                                  bool mipmaps)
     {
         scene::SpriteData spriteData;
@@ -14,7 +14,7 @@ namespace ouzel::assets
 
     bool VorbisLoader::loadAsset(Bundle& bundle,
                                  const std::string& name,
-                                 const std::vector<std::byte>& data,
+                                 Span<const std::byte> data,
                                  bool)
     {
         try
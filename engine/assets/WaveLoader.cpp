@@ -5,11 +5,13 @@
 #include "Bundle.hpp"
 #include "../audio/PcmClip.hpp"
 #include "../core/Engine.hpp"
+#include "../utils/Log.hpp"
 
 namespace
 {
     constexpr std::uint16_t WAVE_FORMAT_PCM = 1;
     constexpr std::uint16_t WAVE_FORMAT_IEEE_FLOAT = 3;
+    constexpr std::uint16_t WAVE_FORMAT_IMA_ADPCM = 0x11;
 
     constexpr std::int32_t convert24bitTo232bit(std::byte data[3]) noexcept
     {
@@ -31,10 +33,32 @@ namespace ouzel::assets
     {
     }
 
+    namespace
+    {
+        class PreparedSound final: public Loader::Prepared
+        {
+        public:
+            std::uint32_t channels = 0U;
+            std::uint32_t sampleRate = 0U;
+            bool converted = false; // samples holds planar float samples
+            audio::PcmClip::Encoding encoding = audio::PcmClip::Encoding::float32;
+            std::vector<std::byte> soundData;
+            std::uint16_t blockAlign = 0U;
+            std::vector<float> samples;
+        };
+    }
+
     bool WaveLoader::loadAsset(Bundle& bundle,
                                const std::string& name,
-                               const std::vector<std::byte>& data,
-                               bool)
+                               Span<const std::byte> data,
+                               bool mipmaps)
+    {
+        return finishAsset(bundle, name, prepareAsset(name, data, mipmaps), mipmaps);
+    }
+
+    std::unique_ptr<Loader::Prepared> WaveLoader::prepareAsset(const std::string&,
+                                                               Span<const std::byte> data,
+                                                               bool)
     {
         try
         {
@@ -72,6 +96,7 @@ namespace ouzel::assets
                 throw std::runtime_error("Failed to load sound file, not a WAVE file");
 
             std::uint16_t bitsPerSample = 0U;
+            std::uint16_t blockAlign = 0U;
             std::uint16_t formatTag = 0U;
             std::vector<std::byte> soundData;
 
@@ -112,7 +137,9 @@ namespace ouzel::assets
                     formatTag = static_cast<std::uint16_t>(static_cast<std::uint32_t>(data[formatTagOffset + 0]) |
                                                            (static_cast<std::uint32_t>(data[formatTagOffset + 1]) << 8));
 
-                    if (formatTag != WAVE_FORMAT_PCM && formatTag != WAVE_FORMAT_IEEE_FLOAT)
+                    if (formatTag != WAVE_FORMAT_PCM &&
+                        formatTag != WAVE_FORMAT_IEEE_FLOAT &&
+                        formatTag != WAVE_FORMAT_IMA_ADPCM)
                         throw std::runtime_error("Failed to load sound file, unsupported format");
 
                     const std::size_t channelsOffset = formatTagOffset + 2;
@@ -133,24 +160,26 @@ namespace ouzel::assets
 
                     const std::size_t byteRateOffset = sampleRateOffset + 4;
                     const std::size_t blockAlignOffset = byteRateOffset + 4;
+                    blockAlign = static_cast<std::uint16_t>(static_cast<std::uint32_t>(data[blockAlignOffset + 0]) |
+                                                            (static_cast<std::uint32_t>(data[blockAlignOffset + 1]) << 8));
+
                     const std::size_t bitsPerSampleOffset = blockAlignOffset + 2;
                     bitsPerSample = static_cast<std::uint16_t>(static_cast<std::uint32_t>(data[bitsPerSampleOffset + 0]) |
                                                                (static_cast<std::uint32_t>(data[bitsPerSampleOffset + 1]) << 8));
 
-                    if (bitsPerSample != 8 && bitsPerSample != 16 &&
-                        bitsPerSample != 24 && bitsPerSample != 32)
-                        throw std::runtime_error("Failed to load sound file, unsupported bit depth");
-
-                    if (formatTag != WAVE_FORMAT_PCM && formatTag != WAVE_FORMAT_IEEE_FLOAT)
+                    if (formatTag == WAVE_FORMAT_IMA_ADPCM)
                     {
-                        const auto size = static_cast<std::uint32_t>(data[offset + 0]) |
-                            (static_cast<std::uint32_t>(data[offset + 1]) << 8) |
-                            (static_cast<std::uint32_t>(data[offset + 2]) << 16) |
-                            (static_cast<std::uint32_t>(data[offset + 3]) << 24);
-
-                        offset += 4;
-                        offset += size; // skip the additional data
+                        if (bitsPerSample != 4)
+                            throw std::runtime_error("Failed to load sound file, unsupported bit depth");
+                    }
+                    else if (formatTag == WAVE_FORMAT_IEEE_FLOAT)
+                    {
+                        if (bitsPerSample != 32)
+                            throw std::runtime_error("Failed to load sound file, unsupported bit depth");
                     }
+                    else if (bitsPerSample != 8 && bitsPerSample != 16 &&
+                             bitsPerSample != 24 && bitsPerSample != 32)
+                        throw std::runtime_error("Failed to load sound file, unsupported bit depth");
                 }
                 else if (static_cast<char>(chunkHeader[0]) == 'd' &&
                          static_cast<char>(chunkHeader[1]) == 'a' &&
@@ -165,48 +194,31 @@ namespace ouzel::assets
             if (!formatTag)
                 throw std::runtime_error("Failed to load sound file, failed to find a format chunk");
 
-            if (data.empty())
+            if (soundData.empty())
                 throw std::runtime_error("Failed to load sound file, failed to find a data chunk");
 
-            const auto sampleCount = static_cast<std::uint32_t>(soundData.size() / (bitsPerSample / 8));
-            const auto frames = sampleCount / channels;
-            std::vector<float> samples(sampleCount);
-
-            if (formatTag == WAVE_FORMAT_PCM)
+            auto prepared = std::make_unique<PreparedSound>();
+            prepared->channels = channels;
+            prepared->sampleRate = sampleRate;
+            prepared->blockAlign = blockAlign;
+
+            if (formatTag == WAVE_FORMAT_PCM && bitsPerSample == 8)
+                prepared->encoding = audio::PcmClip::Encoding::unsignedInt8;
+            else if (formatTag == WAVE_FORMAT_PCM && bitsPerSample == 16)
+                prepared->encoding = audio::PcmClip::Encoding::signedInt16;
+            else if (formatTag == WAVE_FORMAT_IMA_ADPCM)
+                prepared->encoding = audio::PcmClip::Encoding::imaAdpcm;
+            else if (formatTag == WAVE_FORMAT_IEEE_FLOAT)
+                prepared->encoding = audio::PcmClip::Encoding::float32;
+            else
             {
+                // 24 and 32-bit integer samples have no compact representation, so convert them to float
+                const auto sampleCount = static_cast<std::uint32_t>(soundData.size() / (bitsPerSample / 8));
+                const auto frames = sampleCount / channels;
+                std::vector<float> samples(sampleCount);
+
                 switch (bitsPerSample)
                 {
-                    case 8:
-                    {
-                        for (std::uint32_t channel = 0; channel < channels; ++channel)
-                        {
-                            auto outputChannel = &samples[channel * frames];
-
-                            for (std::uint32_t frame = 0; frame < frames; ++frame)
-                            {
-                                const auto sourceData = &soundData[frame * channels + channel];
-                                const auto value = static_cast<std::uint8_t>(sourceData[0]);
-                                outputChannel[frame] = 2.0F * value / 255.0F - 1.0F;
-                            }
-                        }
-                        break;
-                    }
-                    case 16:
-                    {
-                        for (std::uint32_t channel = 0; channel < channels; ++channel)
-                        {
-                            auto outputChannel = &samples[channel * frames];
-
-                            for (std::uint32_t frame = 0; frame < frames; ++frame)
-                            {
-                                const auto sourceData = &soundData[(frame * channels + channel) * 2];
-                                const auto value = static_cast<std::int32_t>(sourceData[0]) |
-                                    (static_cast<std::int32_t>(sourceData[1]) << 8);
-                                outputChannel[frame] = static_cast<float>(value) / 32767.0F;
-                            }
-                        }
-                        break;
-                    }
                     case 24:
                     {
                         for (std::uint32_t channel = 0; channel < channels; ++channel)
@@ -244,33 +256,50 @@ namespace ouzel::assets
                     default:
                         throw std::runtime_error("Failed to load sound file, unsupported bit depth");
                 }
-            }
-            else if (formatTag == WAVE_FORMAT_IEEE_FLOAT)
-            {
-                if (bitsPerSample == 32)
-                {
-                    for (std::uint32_t channel = 0; channel < channels; ++channel)
-                    {
-                        auto outputChannel = &samples[channel * frames];
 
-                        for (std::uint32_t frame = 0; frame < frames; ++frame)
-                        {
-                            const auto sourceData = &soundData[(frame * channels + channel) * 4];
-                            std::memcpy(&outputChannel[frame], sourceData, sizeof(float));
-                        }
-                    }
-                }
-                else
-                    throw std::runtime_error("Failed to load sound file, unsupported bit depth");
+                prepared->converted = true;
+                prepared->samples = std::move(samples);
             }
 
-            auto sound = std::make_unique<audio::PcmClip>(*engine->getAudio(), channels, sampleRate, samples);
-            bundle.setSound(name, std::move(sound));
+            if (!prepared->converted)
+                prepared->soundData = std::move(soundData);
+
+            return prepared;
         }
         catch (const std::exception&)
         {
-            return false;
+            return nullptr;
         }
+    }
+
+    bool WaveLoader::finishAsset(Bundle& bundle,
+                                 const std::string& name,
+                                 std::unique_ptr<Prepared> prepared,
+                                 bool)
+    {
+        if (!prepared) return false;
+
+        auto& preparedSound = static_cast<PreparedSound&>(*prepared);
+
+        std::unique_ptr<audio::PcmClip> sound;
+
+        if (preparedSound.converted)
+            sound = std::make_unique<audio::PcmClip>(*engine->getAudio(),
+                                                     preparedSound.channels,
+                                                     preparedSound.sampleRate,
+                                                     preparedSound.samples);
+        else
+            sound = std::make_unique<audio::PcmClip>(*engine->getAudio(),
+                                                     preparedSound.channels,
+                                                     preparedSound.sampleRate,
+                                                     preparedSound.encoding,
+                                                     preparedSound.soundData,
+                                                     preparedSound.blockAlign);
+
+        logger.log(Log::Level::all) << "Sound " << name << " uses " << sound->getMemoryUsage() <<
+            " bytes (" << sound->getDecodedSize() << " bytes decoded)";
+
+        bundle.setSound(name, std::move(sound));
 
         return true;
     }
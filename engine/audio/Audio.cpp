@@ -8,6 +8,7 @@
 #include "alsa/ALSAAudioDevice.hpp"
 #include "coreaudio/CAAudioDevice.hpp"
 #include "empty/EmptyAudioDevice.hpp"
+#include "offline/OfflineAudioDevice.hpp"
 #include "openal/OALAudioDevice.hpp"
 #include "opensl/OSLAudioDevice.hpp"
 #include "xaudio2/XA2AudioDevice.hpp"
@@ -40,6 +41,8 @@ namespace ouzel::audio
         }
         else if (driver == "empty")
             return Driver::empty;
+        else if (driver == "offline")
+            return Driver::offline;
         else if (driver == "openal")
             return Driver::openAL;
         else if (driver == "xaudio2")
@@ -63,6 +66,7 @@ namespace ouzel::audio
         if (availableDrivers.empty())
         {
             availableDrivers.insert(Driver::empty);
+            availableDrivers.insert(Driver::offline);
 
 #if OUZEL_COMPILE_OPENAL
             availableDrivers.insert(Driver::openAL);
@@ -95,6 +99,9 @@ namespace ouzel::audio
         {
             switch (driver)
             {
+                case Driver::offline:
+                    logger.log(Log::Level::info) << "Using offline audio driver";
+                    return std::make_unique<offline::AudioDevice>(settings, dataGetter);
 #if OUZEL_COMPILE_OPENAL
                 case Driver::openAL:
                     logger.log(Log::Level::info) << "Using OpenAL audio driver";
@@ -145,6 +152,19 @@ namespace ouzel::audio
         device->start();
     }
 
+    Audio::~Audio()
+    {
+        // the device must not pull samples from the mixer while it is destroyed
+        try
+        {
+            device->stop();
+        }
+        catch (const std::exception& e)
+        {
+            logger.log(Log::Level::error) << e.what();
+        }
+    }
+
     void Audio::update()
     {
         // TODO: handle events from the audio device
@@ -153,6 +173,13 @@ namespace ouzel::audio
         commandBuffer = mixer::CommandBuffer();
     }
 
+    void Audio::setMaxVoices(std::uint32_t newMaxVoices)
+    {
+        maxVoices = newMaxVoices;
+
+        addCommand(std::make_unique<mixer::SetMaxStreamsCommand>(maxVoices));
+    }
+
     void Audio::deleteObject(mixer::Mixer::ObjectId objectId)
     {
         addCommand(std::make_unique<mixer::DeleteObjectCommand>(objectId));
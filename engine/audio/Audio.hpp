@@ -27,6 +27,12 @@ namespace ouzel::audio
     {
     public:
         Audio(Driver driver, const Settings& settings);
+        ~Audio();
+
+        Audio(const Audio&) = delete;
+        Audio& operator=(const Audio&) = delete;
+        Audio(Audio&&) = delete;
+        Audio& operator=(Audio&&) = delete;
 
         static Driver getDriver(const std::string& driver);
         static std::set<Driver> getAvailableAudioDrivers();
@@ -52,6 +58,14 @@ namespace ouzel::audio
 
         auto& getRootNode() { return rootNode; }
 
+        // maximum number of voices mixed at once, zero for unlimited
+        auto getMaxVoices() const noexcept { return maxVoices; }
+        void setMaxVoices(std::uint32_t newMaxVoices);
+
+        // voices that were mixed and voices that were virtualized in the last mixed block
+        auto getRealVoiceCount() const noexcept { return mixer.getVoiceManager().getRealStreamCount(); }
+        auto getVirtualVoiceCount() const noexcept { return mixer.getVoiceManager().getVirtualStreamCount(); }
+
     private:
         void getSamples(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate, std::vector<float>& samples);
         void eventCallback(const mixer::Mixer::Event& event);
@@ -61,6 +75,7 @@ namespace ouzel::audio
         mixer::CommandBuffer commandBuffer;
         Mix masterMix;
         Node rootNode;
+        std::uint32_t maxVoices = 0;
     };
 }
 
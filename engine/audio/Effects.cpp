@@ -7,6 +7,10 @@
 #include "../scene/Actor.hpp"
 #include "../math/MathUtils.hpp"
 #include "smbPitchShift.hpp"
+#include "dsp/Biquad.hpp"
+#include "dsp/DelayLine.hpp"
+#include "dsp/FeedbackDelayNetwork.hpp"
+#include "dsp/PitchShifter.hpp"
 
 namespace ouzel::audio
 {
@@ -21,28 +25,25 @@ namespace ouzel::audio
         void process(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
                      std::vector<float>& samples) final
         {
-            const auto delayFrames = static_cast<std::uint32_t>(delay * sampleRate);
-            const auto bufferFrames = frames + delayFrames;
+            const auto delayFrames = static_cast<std::size_t>(delay * sampleRate);
+            if (delayFrames == 0) return;
 
-            buffer.resize(bufferFrames * channels);
+            // lines only grow, so the buffers are allocated once per configuration
+            if (lines.size() != channels) lines.resize(channels);
 
             for (std::uint32_t channel = 0; channel < channels; ++channel)
             {
-                float* bufferChannel = &buffer[channel * bufferFrames];
-                float* outputChannel = &samples[channel * frames];
+                dsp::DelayLine& line = lines[channel];
+                if (line.getMaxDelay() < delayFrames) line.resize(delayFrames);
 
-                for (std::uint32_t frame = 0; frame < frames; ++frame)
-                    bufferChannel[frame + delayFrames] += outputChannel[frame];
+                float* outputChannel = &samples[channel * frames];
 
                 for (std::uint32_t frame = 0; frame < frames; ++frame)
-                    outputChannel[frame] = bufferChannel[frame];
-
-                // erase frames from beginning
-                for (std::uint32_t frame = 0; frame < bufferFrames - frames; ++frame)
-                    bufferChannel[frame] = bufferChannel[frame + frames];
-
-                for (std::uint32_t frame = bufferFrames - frames; frame < bufferFrames; ++frame)
-                    bufferChannel[frame] = 0.0F;
+                {
+                    const float input = outputChannel[frame];
+                    outputChannel[frame] = line.read(delayFrames);
+                    line.write(input);
+                }
             }
         }
 
@@ -53,7 +54,7 @@ namespace ouzel::audio
 
     private:
         float delay = 0.0F;
-        std::vector<float> buffer;
+        std::vector<dsp::DelayLine> lines;
     };
 
     Delay::Delay(Audio& initAudio, float initDelay):
@@ -101,6 +102,11 @@ namespace ouzel::audio
             gainFactor = std::pow(10.0F, gain / 20.0F);
         }
 
+        float getEstimatedGain(const Vector<float, 3>&) const final
+        {
+            return gainFactor;
+        }
+
     private:
         float gain = 0.0F;
         float gainFactor = 1.0F;
@@ -141,6 +147,15 @@ namespace ouzel::audio
         {
         }
 
+        // inverse distance attenuation clamped to the min and max distance
+        float getEstimatedGain(const Vector<float, 3>& listenerPosition) const final
+        {
+            if (minDistance <= 0.0F) return 1.0F;
+
+            const auto distance = std::max(std::min((position - listenerPosition).length(), maxDistance), minDistance);
+            return minDistance / (minDistance + rolloffFactor * (distance - minDistance));
+        }
+
         void setPosition(const Vector<float, 3>& newPosition)
         {
             position = newPosition;
@@ -285,19 +300,36 @@ namespace ouzel::audio
         {
         }
 
-        void process(std::uint32_t, std::uint32_t, std::uint32_t,
-                     std::vector<float>&) final
+        void process(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
+                     std::vector<float>& samples) final
         {
-            // TODO: implement
+            if (shifters.size() != channels || sampleRate != currentSampleRate || dirty)
+            {
+                shifters.resize(channels);
+                for (auto& shifter : shifters)
+                    shifter.setParameters(shift, windowLength, sampleRate);
+
+                currentSampleRate = sampleRate;
+                dirty = false;
+            }
+
+            for (std::uint32_t channel = 0; channel < channels; ++channel)
+                shifters[channel].process(frames, &samples[channel * frames]);
         }
 
         void setShift(float newShift)
         {
             shift = newShift;
+            dirty = true;
         }
 
     private:
+        static constexpr float windowLength = 0.05F;
+
         float shift = 1.0f;
+        bool dirty = true;
+        std::uint32_t currentSampleRate = 0;
+        std::vector<dsp::PitchShifter> shifters;
     };
 
     PitchShift::PitchShift(Audio& initAudio, float initShift):
@@ -334,36 +366,27 @@ namespace ouzel::audio
         void process(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
                      std::vector<float>& samples) final
         {
-            const auto delayFrames = static_cast<std::uint32_t>(delay * sampleRate);
-            const auto bufferFrames = frames + delayFrames;
-
-            buffers.resize(channels);
-
-            for (std::uint32_t channel = 0; channel < channels; ++channel)
+            if (networks.size() != channels || sampleRate != currentSampleRate)
             {
-                std::vector<float>& buffer = buffers[channel];
-                buffer.resize(bufferFrames);
-
-                float* outputChannel = &samples[channel * frames];
-
-                for (std::uint32_t frame = 0; frame < frames; ++frame)
-                    buffer[frame] += outputChannel[frame];
-
-                for (std::uint32_t frame = 0; frame < frames; ++frame)
-                    buffer[frame + delayFrames] += buffer[frame] * decay;
-
-                for (std::uint32_t frame = 0; frame < frames; ++frame)
-                    outputChannel[frame] = buffer[frame];
+                networks.resize(channels);
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                    networks[channel].setParameters(delay, decay, sampleRate, channel * channelSpread);
 
-                // erase frames from beginning
-                buffer.erase(buffer.begin(), buffer.begin() + frames);
+                currentSampleRate = sampleRate;
             }
+
+            for (std::uint32_t channel = 0; channel < channels; ++channel)
+                networks[channel].process(frames, &samples[channel * frames]);
         }
 
     private:
+        // difference of the line lengths of neighbouring channels in frames
+        static constexpr std::uint32_t channelSpread = 23;
+
         float delay = 0.1F;
         float decay = 0.5F;
-        std::vector<std::vector<float>> buffers;
+        std::uint32_t currentSampleRate = 0;
+        std::vector<dsp::FeedbackDelayNetwork> networks;
     };
 
     Reverb::Reverb(Audio& initAudio, float initDelay, float initDecay):
@@ -374,33 +397,106 @@ namespace ouzel::audio
     {
     }
 
-    class LowPassProcessor final: public mixer::Processor
+    class FilterProcessor final: public mixer::Processor
     {
     public:
+        FilterProcessor(dsp::Biquad::Type initType, float initCutoffFrequency, float initResonance):
+            type(initType), cutoffFrequency(initCutoffFrequency), resonance(initResonance)
+        {
+        }
+
         void process(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
                      std::vector<float>& samples) final
         {
+            if (sampleRate != currentSampleRate || dirty)
+            {
+                filter.setParameters(type, cutoffFrequency, resonance, sampleRate);
+                currentSampleRate = sampleRate;
+                dirty = false;
+            }
+
+            filter.setChannels(channels);
+            filter.process(frames, channels, samples.data());
+        }
+
+        void setCutoffFrequency(float newCutoffFrequency)
+        {
+            cutoffFrequency = newCutoffFrequency;
+            dirty = true;
         }
+
+        void setResonance(float newResonance)
+        {
+            resonance = newResonance;
+            dirty = true;
+        }
+
+    private:
+        dsp::Biquad::Type type;
+        float cutoffFrequency;
+        float resonance;
+        bool dirty = true;
+        std::uint32_t currentSampleRate = 0;
+        dsp::Biquad filter;
     };
 
-    LowPass::LowPass(Audio& initAudio):
+    LowPass::LowPass(Audio& initAudio, float initCutoffFrequency, float initResonance):
         Effect(initAudio,
-               initAudio.initProcessor(std::unique_ptr<LowPassProcessor>()))
+               initAudio.initProcessor(std::make_unique<FilterProcessor>(dsp::Biquad::Type::lowPass,
+                                                                         initCutoffFrequency,
+                                                                         initResonance))),
+        cutoffFrequency(initCutoffFrequency),
+        resonance(initResonance)
     {
     }
 
-    class HighPassProcessor final: public mixer::Processor
+    void LowPass::setCutoffFrequency(float newCutoffFrequency)
     {
-    public:
-        void process(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
-                     std::vector<float>& samples) final
-        {
-        }
-    };
+        cutoffFrequency = newCutoffFrequency;
 
-    HighPass::HighPass(Audio& initAudio):
+        audio.updateProcessor(processorId, [newCutoffFrequency](mixer::Object* node) {
+            auto filterProcessor = static_cast<FilterProcessor*>(node);
+            filterProcessor->setCutoffFrequency(newCutoffFrequency);
+        });
+    }
+
+    void LowPass::setResonance(float newResonance)
+    {
+        resonance = newResonance;
+
+        audio.updateProcessor(processorId, [newResonance](mixer::Object* node) {
+            auto filterProcessor = static_cast<FilterProcessor*>(node);
+            filterProcessor->setResonance(newResonance);
+        });
+    }
+
+    HighPass::HighPass(Audio& initAudio, float initCutoffFrequency, float initResonance):
         Effect(initAudio,
-               initAudio.initProcessor(std::unique_ptr<HighPassProcessor>()))
+               initAudio.initProcessor(std::make_unique<FilterProcessor>(dsp::Biquad::Type::highPass,
+                                                                         initCutoffFrequency,
+                                                                         initResonance))),
+        cutoffFrequency(initCutoffFrequency),
+        resonance(initResonance)
+    {
+    }
+
+    void HighPass::setCutoffFrequency(float newCutoffFrequency)
     {
+        cutoffFrequency = newCutoffFrequency;
+
+        audio.updateProcessor(processorId, [newCutoffFrequency](mixer::Object* node) {
+            auto filterProcessor = static_cast<FilterProcessor*>(node);
+            filterProcessor->setCutoffFrequency(newCutoffFrequency);
+        });
+    }
+
+    void HighPass::setResonance(float newResonance)
+    {
+        resonance = newResonance;
+
+        audio.updateProcessor(processorId, [newResonance](mixer::Object* node) {
+            auto filterProcessor = static_cast<FilterProcessor*>(node);
+            filterProcessor->setResonance(newResonance);
+        });
     }
 }
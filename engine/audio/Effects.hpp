@@ -147,23 +147,43 @@ namespace ouzel::audio
     class LowPass final: public Effect
     {
     public:
-        explicit LowPass(Audio& initAudio);
+        LowPass(Audio& initAudio, float initCutoffFrequency = 1000.0F, float initResonance = 0.7071F);
 
         LowPass(const LowPass&) = delete;
         LowPass& operator=(const LowPass&) = delete;
         LowPass(LowPass&&) = delete;
         LowPass& operator=(LowPass&&) = delete;
+
+        auto getCutoffFrequency() const noexcept { return cutoffFrequency; }
+        void setCutoffFrequency(float newCutoffFrequency);
+
+        auto getResonance() const noexcept { return resonance; }
+        void setResonance(float newResonance);
+
+    private:
+        float cutoffFrequency = 1000.0F;
+        float resonance = 0.7071F;
     };
 
     class HighPass final: public Effect
     {
     public:
-        explicit HighPass(Audio& initAudio);
+        HighPass(Audio& initAudio, float initCutoffFrequency = 200.0F, float initResonance = 0.7071F);
 
         HighPass(const HighPass&) = delete;
         HighPass& operator=(const HighPass&) = delete;
         HighPass(HighPass&&) = delete;
         HighPass& operator=(HighPass&&) = delete;
+
+        auto getCutoffFrequency() const noexcept { return cutoffFrequency; }
+        void setCutoffFrequency(float newCutoffFrequency);
+
+        auto getResonance() const noexcept { return resonance; }
+        void setResonance(float newResonance);
+
+    private:
+        float cutoffFrequency = 200.0F;
+        float resonance = 0.7071F;
     };
 }
 
@@ -57,6 +57,13 @@ namespace ouzel::audio
         }
     }
 
+    void Mix::setMaxVoices(std::uint32_t newMaxVoices)
+    {
+        maxVoices = newMaxVoices;
+
+        audio.addCommand(std::make_unique<mixer::SetBusMaxStreamsCommand>(busId, maxVoices));
+    }
+
     void Mix::addInput(Submix* submix)
     {
         const auto i = std::find(inputSubmixes.begin(), inputSubmixes.end(), submix);
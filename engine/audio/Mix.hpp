@@ -33,6 +33,10 @@ namespace ouzel::audio
         void addEffect(Effect* effect);
         void removeEffect(Effect* effect);
 
+        // maximum number of voices of this mix that are mixed at once, zero for unlimited
+        auto getMaxVoices() const noexcept { return maxVoices; }
+        void setMaxVoices(std::uint32_t newMaxVoices);
+
     protected:
         void addInput(Submix* submix);
         void removeInput(Submix* submix);
@@ -47,6 +51,7 @@ namespace ouzel::audio
         std::vector<Voice*> inputVoices;
         std::vector<Effect*> effects;
         std::vector<Listener*> listeners;
+        std::uint32_t maxVoices = 0;
     };
 }
 
@@ -21,6 +21,7 @@ namespace ouzel::audio
         }
 
         void generateSamples(std::uint32_t frames, std::vector<float>& samples) final;
+        void skip(std::uint32_t frames) final;
 
     private:
         std::uint32_t position = 0;
@@ -149,6 +150,25 @@ namespace ouzel::audio
         }
     }
 
+    void OscillatorStream::skip(std::uint32_t frames)
+    {
+        const auto length = static_cast<OscillatorData&>(data).getLength();
+
+        if (length > 0.0F)
+        {
+            const auto frameCount = static_cast<std::uint32_t>(length * data.getSampleRate());
+            position += (frames > frameCount - position) ? frameCount - position : frames;
+
+            if ((frameCount - position) == 0)
+            {
+                playing = false; // TODO: fire event
+                reset();
+            }
+        }
+        else
+            position += frames;
+    }
+
     Oscillator::Oscillator(Audio& initAudio, float initFrequency,
                            Type initType, float initAmplitude, float initLength):
         Sound(initAudio,
@@ -1,14 +1,163 @@
 // Ouzel by Elviss Strazdins
 
+#if defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#elif defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <iterator>
+#include <limits>
 #include <stdexcept>
 #include "PcmClip.hpp"
 #include "Audio.hpp"
 #include "mixer/Data.hpp"
 #include "mixer/Stream.hpp"
+#include "../core/Engine.hpp"
 
 namespace ouzel::audio
 {
+    namespace
+    {
+        void convertUnsignedInt8(const std::uint8_t* source, float* output, std::uint32_t count) noexcept
+        {
+            std::uint32_t i = 0;
+
+            if (core::isSimdAvailable)
+            {
+#if defined(__ARM_NEON__)
+                const float32x4_t scale = vdupq_n_f32(2.0F / 255.0F);
+                const float32x4_t bias = vdupq_n_f32(-1.0F);
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const uint16x8_t value = vmovl_u8(vld1_u8(source + i));
+                    const float32x4_t low = vcvtq_f32_u32(vmovl_u16(vget_low_u16(value)));
+                    const float32x4_t high = vcvtq_f32_u32(vmovl_u16(vget_high_u16(value)));
+                    vst1q_f32(output + i, vmlaq_f32(bias, low, scale));
+                    vst1q_f32(output + i + 4, vmlaq_f32(bias, high, scale));
+                }
+#elif defined(__SSE2__)
+                const __m128 scale = _mm_set1_ps(2.0F / 255.0F);
+                const __m128 bias = _mm_set1_ps(-1.0F);
+                const __m128i zero = _mm_setzero_si128();
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i value = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i)), zero);
+                    const __m128 low = _mm_cvtepi32_ps(_mm_unpacklo_epi16(value, zero));
+                    const __m128 high = _mm_cvtepi32_ps(_mm_unpackhi_epi16(value, zero));
+                    _mm_storeu_ps(output + i, _mm_add_ps(_mm_mul_ps(low, scale), bias));
+                    _mm_storeu_ps(output + i + 4, _mm_add_ps(_mm_mul_ps(high, scale), bias));
+                }
+#endif
+            }
+
+            for (; i < count; ++i)
+                output[i] = 2.0F * source[i] / 255.0F - 1.0F;
+        }
+
+        void convertSignedInt16(const std::int16_t* source, float* output, std::uint32_t count) noexcept
+        {
+            std::uint32_t i = 0;
+
+            if (core::isSimdAvailable)
+            {
+#if defined(__ARM_NEON__)
+                for (; i + 8 <= count; i += 8)
+                {
+                    const int16x8_t value = vld1q_s16(source + i);
+                    const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(value)));
+                    const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(value)));
+                    vst1q_f32(output + i, vmulq_n_f32(low, 1.0F / 32768.0F));
+                    vst1q_f32(output + i + 4, vmulq_n_f32(high, 1.0F / 32768.0F));
+                }
+#elif defined(__SSE2__)
+                const __m128 scale = _mm_set1_ps(1.0F / 32768.0F);
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                    // move each 16-bit value to the upper half of a 32-bit lane and shift it back to sign extend
+                    const __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16));
+                    const __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16));
+                    _mm_storeu_ps(output + i, _mm_mul_ps(low, scale));
+                    _mm_storeu_ps(output + i + 4, _mm_mul_ps(high, scale));
+                }
+#endif
+            }
+
+            for (; i < count; ++i)
+                output[i] = static_cast<float>(source[i]) / 32768.0F;
+        }
+
+        constexpr std::array<std::int32_t, 89> adpcmStepTable{
+            7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+            19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+            50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+            130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+            337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+            876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+            2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+            5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+            15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+        };
+
+        constexpr std::array<std::int32_t, 16> adpcmIndexTable{
+            -1, -1, -1, -1, 2, 4, 6, 8,
+            -1, -1, -1, -1, 2, 4, 6, 8
+        };
+
+        class AdpcmDecoder final
+        {
+        public:
+            AdpcmDecoder(std::int32_t initPredictor, std::int32_t initIndex) noexcept:
+                predictor(initPredictor), index(std::clamp(initIndex, 0, 88))
+            {
+            }
+
+            std::int32_t decode(std::uint8_t nibble) noexcept
+            {
+                const std::int32_t step = adpcmStepTable[static_cast<std::size_t>(index)];
+
+                std::int32_t diff = step >> 3;
+                if (nibble & 0x01) diff += step >> 2;
+                if (nibble & 0x02) diff += step >> 1;
+                if (nibble & 0x04) diff += step;
+                if (nibble & 0x08) diff = -diff;
+
+                predictor = std::clamp(predictor + diff, -32768, 32767);
+                index = std::clamp(index + adpcmIndexTable[nibble], 0, 88);
+
+                return predictor;
+            }
+
+        private:
+            std::int32_t predictor;
+            std::int32_t index;
+        };
+
+        // IMA ADPCM blocks as stored in WAVE files: a 4-byte header per channel followed by
+        // 4-byte words of 8 samples that alternate between the channels
+        constexpr std::uint32_t getAdpcmFramesPerBlock(std::uint32_t blockAlign, std::uint32_t channels) noexcept
+        {
+            return (blockAlign - 4 * channels) * 2 / channels + 1;
+        }
+
+        std::size_t getSampleSize(PcmClip::Encoding encoding) noexcept
+        {
+            switch (encoding)
+            {
+                case PcmClip::Encoding::unsignedInt8: return sizeof(std::uint8_t);
+                case PcmClip::Encoding::signedInt16: return sizeof(std::int16_t);
+                case PcmClip::Encoding::float32: return sizeof(float);
+                default: return 0;
+            }
+        }
+    }
+
     class PcmData;
 
     class PcmStream final: public mixer::Stream
@@ -22,21 +171,35 @@ namespace ouzel::audio
         }
 
         void generateSamples(std::uint32_t frames, std::vector<float>& samples) final;
+        void skip(std::uint32_t frames) final;
 
     private:
+        void decodeBlock(std::uint32_t block);
+
         std::uint32_t position = 0;
+
+        // the last decoded IMA ADPCM block (planar)
+        std::vector<float> blockSamples;
+        std::uint32_t decodedBlock = std::numeric_limits<std::uint32_t>::max();
     };
 
     class PcmData final: public mixer::Data
     {
     public:
         PcmData(std::uint32_t initChannels, std::uint32_t initSampleRate,
-                const std::vector<float>& initData):
+                PcmClip::Encoding initEncoding, std::uint32_t initFrames,
+                std::vector<std::byte> initData, std::uint32_t initBlockAlign = 0):
             Data(initChannels, initSampleRate),
-            data(initData)
+            encoding(initEncoding),
+            frames(initFrames),
+            blockAlign(initBlockAlign),
+            data(std::move(initData))
         {
         }
 
+        auto getEncoding() const noexcept { return encoding; }
+        auto getFrames() const noexcept { return frames; }
+        auto getBlockAlign() const noexcept { return blockAlign; }
         auto& getData() const noexcept { return data; }
 
         std::unique_ptr<mixer::Stream> createStream() final
@@ -45,12 +208,55 @@ namespace ouzel::audio
         }
 
     private:
-        std::vector<float> data;
+        PcmClip::Encoding encoding;
+        std::uint32_t frames;
+        std::uint32_t blockAlign;
+        std::vector<std::byte> data; // planar, except for IMA ADPCM which is kept in blocks
     };
 
     PcmStream::PcmStream(PcmData& pcmData):
         Stream(pcmData)
     {
+        if (pcmData.getEncoding() == PcmClip::Encoding::imaAdpcm)
+            blockSamples.resize(getAdpcmFramesPerBlock(pcmData.getBlockAlign(), pcmData.getChannels()) *
+                                pcmData.getChannels());
+    }
+
+    void PcmStream::decodeBlock(std::uint32_t block)
+    {
+        const auto& pcmData = static_cast<PcmData&>(data);
+        const std::uint32_t channels = pcmData.getChannels();
+        const std::uint32_t blockAlign = pcmData.getBlockAlign();
+        const std::uint32_t framesPerBlock = getAdpcmFramesPerBlock(blockAlign, channels);
+        const auto& blocks = pcmData.getData();
+
+        const std::size_t blockOffset = static_cast<std::size_t>(block) * blockAlign;
+        const std::size_t blockSize = std::min(static_cast<std::size_t>(blockAlign), blocks.size() - blockOffset);
+        const auto blockData = reinterpret_cast<const std::uint8_t*>(blocks.data() + blockOffset);
+
+        for (std::uint32_t channel = 0; channel < channels; ++channel)
+        {
+            const auto header = blockData + channel * 4;
+            const auto predictor = static_cast<std::int16_t>(header[0] | (header[1] << 8));
+            AdpcmDecoder decoder(predictor, header[2]);
+
+            float* outputChannel = &blockSamples[channel * framesPerBlock];
+            outputChannel[0] = static_cast<float>(predictor) / 32768.0F;
+
+            std::uint32_t frame = 1;
+            for (std::size_t offset = channels * 4 + channel * 4; offset + 4 <= blockSize; offset += channels * 4)
+                for (std::size_t b = 0; b < 4; ++b)
+                {
+                    const std::uint8_t value = blockData[offset + b];
+                    outputChannel[frame++] = static_cast<float>(decoder.decode(value & 0x0F)) / 32768.0F;
+                    outputChannel[frame++] = static_cast<float>(decoder.decode(value >> 4)) / 32768.0F;
+                }
+
+            // a truncated last block
+            std::fill(outputChannel + frame, outputChannel + framesPerBlock, 0.0F);
+        }
+
+        decodedBlock = block;
     }
 
     void PcmStream::generateSamples(std::uint32_t frames, std::vector<float>& samples)
@@ -59,23 +265,67 @@ namespace ouzel::audio
         samples.resize(neededSize);
 
         const auto& pcmData = static_cast<PcmData&>(data);
-        const std::vector<float>& dataSamples = pcmData.getData();
-
-        const auto sourceFrames = static_cast<std::uint32_t>(dataSamples.size() / pcmData.getChannels());
+        const std::uint32_t channels = pcmData.getChannels();
+        const std::uint32_t sourceFrames = pcmData.getFrames();
         const std::uint32_t copyFrames = (frames > sourceFrames - position) ? sourceFrames - position : frames;
+        const auto& dataSamples = pcmData.getData();
 
-        for (std::uint32_t channel = 0; channel < pcmData.getChannels(); ++channel)
+        switch (pcmData.getEncoding())
         {
-            const float* sourceChannel = &dataSamples[channel * sourceFrames];
-            float* outputChannel = &samples[channel * frames];
+            case PcmClip::Encoding::unsignedInt8:
+            {
+                const auto sourceSamples = reinterpret_cast<const std::uint8_t*>(dataSamples.data());
+
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                    convertUnsignedInt8(sourceSamples + channel * sourceFrames + position,
+                                        &samples[channel * frames], copyFrames);
+                break;
+            }
+            case PcmClip::Encoding::signedInt16:
+            {
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                {
+                    // the vector buffer is suitably aligned for any fundamental type
+                    const auto sourceChannel = reinterpret_cast<const std::int16_t*>(dataSamples.data()) + channel * sourceFrames;
+                    convertSignedInt16(sourceChannel + position, &samples[channel * frames], copyFrames);
+                }
+                break;
+            }
+            case PcmClip::Encoding::float32:
+            {
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                    std::memcpy(&samples[channel * frames],
+                                dataSamples.data() + (channel * sourceFrames + position) * sizeof(float),
+                                copyFrames * sizeof(float));
+                break;
+            }
+            case PcmClip::Encoding::imaAdpcm:
+            {
+                const std::uint32_t framesPerBlock = getAdpcmFramesPerBlock(pcmData.getBlockAlign(), channels);
+
+                for (std::uint32_t frame = 0; frame < copyFrames;)
+                {
+                    const std::uint32_t sourceFrame = position + frame;
+                    const std::uint32_t block = sourceFrame / framesPerBlock;
+                    const std::uint32_t blockFrame = sourceFrame % framesPerBlock;
+                    const std::uint32_t blockFrames = std::min(framesPerBlock - blockFrame, copyFrames - frame);
 
-            for (std::uint32_t frame = 0; frame < copyFrames; ++frame)
-                outputChannel[frame] = sourceChannel[frame + position];
+                    if (block != decodedBlock) decodeBlock(block);
+
+                    for (std::uint32_t channel = 0; channel < channels; ++channel)
+                        std::copy(&blockSamples[channel * framesPerBlock + blockFrame],
+                                  &blockSamples[channel * framesPerBlock + blockFrame + blockFrames],
+                                  &samples[channel * frames + frame]);
+
+                    frame += blockFrames;
+                }
+                break;
+            }
         }
 
         position += copyFrames;
 
-        for (std::uint32_t channel = 0; channel < pcmData.getChannels(); ++channel)
+        for (std::uint32_t channel = 0; channel < channels; ++channel)
         {
             float* outputChannel = &samples[channel * frames];
 
@@ -90,11 +340,110 @@ namespace ouzel::audio
         }
     }
 
+    void PcmStream::skip(std::uint32_t frames)
+    {
+        const auto& pcmData = static_cast<PcmData&>(data);
+        const std::uint32_t sourceFrames = pcmData.getFrames();
+
+        position += (frames > sourceFrames - position) ? sourceFrames - position : frames;
+
+        if ((sourceFrames - position) == 0)
+        {
+            playing = false; // TODO: fire event
+            reset();
+        }
+    }
+
+    namespace
+    {
+        std::vector<std::byte> toBytes(const std::vector<float>& samples)
+        {
+            std::vector<std::byte> result(samples.size() * sizeof(float));
+            if (!samples.empty())
+                std::memcpy(result.data(), samples.data(), result.size());
+            return result;
+        }
+
+        std::vector<std::byte> deinterleave(std::uint32_t channels, std::size_t sampleSize,
+                                            const std::vector<std::byte>& samples)
+        {
+            const std::size_t frames = samples.size() / (sampleSize * channels);
+            std::vector<std::byte> result(frames * channels * sampleSize);
+
+            for (std::uint32_t channel = 0; channel < channels; ++channel)
+            {
+                std::byte* outputChannel = &result[channel * frames * sampleSize];
+
+                for (std::size_t frame = 0; frame < frames; ++frame)
+                    std::memcpy(outputChannel + frame * sampleSize,
+                                &samples[(frame * channels + channel) * sampleSize],
+                                sampleSize);
+            }
+
+            return result;
+        }
+
+        std::uint32_t getEncodedFrameCount(std::uint32_t channels, PcmClip::Encoding encoding,
+                                           std::size_t size, std::uint32_t blockAlign)
+        {
+            if (encoding == PcmClip::Encoding::imaAdpcm)
+            {
+                if (blockAlign <= 4 * channels || (blockAlign - 4 * channels) % (4 * channels) != 0)
+                    throw std::runtime_error("Invalid IMA ADPCM block size");
+
+                const std::uint32_t framesPerBlock = getAdpcmFramesPerBlock(blockAlign, channels);
+                const auto fullBlocks = static_cast<std::uint32_t>(size / blockAlign);
+                const auto remainder = static_cast<std::uint32_t>(size % blockAlign);
+
+                return fullBlocks * framesPerBlock +
+                    ((remainder > 4 * channels) ? getAdpcmFramesPerBlock(remainder - remainder % (4 * channels), channels) : 0);
+            }
+            else
+                return static_cast<std::uint32_t>(size / (getSampleSize(encoding) * channels));
+        }
+    }
+
+    PcmClip::PcmClip(Audio& initAudio, std::uint32_t channels, std::uint32_t sampleRate,
+                     const std::vector<float>& samples):
+        Sound(initAudio,
+              initAudio.initData(std::unique_ptr<mixer::Data>(data = new PcmData(channels, sampleRate,
+                                                                                 Encoding::float32,
+                                                                                 static_cast<std::uint32_t>(samples.size() / channels),
+                                                                                 toBytes(samples)))),
+              Sound::Format::pcm)
+    {
+    }
+
     PcmClip::PcmClip(Audio& initAudio, std::uint32_t channels, std::uint32_t sampleRate,
-                      const std::vector<float>& samples):
+                     Encoding encoding, const std::vector<std::byte>& samples,
+                     std::uint32_t blockAlign):
         Sound(initAudio,
-              initAudio.initData(std::unique_ptr<mixer::Data>(data = new PcmData(channels, sampleRate, samples))),
+              initAudio.initData(std::unique_ptr<mixer::Data>(data = new PcmData(channels, sampleRate, encoding,
+                                                                                 getEncodedFrameCount(channels, encoding, samples.size(), blockAlign),
+                                                                                 (encoding == Encoding::imaAdpcm) ? samples :
+                                                                                    deinterleave(channels, getSampleSize(encoding), samples),
+                                                                                 blockAlign))),
               Sound::Format::pcm)
     {
     }
+
+    PcmClip::Encoding PcmClip::getEncoding() const noexcept
+    {
+        return data->getEncoding();
+    }
+
+    std::uint32_t PcmClip::getFrameCount() const noexcept
+    {
+        return data->getFrames();
+    }
+
+    std::size_t PcmClip::getMemoryUsage() const noexcept
+    {
+        return data->getData().size();
+    }
+
+    std::size_t PcmClip::getDecodedSize() const noexcept
+    {
+        return static_cast<std::size_t>(data->getFrames()) * data->getChannels() * sizeof(float);
+    }
 }
@@ -3,6 +3,7 @@
 #ifndef OUZEL_AUDIO_PCMCLIP_HPP
 #define OUZEL_AUDIO_PCMCLIP_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include "Sound.hpp"
@@ -14,9 +15,32 @@ namespace ouzel::audio
     class PcmClip final: public Sound
     {
     public:
+        enum class Encoding
+        {
+            unsignedInt8,
+            signedInt16,
+            float32,
+            imaAdpcm
+        };
+
+        // planar float samples
         PcmClip(Audio& initAudio, std::uint32_t channels, std::uint32_t sampleRate,
                 const std::vector<float>& samples);
 
+        // interleaved samples in the given encoding, kept in it until mixed
+        // (blockAlign is the size of an IMA ADPCM block in bytes and is ignored by other encodings)
+        PcmClip(Audio& initAudio, std::uint32_t channels, std::uint32_t sampleRate,
+                Encoding encoding, const std::vector<std::byte>& samples,
+                std::uint32_t blockAlign = 0);
+
+        Encoding getEncoding() const noexcept;
+        std::uint32_t getFrameCount() const noexcept;
+
+        // bytes used by the sample data of this clip
+        std::size_t getMemoryUsage() const noexcept;
+        // bytes the same clip would use if it was stored as 32-bit float
+        std::size_t getDecodedSize() const noexcept;
+
     private:
         PcmData* data;
     };
@@ -46,6 +46,9 @@ namespace ouzel::audio
         auto& getVelocity() const noexcept { return velocity; }
         void setVelocity(const Vector<float, 3>& newVelocity) { velocity = newVelocity; }
 
+        auto getPriority() const noexcept { return priority; }
+        void setPriority(float newPriority);
+
         void play();
         void pause();
         void stop();
@@ -61,6 +64,7 @@ namespace ouzel::audio
         const Sound* sound = nullptr;
         Vector<float, 3> position;
         Vector<float, 3> velocity;
+        float priority = 1.0F;
         bool playing = false;
 
         Mix* output = nullptr;
@@ -1,5 +1,6 @@
 // Ouzel by Elviss Strazdins
 
+#include <algorithm>
 #include <stdexcept>
 #include "VorbisClip.hpp"
 #include "Audio.hpp"
@@ -59,19 +60,23 @@ namespace ouzel::audio
         void reset() final
         {
             stb_vorbis_seek_start(vorbisStream);
+            skippedFrames = 0;
         }
 
         void generateSamples(std::uint32_t frames, std::vector<float>& samples) final;
+        void skip(std::uint32_t frames) final;
 
     private:
         stb_vorbis* vorbisStream = nullptr;
+        // frames skipped while virtual, the seek is deferred until samples are needed again
+        std::uint32_t skippedFrames = 0;
     };
 
     class VorbisData final: public mixer::Data
     {
     public:
-        explicit VorbisData(const std::vector<std::byte>& initData):
-            data(initData)
+        explicit VorbisData(Span<const std::byte> initData):
+            data(initData.begin(), initData.end())
         {
             stb_vorbis* vorbisStream = stb_vorbis_open_memory(reinterpret_cast<const unsigned char*>(data.data()),
                                                               static_cast<int>(data.size()),
@@ -84,11 +89,13 @@ namespace ouzel::audio
 
             channels = static_cast<std::uint32_t>(info.channels);
             sampleRate = info.sample_rate;
+            frames = stb_vorbis_stream_length_in_samples(vorbisStream);
 
             stb_vorbis_close(vorbisStream);
         }
 
         auto& getData() const noexcept { return data; }
+        auto getFrames() const noexcept { return frames; }
 
         std::unique_ptr<mixer::Stream> createStream() final
         {
@@ -97,6 +104,7 @@ namespace ouzel::audio
 
     private:
         std::vector<std::byte> data;
+        std::uint32_t frames = 0;
     };
 
     VorbisStream::VorbisStream(VorbisData& vorbisData):
@@ -119,6 +127,13 @@ namespace ouzel::audio
             if (vorbisStream->eof)
                 reset();
 
+            if (skippedFrames)
+            {
+                const auto offset = static_cast<unsigned int>(std::max(stb_vorbis_get_sample_offset(vorbisStream), 0));
+                stb_vorbis_seek(vorbisStream, offset + skippedFrames);
+                skippedFrames = 0;
+            }
+
             std::vector<float*> channelData(data.getChannels());
 
             switch (data.getChannels())
@@ -165,7 +180,21 @@ namespace ouzel::audio
                 samples[channel * frames + frame] = 0.0F;
     }
 
-    VorbisClip::VorbisClip(Audio& initAudio, const std::vector<std::byte>& initData):
+    void VorbisStream::skip(std::uint32_t frames)
+    {
+        const auto& vorbisData = static_cast<VorbisData&>(data);
+        const auto offset = static_cast<std::uint32_t>(std::max(stb_vorbis_get_sample_offset(vorbisStream), 0));
+
+        skippedFrames += frames;
+
+        if (offset + skippedFrames >= vorbisData.getFrames())
+        {
+            playing = false; // TODO: fire event
+            reset();
+        }
+    }
+
+    VorbisClip::VorbisClip(Audio& initAudio, Span<const std::byte> initData):
         Sound(initAudio,
               initAudio.initData(std::unique_ptr<mixer::Data>(data = new VorbisData(initData))),
               Sound::Format::vorbis)
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <vector>
 #include "Sound.hpp"
+#include "../utils/Span.hpp"
 
 namespace ouzel::audio
 {
@@ -14,7 +15,7 @@ namespace ouzel::audio
     class VorbisClip final: public Sound
     {
     public:
-        VorbisClip(Audio& initAudio, const std::vector<std::byte>& initData);
+        VorbisClip(Audio& initAudio, Span<const std::byte> initData);
 
     private:
         VorbisData* data;
@@ -0,0 +1,149 @@
+// Ouzel by Elviss Strazdins
+
+#if defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#elif defined(__SSE__)
+#  include <xmmintrin.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include "Biquad.hpp"
+#include "../../core/Engine.hpp"
+#include "../../math/Constants.hpp"
+
+namespace ouzel::audio::dsp
+{
+    void Biquad::setParameters(Type type, float frequency, float q, std::uint32_t sampleRate) noexcept
+    {
+        const auto nyquist = static_cast<float>(sampleRate) / 2.0F;
+        const auto w0 = tau<float> * std::clamp(frequency, 1.0F, nyquist * 0.99F) / static_cast<float>(sampleRate);
+        const auto cosW0 = std::cos(w0);
+        const auto alpha = std::sin(w0) / (2.0F * std::max(q, 0.01F));
+        const auto a0 = 1.0F + alpha;
+
+        switch (type)
+        {
+            case Type::lowPass:
+                b0 = (1.0F - cosW0) / 2.0F / a0;
+                b1 = (1.0F - cosW0) / a0;
+                b2 = b0;
+                break;
+            case Type::highPass:
+                b0 = (1.0F + cosW0) / 2.0F / a0;
+                b1 = -(1.0F + cosW0) / a0;
+                b2 = b0;
+                break;
+        }
+
+        a1 = -2.0F * cosW0 / a0;
+        a2 = (1.0F - alpha) / a0;
+    }
+
+    void Biquad::setChannels(std::uint32_t channels)
+    {
+        if (channels != channelCount)
+        {
+            channelCount = channels;
+            z1.assign((channels + 3) & ~3U, 0.0F);
+            z2.assign((channels + 3) & ~3U, 0.0F);
+        }
+    }
+
+    void Biquad::reset() noexcept
+    {
+        std::fill(z1.begin(), z1.end(), 0.0F);
+        std::fill(z2.begin(), z2.end(), 0.0F);
+    }
+
+    void Biquad::process(std::uint32_t frames, std::uint32_t channels, float* samples) noexcept
+    {
+        channels = std::min(channels, channelCount);
+
+        std::uint32_t channel = 0;
+
+        if (core::isSimdAvailable)
+        {
+#if defined(__ARM_NEON__) || defined(__SSE__)
+            for (; channel < channels; channel += 4)
+            {
+                const std::uint32_t lanes = std::min(channels - channel, 4U);
+
+                // unused lanes read the first channel and their results are discarded
+                float* channelSamples[4];
+                for (std::uint32_t lane = 0; lane < 4; ++lane)
+                    channelSamples[lane] = samples + (lane < lanes ? channel + lane : channel) * frames;
+
+                alignas(16) float output[4];
+
+#  if defined(__ARM_NEON__)
+                float32x4_t s1 = vld1q_f32(&z1[channel]);
+                float32x4_t s2 = vld1q_f32(&z2[channel]);
+
+                for (std::uint32_t frame = 0; frame < frames; ++frame)
+                {
+                    const float input[4] = {
+                        channelSamples[0][frame], channelSamples[1][frame],
+                        channelSamples[2][frame], channelSamples[3][frame]
+                    };
+                    const float32x4_t x = vld1q_f32(input);
+                    const float32x4_t y = vmlaq_n_f32(s1, x, b0);
+                    s1 = vmlsq_n_f32(vmlaq_n_f32(s2, x, b1), y, a1);
+                    s2 = vmlsq_n_f32(vmulq_n_f32(x, b2), y, a2);
+                    vst1q_f32(output, y);
+
+                    for (std::uint32_t lane = 0; lane < lanes; ++lane)
+                        channelSamples[lane][frame] = output[lane];
+                }
+
+                vst1q_f32(&z1[channel], s1);
+                vst1q_f32(&z2[channel], s2);
+#  else
+                const __m128 vb0 = _mm_set1_ps(b0);
+                const __m128 vb1 = _mm_set1_ps(b1);
+                const __m128 vb2 = _mm_set1_ps(b2);
+                const __m128 va1 = _mm_set1_ps(a1);
+                const __m128 va2 = _mm_set1_ps(a2);
+
+                __m128 s1 = _mm_loadu_ps(&z1[channel]);
+                __m128 s2 = _mm_loadu_ps(&z2[channel]);
+
+                for (std::uint32_t frame = 0; frame < frames; ++frame)
+                {
+                    const __m128 x = _mm_setr_ps(channelSamples[0][frame], channelSamples[1][frame],
+                                                 channelSamples[2][frame], channelSamples[3][frame]);
+                    const __m128 y = _mm_add_ps(_mm_mul_ps(x, vb0), s1);
+                    s1 = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(x, vb1), s2), _mm_mul_ps(y, va1));
+                    s2 = _mm_sub_ps(_mm_mul_ps(x, vb2), _mm_mul_ps(y, va2));
+                    _mm_store_ps(output, y);
+
+                    for (std::uint32_t lane = 0; lane < lanes; ++lane)
+                        channelSamples[lane][frame] = output[lane];
+                }
+
+                _mm_storeu_ps(&z1[channel], s1);
+                _mm_storeu_ps(&z2[channel], s2);
+#  endif
+            }
+#endif
+        }
+
+        for (; channel < channels; ++channel)
+        {
+            float* channelSamples = samples + channel * frames;
+            float s1 = z1[channel];
+            float s2 = z2[channel];
+
+            for (std::uint32_t frame = 0; frame < frames; ++frame)
+            {
+                const float x = channelSamples[frame];
+                const float y = b0 * x + s1;
+                s1 = b1 * x - a1 * y + s2;
+                s2 = b2 * x - a2 * y;
+                channelSamples[frame] = y;
+            }
+
+            z1[channel] = s1;
+            z2[channel] = s2;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_DSP_BIQUAD_HPP
+#define OUZEL_AUDIO_DSP_BIQUAD_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace ouzel::audio::dsp
+{
+    // Second order IIR filter (transposed direct form II) applied to planar multi-channel
+    // samples, with up to four channels processed at once when SIMD is available
+    class Biquad final
+    {
+    public:
+        enum class Type
+        {
+            lowPass,
+            highPass
+        };
+
+        void setParameters(Type type, float frequency, float q, std::uint32_t sampleRate) noexcept;
+
+        // allocates the filter state when the channel count changes
+        void setChannels(std::uint32_t channels);
+        void reset() noexcept;
+
+        void process(std::uint32_t frames, std::uint32_t channels, float* samples) noexcept;
+
+    private:
+        float b0 = 1.0F;
+        float b1 = 0.0F;
+        float b2 = 0.0F;
+        float a1 = 0.0F;
+        float a2 = 0.0F;
+
+        std::uint32_t channelCount = 0;
+        std::vector<float> z1; // padded to a multiple of four channels
+        std::vector<float> z2;
+    };
+}
+
+#endif // OUZEL_AUDIO_DSP_BIQUAD_HPP
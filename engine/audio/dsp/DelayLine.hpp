@@ -0,0 +1,69 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_DSP_DELAYLINE_HPP
+#define OUZEL_AUDIO_DSP_DELAYLINE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ouzel::audio::dsp
+{
+    // Circular buffer of samples with a power of two capacity, so that reading and
+    // writing never moves the stored samples. Only resize allocates.
+    class DelayLine final
+    {
+    public:
+        DelayLine() = default;
+        explicit DelayLine(std::size_t maxDelay)
+        {
+            resize(maxDelay);
+        }
+
+        void resize(std::size_t maxDelay)
+        {
+            std::size_t size = 1;
+            while (size < maxDelay) size <<= 1;
+
+            buffer.assign(size, 0.0F);
+            mask = size - 1;
+            writePosition = 0;
+        }
+
+        auto getMaxDelay() const noexcept { return buffer.size(); }
+
+        void clear() noexcept
+        {
+            std::fill(buffer.begin(), buffer.end(), 0.0F);
+        }
+
+        // the sample written delay samples ago (1 is the last written one)
+        float read(std::size_t delay) const noexcept
+        {
+            return buffer[(writePosition - delay) & mask];
+        }
+
+        // fractional delay with linear interpolation
+        float read(float delay) const noexcept
+        {
+            const auto whole = static_cast<std::size_t>(delay);
+            const auto fraction = delay - static_cast<float>(whole);
+            const auto a = buffer[(writePosition - whole) & mask];
+            const auto b = buffer[(writePosition - whole - 1) & mask];
+            return a + (b - a) * fraction;
+        }
+
+        void write(float sample) noexcept
+        {
+            buffer[writePosition] = sample;
+            writePosition = (writePosition + 1) & mask;
+        }
+
+    private:
+        std::vector<float> buffer;
+        std::size_t mask = 0;
+        std::size_t writePosition = 0;
+    };
+}
+
+#endif // OUZEL_AUDIO_DSP_DELAYLINE_HPP
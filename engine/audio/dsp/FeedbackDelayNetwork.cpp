@@ -0,0 +1,59 @@
+// Ouzel by Elviss Strazdins
+
+#include <cmath>
+#include "FeedbackDelayNetwork.hpp"
+
+namespace ouzel::audio::dsp
+{
+    namespace
+    {
+        // line lengths relative to the shortest one, spaced by quarter octaves to avoid
+        // coinciding echoes
+        constexpr std::array<float, FeedbackDelayNetwork::lineCount> ratios{1.0F, 1.1892F, 1.4142F, 1.6818F};
+    }
+
+    void FeedbackDelayNetwork::setParameters(float delay, float decay, std::uint32_t sampleRate, std::uint32_t spread)
+    {
+        const auto baseLength = std::max(delay * static_cast<float>(sampleRate), 1.0F);
+
+        for (std::size_t i = 0; i < lineCount; ++i)
+        {
+            // odd lengths, so that no two lines share a factor of two
+            lengths[i] = (static_cast<std::size_t>(baseLength * ratios[i]) + spread * (i + 1)) | 1U;
+
+            // the same decay per second for every line
+            gains[i] = std::pow(decay, static_cast<float>(lengths[i]) / static_cast<float>(lengths[0]));
+
+            if (lines[i].getMaxDelay() < lengths[i])
+                lines[i].resize(lengths[i]);
+        }
+    }
+
+    void FeedbackDelayNetwork::reset() noexcept
+    {
+        for (auto& line : lines)
+            line.clear();
+    }
+
+    void FeedbackDelayNetwork::process(std::uint32_t frames, float* samples) noexcept
+    {
+        for (std::uint32_t frame = 0; frame < frames; ++frame)
+        {
+            std::array<float, lineCount> outputs;
+            float sum = 0.0F;
+            for (std::size_t i = 0; i < lineCount; ++i)
+            {
+                outputs[i] = lines[i].read(lengths[i]) * gains[i];
+                sum += outputs[i];
+            }
+
+            // Householder reflection: I - 2/N * ones
+            const float reflection = sum * (2.0F / lineCount);
+            const float input = samples[frame] * 0.5F;
+            for (std::size_t i = 0; i < lineCount; ++i)
+                lines[i].write(input + outputs[i] - reflection);
+
+            samples[frame] += sum * 0.5F;
+        }
+    }
+}
@@ -0,0 +1,34 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_DSP_FEEDBACKDELAYNETWORK_HPP
+#define OUZEL_AUDIO_DSP_FEEDBACKDELAYNETWORK_HPP
+
+#include <array>
+#include <cstdint>
+#include "DelayLine.hpp"
+
+namespace ouzel::audio::dsp
+{
+    // Four delay lines mixed through a Householder matrix, used for reverb
+    class FeedbackDelayNetwork final
+    {
+    public:
+        static constexpr std::size_t lineCount = 4;
+
+        // delay is the length of the shortest line in seconds, decay is the gain applied to
+        // the signal after each pass through it and spread offsets the line lengths, so that
+        // the networks of different channels are decorrelated
+        // (allocates only when the lines have to grow)
+        void setParameters(float delay, float decay, std::uint32_t sampleRate, std::uint32_t spread = 0);
+        void reset() noexcept;
+
+        void process(std::uint32_t frames, float* samples) noexcept;
+
+    private:
+        std::array<DelayLine, lineCount> lines;
+        std::array<std::size_t, lineCount> lengths{};
+        std::array<float, lineCount> gains{};
+    };
+}
+
+#endif // OUZEL_AUDIO_DSP_FEEDBACKDELAYNETWORK_HPP
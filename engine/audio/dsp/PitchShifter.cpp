@@ -0,0 +1,46 @@
+// Ouzel by Elviss Strazdins
+
+#include <cmath>
+#include "PitchShifter.hpp"
+
+namespace ouzel::audio::dsp
+{
+    void PitchShifter::setParameters(float newRatio, float windowLength, std::uint32_t sampleRate)
+    {
+        ratio = newRatio;
+        window = std::max(std::round(windowLength * static_cast<float>(sampleRate)), 2.0F);
+
+        if (line.getMaxDelay() < static_cast<std::size_t>(window) + 1)
+            line.resize(static_cast<std::size_t>(window) + 1);
+    }
+
+    void PitchShifter::reset() noexcept
+    {
+        line.clear();
+        phase = 0.0F;
+    }
+
+    void PitchShifter::process(std::uint32_t frames, float* samples) noexcept
+    {
+        const float step = (1.0F - ratio) / window;
+
+        for (std::uint32_t frame = 0; frame < frames; ++frame)
+        {
+            phase += step;
+            phase -= std::floor(phase);
+
+            float otherPhase = phase + 0.5F;
+            if (otherPhase >= 1.0F) otherPhase -= 1.0F;
+
+            // the windows are zero where the taps jump and add up to one
+            const float gain = 1.0F - std::fabs(2.0F * phase - 1.0F);
+            const float otherGain = 1.0F - std::fabs(2.0F * otherPhase - 1.0F);
+
+            const float output = gain * line.read(1.0F + phase * (window - 1.0F)) +
+                otherGain * line.read(1.0F + otherPhase * (window - 1.0F));
+
+            line.write(samples[frame]);
+            samples[frame] = output;
+        }
+    }
+}
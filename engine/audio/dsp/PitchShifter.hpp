@@ -0,0 +1,30 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_DSP_PITCHSHIFTER_HPP
+#define OUZEL_AUDIO_DSP_PITCHSHIFTER_HPP
+
+#include <cstdint>
+#include "DelayLine.hpp"
+
+namespace ouzel::audio::dsp
+{
+    // Time-domain pitch shifter reading a delay line through two taps that sweep at the
+    // rate given by the pitch ratio and crossfade with triangular windows
+    class PitchShifter final
+    {
+    public:
+        // allocates only when the window grows
+        void setParameters(float ratio, float windowLength, std::uint32_t sampleRate);
+        void reset() noexcept;
+
+        void process(std::uint32_t frames, float* samples) noexcept;
+
+    private:
+        DelayLine line;
+        float ratio = 1.0F;
+        float window = 1.0F;
+        float phase = 0.0F;
+    };
+}
+
+#endif // OUZEL_AUDIO_DSP_PITCHSHIFTER_HPP
@@ -196,23 +196,23 @@ namespace ouzel::audio::mixer
                         case 2: // downmix 6 to 2
                             for (std::uint32_t frame = 0; frame < frames; ++frame)
                             {
-                                samples[frame * channels + 0] = (sourceSamples[0 * frames + frame] +
-                                                                 (sourceSamples[2 * frames + frame] +
-                                                                  sourceSamples[4 * frames + frame]) * 0.7071F); // L = L + (C + SL) * 0.7071
-                                samples[frame * channels + 1] = (sourceSamples[1 * frames + frame] +
-                                                                 (sourceSamples[2 * frames + frame] +
-                                                                  sourceSamples[5 * frames + frame]) * 0.7071F); // R = R + (C + SR) * 0.7071
+                                samples[0 * frames + frame] = (sourceSamples[0 * frames + frame] +
+                                                               (sourceSamples[2 * frames + frame] +
+                                                                sourceSamples[4 * frames + frame]) * 0.7071F); // L = L + (C + SL) * 0.7071
+                                samples[1 * frames + frame] = (sourceSamples[1 * frames + frame] +
+                                                               (sourceSamples[2 * frames + frame] +
+                                                                sourceSamples[5 * frames + frame]) * 0.7071F); // R = R + (C + SR) * 0.7071
                             }
                             break;
                         case 4: // downmix 6 to 4
                             for (std::uint32_t frame = 0; frame < frames; ++frame)
                             {
-                                samples[frame * channels + 0] = (sourceSamples[0 * frames + frame] +
-                                                                 sourceSamples[2 * frames + frame] * 0.7071F); // L = L + C * 0.7071
-                                samples[frame * channels + 1] = (sourceSamples[1 * frames + frame] +
-                                                                 sourceSamples[2 * frames + frame] * 0.7071F); // R = R + C * 0.7071
-                                samples[frame * channels + 2] = sourceSamples[4 * frames + frame]; // SL = SL
-                                samples[frame * channels + 3] = sourceSamples[5 * frames + frame]; // SR = SR
+                                samples[0 * frames + frame] = (sourceSamples[0 * frames + frame] +
+                                                               sourceSamples[2 * frames + frame] * 0.7071F); // L = L + C * 0.7071
+                                samples[1 * frames + frame] = (sourceSamples[1 * frames + frame] +
+                                                               sourceSamples[2 * frames + frame] * 0.7071F); // R = R + C * 0.7071
+                                samples[2 * frames + frame] = sourceSamples[4 * frames + frame]; // SL = SL
+                                samples[3 * frames + frame] = sourceSamples[5 * frames + frame]; // SR = SR
                             }
                             break;
                     }
@@ -224,22 +224,9 @@ namespace ouzel::audio::mixer
             samples = sourceSamples;
     }
 
-    void Bus::generateSamples(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
-                              const Vector<float, 3>& listenerPosition, const Quaternion<float>& listenerRotation,
-                              std::vector<float>& samples)
+    void Bus::process(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
+                      std::vector<float>& samples, MixScratch& scratch)
     {
-        samples.resize(frames * channels);
-        std::fill(samples.begin(), samples.end(), 0.0F);
-
-        for (Bus* bus : inputBuses)
-        {
-            bus->generateSamples(frames, channels, sampleRate,
-                                 listenerPosition, listenerRotation, buffer);
-
-            for (std::size_t s = 0; s < samples.size(); ++s)
-                samples[s] += buffer[s];
-        }
-
         for (Stream* stream : inputStreams)
         {
             if (stream->isPlaying())
@@ -247,22 +234,31 @@ namespace ouzel::audio::mixer
                 const std::uint32_t sourceSampleRate = stream->getData().getSampleRate();
                 const std::uint32_t sourceChannels = stream->getData().getChannels();
 
+                if (stream->isVirtual())
+                {
+                    stream->skip((frames * sourceSampleRate + sampleRate - 1) / sampleRate);
+                    continue;
+                }
+
                 if (sourceSampleRate != sampleRate)
                 {
                     std::uint32_t sourceFrames = (frames * sourceSampleRate + sampleRate - 1) / sampleRate; // round up
-                    stream->generateSamples(sourceFrames, resampleBuffer);
-                    resample(sourceChannels, sourceFrames, resampleBuffer, frames, mixBuffer);
+                    stream->generateSamples(sourceFrames, scratch.resampleBuffer);
+                    resample(sourceChannels, sourceFrames, scratch.resampleBuffer, frames, scratch.mixBuffer);
                 }
                 else
-                    stream->generateSamples(frames, mixBuffer);
+                    stream->generateSamples(frames, scratch.mixBuffer);
+
+                const std::vector<float>* streamSamples = &scratch.mixBuffer;
 
                 if (sourceChannels != channels)
-                    convert(frames, sourceChannels, mixBuffer, channels, buffer);
-                else
-                    buffer = mixBuffer;
+                {
+                    convert(frames, sourceChannels, scratch.mixBuffer, channels, scratch.buffer);
+                    streamSamples = &scratch.buffer;
+                }
 
                 for (std::size_t s = 0; s < samples.size(); ++s)
-                    samples[s] += buffer[s];
+                    samples[s] += (*streamSamples)[s];
             }
         }
 
@@ -8,15 +8,29 @@
 
 namespace ouzel::audio::mixer
 {
+    class Graph;
     class Processor;
     class Stream;
+    class VoiceManager;
+
+    // temporary buffers used while mixing the input streams of a bus, every thread
+    // rendering buses needs its own set
+    class MixScratch final
+    {
+    public:
+        std::vector<float> resampleBuffer;
+        std::vector<float> mixBuffer;
+        std::vector<float> buffer;
+    };
 
     class Bus final: public Object
     {
+        friend Graph;
         friend Processor;
         friend Stream;
+        friend VoiceManager;
     public:
-        Bus() noexcept {}
+        explicit Bus(std::size_t initId = 0) noexcept: id(initId) {}
         ~Bus() override;
         Bus(const Bus&) = delete;
         Bus& operator=(const Bus&) = delete;
@@ -24,29 +38,35 @@ namespace ouzel::audio::mixer
         Bus(Bus&&) = delete;
         Bus& operator=(Bus&&) = delete;
 
+        auto getId() const noexcept { return id; }
+
         void setOutput(Bus* newOutput);
 
-        void generateSamples(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
-                             const Vector<float, 3>& listenerPosition, const Quaternion<float>& listenerRotation,
-                             std::vector<float>& samples);
+        // mixes the input streams into samples, which already hold the sum of the input buses,
+        // and applies the processors
+        void process(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
+                     std::vector<float>& samples, MixScratch& scratch);
 
         void addProcessor(Processor* processor);
         void removeProcessor(Processor* processor);
 
+        // maximum number of input streams mixed at once, zero for unlimited
+        auto getMaxStreams() const noexcept { return maxStreams; }
+        void setMaxStreams(std::uint32_t newMaxStreams) { maxStreams = newMaxStreams; }
+
     private:
         void addInput(Bus* bus);
         void removeInput(Bus* bus);
         void addInput(Stream* stream);
         void removeInput(Stream* stream);
 
+        std::size_t id = 0;
         Bus* output = nullptr;
         std::vector<Bus*> inputBuses;
         std::vector<Stream*> inputStreams;
         std::vector<Processor*> processors;
-
-        std::vector<float> resampleBuffer;
-        std::vector<float> mixBuffer;
-        std::vector<float> buffer;
+        std::uint32_t maxStreams = 0;
+        std::uint32_t realStreams = 0;
     };
 }
 
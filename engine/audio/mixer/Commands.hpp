@@ -32,10 +32,13 @@ namespace ouzel::audio::mixer
             addProcessor,
             removeProcessor,
             setMasterBus,
+            setBusMaxStreams,
+            setMaxStreams,
             initStream,
             playStream,
             stopStream,
             setStreamOutput,
+            setStreamPriority,
             initData,
             initProcessor,
             updateProcessor
@@ -194,6 +197,31 @@ namespace ouzel::audio::mixer
         const ObjectId busId;
     };
 
+    class SetBusMaxStreamsCommand final: public Command
+    {
+    public:
+        constexpr SetBusMaxStreamsCommand(ObjectId initBusId,
+                                          std::uint32_t initMaxStreams) noexcept:
+            Command(Command::Type::setBusMaxStreams),
+            busId(initBusId),
+            maxStreams(initMaxStreams)
+        {}
+
+        const ObjectId busId;
+        const std::uint32_t maxStreams;
+    };
+
+    class SetMaxStreamsCommand final: public Command
+    {
+    public:
+        explicit constexpr SetMaxStreamsCommand(std::uint32_t initMaxStreams) noexcept:
+            Command(Command::Type::setMaxStreams),
+            maxStreams(initMaxStreams)
+        {}
+
+        const std::uint32_t maxStreams;
+    };
+
     class InitStreamCommand final: public Command
     {
     public:
@@ -247,6 +275,20 @@ namespace ouzel::audio::mixer
         const ObjectId busId;
     };
 
+    class SetStreamPriorityCommand final: public Command
+    {
+    public:
+        constexpr SetStreamPriorityCommand(ObjectId initStreamId,
+                                           float initPriority) noexcept:
+            Command(Command::Type::setStreamPriority),
+            streamId(initStreamId),
+            priority(initPriority)
+        {}
+
+        const ObjectId streamId;
+        const float priority;
+    };
+
     class InitDataCommand final: public Command
     {
     public:
@@ -0,0 +1,245 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include "Graph.hpp"
+
+namespace ouzel::audio::mixer
+{
+    Graph::Graph(std::uint32_t workerCount):
+        scratches(workerCount + 1)
+    {
+        workers.reserve(workerCount);
+        for (std::uint32_t worker = 0; worker < workerCount; ++worker)
+            workers.emplace_back(&Graph::workerMain, this, worker + 1);
+    }
+
+    Graph::~Graph()
+    {
+        std::unique_lock lock(workMutex);
+        running = false;
+        lock.unlock();
+        workCondition.notify_all();
+
+        for (auto& worker : workers)
+            if (worker.isJoinable()) worker.join();
+    }
+
+    std::uint32_t Graph::visit(Bus* bus, std::vector<Bus*>& path)
+    {
+        // ignore loops in the bus outputs
+        if (std::find(path.begin(), path.end(), bus) != path.end())
+            return 0;
+
+        path.push_back(bus);
+
+        std::uint32_t level = 0;
+        for (Bus* inputBus : bus->inputBuses)
+            level = std::max(level, visit(inputBus, path) + 1);
+
+        path.pop_back();
+
+        Node node;
+        node.bus = bus;
+        node.level = level;
+        nodes.push_back(std::move(node));
+
+        return level;
+    }
+
+    void Graph::compile(Bus* masterBus)
+    {
+        nodes.clear();
+        levels.clear();
+
+        if (masterBus)
+        {
+            std::vector<Bus*> path;
+            visit(masterBus, path);
+        }
+
+        // the post-order of the walk already puts every bus after its inputs, sorting by
+        // level keeps that and groups the independent buses together
+        std::stable_sort(nodes.begin(), nodes.end(), [](const Node& a, const Node& b) noexcept {
+            return a.level < b.level;
+        });
+
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            if (levels.empty() || nodes[levels.back().begin].level != nodes[i].level)
+                levels.push_back(Level{i, i});
+            levels.back().end = i + 1;
+        }
+
+        // allocate the slots level by level, a slot is released after the level that
+        // consumes it, so that buses of the same level never share one
+        std::vector<std::uint32_t> freeSlots;
+        std::uint32_t slotCount = 0;
+
+        for (const Level& level : levels)
+        {
+            for (std::size_t i = level.begin; i < level.end; ++i)
+            {
+                Node& node = nodes[i];
+
+                if (freeSlots.empty())
+                    node.slot = slotCount++;
+                else
+                {
+                    node.slot = freeSlots.back();
+                    freeSlots.pop_back();
+                }
+
+                node.inputSlots.clear();
+                for (Bus* inputBus : node.bus->inputBuses)
+                {
+                    const auto input = std::find_if(nodes.begin(), nodes.begin() + static_cast<std::ptrdiff_t>(level.begin),
+                                                    [inputBus](const Node& other) noexcept {
+                                                        return other.bus == inputBus;
+                                                    });
+                    if (input != nodes.begin() + static_cast<std::ptrdiff_t>(level.begin))
+                        node.inputSlots.push_back(input->slot);
+                }
+            }
+
+            for (std::size_t i = level.begin; i < level.end; ++i)
+                freeSlots.insert(freeSlots.end(), nodes[i].inputSlots.begin(), nodes[i].inputSlots.end());
+        }
+
+        slots.resize(slotCount);
+        for (auto& slot : slots)
+            slot.reserve(static_cast<std::size_t>(frameCount) * channelCount);
+
+        std::lock_guard lock(timingMutex);
+        timings.resize(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+            timings[i] = NodeTiming{nodes[i].bus->getId(), nodes[i].level, std::chrono::nanoseconds{0}};
+    }
+
+    void Graph::renderNode(Node& node, MixScratch& scratch)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<float>& samples = slots[node.slot];
+        samples.resize(static_cast<std::size_t>(frameCount) * channelCount);
+        std::fill(samples.begin(), samples.end(), 0.0F);
+
+        for (const std::uint32_t inputSlot : node.inputSlots)
+        {
+            const std::vector<float>& input = slots[inputSlot];
+            for (std::size_t s = 0; s < samples.size(); ++s)
+                samples[s] += input[s];
+        }
+
+        node.bus->process(frameCount, channelCount, currentSampleRate, samples, scratch);
+
+        node.time = std::chrono::steady_clock::now() - start;
+    }
+
+    void Graph::renderLevel(const Level& level)
+    {
+        // a single bus is not worth waking up the workers
+        if (workers.empty() || level.end - level.begin < 2)
+        {
+            for (std::size_t i = level.begin; i < level.end; ++i)
+                renderNode(nodes[i], scratches[0]);
+            return;
+        }
+
+        std::unique_lock lock(workMutex);
+        ++generation;
+        work = level;
+        finishedNodes.store(0, std::memory_order_relaxed);
+        nextNode.store((static_cast<std::uint64_t>(generation) << 32) | level.begin, std::memory_order_release);
+        const auto currentGeneration = generation;
+        lock.unlock();
+        workCondition.notify_all();
+
+        // the rendering thread takes part in the work instead of waiting
+        for (;;)
+        {
+            auto next = nextNode.load(std::memory_order_acquire);
+            const auto index = static_cast<std::size_t>(next & 0xFFFFFFFFU);
+            if ((next >> 32) != currentGeneration || index >= level.end) break;
+
+            if (nextNode.compare_exchange_weak(next, next + 1, std::memory_order_acq_rel))
+            {
+                renderNode(nodes[index], scratches[0]);
+                finishedNodes.fetch_add(1, std::memory_order_acq_rel);
+            }
+        }
+
+        // spin, the remaining buses are already being rendered
+        while (finishedNodes.load(std::memory_order_acquire) < level.end - level.begin)
+            std::this_thread::yield();
+    }
+
+    void Graph::render(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
+                       std::vector<float>& samples)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        frameCount = frames;
+        channelCount = channels;
+        currentSampleRate = sampleRate;
+
+        samples.resize(static_cast<std::size_t>(frames) * channels);
+
+        if (nodes.empty())
+            std::fill(samples.begin(), samples.end(), 0.0F);
+        else
+        {
+            for (const Level& level : levels)
+                renderLevel(level);
+
+            const std::vector<float>& output = slots[nodes.back().slot];
+            std::copy(output.begin(), output.end(), samples.begin());
+        }
+
+        // never block the audio thread for the readers of the timings
+        std::unique_lock lock(timingMutex, std::try_to_lock);
+        if (lock.owns_lock())
+            for (std::size_t i = 0; i < nodes.size(); ++i)
+                timings[i].time = nodes[i].time;
+
+        renderTime.store((std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+    }
+
+    std::vector<Graph::NodeTiming> Graph::getNodeTimings() const
+    {
+        std::lock_guard lock(timingMutex);
+        return timings;
+    }
+
+    void Graph::workerMain(std::size_t worker)
+    {
+        thread::setCurrentThreadName("Mixer worker");
+
+        std::uint32_t seenGeneration = 0;
+
+        for (;;)
+        {
+            std::unique_lock lock(workMutex);
+            workCondition.wait(lock, [this, seenGeneration]() noexcept {
+                return !running || generation != seenGeneration;
+            });
+            if (!running) break;
+
+            seenGeneration = generation;
+            const Level level = work;
+            lock.unlock();
+
+            for (;;)
+            {
+                auto next = nextNode.load(std::memory_order_acquire);
+                const auto index = static_cast<std::size_t>(next & 0xFFFFFFFFU);
+                if ((next >> 32) != seenGeneration || index >= level.end) break;
+
+                if (nextNode.compare_exchange_weak(next, next + 1, std::memory_order_acq_rel))
+                {
+                    renderNode(nodes[index], scratches[worker]);
+                    finishedNodes.fetch_add(1, std::memory_order_acq_rel);
+                }
+            }
+        }
+    }
+}
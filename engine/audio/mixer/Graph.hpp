@@ -0,0 +1,108 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_MIXER_GRAPH_HPP
+#define OUZEL_AUDIO_MIXER_GRAPH_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "Bus.hpp"
+#include "../../thread/Thread.hpp"
+
+namespace ouzel::audio::mixer
+{
+    // Execution plan of the bus tree. Buses are grouped into levels by their distance
+    // from the leaves, so that all buses of a level only depend on the buses of the
+    // previous levels and can be rendered in parallel. Every bus renders into a buffer
+    // slot that is reused as soon as its output bus has consumed it.
+    class Graph final
+    {
+    public:
+        class NodeTiming final
+        {
+        public:
+            std::size_t busId = 0;
+            std::uint32_t level = 0;
+            std::chrono::nanoseconds time{0};
+        };
+
+        explicit Graph(std::uint32_t workerCount);
+        ~Graph();
+
+        Graph(const Graph&) = delete;
+        Graph& operator=(const Graph&) = delete;
+
+        Graph(Graph&&) = delete;
+        Graph& operator=(Graph&&) = delete;
+
+        // must be called every time the bus tree changes
+        void compile(Bus* masterBus);
+
+        void render(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
+                    std::vector<float>& samples);
+
+        auto getNodeCount() const noexcept { return nodes.size(); }
+        auto getLevelCount() const noexcept { return levels.size(); }
+        auto getSlotCount() const noexcept { return slots.size(); }
+        auto getWorkerCount() const noexcept { return static_cast<std::uint32_t>(workers.size()); }
+
+        // timings of the last rendered block, in the order the buses were rendered
+        std::vector<NodeTiming> getNodeTimings() const;
+        std::chrono::nanoseconds getRenderTime() const noexcept
+        {
+            return std::chrono::nanoseconds{renderTime.load(std::memory_order_relaxed)};
+        }
+
+    private:
+        class Node final
+        {
+        public:
+            Bus* bus = nullptr;
+            std::uint32_t level = 0;
+            std::uint32_t slot = 0;
+            std::vector<std::uint32_t> inputSlots;
+            std::chrono::nanoseconds time{0};
+        };
+
+        class Level final
+        {
+        public:
+            std::size_t begin = 0;
+            std::size_t end = 0;
+        };
+
+        std::uint32_t visit(Bus* bus, std::vector<Bus*>& path);
+        void renderNode(Node& node, MixScratch& scratch);
+        void renderLevel(const Level& level);
+        void workerMain(std::size_t worker);
+
+        std::vector<Node> nodes; // sorted by level
+        std::vector<Level> levels;
+        std::vector<std::vector<float>> slots;
+
+        std::uint32_t frameCount = 0;
+        std::uint32_t channelCount = 0;
+        std::uint32_t currentSampleRate = 0;
+
+        std::vector<thread::Thread> workers;
+        std::vector<MixScratch> scratches; // the first one belongs to the rendering thread
+        std::mutex workMutex;
+        std::condition_variable workCondition;
+        bool running = true;
+        std::uint32_t generation = 0;
+        Level work;
+        // generation in the high and the next node in the low 32 bits, so that a worker
+        // that woke up late can not take a node of the next job
+        std::atomic<std::uint64_t> nextNode{0};
+        std::atomic<std::size_t> finishedNodes{0};
+
+        mutable std::mutex timingMutex;
+        std::vector<NodeTiming> timings;
+        std::atomic<std::chrono::nanoseconds::rep> renderTime{0};
+    };
+}
+
+#endif // OUZEL_AUDIO_MIXER_GRAPH_HPP
@@ -6,6 +6,7 @@
 #include "Data.hpp"
 #include "Stream.hpp"
 #include "../../math/MathUtils.hpp"
+#include "../../utils/Profiler.hpp"
 
 namespace ouzel::audio::mixer
 {
@@ -15,6 +16,7 @@ namespace ouzel::audio::mixer
         bufferSize(initBufferSize),
         channels(initChannels),
         callback(initCallback),
+        graph(std::min(std::thread::hardware_concurrency() / 2U, 3U)),
         mixerThread(&Mixer::mixerMain, this),
         buffer(initBufferSize * 3, initChannels)
     {
@@ -35,6 +37,8 @@ namespace ouzel::audio::mixer
 
     void Mixer::process()
     {
+        OUZEL_PROFILE_SCOPE("Mixer::process");
+
         CommandBuffer commandBuffer;
         std::unique_ptr<Command> command;
 
@@ -61,7 +65,9 @@ namespace ouzel::audio::mixer
                     case Command::Type::deleteObject:
                     {
                         auto deleteObjectCommand = static_cast<const DeleteObjectCommand*>(command.get());
+                        if (objects[deleteObjectCommand->objectId - 1].get() == masterBus) masterBus = nullptr;
                         objects[deleteObjectCommand->objectId - 1].reset();
+                        graphDirty = true;
                         break;
                     }
                     case Command::Type::addChild:
@@ -101,7 +107,7 @@ namespace ouzel::audio::mixer
                         if (initBusCommand->busId > objects.size())
                             objects.resize(initBusCommand->busId);
 
-                        objects[initBusCommand->busId - 1] = std::make_unique<Bus>();
+                        objects[initBusCommand->busId - 1] = std::make_unique<Bus>(initBusCommand->busId);
                         break;
                     }
                     case Command::Type::setBusOutput:
@@ -110,6 +116,7 @@ namespace ouzel::audio::mixer
 
                         auto bus = static_cast<Bus*>(objects[setBusOutputCommand->busId - 1].get());
                         bus->setOutput(setBusOutputCommand->outputBusId ? static_cast<Bus*>(objects[setBusOutputCommand->outputBusId - 1].get()) : nullptr);
+                        graphDirty = true;
                         break;
                     }
                     case Command::Type::addProcessor:
@@ -135,6 +142,22 @@ namespace ouzel::audio::mixer
                         auto setMasterBusCommand = static_cast<const SetMasterBusCommand*>(command.get());
 
                         masterBus = setMasterBusCommand->busId ? static_cast<Bus*>(objects[setMasterBusCommand->busId - 1].get()) : nullptr;
+                        graphDirty = true;
+                        break;
+                    }
+                    case Command::Type::setBusMaxStreams:
+                    {
+                        auto setBusMaxStreamsCommand = static_cast<const SetBusMaxStreamsCommand*>(command.get());
+
+                        auto bus = static_cast<Bus*>(objects[setBusMaxStreamsCommand->busId - 1].get());
+                        bus->setMaxStreams(setBusMaxStreamsCommand->maxStreams);
+                        break;
+                    }
+                    case Command::Type::setMaxStreams:
+                    {
+                        auto setMaxStreamsCommand = static_cast<const SetMaxStreamsCommand*>(command.get());
+
+                        voiceManager.setMaxStreams(setMaxStreamsCommand->maxStreams);
                         break;
                     }
                     case Command::Type::initStream:
@@ -172,6 +195,14 @@ namespace ouzel::audio::mixer
                         stream->setOutput(setStreamOutputCommand->busId ? static_cast<Bus*>(objects[setStreamOutputCommand->busId - 1].get()) : nullptr);
                         break;
                     }
+                    case Command::Type::setStreamPriority:
+                    {
+                        auto setStreamPriorityCommand = static_cast<const SetStreamPriorityCommand*>(command.get());
+
+                        auto stream = static_cast<Stream*>(objects[setStreamPriorityCommand->streamId - 1].get());
+                        stream->setPriority(setStreamPriorityCommand->priority);
+                        break;
+                    }
                     case Command::Type::initData:
                     {
                         auto initDataCommand = static_cast<InitDataCommand*>(command.get());
@@ -209,19 +240,25 @@ namespace ouzel::audio::mixer
 
     void Mixer::getSamples(std::uint32_t frames, std::uint32_t channelCount, std::uint32_t sampleRate, std::vector<float>& samples)
     {
-        process();
+        OUZEL_PROFILE_SCOPE("Mixer::getSamples");
 
-        samples.resize(frames * channelCount);
+        process();
 
         if (masterBus)
         {
             Vector<float, 3> listenerPosition;
-            Quaternion<float> listenerRotation;
 
-            masterBus->generateSamples(frames, channelCount, sampleRate,
-                                       listenerPosition, listenerRotation, samples);
+            voiceManager.update(*masterBus, listenerPosition);
         }
 
+        if (graphDirty)
+        {
+            graph.compile(masterBus);
+            graphDirty = false;
+        }
+
+        graph.render(frames, channelCount, sampleRate, samples);
+
         for (float& sample : samples)
             sample = std::clamp(sample, -1.0F, 1.0F);
     }
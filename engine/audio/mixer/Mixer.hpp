@@ -12,8 +12,10 @@
 #include <thread>
 #include <vector>
 #include "Commands.hpp"
+#include "Graph.hpp"
 #include "Object.hpp"
 #include "Processor.hpp"
+#include "VoiceManager.hpp"
 #include "../../thread/Thread.hpp"
 
 namespace ouzel::audio::mixer
@@ -108,6 +110,9 @@ namespace ouzel::audio::mixer
             return rootObjectId;
         }
 
+        auto& getVoiceManager() const noexcept { return voiceManager; }
+        auto& getGraph() const noexcept { return graph; }
+
     private:
         void mixerMain();
 
@@ -123,6 +128,9 @@ namespace ouzel::audio::mixer
         RootObject* rootObject = nullptr;
 
         Bus* masterBus = nullptr;
+        VoiceManager voiceManager;
+        Graph graph;
+        bool graphDirty = true;
 
         class Buffer final
         {
@@ -27,6 +27,13 @@ namespace ouzel::audio::mixer
         virtual void process(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
                              std::vector<float>& samples) = 0;
 
+        // estimated gain the processor applies to its input, used to rank streams by loudness
+        virtual float getEstimatedGain(const Vector<float, 3>& listenerPosition) const
+        {
+            (void)listenerPosition;
+            return 1.0F;
+        }
+
         auto isEnabled() const noexcept { return enabled; }
         void setEnabled(bool newEnabled) { enabled = newEnabled; }
 
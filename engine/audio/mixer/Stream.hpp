@@ -50,14 +50,26 @@ namespace ouzel::audio::mixer
             if (shouldReset) reset();
         }
 
+        auto getPriority() const noexcept { return priority; }
+        void setPriority(float newPriority) { priority = newPriority; }
+
+        // virtual streams keep their playback position advancing but are not decoded nor mixed
+        auto isVirtual() const noexcept { return virtualized; }
+        void setVirtual(bool newVirtual) { virtualized = newVirtual; }
+
         virtual void reset() = 0;
 
         virtual void generateSamples(std::uint32_t frames, std::vector<float>& samples) = 0;
 
+        // advance the playback position by the given number of frames without generating samples
+        virtual void skip(std::uint32_t frames) = 0;
+
     protected:
         Data& data;
         Bus* output = nullptr;
         bool playing = false;
+        bool virtualized = false;
+        float priority = 1.0F;
     };
 }
 
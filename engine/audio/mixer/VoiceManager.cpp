@@ -0,0 +1,62 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include "VoiceManager.hpp"
+#include "Bus.hpp"
+#include "Processor.hpp"
+#include "Stream.hpp"
+
+namespace ouzel::audio::mixer
+{
+    void VoiceManager::update(Bus& masterBus, const Vector<float, 3>& listenerPosition)
+    {
+        candidates.clear();
+        collect(masterBus, 1.0F, listenerPosition);
+
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) noexcept {
+                      return a.score > b.score;
+                  });
+
+        std::uint32_t realCount = 0;
+        std::uint32_t virtualCount = 0;
+
+        for (const Candidate& candidate : candidates)
+        {
+            Bus& bus = *candidate.bus;
+
+            const bool real = candidate.gain >= audibilityThreshold &&
+                (!bus.maxStreams || bus.realStreams < bus.maxStreams) &&
+                (!maxStreams || realCount < maxStreams);
+
+            candidate.stream->setVirtual(!real);
+
+            if (real)
+            {
+                ++bus.realStreams;
+                ++realCount;
+            }
+            else
+                ++virtualCount;
+        }
+
+        realStreamCount = realCount;
+        virtualStreamCount = virtualCount;
+    }
+
+    void VoiceManager::collect(Bus& bus, float gain, const Vector<float, 3>& listenerPosition)
+    {
+        bus.realStreams = 0;
+
+        for (const Processor* processor : bus.processors)
+            if (processor->isEnabled())
+                gain *= processor->getEstimatedGain(listenerPosition);
+
+        for (Stream* stream : bus.inputStreams)
+            if (stream->isPlaying())
+                candidates.push_back(Candidate{stream, &bus, gain, stream->getPriority() * gain});
+
+        for (Bus* inputBus : bus.inputBuses)
+            collect(*inputBus, gain, listenerPosition);
+    }
+}
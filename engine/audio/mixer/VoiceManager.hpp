@@ -0,0 +1,56 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_MIXER_VOICEMANAGER_HPP
+#define OUZEL_AUDIO_MIXER_VOICEMANAGER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "../../math/Vector.hpp"
+
+namespace ouzel::audio::mixer
+{
+    class Bus;
+    class Stream;
+
+    // Decides which of the playing streams get mixed. Streams are ranked by their
+    // priority multiplied by the gain estimated from the processors of the buses they
+    // pass through; the ones that do not fit in the per-bus and global limits or are
+    // inaudible become virtual until they rank high enough again.
+    class VoiceManager final
+    {
+    public:
+        // maximum number of streams mixed at once, zero for unlimited
+        auto getMaxStreams() const noexcept { return maxStreams; }
+        void setMaxStreams(std::uint32_t newMaxStreams) { maxStreams = newMaxStreams; }
+
+        // streams with an estimated gain below this are virtualized regardless of the limits
+        auto getAudibilityThreshold() const noexcept { return audibilityThreshold; }
+        void setAudibilityThreshold(float newAudibilityThreshold) { audibilityThreshold = newAudibilityThreshold; }
+
+        void update(Bus& masterBus, const Vector<float, 3>& listenerPosition);
+
+        std::uint32_t getRealStreamCount() const noexcept { return realStreamCount; }
+        std::uint32_t getVirtualStreamCount() const noexcept { return virtualStreamCount; }
+
+    private:
+        struct Candidate final
+        {
+            Stream* stream;
+            Bus* bus;
+            float gain;
+            float score;
+        };
+
+        void collect(Bus& bus, float gain, const Vector<float, 3>& listenerPosition);
+
+        std::uint32_t maxStreams = 0;
+        float audibilityThreshold = 0.001F; // -60 dB
+        std::vector<Candidate> candidates;
+
+        std::atomic<std::uint32_t> realStreamCount{0};
+        std::atomic<std::uint32_t> virtualStreamCount{0};
+    };
+}
+
+#endif // OUZEL_AUDIO_MIXER_VOICEMANAGER_HPP
@@ -0,0 +1,229 @@
+// Ouzel by Elviss Strazdins
+
+#include <fstream>
+#include <stdexcept>
+#include "OfflineAudioDevice.hpp"
+#include "../../utils/Log.hpp"
+
+namespace ouzel::audio::offline
+{
+    namespace
+    {
+        void writeUInt16(std::ofstream& file, std::uint16_t value)
+        {
+            const char bytes[] = {
+                static_cast<char>(value & 0xFF),
+                static_cast<char>((value >> 8) & 0xFF)
+            };
+            file.write(bytes, sizeof(bytes));
+        }
+
+        void writeUInt32(std::ofstream& file, std::uint32_t value)
+        {
+            const char bytes[] = {
+                static_cast<char>(value & 0xFF),
+                static_cast<char>((value >> 8) & 0xFF),
+                static_cast<char>((value >> 16) & 0xFF),
+                static_cast<char>((value >> 24) & 0xFF)
+            };
+            file.write(bytes, sizeof(bytes));
+        }
+
+        constexpr std::uint16_t WAVE_FORMAT_PCM = 1;
+        constexpr std::uint16_t WAVE_FORMAT_IEEE_FLOAT = 3;
+    }
+
+    AudioDevice::AudioDevice(const Settings& settings,
+                             const std::function<void(std::uint32_t frames,
+                                                      std::uint32_t channels,
+                                                      std::uint32_t sampleRate,
+                                                      std::vector<float>& samples)>& initDataGetter):
+        audio::AudioDevice(Driver::offline, settings, initDataGetter),
+        outputFile(settings.audioDevice)
+    {
+        sampleFormat = settings.sampleFormat;
+
+        captureEnabled = !outputFile.empty();
+    }
+
+    AudioDevice::~AudioDevice()
+    {
+        stopThread();
+    }
+
+    void AudioDevice::start()
+    {
+        started = true;
+        startThread();
+    }
+
+    void AudioDevice::stop()
+    {
+        stopThread();
+        started = false;
+
+        if (!outputFile.empty())
+            writeOutputFile();
+    }
+
+    void AudioDevice::setMode(Mode newMode, float newClockRate)
+    {
+        stopThread();
+
+        mode = newMode;
+        clockRate = newClockRate;
+
+        if (started) startThread();
+    }
+
+    void AudioDevice::render(std::uint32_t frames)
+    {
+        for (std::uint32_t rendered = 0; rendered < frames; rendered += bufferSize)
+            renderBlock();
+    }
+
+    void AudioDevice::renderBlock()
+    {
+        std::lock_guard renderLock(renderMutex);
+
+        const auto start = std::chrono::steady_clock::now();
+        getData(bufferSize, block);
+        const auto blockTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        std::lock_guard lock(dataMutex);
+
+        if (captureEnabled)
+            capturedData.insert(capturedData.end(), block.begin(), block.end());
+
+        ++statistics.blocks;
+        statistics.frames += bufferSize;
+        statistics.totalTime += blockTime;
+        statistics.lastBlockTime = blockTime;
+        if (blockTime > statistics.maxBlockTime) statistics.maxBlockTime = blockTime;
+    }
+
+    std::vector<std::uint8_t> AudioDevice::getCapturedData() const
+    {
+        std::lock_guard lock(dataMutex);
+        return capturedData;
+    }
+
+    void AudioDevice::clearCapturedData()
+    {
+        std::lock_guard lock(dataMutex);
+        capturedData.clear();
+    }
+
+    void AudioDevice::writeOutputFile() const
+    {
+        std::ofstream file(outputFile, std::ios::binary | std::ios::trunc);
+        if (!file)
+            throw std::runtime_error("Failed to open file " + outputFile);
+
+        const auto floatFormat = sampleFormat == SampleFormat::float32;
+        const std::uint16_t formatTag = floatFormat ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
+        const std::uint16_t bitsPerSample = floatFormat ? 32 : 16;
+        const auto blockAlign = static_cast<std::uint16_t>(channels * bitsPerSample / 8);
+
+        // formats other than PCM have the cbSize field in the fmt chunk and need a fact chunk
+        const std::uint32_t formatSize = floatFormat ? 18 : 16;
+        const std::uint32_t factSize = floatFormat ? 8 + 4 : 0;
+
+        std::lock_guard lock(dataMutex);
+
+        const auto dataSize = static_cast<std::uint32_t>(capturedData.size());
+        const auto frames = dataSize / blockAlign;
+
+        file.write("RIFF", 4);
+        writeUInt32(file, 4 + 8 + formatSize + factSize + 8 + dataSize);
+        file.write("WAVE", 4);
+
+        file.write("fmt ", 4);
+        writeUInt32(file, formatSize);
+        writeUInt16(file, formatTag);
+        writeUInt16(file, static_cast<std::uint16_t>(channels));
+        writeUInt32(file, sampleRate);
+        writeUInt32(file, sampleRate * blockAlign);
+        writeUInt16(file, blockAlign);
+        writeUInt16(file, bitsPerSample);
+
+        if (floatFormat)
+        {
+            writeUInt16(file, 0); // cbSize
+
+            file.write("fact", 4);
+            writeUInt32(file, 4);
+            writeUInt32(file, frames);
+        }
+
+        file.write("data", 4);
+        writeUInt32(file, dataSize);
+        file.write(reinterpret_cast<const char*>(capturedData.data()), static_cast<std::streamsize>(capturedData.size()));
+
+        if (!file)
+            throw std::runtime_error("Failed to write file " + outputFile);
+
+        logger.log(Log::Level::info) << "Wrote " << frames << " frames of audio to " << outputFile;
+    }
+
+    AudioDevice::Statistics AudioDevice::getStatistics() const
+    {
+        std::lock_guard lock(dataMutex);
+
+        Statistics result = statistics;
+        if (result.totalTime.count() > 0)
+            result.realTimeFactor = (static_cast<double>(result.frames) / sampleRate) /
+                std::chrono::duration<double>(result.totalTime).count();
+
+        return result;
+    }
+
+    void AudioDevice::resetStatistics()
+    {
+        std::lock_guard lock(dataMutex);
+        statistics = Statistics();
+    }
+
+    void AudioDevice::startThread()
+    {
+        if (mode != Mode::manual && !running)
+        {
+            running = true;
+            renderThread = thread::Thread(&AudioDevice::run, this);
+        }
+    }
+
+    void AudioDevice::stopThread()
+    {
+        running = false;
+        if (renderThread.isJoinable()) renderThread.join();
+    }
+
+    void AudioDevice::run()
+    {
+        thread::setCurrentThreadName("Offline audio");
+
+        const auto blockDuration = std::chrono::duration<double>(static_cast<double>(bufferSize) / sampleRate / static_cast<double>(clockRate));
+        auto nextBlock = std::chrono::steady_clock::now();
+
+        while (running)
+        {
+            try
+            {
+                renderBlock();
+            }
+            catch (const std::exception& e)
+            {
+                logger.log(Log::Level::error) << e.what();
+                running = false;
+                break;
+            }
+
+            if (mode == Mode::clocked)
+            {
+                nextBlock += std::chrono::duration_cast<std::chrono::steady_clock::duration>(blockDuration);
+                std::this_thread::sleep_until(nextBlock);
+            }
+        }
+    }
+}
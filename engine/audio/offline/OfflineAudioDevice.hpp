@@ -0,0 +1,98 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_OFFLINEAUDIODEVICE_HPP
+#define OUZEL_AUDIO_OFFLINEAUDIODEVICE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../AudioDevice.hpp"
+#include "../../thread/Thread.hpp"
+
+namespace ouzel::audio::offline
+{
+    // Audio device without a sound card. Blocks are pulled from the mixer either on
+    // request or by a thread running as fast as possible or at a multiple of real time,
+    // captured to memory and written to a WAV file (settings.audioDevice) on stop.
+    // By default the blocks are captured only if the file is set.
+    class AudioDevice final: public audio::AudioDevice
+    {
+    public:
+        enum class Mode
+        {
+            manual, // only render() produces samples
+            unthrottled, // a thread renders blocks back to back
+            clocked // a thread renders blocks at clockRate times real time
+        };
+
+        class Statistics final
+        {
+        public:
+            std::uint64_t blocks = 0;
+            std::uint64_t frames = 0;
+            std::chrono::nanoseconds totalTime{0};
+            std::chrono::nanoseconds lastBlockTime{0};
+            std::chrono::nanoseconds maxBlockTime{0};
+
+            // seconds of audio rendered per second of mixing
+            double realTimeFactor = 0.0;
+        };
+
+        AudioDevice(const Settings& settings,
+                    const std::function<void(std::uint32_t frames,
+                                             std::uint32_t channels,
+                                             std::uint32_t sampleRate,
+                                             std::vector<float>& samples)>& initDataGetter);
+        ~AudioDevice() override;
+
+        void start() final;
+        void stop() final;
+
+        auto getMode() const noexcept { return mode; }
+        auto getClockRate() const noexcept { return clockRate; }
+        void setMode(Mode newMode, float newClockRate = 1.0F);
+
+        // renders at least the given number of frames in whole blocks on the calling thread
+        void render(std::uint32_t frames);
+
+        auto isCaptureEnabled() const noexcept { return captureEnabled.load(); }
+        void setCaptureEnabled(bool newCaptureEnabled) { captureEnabled = newCaptureEnabled; }
+
+        // interleaved samples in the sample format of the settings
+        std::vector<std::uint8_t> getCapturedData() const;
+        void clearCapturedData();
+
+        auto& getOutputFile() const noexcept { return outputFile; }
+        void setOutputFile(const std::string& newOutputFile) { outputFile = newOutputFile; }
+        void writeOutputFile() const;
+
+        Statistics getStatistics() const;
+        void resetStatistics();
+
+    private:
+        void renderBlock();
+        void startThread();
+        void stopThread();
+        void run();
+
+        Mode mode = Mode::manual;
+        float clockRate = 1.0F;
+        std::string outputFile;
+        bool started = false;
+
+        std::vector<std::uint8_t> block;
+        std::atomic_bool captureEnabled{false};
+        mutable std::mutex dataMutex;
+        std::vector<std::uint8_t> capturedData;
+        Statistics statistics;
+
+        std::mutex renderMutex;
+        std::atomic_bool running{false};
+        thread::Thread renderThread;
+    };
+}
+
+#endif // OUZEL_AUDIO_OFFLINEAUDIODEVICE_HPP
@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include "Setup.h"
 #include "Engine.hpp"
+#include "../utils/Profiler.hpp"
 #include "../utils/Utils.hpp"
 #include "../graphics/Graphics.hpp"
 #include "../audio/Audio.hpp"
@@ -100,6 +101,10 @@ namespace ouzel::core
             bool fullscreen = false;
             bool exclusiveFullscreen = false;
             bool highDpi = true; // should high DPI resolution be used
+            bool coalesceInput = false; // should mouse and touch moves be merged into one event per frame
+            bool profiler = false; // should the profiler markers be recorded
+            float fixedUpdateRate = 0.0F; // fixed updates per second, zero disables them
+            float targetFrameRate = 0.0F; // zero does not limit the frame rate
             audio::Driver audioDriver;
             audio::Settings audioSettings;
         };
@@ -166,6 +171,18 @@ namespace ouzel::core
             const auto& highDpiValue = userEngineSection.getValue("highDpi", defaultEngineSection.getValue("highDpi"));
             if (!highDpiValue.empty()) settings.highDpi = (highDpiValue == "true" || highDpiValue == "1" || highDpiValue == "yes");
 
+            const auto& coalesceInputValue = userEngineSection.getValue("coalesceInput", defaultEngineSection.getValue("coalesceInput"));
+            if (!coalesceInputValue.empty()) settings.coalesceInput = (coalesceInputValue == "true" || coalesceInputValue == "1" || coalesceInputValue == "yes");
+
+            const auto& profilerValue = userEngineSection.getValue("profiler", defaultEngineSection.getValue("profiler"));
+            if (!profilerValue.empty()) settings.profiler = (profilerValue == "true" || profilerValue == "1" || profilerValue == "yes");
+
+            const auto& fixedUpdateRateValue = userEngineSection.getValue("fixedUpdateRate", defaultEngineSection.getValue("fixedUpdateRate"));
+            if (!fixedUpdateRateValue.empty()) settings.fixedUpdateRate = std::stof(fixedUpdateRateValue);
+
+            const auto& targetFrameRateValue = userEngineSection.getValue("targetFrameRate", defaultEngineSection.getValue("targetFrameRate"));
+            if (!targetFrameRateValue.empty()) settings.targetFrameRate = std::stof(targetFrameRateValue);
+
             const auto& audioDriverValue = userEngineSection.getValue("audioDriver", defaultEngineSection.getValue("audioDriver"));
             settings.audioDriver = audio::Audio::getDriver(audioDriverValue);
 
@@ -190,8 +207,8 @@ namespace ouzel::core
     {
         if (active)
         {
-            auto event = std::make_unique<SystemEvent>();
-            event->type = Event::Type::engineStop;
+            SystemEvent event;
+            event.type = Event::Type::engineStop;
             eventDispatcher.postEvent(std::move(event));
         }
 
@@ -217,28 +234,42 @@ namespace ouzel::core
         const auto settings = parseSettings(fileSystem.resourceFileExists("settings.ini") ? ini::parse(fileSystem.readFile("settings.ini")) : ini::Data{},
                                             fileSystem.fileExists(settingsPath) ? ini::parse(fileSystem.readFile(settingsPath)) : ini::Data{});
 
+        profiler.setEnabled(settings.profiler);
+
+        if (settings.fixedUpdateRate > 0.0F)
+            frameScheduler.setFixedTimeStep(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float>(1.0F / settings.fixedUpdateRate)));
+        frameScheduler.setTargetFrameRate(settings.targetFrameRate);
+
         const Window::Flags windowFlags =
             (settings.resizable ? Window::Flags::resizable : Window::Flags::none) |
             (settings.fullscreen ? Window::Flags::fullscreen : Window::Flags::none) |
             (settings.exclusiveFullscreen ? Window::Flags::exclusiveFullscreen : Window::Flags::none) |
-            (settings.highDpi ? Window::Flags::highDpi : Window::Flags::none);
+            (settings.highDpi ? Window::Flags::highDpi : Window::Flags::none) |
+            (headless ? Window::Flags::headless : Window::Flags::none);
+
+        const auto graphicsDriver = headless ? graphics::Driver::empty : settings.graphicsDriver;
+        const auto audioDriver = headless ? audio::Driver::offline : settings.audioDriver;
 
         window = std::make_unique<Window>(*this,
                                           settings.size,
                                           windowFlags,
                                           OUZEL_APPLICATION_NAME,
-                                          settings.graphicsDriver);
+                                          graphicsDriver);
 
-        graphics = std::make_unique<graphics::Graphics>(settings.graphicsDriver,
+        graphics = std::make_unique<graphics::Graphics>(graphicsDriver,
                                                         *window,
                                                         settings.graphicsSettings);
 
-        audio = std::make_unique<audio::Audio>(settings.audioDriver, settings.audioSettings);
+        audio = std::make_unique<audio::Audio>(audioDriver, settings.audioSettings);
 
-        inputManager = std::make_unique<input::InputManager>();
+        if (!headless)
+        {
+            inputManager = std::make_unique<input::InputManager>();
+            inputManager->setCoalescing(settings.coalesceInput);
+        }
 
         // default assets
-        switch (settings.graphicsDriver)
+        switch (graphicsDriver)
         {
 #if OUZEL_COMPILE_OPENGL
             case graphics::Driver::openGL:
@@ -639,8 +670,8 @@ namespace ouzel::core
     {
         if (!active)
         {
-            auto event = std::make_unique<SystemEvent>();
-            event->type = Event::Type::engineStart;
+            SystemEvent event;
+            event.type = Event::Type::engineStart;
             eventDispatcher.postEvent(std::move(event));
 
             active = true;
@@ -658,8 +689,8 @@ namespace ouzel::core
     {
         if (active && !paused)
         {
-            auto event = std::make_unique<SystemEvent>();
-            event->type = Event::Type::enginePause;
+            SystemEvent event;
+            event.type = Event::Type::enginePause;
             eventDispatcher.postEvent(std::move(event));
 
             paused = true;
@@ -670,8 +701,8 @@ namespace ouzel::core
     {
         if (active && paused)
         {
-            auto event = std::make_unique<SystemEvent>();
-            event->type = Event::Type::engineResume;
+            SystemEvent event;
+            event.type = Event::Type::engineResume;
             eventDispatcher.postEvent(std::move(event));
 
             paused = false;
@@ -688,8 +719,8 @@ namespace ouzel::core
 
         if (active)
         {
-            auto event = std::make_unique<SystemEvent>();
-            event->type = Event::Type::engineStop;
+            SystemEvent event;
+            event.type = Event::Type::engineStop;
             eventDispatcher.postEvent(std::move(event));
 
             active = false;
@@ -709,25 +740,15 @@ namespace ouzel::core
 
     void Engine::update()
     {
-        eventDispatcher.dispatchEvents();
-
-        const auto currentTime = std::chrono::steady_clock::now();
-        auto diff = currentTime - previousUpdateTime;
-
-        if (diff > std::chrono::milliseconds(1)) // at least one millisecond has passed
-        {
-            if (diff > std::chrono::milliseconds(1000 / 20)) diff = std::chrono::milliseconds(1000 / 20); // limit the update rate to a minimum 20 FPS
+        profiler.markFrame();
+        OUZEL_PROFILE_SCOPE("Engine::update");
 
-            previousUpdateTime = currentTime;
-            const float delta = static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(diff).count()) / 1000000.0F;
+        eventDispatcher.dispatchEvents();
+        cache.update();
 
-            auto updateEvent = std::make_unique<UpdateEvent>();
-            updateEvent->type = Event::Type::update;
-            updateEvent->delta = delta;
-            eventDispatcher.dispatchEvent(std::move(updateEvent));
-        }
+        dispatchUpdateEvents(frameScheduler.beginFrame());
 
-        inputManager->update();
+        if (inputManager) inputManager->update();
         window->update();
         audio->update();
 
@@ -735,6 +756,31 @@ namespace ouzel::core
             sceneManager.draw();
 
         if (oneUpdatePerFrame) graphics->waitForNextFrame();
+
+#if !defined(__EMSCRIPTEN__) // the browser schedules the frames
+        frameScheduler.waitForNextFrame();
+#endif
+    }
+
+    void Engine::dispatchUpdateEvents(const FrameScheduler::Frame& frame)
+    {
+        if (!frame.update) return;
+
+        const auto fixedDelta = std::chrono::duration<float>(frameScheduler.getFixedTimeStep()).count();
+
+        for (std::size_t tick = 0; tick < frame.tickCount; ++tick)
+        {
+            auto fixedUpdateEvent = std::make_unique<UpdateEvent>();
+            fixedUpdateEvent->type = Event::Type::fixedUpdate;
+            fixedUpdateEvent->delta = fixedDelta;
+            eventDispatcher.dispatchEvent(std::move(fixedUpdateEvent));
+        }
+
+        auto updateEvent = std::make_unique<UpdateEvent>();
+        updateEvent->type = Event::Type::update;
+        updateEvent->delta = std::chrono::duration<float>(frame.delta).count();
+        updateEvent->alpha = frame.alpha;
+        eventDispatcher.dispatchEvent(std::move(updateEvent));
     }
 
     void Engine::executeOnMainThread(const std::function<void()>& func)
@@ -11,6 +11,7 @@
 #include <thread>
 #include <vector>
 #include "Application.hpp"
+#include "FrameScheduler.hpp"
 #include "Timer.hpp"
 #include "Window.hpp"
 #include "../graphics/Graphics.hpp"
@@ -27,6 +28,7 @@
 #include "../network/Network.hpp"
 #include "../formats/Ini.hpp"
 #include "../utils/Log.hpp"
+#include "../thread/JobSystem.hpp"
 #include "../thread/Thread.hpp"
 
 namespace ouzel::core
@@ -77,6 +79,7 @@ namespace ouzel::core
         [[nodiscard]] auto& getSceneManager() { return sceneManager; }
         [[nodiscard]] auto& getSceneManager() const { return sceneManager; }
 
+        // null for a headless engine
         [[nodiscard]] auto getInputManager() const noexcept { return inputManager.get(); }
 
         [[nodiscard]] auto& getLocalization() { return localization; }
@@ -85,6 +88,12 @@ namespace ouzel::core
         [[nodiscard]] auto& getNetwork() { return network; }
         [[nodiscard]] auto& getNetwork() const { return network; }
 
+        [[nodiscard]] auto& getJobSystem() { return jobSystem; }
+        [[nodiscard]] auto& getJobSystem() const { return jobSystem; }
+
+        [[nodiscard]] auto& getFrameScheduler() { return frameScheduler; }
+        [[nodiscard]] auto& getFrameScheduler() const { return frameScheduler; }
+
         void start();
         void pause();
         void resume();
@@ -122,6 +131,7 @@ namespace ouzel::core
         };
 
         virtual void engineMain();
+        void dispatchUpdateEvents(const FrameScheduler::Frame& frame);
         virtual void runOnMainThread(const std::function<void()>& func) = 0;
 
         storage::FileSystem fileSystem;
@@ -135,13 +145,15 @@ namespace ouzel::core
         assets::Bundle assetBundle;
         scene::SceneManager sceneManager;
         network::Network network;
+        // declared after the subsystems, so that the workers are stopped before the subsystems their jobs use are destroyed
+        thread::JobSystem jobSystem{thread::JobSystem::getDefaultWorkerCount(), true};
 
 #if !defined(__EMSCRIPTEN__)
         thread::Thread updateThread;
         std::mutex updateMutex;
         std::condition_variable updateCondition;
 #endif
-        std::chrono::steady_clock::time_point previousUpdateTime;
+        FrameScheduler frameScheduler;
 
         std::atomic_bool active{false};
         std::atomic_bool paused{false};
@@ -149,6 +161,9 @@ namespace ouzel::core
 
         std::atomic_bool screenSaverEnabled{true};
 
+        // set by the subclass before init to run without a window, a GPU, a sound card and input devices
+        bool headless = false;
+
     private:
         std::vector<std::string> args;
     };
@@ -0,0 +1,156 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include "FrameScheduler.hpp"
+
+namespace ouzel::core
+{
+    namespace
+    {
+        // sleeping can overshoot, so the last part of the wait is spent yielding
+        constexpr std::chrono::milliseconds sleepMargin{1};
+    }
+
+    void FrameScheduler::setFixedTimeStep(std::chrono::nanoseconds newFixedTimeStep) noexcept
+    {
+        fixedTimeStep = newFixedTimeStep;
+        accumulatedTime = std::chrono::nanoseconds{0};
+    }
+
+    float FrameScheduler::getTargetFrameRate() const noexcept
+    {
+        return targetFrameTime.count() > 0 ? 1.0F / std::chrono::duration<float>(targetFrameTime).count() : 0.0F;
+    }
+
+    void FrameScheduler::setTargetFrameRate(float newTargetFrameRate) noexcept
+    {
+        targetFrameTime = newTargetFrameRate > 0.0F ?
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float>(1.0F / newTargetFrameRate)) :
+            std::chrono::nanoseconds{0};
+    }
+
+    FrameScheduler::Frame FrameScheduler::beginFrame()
+    {
+        const auto currentTime = std::chrono::steady_clock::now();
+
+        if (!started)
+        {
+            started = true;
+            previousFrameTime = currentTime;
+            nextFrameTime = currentTime;
+        }
+
+        const auto frameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - previousFrameTime);
+
+        if (targetFrameTime.count() <= 0 && frameTime < minDelta)
+        {
+            Frame frame;
+            frame.update = false;
+            return frame;
+        }
+
+        previousFrameTime = currentTime;
+
+        return advance(frameTime, std::min(frameTime, maxDelta));
+    }
+
+    FrameScheduler::Frame FrameScheduler::beginFrame(std::chrono::nanoseconds frameTime) noexcept
+    {
+        return advance(frameTime, frameTime);
+    }
+
+    FrameScheduler::Frame FrameScheduler::advance(std::chrono::nanoseconds frameTime, std::chrono::nanoseconds delta) noexcept
+    {
+        Frame frame;
+        frame.delta = delta;
+
+        if (fixedTimeStep.count() > 0)
+        {
+            // the whole frame time is accumulated, the steps above maxTickCount are dropped
+            accumulatedTime += frameTime;
+
+            const auto dueTickCount = accumulatedTime / fixedTimeStep;
+            accumulatedTime -= fixedTimeStep * dueTickCount;
+
+            frame.tickCount = std::min(static_cast<std::size_t>(dueTickCount), maxTickCount);
+            droppedTickCount += static_cast<std::size_t>(dueTickCount) - frame.tickCount;
+            frame.alpha = static_cast<float>(accumulatedTime.count()) / static_cast<float>(fixedTimeStep.count());
+        }
+
+        auto& frameRecord = frameRecords[frameCount % statisticsFrameCount];
+        frameRecord.frameTime = frameTime;
+        frameRecord.idleTime = idleTime;
+        frameRecord.tickCount = frame.tickCount;
+        ++frameCount;
+
+        idleTime = std::chrono::nanoseconds{0};
+
+        return frame;
+    }
+
+    void FrameScheduler::waitForNextFrame()
+    {
+        if (targetFrameTime.count() <= 0 || !started) return;
+
+        const auto startTime = std::chrono::steady_clock::now();
+        nextFrameTime += targetFrameTime;
+
+        // a late frame does not shorten the following ones
+        if (nextFrameTime <= startTime)
+        {
+            nextFrameTime = startTime;
+            return;
+        }
+
+        if (nextFrameTime - startTime > sleepMargin)
+            std::this_thread::sleep_until(nextFrameTime - sleepMargin);
+
+        auto currentTime = std::chrono::steady_clock::now();
+        while (currentTime < nextFrameTime)
+        {
+            std::this_thread::yield();
+            currentTime = std::chrono::steady_clock::now();
+        }
+
+        idleTime += std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - startTime);
+    }
+
+    FrameScheduler::Statistics FrameScheduler::getStatistics() const noexcept
+    {
+        Statistics statistics;
+        statistics.droppedTickCount = droppedTickCount;
+
+        const auto count = std::min(frameCount, statisticsFrameCount);
+        if (count == 0) return statistics;
+
+        double totalFrameTime = 0.0;
+        double totalIdleTime = 0.0;
+        std::size_t totalTickCount = 0;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            totalFrameTime += static_cast<double>(frameRecords[i].frameTime.count());
+            totalIdleTime += static_cast<double>(frameRecords[i].idleTime.count());
+            totalTickCount += frameRecords[i].tickCount;
+        }
+
+        const auto averageFrameTime = totalFrameTime / static_cast<double>(count);
+
+        double variance = 0.0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto difference = static_cast<double>(frameRecords[i].frameTime.count()) - averageFrameTime;
+            variance += difference * difference;
+        }
+        variance /= static_cast<double>(count);
+
+        statistics.averageFrameTime = std::chrono::nanoseconds{std::llround(averageFrameTime)};
+        statistics.frameTimeJitter = std::chrono::nanoseconds{std::llround(std::sqrt(variance))};
+        statistics.averageIdleTime = std::chrono::nanoseconds{std::llround(totalIdleTime / static_cast<double>(count))};
+        statistics.averageTickCount = static_cast<float>(totalTickCount) / static_cast<float>(count);
+
+        return statistics;
+    }
+}
@@ -0,0 +1,90 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_CORE_FRAMESCHEDULER_HPP
+#define OUZEL_CORE_FRAMESCHEDULER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace ouzel::core
+{
+    // Splits the time between the frames into fixed simulation steps and limits the frame rate
+    // by sleeping until the next frame is due. Must be used only on the update thread.
+    class FrameScheduler final
+    {
+    public:
+        static constexpr std::size_t statisticsFrameCount = 120;
+        static constexpr std::chrono::nanoseconds maxDelta = std::chrono::milliseconds(1000 / 20); // minimum 20 FPS
+        // without a frame limit the update is skipped until this much time has passed
+        static constexpr std::chrono::nanoseconds minDelta = std::chrono::milliseconds(1);
+
+        struct Frame final
+        {
+            bool update = true; // false if the time is carried over to the next frame
+            std::chrono::nanoseconds delta{0}; // since the previous frame, limited to maxDelta
+            std::size_t tickCount = 0; // fixed steps due in this frame
+            float alpha = 0.0F; // fraction of a fixed step left after the ticks, for interpolating the drawn state
+        };
+
+        // over the last statisticsFrameCount frames
+        struct Statistics final
+        {
+            std::chrono::nanoseconds averageFrameTime{0};
+            std::chrono::nanoseconds frameTimeJitter{0}; // standard deviation of the frame time
+            std::chrono::nanoseconds averageIdleTime{0}; // spent waiting for the next frame
+            float averageTickCount = 0.0F;
+            std::uint64_t droppedTickCount = 0; // since the start, because a frame took too long
+        };
+
+        FrameScheduler() noexcept = default;
+
+        // zero disables the fixed steps
+        auto getFixedTimeStep() const noexcept { return fixedTimeStep; }
+        void setFixedTimeStep(std::chrono::nanoseconds newFixedTimeStep) noexcept;
+
+        auto getMaxTickCount() const noexcept { return maxTickCount; }
+        void setMaxTickCount(std::size_t newMaxTickCount) noexcept { maxTickCount = newMaxTickCount; }
+
+        // zero disables the frame limiter
+        float getTargetFrameRate() const noexcept;
+        void setTargetFrameRate(float newTargetFrameRate) noexcept;
+
+        // measures the time since the previous frame
+        Frame beginFrame();
+        // advances the simulation by the given time without limiting the delta, e.g. for a headless engine
+        Frame beginFrame(std::chrono::nanoseconds frameTime) noexcept;
+
+        // sleeps until the next frame is due if the frame rate is limited
+        void waitForNextFrame();
+
+        Statistics getStatistics() const noexcept;
+
+    private:
+        Frame advance(std::chrono::nanoseconds frameTime, std::chrono::nanoseconds delta) noexcept;
+
+        struct FrameRecord final
+        {
+            std::chrono::nanoseconds frameTime{0};
+            std::chrono::nanoseconds idleTime{0};
+            std::size_t tickCount = 0;
+        };
+
+        std::chrono::nanoseconds fixedTimeStep{0};
+        std::size_t maxTickCount = 5; // the rest of the steps are dropped, so that a slow frame does not slow down the next ones
+        std::chrono::nanoseconds targetFrameTime{0};
+
+        bool started = false;
+        std::chrono::steady_clock::time_point previousFrameTime;
+        std::chrono::steady_clock::time_point nextFrameTime;
+        std::chrono::nanoseconds accumulatedTime{0};
+        std::chrono::nanoseconds idleTime{0}; // of the current frame
+
+        std::array<FrameRecord, statisticsFrameCount> frameRecords;
+        std::size_t frameCount = 0;
+        std::uint64_t droppedTickCount = 0;
+    };
+}
+
+#endif // OUZEL_CORE_FRAMESCHEDULER_HPP
@@ -86,4 +86,14 @@
 #  define OUZEL_COMPILE_WASAPI 1
 #endif
 
+// Profiler markers
+#ifndef OUZEL_ENABLE_PROFILER
+#  define OUZEL_ENABLE_PROFILER 1
+#endif
+
+// Highest log level that is compiled in (0 off, 1 error, 2 warning, 3 info, 4 all)
+#ifndef OUZEL_LOG_LEVEL
+#  define OUZEL_LOG_LEVEL 4
+#endif
+
 #endif // OUZEL_SETUP_H
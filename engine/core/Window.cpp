@@ -27,63 +27,92 @@
 
 namespace ouzel::core
 {
-    Window::Window(Engine& initEngine,
-                   const Size<std::uint32_t, 2>& newSize,
-                   Flags flags,
-                   const std::string& newTitle,
-                   graphics::Driver graphicsDriver):
-        engine(initEngine),
+    namespace
+    {
+        std::unique_ptr<NativeWindow> createNativeWindow(const std::function<void(const NativeWindow::Event&)>& callback,
+                                                         const Size<std::uint32_t, 2>& size,
+                                                         Window::Flags flags,
+                                                         const std::string& title,
+                                                         graphics::Driver graphicsDriver)
+        {
+            // a headless window has no platform window, only the size
+            if ((flags & Window::Flags::headless) == Window::Flags::headless)
+            {
+                constexpr std::uint32_t defaultWidth = 800U;
+                constexpr std::uint32_t defaultHeight = 600U;
+
+                const Size<std::uint32_t, 2> headlessSize{
+                    size.v[0] ? size.v[0] : defaultWidth,
+                    size.v[1] ? size.v[1] : defaultHeight
+                };
+
+                return std::make_unique<NativeWindow>(callback, headlessSize, false, false, false, title, false);
+            }
+
+            static_cast<void>(graphicsDriver);
+
 #if TARGET_OS_IOS
-        nativeWindow(std::make_unique<ios::NativeWindow>(std::bind(&Window::eventCallback, this, std::placeholders::_1),
-                                                         newTitle,
-                                                         graphicsDriver,
-                                                         (flags & Flags::highDpi) == Flags::highDpi)),
+            return std::make_unique<ios::NativeWindow>(callback,
+                                                       title,
+                                                       graphicsDriver,
+                                                       (flags & Window::Flags::highDpi) == Window::Flags::highDpi);
 #elif TARGET_OS_TV
-        nativeWindow(std::make_unique<tvos::NativeWindow>(std::bind(&Window::eventCallback, this, std::placeholders::_1),
-                                                          newTitle,
-                                                          graphicsDriver,
-                                                          (flags & Flags::highDpi) == Flags::highDpi)),
+            return std::make_unique<tvos::NativeWindow>(callback,
+                                                        title,
+                                                        graphicsDriver,
+                                                        (flags & Window::Flags::highDpi) == Window::Flags::highDpi);
 #elif TARGET_OS_MAC
-        nativeWindow(std::make_unique<macos::NativeWindow>(std::bind(&Window::eventCallback, this, std::placeholders::_1),
-                                                           newSize,
-                                                           (flags & Flags::resizable) == Flags::resizable,
-                                                           (flags & Flags::fullscreen) == Flags::fullscreen,
-                                                           (flags & Flags::exclusiveFullscreen) == Flags::exclusiveFullscreen,
-                                                           newTitle,
-                                                           graphicsDriver,
-                                                           (flags & Flags::highDpi) == Flags::highDpi)),
+            return std::make_unique<macos::NativeWindow>(callback,
+                                                         size,
+                                                         (flags & Window::Flags::resizable) == Window::Flags::resizable,
+                                                         (flags & Window::Flags::fullscreen) == Window::Flags::fullscreen,
+                                                         (flags & Window::Flags::exclusiveFullscreen) == Window::Flags::exclusiveFullscreen,
+                                                         title,
+                                                         graphicsDriver,
+                                                         (flags & Window::Flags::highDpi) == Window::Flags::highDpi);
 #elif defined(__ANDROID__)
-        nativeWindow(std::make_unique<android::NativeWindow>(std::bind(&Window::eventCallback, this, std::placeholders::_1), newTitle)),
+            return std::make_unique<android::NativeWindow>(callback, title);
 #elif defined(__linux__)
-        nativeWindow(std::make_unique<linux::NativeWindow>(std::bind(&Window::eventCallback, this, std::placeholders::_1),
-                                                           newSize,
-                                                           (flags & Flags::resizable) == Flags::resizable,
-                                                           (flags & Flags::fullscreen) == Flags::fullscreen,
-                                                           (flags & Flags::exclusiveFullscreen) == Flags::exclusiveFullscreen,
-                                                           newTitle)),
+            return std::make_unique<linux::NativeWindow>(callback,
+                                                         size,
+                                                         (flags & Window::Flags::resizable) == Window::Flags::resizable,
+                                                         (flags & Window::Flags::fullscreen) == Window::Flags::fullscreen,
+                                                         (flags & Window::Flags::exclusiveFullscreen) == Window::Flags::exclusiveFullscreen,
+                                                         title);
 #elif defined(_WIN32)
-        nativeWindow(std::make_unique<windows::NativeWindow>(std::bind(&Window::eventCallback, this, std::placeholders::_1),
-                                                             newSize,
-                                                             (flags & Flags::resizable) == Flags::resizable,
-                                                             (flags & Flags::fullscreen) == Flags::fullscreen,
-                                                             (flags & Flags::exclusiveFullscreen) == Flags::exclusiveFullscreen,
-                                                             newTitle,
-                                                             (flags & Flags::highDpi) == Flags::highDpi)),
+            return std::make_unique<windows::NativeWindow>(callback,
+                                                           size,
+                                                           (flags & Window::Flags::resizable) == Window::Flags::resizable,
+                                                           (flags & Window::Flags::fullscreen) == Window::Flags::fullscreen,
+                                                           (flags & Window::Flags::exclusiveFullscreen) == Window::Flags::exclusiveFullscreen,
+                                                           title,
+                                                           (flags & Window::Flags::highDpi) == Window::Flags::highDpi);
 #elif defined(__EMSCRIPTEN__)
-        nativeWindow(std::make_unique<emscripten::NativeWindow>(std::bind(&Window::eventCallback, this, std::placeholders::_1),
-                                                                newSize,
-                                                                (flags & Flags::fullscreen) == Flags::fullscreen,
-                                                                newTitle,
-                                                                (flags & Flags::highDpi) == Flags::highDpi)),
+            return std::make_unique<emscripten::NativeWindow>(callback,
+                                                              size,
+                                                              (flags & Window::Flags::fullscreen) == Window::Flags::fullscreen,
+                                                              title,
+                                                              (flags & Window::Flags::highDpi) == Window::Flags::highDpi);
 #else
-        nativeWindow(std::make_unique<NativeWindow>(std::bind(&Window::eventCallback, this, std::placeholders::_1),
-                                                    newSize,
-                                                    (flags & Flags::resizable) == Flags::resizable,
-                                                    (flags & Flags::fullscreen) == Flags::fullscreen,
-                                                    (flags & Flags::exclusiveFullscreen) == Flags::exclusiveFullscreen,
-                                                    newTitle,
-                                                    (flags & Flags::highDpi) == Flags::highDpi)),
+            return std::make_unique<NativeWindow>(callback,
+                                                  size,
+                                                  (flags & Window::Flags::resizable) == Window::Flags::resizable,
+                                                  (flags & Window::Flags::fullscreen) == Window::Flags::fullscreen,
+                                                  (flags & Window::Flags::exclusiveFullscreen) == Window::Flags::exclusiveFullscreen,
+                                                  title,
+                                                  (flags & Window::Flags::highDpi) == Window::Flags::highDpi);
 #endif
+        }
+    }
+
+    Window::Window(Engine& initEngine,
+                   const Size<std::uint32_t, 2>& newSize,
+                   Flags flags,
+                   const std::string& newTitle,
+                   graphics::Driver graphicsDriver):
+        engine(initEngine),
+        nativeWindow(createNativeWindow(std::bind(&Window::eventCallback, this, std::placeholders::_1),
+                                        newSize, flags, newTitle, graphicsDriver)),
         size(nativeWindow->getSize()),
         resolution(nativeWindow->getResolution()),
         resizable((flags & Flags::resizable) == Flags::resizable),
@@ -92,8 +121,6 @@ namespace ouzel::core
         highDpi((flags & Flags::highDpi) == Flags::highDpi),
         title(newTitle)
     {
-        static_cast<void>(newSize);
-        static_cast<void>(graphicsDriver);
     }
 
     void Window::update()
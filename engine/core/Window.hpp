@@ -22,7 +22,8 @@ namespace ouzel::core
             resizable = 0x01,
             fullscreen = 0x02,
             exclusiveFullscreen = 0x04,
-            highDpi = 0x08
+            highDpi = 0x08,
+            headless = 0x10 // no platform window, the size stays fixed
         };
 
         enum class Mode
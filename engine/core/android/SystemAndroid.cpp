@@ -241,8 +241,8 @@ extern "C" JNIEXPORT void JNICALL Java_org_ouzel_OuzelLibJNIWrapper_onConfigurat
 
 extern "C" JNIEXPORT void JNICALL Java_org_ouzel_OuzelLibJNIWrapper_onLowMemory(JNIEnv*, jclass)
 {
-    auto event = std::make_unique<ouzel::SystemEvent>();
-    event->type = ouzel::Event::Type::lowMemory;
+    ouzel::SystemEvent event;
+    event.type = ouzel::Event::Type::lowMemory;
     engine->getEventDispatcher().postEvent(std::move(event));
 }
 
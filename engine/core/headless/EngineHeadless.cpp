@@ -0,0 +1,95 @@
+// Ouzel by Elviss Strazdins
+
+#include "EngineHeadless.hpp"
+#include "../../audio/Audio.hpp"
+#include "../../audio/offline/OfflineAudioDevice.hpp"
+#include "../../graphics/Graphics.hpp"
+#include "../../utils/Profiler.hpp"
+
+namespace ouzel::core::headless
+{
+    Engine::Engine(const std::vector<std::string>& initArgs):
+        core::Engine(initArgs)
+    {
+        headless = true;
+        init();
+
+        // the mixed samples are not needed, only the time it takes to mix them
+        auto& audioDevice = static_cast<audio::offline::AudioDevice&>(*audio->getDevice());
+        audioDevice.setCaptureEnabled(false);
+
+        SystemEvent event;
+        event.type = Event::Type::engineStart;
+        eventDispatcher.postEvent(std::move(event));
+
+        active = true;
+    }
+
+    Engine::FrameStatistics Engine::step(std::chrono::nanoseconds timeStep)
+    {
+        FrameStatistics statistics;
+
+        profiler.markFrame();
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        {
+            OUZEL_PROFILE_SCOPE("Engine::update");
+
+            eventDispatcher.dispatchEvents();
+            cache.update();
+
+            dispatchUpdateEvents(frameScheduler.beginFrame(timeStep));
+
+            window->update();
+        }
+
+        auto currentTime = std::chrono::steady_clock::now();
+        statistics.updateTime = currentTime - startTime;
+        startTime = currentTime;
+
+        {
+            OUZEL_PROFILE_SCOPE("Engine::audio");
+
+            audio->update();
+
+            // mixes the samples of the time step in whole blocks
+            auto& audioDevice = static_cast<audio::offline::AudioDevice&>(*audio->getDevice());
+            elapsedTime += timeStep;
+            const auto dueFrames = static_cast<std::uint64_t>(std::chrono::duration<double>(elapsedTime).count() *
+                                                              static_cast<double>(audioDevice.getSampleRate()));
+            const auto renderedFrames = audioDevice.getStatistics().frames;
+            if (dueFrames > renderedFrames)
+                audioDevice.render(static_cast<std::uint32_t>(dueFrames - renderedFrames));
+        }
+
+        currentTime = std::chrono::steady_clock::now();
+        statistics.audioTime = currentTime - startTime;
+        startTime = currentTime;
+
+        if (graphics->getRefillQueue())
+            sceneManager.draw();
+
+        currentTime = std::chrono::steady_clock::now();
+        statistics.drawTime = currentTime - startTime;
+        startTime = currentTime;
+
+        {
+            OUZEL_PROFILE_SCOPE("RenderDevice::process");
+            graphics->getDevice()->process();
+        }
+
+        statistics.submitTime = std::chrono::steady_clock::now() - startTime;
+        statistics.drawCallCount = graphics->getDevice()->getDrawCallCount();
+
+        ++frameCount;
+
+        return statistics;
+    }
+
+    void Engine::runOnMainThread(const std::function<void()>& func)
+    {
+        // step() runs on the main thread
+        func();
+    }
+}
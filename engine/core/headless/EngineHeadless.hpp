@@ -0,0 +1,43 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_CORE_ENGINEHEADLESS_HPP
+#define OUZEL_CORE_ENGINEHEADLESS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../Engine.hpp"
+
+namespace ouzel::core::headless
+{
+    // Engine without a window, a GPU, a sound card and input devices, used by benchmarks and
+    // automated tests. There is no update thread, the owner calls step() for every frame and
+    // the frames advance by a fixed time step, so that the runs are repeatable.
+    class Engine final: public core::Engine
+    {
+    public:
+        struct FrameStatistics final
+        {
+            std::chrono::nanoseconds updateTime{0}; // events, update handlers and the window
+            std::chrono::nanoseconds audioTime{0}; // mixing of the time step
+            std::chrono::nanoseconds drawTime{0}; // scene visit and command recording
+            std::chrono::nanoseconds submitTime{0}; // execution of the command buffers
+            std::uint32_t drawCallCount = 0;
+        };
+
+        explicit Engine(const std::vector<std::string>& initArgs = {});
+
+        FrameStatistics step(std::chrono::nanoseconds timeStep);
+
+        auto getFrameCount() const noexcept { return frameCount; }
+
+    private:
+        void runOnMainThread(const std::function<void()>& func) final;
+
+        std::uint64_t frameCount = 0;
+        std::chrono::nanoseconds elapsedTime{0};
+    };
+}
+
+#endif // OUZEL_CORE_ENGINEHEADLESS_HPP
@@ -55,8 +55,8 @@
 {
     if (ouzel::engine)
     {
-        auto event = std::make_unique<ouzel::SystemEvent>();
-        event->type = ouzel::Event::Type::lowMemory;
+        ouzel::SystemEvent event;
+        event.type = ouzel::Event::Type::lowMemory;
 
         ouzel::engine->getEventDispatcher().postEvent(std::move(event));
     }
@@ -67,31 +67,31 @@
     UIDevice* device = note.object;
     const UIDeviceOrientation orientation = device.orientation;
 
-    auto event = std::make_unique<ouzel::SystemEvent>();
-    event->type = ouzel::Event::Type::orientationChange;
+    ouzel::SystemEvent event;
+    event.type = ouzel::Event::Type::orientationChange;
 
     switch (orientation)
     {
         case UIDeviceOrientationPortrait:
-            event->orientation = ouzel::SystemEvent::Orientation::portrait;
+            event.orientation = ouzel::SystemEvent::Orientation::portrait;
             break;
         case UIDeviceOrientationPortraitUpsideDown:
-            event->orientation = ouzel::SystemEvent::Orientation::portraitReverse;
+            event.orientation = ouzel::SystemEvent::Orientation::portraitReverse;
             break;
         case UIDeviceOrientationLandscapeLeft:
-            event->orientation = ouzel::SystemEvent::Orientation::landscape;
+            event.orientation = ouzel::SystemEvent::Orientation::landscape;
             break;
         case UIDeviceOrientationLandscapeRight:
-            event->orientation = ouzel::SystemEvent::Orientation::landscapeReverse;
+            event.orientation = ouzel::SystemEvent::Orientation::landscapeReverse;
             break;
         case UIDeviceOrientationFaceUp:
-            event->orientation = ouzel::SystemEvent::Orientation::faceUp;
+            event.orientation = ouzel::SystemEvent::Orientation::faceUp;
             break;
         case UIDeviceOrientationFaceDown:
-            event->orientation = ouzel::SystemEvent::Orientation::faceDown;
+            event.orientation = ouzel::SystemEvent::Orientation::faceDown;
             break;
         default: // unsupported orientation, assume portrait
-            event->orientation = ouzel::SystemEvent::Orientation::portrait;
+            event.orientation = ouzel::SystemEvent::Orientation::portrait;
             break;
     }
 
@@ -322,8 +322,6 @@ namespace ouzel::core::linux
         init();
         start();
 
-        auto& inputSystemLinux = inputManager->getInputSystem();
-
 #if OUZEL_SUPPORTS_X11
         auto windowLinux = static_cast<NativeWindow*>(window->getNativeWindow());
 
@@ -510,16 +508,10 @@ namespace ouzel::core::linux
                     }
                 }
             }
-
-            inputSystemLinux.update();
         }
 #else
         while (active)
-        {
             executeAll();
-
-            inputSystemLinux.update();
-        }
 #endif
 
         exit();
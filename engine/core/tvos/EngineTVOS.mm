@@ -50,8 +50,8 @@
 {
     if (ouzel::engine)
     {
-        auto event = std::make_unique<ouzel::SystemEvent>();
-        event->type = ouzel::Event::Type::lowMemory;
+        ouzel::SystemEvent event;
+        event.type = ouzel::Event::Type::lowMemory;
 
         ouzel::engine->getEventDispatcher().postEvent(std::move(event));
     }
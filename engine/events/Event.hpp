@@ -85,6 +85,7 @@ namespace ouzel
             soundFinish,
 
             update,
+            fixedUpdate, // simulation step of the fixed time step
 
             user // user defined event
         };
@@ -148,7 +149,7 @@ namespace ouzel
             faceDown
         };
 
-        Orientation orientation;
+        Orientation orientation = Orientation::portrait;
         std::string filename;
     };
 
@@ -181,6 +182,7 @@ namespace ouzel
     struct UpdateEvent final: Event
     {
         float delta = 0.0F;
+        float alpha = 0.0F; // fraction of the fixed time step passed since the last fixed update
     };
 
     struct UserEvent final: Event
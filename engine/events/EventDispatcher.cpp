@@ -3,177 +3,215 @@
 #include <algorithm>
 #include "EventDispatcher.hpp"
 #include "EventHandler.hpp"
+#include "../utils/Profiler.hpp"
 #include "../utils/Utils.hpp"
 
 namespace ouzel
 {
     EventDispatcher::~EventDispatcher()
     {
-        for (EventHandler* eventHandler : eventHandlerAddSet)
-            eventHandler->eventDispatcher = nullptr;
+        for (const auto& categoryEventHandlers : eventHandlers)
+            for (EventHandler* eventHandler : categoryEventHandlers)
+                if (eventHandler) eventHandler->eventDispatcher = nullptr;
 
-        for (EventHandler* eventHandler : eventHandlers)
+        for (EventHandler* eventHandler : addedEventHandlers)
+            if (eventHandler) eventHandler->eventDispatcher = nullptr;
+    }
+
+    bool EventDispatcher::hasHandler(const EventHandler& eventHandler, std::size_t category) noexcept
+    {
+        switch (category)
         {
-            const auto i = std::find(eventHandlerDeleteSet.begin(),
-                                     eventHandlerDeleteSet.end(),
-                                     eventHandler);
-            if (i == eventHandlerDeleteSet.end()) eventHandler->eventDispatcher = nullptr;
+            case keyboard: return static_cast<bool>(eventHandler.keyboardHandler);
+            case mouse: return static_cast<bool>(eventHandler.mouseHandler);
+            case touch: return static_cast<bool>(eventHandler.touchHandler);
+            case gamepad: return static_cast<bool>(eventHandler.gamepadHandler);
+            case window: return static_cast<bool>(eventHandler.windowHandler);
+            case system: return static_cast<bool>(eventHandler.systemHandler);
+            case ui: return static_cast<bool>(eventHandler.uiHandler);
+            case animation: return static_cast<bool>(eventHandler.animationHandler);
+            case sound: return static_cast<bool>(eventHandler.soundHandler);
+            case update: return static_cast<bool>(eventHandler.updateHandler);
+            case fixedUpdate: return static_cast<bool>(eventHandler.fixedUpdateHandler);
+            case user: return static_cast<bool>(eventHandler.userHandler);
+            default: return false;
         }
     }
 
-    void EventDispatcher::dispatchEvents()
+    void EventDispatcher::updateEventHandlers()
     {
-        for (EventHandler* eventHandler : eventHandlerDeleteSet)
+        for (std::size_t category = 0; category < categoryCount; ++category)
         {
-            const auto i = std::find(eventHandlers.begin(),
-                                     eventHandlers.end(),
-                                     eventHandler);
+            if (!removedCounts[category]) continue;
+
+            auto& categoryEventHandlers = eventHandlers[category];
+            categoryEventHandlers.erase(std::remove(categoryEventHandlers.begin(),
+                                                    categoryEventHandlers.end(),
+                                                    nullptr),
+                                        categoryEventHandlers.end());
+
+            for (std::size_t i = 0; i < categoryEventHandlers.size(); ++i)
+                categoryEventHandlers[i]->indices[category] = i;
 
-            if (i != eventHandlers.end())
-                eventHandlers.erase(i);
+            removedCounts[category] = 0;
         }
 
-        eventHandlerDeleteSet.clear();
+        if (addedEventHandlers.empty()) return;
 
-        for (EventHandler* eventHandler : eventHandlerAddSet)
+        addedEventHandlers.erase(std::remove(addedEventHandlers.begin(),
+                                             addedEventHandlers.end(),
+                                             nullptr),
+                                 addedEventHandlers.end());
+
+        const auto comparePriority = [](const auto a, const auto b) noexcept {
+            return a->priority > b->priority;
+        };
+
+        // handlers with the same priority are called in the order they were added
+        std::stable_sort(addedEventHandlers.begin(), addedEventHandlers.end(), comparePriority);
+
+        for (EventHandler* eventHandler : addedEventHandlers)
+            eventHandler->addedIndex = none;
+
+        for (std::size_t category = 0; category < categoryCount; ++category)
         {
-            const auto i = std::find(eventHandlers.begin(),
-                                     eventHandlers.end(),
-                                     eventHandler);
+            auto& categoryEventHandlers = eventHandlers[category];
+            const auto oldSize = categoryEventHandlers.size();
 
-            if (i == eventHandlers.end())
-            {
-                const auto upperBound = std::upper_bound(eventHandlers.begin(), eventHandlers.end(), eventHandler,
-                                                         [](const auto a, const auto b) noexcept {
-                                                                return a->priority > b->priority;
-                                                            });
+            for (EventHandler* eventHandler : addedEventHandlers)
+                if (hasHandler(*eventHandler, category))
+                    categoryEventHandlers.push_back(eventHandler);
 
-                eventHandlers.insert(upperBound, eventHandler);
-            }
+            if (categoryEventHandlers.size() == oldSize) continue;
+
+            std::inplace_merge(categoryEventHandlers.begin(),
+                               categoryEventHandlers.begin() + static_cast<std::ptrdiff_t>(oldSize),
+                               categoryEventHandlers.end(),
+                               comparePriority);
+
+            for (std::size_t i = 0; i < categoryEventHandlers.size(); ++i)
+                categoryEventHandlers[i]->indices[category] = i;
         }
 
-        eventHandlerAddSet.clear();
+        addedEventHandlers.clear();
+    }
 
-        std::pair<std::promise<bool>, std::unique_ptr<Event>> event;
+    void EventDispatcher::dispatchEvents()
+    {
+        OUZEL_PROFILE_SCOPE("EventDispatcher::dispatchEvents");
 
-        for (;;)
-        {
-            std::unique_lock lock(eventQueueMutex);
-            if (eventQueue.empty()) break;
+        updateEventHandlers();
 
-            event = std::move(eventQueue.front());
-            eventQueue.pop();
-            lock.unlock();
+        eventQueue.popAll([this](QueuedEvent& queuedEvent) {
+            dispatchQueuedEvent(queuedEvent);
+        });
+    }
+
+    void EventDispatcher::dispatchQueuedEvent(QueuedEvent& queuedEvent)
+    {
+        const auto handled = std::visit([this](const auto& event) {
+            return dispatch(event);
+        }, queuedEvent.event);
 
-            event.first.set_value(dispatchEvent(std::move(event.second)));
+        if (queuedEvent.promise)
+        {
+            queuedEvent.promise->set_value(handled);
+            queuedEvent.promise.reset();
         }
     }
 
+    template <class EventType, class Function>
+    bool EventDispatcher::dispatchToCategory(Category category,
+                                             Function EventHandler::* function,
+                                             const Event& event)
+    {
+        // handlers added during the dispatch are deferred and removed ones are only set to nullptr,
+        // so the list can not be reallocated here
+        const auto& categoryEventHandlers = eventHandlers[category];
+
+        for (std::size_t i = 0; i < categoryEventHandlers.size(); ++i)
+            if (const auto eventHandler = categoryEventHandlers[i])
+                if (const auto& handler = eventHandler->*function)
+                    if (handler(static_cast<const EventType&>(event)))
+                        return true;
+
+        return false;
+    }
+
     bool EventDispatcher::dispatchEvent(std::unique_ptr<Event> event)
     {
         if (!event) return false;
 
-        bool handled = false;
+        return dispatch(*event);
+    }
 
-        for (const auto eventHandler : eventHandlers)
+    bool EventDispatcher::dispatch(const Event& event)
+    {
+        switch (event.type)
         {
-            const auto i = std::find(eventHandlerDeleteSet.begin(),
-                                     eventHandlerDeleteSet.end(),
-                                     eventHandler);
-
-            if (i == eventHandlerDeleteSet.end())
-            {
-                switch (event->type)
-                {
-                    case Event::Type::keyboardConnect:
-                    case Event::Type::keyboardDisconnect:
-                    case Event::Type::keyboardKeyPress:
-                    case Event::Type::keyboardKeyRelease:
-                        if (eventHandler->keyboardHandler)
-                            handled = eventHandler->keyboardHandler(*static_cast<KeyboardEvent*>(event.get()));
-                        break;
-                    case Event::Type::mouseConnect:
-                    case Event::Type::mouseDisconnect:
-                    case Event::Type::mousePress:
-                    case Event::Type::mouseRelease:
-                    case Event::Type::mouseScroll:
-                    case Event::Type::mouseMove:
-                    case Event::Type::mouseCursorLockChange:
-                        if (eventHandler->mouseHandler)
-                            handled = eventHandler->mouseHandler(*static_cast<MouseEvent*>(event.get()));
-                        break;
-                    case Event::Type::touchpadConnect:
-                    case Event::Type::touchpadDisconnect:
-                    case Event::Type::touchBegin:
-                    case Event::Type::touchMove:
-                    case Event::Type::touchEnd:
-                    case Event::Type::touchCancel:
-                        if (eventHandler->touchHandler)
-                            handled = eventHandler->touchHandler(*static_cast<TouchEvent*>(event.get()));
-                        break;
-                    case Event::Type::gamepadConnect:
-                    case Event::Type::gamepadDisconnect:
-                    case Event::Type::gamepadButtonChange:
-                        if (eventHandler->gamepadHandler)
-                            handled = eventHandler->gamepadHandler(*static_cast<GamepadEvent*>(event.get()));
-                        break;
-                    case Event::Type::windowSizeChange:
-                    case Event::Type::windowTitleChange:
-                    case Event::Type::fullscreenChange:
-                    case Event::Type::screenChange:
-                    case Event::Type::resolutionChange:
-                        if (eventHandler->windowHandler)
-                            handled = eventHandler->windowHandler(*static_cast<WindowEvent*>(event.get()));
-                        break;
-                    case Event::Type::engineStart:
-                    case Event::Type::engineStop:
-                    case Event::Type::engineResume:
-                    case Event::Type::enginePause:
-                    case Event::Type::orientationChange:
-                    case Event::Type::lowMemory:
-                    case Event::Type::openFile:
-                        if (eventHandler->systemHandler)
-                            handled = eventHandler->systemHandler(*static_cast<SystemEvent*>(event.get()));
-                        break;
-                    case Event::Type::actorEnter:
-                    case Event::Type::actorLeave:
-                    case Event::Type::actorPress:
-                    case Event::Type::actorRelease:
-                    case Event::Type::actorClick:
-                    case Event::Type::actorDrag:
-                    case Event::Type::widgetChange:
-                        if (eventHandler->uiHandler)
-                            handled = eventHandler->uiHandler(*static_cast<UIEvent*>(event.get()));
-                        break;
-                    case Event::Type::animationStart:
-                    case Event::Type::animationReset:
-                    case Event::Type::animationFinish:
-                        if (eventHandler->animationHandler)
-                            handled = eventHandler->animationHandler(*static_cast<AnimationEvent*>(event.get()));
-                        break;
-                    case Event::Type::soundStart:
-                    case Event::Type::soundReset:
-                    case Event::Type::soundFinish:
-                        if (eventHandler->soundHandler)
-                            handled = eventHandler->soundHandler(*static_cast<SoundEvent*>(event.get()));
-                        break;
-                    case Event::Type::update:
-                        if (eventHandler->updateHandler)
-                            handled = eventHandler->updateHandler(*static_cast<UpdateEvent*>(event.get()));
-                        break;
-                    case Event::Type::user:
-                        if (eventHandler->userHandler)
-                            handled = eventHandler->userHandler(*static_cast<UserEvent*>(event.get()));
-                        break;
-                    default:
-                        return false; // custom event should not be sent
-                }
-            }
-
-            if (handled) break;
+            case Event::Type::keyboardConnect:
+            case Event::Type::keyboardDisconnect:
+            case Event::Type::keyboardKeyPress:
+            case Event::Type::keyboardKeyRelease:
+                return dispatchToCategory<KeyboardEvent>(keyboard, &EventHandler::keyboardHandler, event);
+            case Event::Type::mouseConnect:
+            case Event::Type::mouseDisconnect:
+            case Event::Type::mousePress:
+            case Event::Type::mouseRelease:
+            case Event::Type::mouseScroll:
+            case Event::Type::mouseMove:
+            case Event::Type::mouseCursorLockChange:
+                return dispatchToCategory<MouseEvent>(mouse, &EventHandler::mouseHandler, event);
+            case Event::Type::touchpadConnect:
+            case Event::Type::touchpadDisconnect:
+            case Event::Type::touchBegin:
+            case Event::Type::touchMove:
+            case Event::Type::touchEnd:
+            case Event::Type::touchCancel:
+                return dispatchToCategory<TouchEvent>(touch, &EventHandler::touchHandler, event);
+            case Event::Type::gamepadConnect:
+            case Event::Type::gamepadDisconnect:
+            case Event::Type::gamepadButtonChange:
+                return dispatchToCategory<GamepadEvent>(gamepad, &EventHandler::gamepadHandler, event);
+            case Event::Type::windowSizeChange:
+            case Event::Type::windowTitleChange:
+            case Event::Type::fullscreenChange:
+            case Event::Type::screenChange:
+            case Event::Type::resolutionChange:
+                return dispatchToCategory<WindowEvent>(window, &EventHandler::windowHandler, event);
+            case Event::Type::engineStart:
+            case Event::Type::engineStop:
+            case Event::Type::engineResume:
+            case Event::Type::enginePause:
+            case Event::Type::orientationChange:
+            case Event::Type::lowMemory:
+            case Event::Type::openFile:
+                return dispatchToCategory<SystemEvent>(system, &EventHandler::systemHandler, event);
+            case Event::Type::actorEnter:
+            case Event::Type::actorLeave:
+            case Event::Type::actorPress:
+            case Event::Type::actorRelease:
+            case Event::Type::actorClick:
+            case Event::Type::actorDrag:
+            case Event::Type::widgetChange:
+                return dispatchToCategory<UIEvent>(ui, &EventHandler::uiHandler, event);
+            case Event::Type::animationStart:
+            case Event::Type::animationReset:
+            case Event::Type::animationFinish:
+                return dispatchToCategory<AnimationEvent>(animation, &EventHandler::animationHandler, event);
+            case Event::Type::soundStart:
+            case Event::Type::soundReset:
+            case Event::Type::soundFinish:
+                return dispatchToCategory<SoundEvent>(sound, &EventHandler::soundHandler, event);
+            case Event::Type::update:
+                return dispatchToCategory<UpdateEvent>(update, &EventHandler::updateHandler, event);
+            case Event::Type::fixedUpdate:
+                return dispatchToCategory<UpdateEvent>(fixedUpdate, &EventHandler::fixedUpdateHandler, event);
+            case Event::Type::user:
+                return dispatchToCategory<UserEvent>(user, &EventHandler::userHandler, event);
+            default:
+                return false; // custom event should not be sent
         }
-
-        return handled;
     }
 
     void EventDispatcher::addEventHandler(EventHandler& eventHandler)
@@ -182,38 +220,49 @@ namespace ouzel
             eventHandler.eventDispatcher->removeEventHandler(eventHandler);
 
         eventHandler.eventDispatcher = this;
-
-        eventHandlerAddSet.insert(&eventHandler);
-
-        const auto setIterator = eventHandlerDeleteSet.find(&eventHandler);
-
-        if (setIterator != eventHandlerDeleteSet.end())
-            eventHandlerDeleteSet.erase(setIterator);
+        eventHandler.addedIndex = addedEventHandlers.size();
+        addedEventHandlers.push_back(&eventHandler);
     }
 
     void EventDispatcher::removeEventHandler(EventHandler& eventHandler)
     {
-        if (eventHandler.eventDispatcher == this)
-            eventHandler.eventDispatcher = nullptr;
+        if (eventHandler.eventDispatcher != this) return;
 
-        eventHandlerDeleteSet.insert(&eventHandler);
+        for (std::size_t category = 0; category < categoryCount; ++category)
+            if (auto& index = eventHandler.indices[category]; index != none)
+            {
+                eventHandlers[category][index] = nullptr;
+                ++removedCounts[category];
+                index = none;
+            }
 
-        const auto setIterator = eventHandlerAddSet.find(&eventHandler);
+        if (eventHandler.addedIndex != none)
+        {
+            addedEventHandlers[eventHandler.addedIndex] = nullptr;
+            eventHandler.addedIndex = none;
+        }
 
-        if (setIterator != eventHandlerAddSet.end())
-            eventHandlerAddSet.erase(setIterator);
+        eventHandler.eventDispatcher = nullptr;
+    }
+
+    void EventDispatcher::postEvent(PostedEvent event)
+    {
+#if defined(__EMSCRIPTEN__)
+        std::visit([this](const auto& e) { dispatch(e); }, event);
+#else
+        eventQueue.push(QueuedEvent{std::move(event), std::nullopt});
+#endif
     }
 
-    std::future<bool> EventDispatcher::postEvent(std::unique_ptr<Event> event)
+    std::future<bool> EventDispatcher::postEventWithResult(PostedEvent event)
     {
         std::promise<bool> promise;
         std::future<bool> future = promise.get_future();
 
 #if defined(__EMSCRIPTEN__)
-        promise.set_value(dispatchEvent(std::move(event)));
+        promise.set_value(std::visit([this](const auto& e) { return dispatch(e); }, event));
 #else
-        std::lock_guard lock(eventQueueMutex);
-        eventQueue.push(std::pair<std::promise<bool>, std::unique_ptr<Event>>(std::move(promise), std::move(event)));
+        eventQueue.push(QueuedEvent{std::move(event), std::move(promise)});
 #endif
 
         return future;
@@ -3,13 +3,16 @@
 #ifndef OUZEL_EVENTS_EVENTDISPATCHER_HPP
 #define OUZEL_EVENTS_EVENTDISPATCHER_HPP
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <future>
 #include <memory>
-#include <queue>
-#include <set>
+#include <optional>
+#include <variant>
 #include <vector>
 #include "Event.hpp"
+#include "../thread/OverflowMpscQueue.hpp"
 
 namespace ouzel
 {
@@ -17,7 +20,22 @@ namespace ouzel
 
     class EventDispatcher final
     {
+        friend EventHandler;
     public:
+        using PostedEvent = std::variant<
+            KeyboardEvent,
+            MouseEvent,
+            TouchEvent,
+            GamepadEvent,
+            WindowEvent,
+            SystemEvent,
+            UIEvent,
+            AnimationEvent,
+            SoundEvent,
+            UpdateEvent,
+            UserEvent
+        >;
+
         EventDispatcher() = default;
         ~EventDispatcher();
 
@@ -26,25 +44,66 @@ namespace ouzel
         EventDispatcher(EventDispatcher&&) = delete;
         EventDispatcher& operator=(EventDispatcher&&) = delete;
 
+        // the handler is added before the next dispatchEvents call and only to the
+        // categories whose handler functions are set at that time
         void addEventHandler(EventHandler& eventHandler);
         void removeEventHandler(EventHandler& eventHandler);
 
         // dispatches the event immediately
         bool dispatchEvent(std::unique_ptr<Event> event);
 
-        // posts the event for dispatching on the game thread
-        std::future<bool> postEvent(std::unique_ptr<Event> event);
+        // posts the event for dispatching on the game thread, can be called from any thread
+        void postEvent(PostedEvent event);
+        // same as postEvent, but the future is set to whether the event was handled
+        std::future<bool> postEventWithResult(PostedEvent event);
 
         // dispatches all queued events on the game thread
         void dispatchEvents();
 
     private:
-        std::vector<EventHandler*> eventHandlers;
-        std::set<EventHandler*> eventHandlerAddSet;
-        std::set<EventHandler*> eventHandlerDeleteSet;
+        enum Category: std::size_t
+        {
+            keyboard,
+            mouse,
+            touch,
+            gamepad,
+            window,
+            system,
+            ui,
+            animation,
+            sound,
+            update,
+            fixedUpdate,
+            user,
+            categoryCount
+        };
+
+        static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+        struct QueuedEvent final
+        {
+            PostedEvent event;
+            std::optional<std::promise<bool>> promise;
+        };
+
+        bool dispatch(const Event& event);
+        void dispatchQueuedEvent(QueuedEvent& queuedEvent);
+
+        static bool hasHandler(const EventHandler& eventHandler, std::size_t category) noexcept;
+        void updateEventHandlers();
+
+        template <class EventType, class Function>
+        bool dispatchToCategory(Category category,
+                                Function EventHandler::* function,
+                                const Event& event);
+
+        // handlers of every category sorted by priority, removed handlers are set to nullptr
+        std::array<std::vector<EventHandler*>, categoryCount> eventHandlers;
+        std::array<std::size_t, categoryCount> removedCounts{};
+        std::vector<EventHandler*> addedEventHandlers;
 
-        std::mutex eventQueueMutex;
-        std::queue<std::pair<std::promise<bool>, std::unique_ptr<Event>>> eventQueue;
+        static constexpr std::size_t eventQueueCapacity = 1024;
+        thread::OverflowMpscQueue<QueuedEvent> eventQueue{eventQueueCapacity};
     };
 }
 
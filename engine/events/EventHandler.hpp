@@ -3,6 +3,7 @@
 #ifndef OUZEL_EVENTS_EVENTHANDLER_HPP
 #define OUZEL_EVENTS_EVENTHANDLER_HPP
 
+#include <array>
 #include <functional>
 #include <cstdint>
 #include "Event.hpp"
@@ -17,7 +18,10 @@ namespace ouzel
         using Priority = std::int32_t;
         static constexpr Priority priorityMax = 0x1000;
 
-        explicit EventHandler(Priority initPriority = 0): priority(initPriority) {}
+        explicit EventHandler(Priority initPriority = 0): priority(initPriority)
+        {
+            indices.fill(EventDispatcher::none);
+        }
         ~EventHandler()
         {
             if (eventDispatcher) eventDispatcher->removeEventHandler(*this);
@@ -47,11 +51,16 @@ namespace ouzel
         std::function<bool(const AnimationEvent&)> animationHandler;
         std::function<bool(const SoundEvent&)> soundHandler;
         std::function<bool(const UpdateEvent&)> updateHandler;
+        std::function<bool(const UpdateEvent&)> fixedUpdateHandler;
         std::function<bool(const UserEvent&)> userHandler;
 
     private:
         Priority priority;
         EventDispatcher* eventDispatcher = nullptr;
+
+        // positions in the dispatcher's handler lists
+        std::array<std::size_t, EventDispatcher::categoryCount> indices;
+        std::size_t addedIndex = EventDispatcher::none;
     };
 }
 
@@ -0,0 +1,202 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_FORMATS_COOKED_HPP
+#define OUZEL_FORMATS_COOKED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../utils/Span.hpp"
+
+// Binary asset formats written by the asset cooker (tools/ouzel --export-assets).
+// All the values are little-endian, every file starts with a magic and the version,
+// blobs are prefixed with their byte size and start at a 4-byte aligned offset, so
+// that they can be handed to the graphics API straight from the mapped file.
+//
+// texture: pixel format, width, height, level count, {width, height, blob} per level
+// static mesh: material library count, {filename} per library, mesh count,
+//     {name, material, bounding box, index size, index blob, vertex size, vertex blob} per mesh
+// sprite: texture name, texture filename, animation count,
+//     {name, frame interval, frame count, {name, bounding box, index blob, vertex blob} per frame} per animation
+// font: texture name, texture filename, line height, base, width, height, pages, outline,
+//     char count, {id, x, y, width, height, x offset, y offset, x advance, page} per char,
+//     kerning count, {first, second, amount} per kerning pair
+namespace ouzel::cooked
+{
+    class DecodeError final: public std::runtime_error
+    {
+    public:
+        explicit DecodeError(const std::string& str): std::runtime_error(str) {}
+        explicit DecodeError(const char* str): std::runtime_error(str) {}
+    };
+
+    constexpr std::uint32_t version = 1;
+
+    constexpr std::uint32_t textureMagic = 0x5845544FU; // OTEX
+    constexpr std::uint32_t staticMeshMagic = 0x48534D4FU; // OMSH
+    constexpr std::uint32_t spriteMagic = 0x5250534FU; // OSPR
+    constexpr std::uint32_t fontMagic = 0x544E464FU; // OFNT
+
+    class Writer final
+    {
+    public:
+        explicit Writer(std::uint32_t magic)
+        {
+            writeUint32(magic);
+            writeUint32(version);
+        }
+
+        void writeUint8(std::uint8_t value)
+        {
+            data.push_back(static_cast<std::byte>(value));
+        }
+
+        void writeUint16(std::uint16_t value)
+        {
+            for (std::size_t i = 0; i < sizeof(value); ++i)
+                data.push_back(static_cast<std::byte>((value >> (i * 8)) & 0xFFU));
+        }
+
+        void writeUint32(std::uint32_t value)
+        {
+            for (std::size_t i = 0; i < sizeof(value); ++i)
+                data.push_back(static_cast<std::byte>((value >> (i * 8)) & 0xFFU));
+        }
+
+        void writeInt16(std::int16_t value)
+        {
+            writeUint16(static_cast<std::uint16_t>(value));
+        }
+
+        void writeFloat(float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writeUint32(bits);
+        }
+
+        void writeString(const std::string& value)
+        {
+            writeUint32(static_cast<std::uint32_t>(value.size()));
+            for (const auto c : value)
+                data.push_back(static_cast<std::byte>(c));
+        }
+
+        void writeBlob(const void* blob, std::size_t size)
+        {
+            writeUint32(static_cast<std::uint32_t>(size));
+            align();
+            const auto bytes = static_cast<const std::byte*>(blob);
+            data.insert(data.end(), bytes, bytes + size);
+        }
+
+        auto& getData() const noexcept { return data; }
+
+    private:
+        void align()
+        {
+            while (data.size() % 4) data.push_back(std::byte{0});
+        }
+
+        std::vector<std::byte> data;
+    };
+
+    class Reader final
+    {
+    public:
+        explicit Reader(Span<const std::byte> initData) noexcept:
+            data(initData)
+        {
+        }
+
+        // Returns false if the data is not a cooked asset of the given type
+        static bool check(Span<const std::byte> data, std::uint32_t magic)
+        {
+            if (data.size() < 8) return false;
+
+            Reader reader{data};
+            if (reader.readUint32() != magic) return false;
+            if (reader.readUint32() != version)
+                throw DecodeError("Unsupported cooked asset version");
+            return true;
+        }
+
+        void skipHeader()
+        {
+            require(8);
+            offset += 8;
+        }
+
+        std::uint8_t readUint8()
+        {
+            require(1);
+            return static_cast<std::uint8_t>(data[offset++]);
+        }
+
+        std::uint16_t readUint16()
+        {
+            require(sizeof(std::uint16_t));
+            std::uint16_t result = 0;
+            for (std::size_t i = 0; i < sizeof(result); ++i)
+                result |= static_cast<std::uint16_t>(static_cast<std::uint16_t>(data[offset++]) << (i * 8));
+            return result;
+        }
+
+        std::uint32_t readUint32()
+        {
+            require(sizeof(std::uint32_t));
+            std::uint32_t result = 0;
+            for (std::size_t i = 0; i < sizeof(result); ++i)
+                result |= static_cast<std::uint32_t>(data[offset++]) << (i * 8);
+            return result;
+        }
+
+        std::int16_t readInt16()
+        {
+            return static_cast<std::int16_t>(readUint16());
+        }
+
+        float readFloat()
+        {
+            const auto bits = readUint32();
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        std::string readString()
+        {
+            const auto size = readUint32();
+            require(size);
+            std::string result(reinterpret_cast<const char*>(data.data() + offset), size);
+            offset += size;
+            return result;
+        }
+
+        // The returned span points into the cooked data, nothing is copied
+        Span<const std::byte> readBlob()
+        {
+            const auto size = readUint32();
+            offset = (offset + 3) & ~std::size_t{3};
+            require(size);
+            const auto result = data.subspan(offset, size);
+            offset += size;
+            return result;
+        }
+
+    private:
+        void require(std::size_t size) const
+        {
+            if (data.size() < offset || data.size() - offset < size)
+                throw DecodeError("Unexpected end of cooked data");
+        }
+
+        Span<const std::byte> data;
+        std::size_t offset = 0;
+    };
+}
+
+#endif // OUZEL_FORMATS_COOKED_HPP
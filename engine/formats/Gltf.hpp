@@ -0,0 +1,906 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_FORMATS_GLTF_HPP
+#define OUZEL_FORMATS_GLTF_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "JsonDocument.hpp"
+#include "../graphics/Vertex.hpp"
+#include "../math/Box.hpp"
+#include "../math/Color.hpp"
+#include "../math/Matrix.hpp"
+#include "../math/Quaternion.hpp"
+#include "../utils/Span.hpp"
+
+namespace ouzel::gltf
+{
+    class ParseError final: public std::logic_error
+    {
+    public:
+        explicit ParseError(const std::string& str): std::logic_error(str) {}
+        explicit ParseError(const char* str): std::logic_error(str) {}
+    };
+
+    constexpr std::uint32_t glbMagic = 0x46546C67; // "glTF"
+    constexpr std::uint32_t jsonChunkType = 0x4E4F534A; // "JSON"
+    constexpr std::uint32_t binaryChunkType = 0x004E4942; // "BIN\0"
+
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    enum class ComponentType: std::uint32_t
+    {
+        byte = 5120,
+        unsignedByte = 5121,
+        shortInt = 5122,
+        unsignedShort = 5123,
+        unsignedInt = 5125,
+        floatingPoint = 5126
+    };
+
+    // Typed view of the elements of a buffer, the data is not copied
+    class Accessor final
+    {
+    public:
+        const std::byte* data = nullptr;
+        std::size_t count = 0;
+        std::size_t stride = 0;
+        ComponentType componentType = ComponentType::floatingPoint;
+        std::size_t componentCount = 1;
+        bool normalized = false;
+    };
+
+    // The JSON part of a glTF file and its buffers, both point into the parsed data
+    // whenever possible, only data URIs and external files are copied
+    class Document final
+    {
+    public:
+        json::Document json;
+        std::vector<Span<const std::byte>> buffers;
+        std::vector<std::vector<std::byte>> ownedBuffers;
+
+        Span<const std::byte> getBufferView(std::size_t index) const;
+        Accessor getAccessor(std::size_t index) const;
+    };
+
+    class Node final
+    {
+    public:
+        std::string name;
+        std::size_t parent = none;
+        Vector<float, 3> translation;
+        Quaternion<float> rotation = Quaternion<float>::identity();
+        Vector<float, 3> scale{1.0F, 1.0F, 1.0F};
+        std::size_t mesh = none;
+        std::size_t skin = none;
+
+        Matrix<float, 4> getLocalTransform() const noexcept
+        {
+            Matrix<float, 4> result = Matrix<float, 4>::identity();
+            result.setTranslation(translation);
+
+            Matrix<float, 4> rotationMatrix;
+            rotationMatrix.setRotation(rotation);
+            result *= rotationMatrix;
+
+            Matrix<float, 4> scaleMatrix;
+            scaleMatrix.setScale(scale);
+            result *= scaleMatrix;
+
+            return result;
+        }
+    };
+
+    class Primitive final
+    {
+    public:
+        std::size_t node = none;
+        std::size_t material = none;
+        std::size_t skin = none;
+        Box<float, 3> boundingBox;
+        std::vector<graphics::Vertex> vertices;
+        std::vector<std::array<std::uint16_t, 4>> joints;
+        std::vector<std::array<float, 4>> weights;
+
+        std::uint32_t indexSize = 0;
+        std::uint32_t indexCount = 0;
+        Span<const std::byte> indexData; // points into the document or to convertedIndices
+        std::vector<std::byte> convertedIndices;
+    };
+
+    class Skin final
+    {
+    public:
+        std::vector<std::size_t> joints; // node indices
+        std::vector<Matrix<float, 4>> inverseBindMatrices;
+    };
+
+    class Channel final
+    {
+    public:
+        enum class Path
+        {
+            translation,
+            rotation,
+            scale
+        };
+
+        enum class Interpolation
+        {
+            linear,
+            step,
+            cubicSpline
+        };
+
+        std::size_t node = none;
+        Path path = Path::translation;
+        Interpolation interpolation = Interpolation::linear;
+        std::vector<float> times;
+        std::vector<float> values;
+    };
+
+    class Animation final
+    {
+    public:
+        std::string name;
+        float duration = 0.0F;
+        std::vector<Channel> channels;
+    };
+
+    class Material final
+    {
+    public:
+        std::string name;
+        Color baseColor = Color::white();
+        float opacity = 1.0F;
+        std::size_t baseColorImage = none;
+        bool doubleSided = false;
+        bool blend = false;
+    };
+
+    class Image final
+    {
+    public:
+        std::string uri; // empty if the image is stored in a buffer view
+        Span<const std::byte> data;
+        std::string mimeType;
+    };
+
+    // Geometry of the default scene, the unskinned primitives are transformed by their nodes
+    class Model final
+    {
+    public:
+        std::vector<Node> nodes;
+        std::vector<Primitive> primitives;
+        std::vector<Skin> skins;
+        std::vector<Animation> animations;
+        std::vector<Material> materials;
+        std::vector<Image> images;
+    };
+
+    using FileReader = std::function<std::vector<std::byte>(const std::string&)>;
+
+    inline namespace detail
+    {
+        inline std::uint32_t readUint32(const std::byte* data) noexcept
+        {
+            return static_cast<std::uint32_t>(data[0]) |
+                (static_cast<std::uint32_t>(data[1]) << 8) |
+                (static_cast<std::uint32_t>(data[2]) << 16) |
+                (static_cast<std::uint32_t>(data[3]) << 24);
+        }
+
+        inline std::vector<std::byte> decodeBase64(const char* iterator, const char* end)
+        {
+            std::vector<std::byte> result;
+            result.reserve(static_cast<std::size_t>(end - iterator) / 4 * 3);
+
+            std::uint32_t bits = 0;
+            std::uint32_t bitCount = 0;
+
+            for (; iterator != end && *iterator != '='; ++iterator)
+            {
+                const auto c = *iterator;
+                std::uint32_t value;
+
+                if (c >= 'A' && c <= 'Z') value = static_cast<std::uint32_t>(c - 'A');
+                else if (c >= 'a' && c <= 'z') value = static_cast<std::uint32_t>(c - 'a' + 26);
+                else if (c >= '0' && c <= '9') value = static_cast<std::uint32_t>(c - '0' + 52);
+                else if (c == '+') value = 62;
+                else if (c == '/') value = 63;
+                else throw ParseError("Invalid base64 data");
+
+                bits = (bits << 6) | value;
+                bitCount += 6;
+
+                if (bitCount >= 8)
+                {
+                    bitCount -= 8;
+                    result.push_back(static_cast<std::byte>((bits >> bitCount) & 0xFFU));
+                }
+            }
+
+            return result;
+        }
+
+        // Returns false if the URI refers to a file
+        inline bool decodeDataUri(const std::string& uri, std::vector<std::byte>& result)
+        {
+            if (uri.compare(0, 5, "data:") != 0) return false;
+
+            const auto comma = uri.find(',');
+            if (comma == std::string::npos || comma < 7 || uri.compare(comma - 7, 7, ";base64") != 0)
+                throw ParseError("Only base64 data URIs are supported");
+
+            result = decodeBase64(uri.data() + comma + 1, uri.data() + uri.size());
+            return true;
+        }
+
+        inline std::size_t getComponentSize(ComponentType componentType)
+        {
+            switch (componentType)
+            {
+                case ComponentType::byte: return 1;
+                case ComponentType::unsignedByte: return 1;
+                case ComponentType::shortInt: return 2;
+                case ComponentType::unsignedShort: return 2;
+                case ComponentType::unsignedInt: return 4;
+                case ComponentType::floatingPoint: return 4;
+                default: throw ParseError("Invalid component type");
+            }
+        }
+
+        inline std::size_t getComponentCount(const std::string& type)
+        {
+            if (type == "SCALAR") return 1;
+            else if (type == "VEC2") return 2;
+            else if (type == "VEC3") return 3;
+            else if (type == "VEC4") return 4;
+            else if (type == "MAT2") return 4;
+            else if (type == "MAT3") return 9;
+            else if (type == "MAT4") return 16;
+            else throw ParseError("Invalid accessor type " + type);
+        }
+
+        template <class T>
+        T getMember(const json::Element& value, std::string_view member, T defaultValue)
+        {
+            return value.hasMember(member) ? value[member].as<T>() : defaultValue;
+        }
+
+        template <class T, bool normalized>
+        float convertComponent(const std::byte* data) noexcept
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+
+            if constexpr (normalized && std::is_integral_v<T>)
+                return std::max(static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max()), -1.0F);
+            else
+                return static_cast<float>(value);
+        }
+
+        template <class T, bool normalized, class Function>
+        void forEachElement(const Accessor& accessor, Function function)
+        {
+            float values[16];
+            const auto componentCount = accessor.componentCount;
+
+            auto data = accessor.data;
+            for (std::size_t i = 0; i < accessor.count; ++i, data += accessor.stride)
+            {
+                for (std::size_t c = 0; c < componentCount; ++c)
+                    values[c] = convertComponent<T, normalized>(data + c * sizeof(T));
+
+                function(i, values);
+            }
+        }
+
+        template <bool normalized, class Function>
+        void forEachElement(const Accessor& accessor, Function function)
+        {
+            switch (accessor.componentType)
+            {
+                case ComponentType::byte: forEachElement<std::int8_t, normalized>(accessor, function); break;
+                case ComponentType::unsignedByte: forEachElement<std::uint8_t, normalized>(accessor, function); break;
+                case ComponentType::shortInt: forEachElement<std::int16_t, normalized>(accessor, function); break;
+                case ComponentType::unsignedShort: forEachElement<std::uint16_t, normalized>(accessor, function); break;
+                case ComponentType::unsignedInt: forEachElement<std::uint32_t, normalized>(accessor, function); break;
+                case ComponentType::floatingPoint: forEachElement<float, false>(accessor, function); break;
+            }
+        }
+    }
+
+    // Calls the function with the index and the components of every element converted to float,
+    // the type dispatch is done once per accessor, not per element
+    template <class Function>
+    void forEachElement(const Accessor& accessor, Function function)
+    {
+        if (accessor.normalized)
+            forEachElement<true>(accessor, function);
+        else
+            forEachElement<false>(accessor, function);
+    }
+
+    inline Span<const std::byte> Document::getBufferView(std::size_t index) const
+    {
+        const auto& bufferView = json.getRoot()["bufferViews"][index];
+
+        const auto buffer = bufferView["buffer"].as<std::size_t>();
+        if (buffer >= buffers.size())
+            throw ParseError("Invalid buffer index");
+
+        const auto offset = getMember<std::size_t>(bufferView, "byteOffset", 0);
+        const auto length = bufferView["byteLength"].as<std::size_t>();
+
+        if (offset > buffers[buffer].size() || length > buffers[buffer].size() - offset)
+            throw ParseError("Buffer view out of range");
+
+        return Span<const std::byte>{buffers[buffer].data() + offset, length};
+    }
+
+    inline Accessor Document::getAccessor(std::size_t index) const
+    {
+        const auto& accessorValue = json.getRoot()["accessors"][index];
+
+        if (accessorValue.hasMember("sparse"))
+            throw ParseError("Sparse accessors are not supported");
+        if (!accessorValue.hasMember("bufferView"))
+            throw ParseError("Accessors without a buffer view are not supported");
+
+        Accessor accessor;
+        accessor.count = accessorValue["count"].as<std::size_t>();
+        accessor.componentType = static_cast<ComponentType>(accessorValue["componentType"].as<std::uint32_t>());
+        accessor.componentCount = getComponentCount(accessorValue["type"].as<std::string>());
+        accessor.normalized = getMember<bool>(accessorValue, "normalized", false);
+
+        const auto bufferViewIndex = accessorValue["bufferView"].as<std::size_t>();
+        const auto bufferView = getBufferView(bufferViewIndex);
+        const auto elementSize = getComponentSize(accessor.componentType) * accessor.componentCount;
+
+        accessor.stride = getMember<std::size_t>(json.getRoot()["bufferViews"][bufferViewIndex], "byteStride", elementSize);
+        if (accessor.stride < elementSize)
+            throw ParseError("Invalid byte stride");
+
+        const auto offset = getMember<std::size_t>(accessorValue, "byteOffset", 0);
+        if (accessor.count != 0 &&
+            (offset > bufferView.size() ||
+             (accessor.count - 1) * accessor.stride + elementSize > bufferView.size() - offset))
+            throw ParseError("Accessor out of range");
+
+        accessor.data = bufferView.data() + offset;
+
+        return accessor;
+    }
+
+    // Splits a GLB file into the JSON and the binary chunk, a .gltf file is plain JSON
+    inline Document parse(Span<const std::byte> data, const FileReader& readFile = nullptr)
+    {
+        Document result;
+        Span<const std::byte> binaryChunk;
+
+        if (data.size() >= 12 && readUint32(data.data()) == glbMagic)
+        {
+            if (readUint32(data.data() + 4) != 2)
+                throw ParseError("Unsupported glTF version");
+
+            const auto length = std::min(static_cast<std::size_t>(readUint32(data.data() + 8)), data.size());
+            std::size_t offset = 12;
+            bool hasJson = false;
+
+            while (offset + 8 <= length)
+            {
+                const auto chunkLength = static_cast<std::size_t>(readUint32(data.data() + offset));
+                const auto chunkType = readUint32(data.data() + offset + 4);
+                offset += 8;
+
+                if (chunkLength > length - offset)
+                    throw ParseError("Invalid chunk length");
+
+                const Span<const std::byte> chunk{data.data() + offset, chunkLength};
+
+                if (chunkType == jsonChunkType && !hasJson)
+                {
+                    result.json = json::parseDocument(chunk);
+                    hasJson = true;
+                }
+                else if (chunkType == binaryChunkType && binaryChunk.empty())
+                    binaryChunk = chunk;
+
+                // the chunks are aligned to four bytes
+                offset += (chunkLength + 3) & ~std::size_t{3};
+            }
+
+            if (!hasJson)
+                throw ParseError("GLB file has no JSON chunk");
+        }
+        else
+            result.json = json::parseDocument(data);
+
+        if (result.json.getRoot().hasMember("buffers"))
+            for (const auto& bufferValue : result.json.getRoot()["buffers"])
+            {
+                const auto byteLength = bufferValue["byteLength"].as<std::size_t>();
+
+                if (!bufferValue.hasMember("uri"))
+                {
+                    // the first buffer without an URI is the binary chunk of a GLB file
+                    if (binaryChunk.size() < byteLength || !result.buffers.empty())
+                        throw ParseError("Invalid binary chunk");
+
+                    result.buffers.push_back(binaryChunk);
+                    continue;
+                }
+
+                const auto& uri = bufferValue["uri"].as<std::string>();
+                std::vector<std::byte> bufferData;
+
+                if (!decodeDataUri(uri, bufferData))
+                {
+                    if (!readFile)
+                        throw ParseError("External buffers are not supported");
+                    bufferData = readFile(uri);
+                }
+
+                if (bufferData.size() < byteLength)
+                    throw ParseError("Buffer is too short");
+
+                result.ownedBuffers.push_back(std::move(bufferData));
+                result.buffers.emplace_back(result.ownedBuffers.back().data(), byteLength);
+            }
+
+        return result;
+    }
+
+    inline namespace detail
+    {
+        inline void readIndices(const Document& document, const json::Element& primitiveValue,
+                                std::size_t vertexCount, Primitive& primitive)
+        {
+            const auto mode = getMember<std::uint32_t>(primitiveValue, "mode", 4);
+
+            std::vector<std::uint32_t> indices;
+            Accessor accessor;
+
+            if (primitiveValue.hasMember("indices"))
+            {
+                accessor = document.getAccessor(primitiveValue["indices"].as<std::size_t>());
+                if (accessor.componentCount != 1)
+                    throw ParseError("Invalid index accessor");
+
+                const auto componentSize = getComponentSize(accessor.componentType);
+
+                // 16 and 32-bit triangle lists are uploaded straight from the buffer
+                if (mode == 4 && accessor.stride == componentSize &&
+                    (accessor.componentType == ComponentType::unsignedShort ||
+                     accessor.componentType == ComponentType::unsignedInt))
+                {
+                    primitive.indexSize = static_cast<std::uint32_t>(componentSize);
+                    primitive.indexCount = static_cast<std::uint32_t>(accessor.count);
+                    primitive.indexData = Span<const std::byte>{accessor.data, accessor.count * componentSize};
+                    return;
+                }
+
+                indices.reserve(accessor.count);
+                forEachElement(accessor, [&indices](std::size_t, const float* values) {
+                    indices.push_back(static_cast<std::uint32_t>(values[0]));
+                });
+            }
+            else
+            {
+                indices.resize(vertexCount);
+                for (std::size_t i = 0; i < vertexCount; ++i)
+                    indices[i] = static_cast<std::uint32_t>(i);
+            }
+
+            // convert the triangle strips and fans to lists
+            if (mode == 5 || mode == 6)
+            {
+                std::vector<std::uint32_t> triangles;
+                for (std::size_t i = 2; i < indices.size(); ++i)
+                    if (mode == 5)
+                    {
+                        const bool odd = (i % 2) != 0;
+                        triangles.insert(triangles.end(), {indices[i - 2], indices[odd ? i : i - 1], indices[odd ? i - 1 : i]});
+                    }
+                    else
+                        triangles.insert(triangles.end(), {indices[0], indices[i - 1], indices[i]});
+
+                indices = std::move(triangles);
+            }
+            else if (mode != 4)
+                throw ParseError("Only triangle primitives are supported");
+
+            for (const auto index : indices)
+                if (index >= vertexCount)
+                    throw ParseError("Index out of range");
+
+            primitive.indexCount = static_cast<std::uint32_t>(indices.size());
+
+            if (vertexCount <= std::numeric_limits<std::uint16_t>::max() + 1U)
+            {
+                primitive.indexSize = sizeof(std::uint16_t);
+                primitive.convertedIndices.resize(indices.size() * sizeof(std::uint16_t));
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    const auto index = static_cast<std::uint16_t>(indices[i]);
+                    std::memcpy(primitive.convertedIndices.data() + i * sizeof(index), &index, sizeof(index));
+                }
+            }
+            else
+            {
+                primitive.indexSize = sizeof(std::uint32_t);
+                primitive.convertedIndices.resize(indices.size() * sizeof(std::uint32_t));
+                std::memcpy(primitive.convertedIndices.data(), indices.data(), primitive.convertedIndices.size());
+            }
+
+            primitive.indexData = Span<const std::byte>{primitive.convertedIndices.data(), primitive.convertedIndices.size()};
+        }
+
+        inline Primitive readPrimitive(const Document& document, const json::Element& primitiveValue,
+                                       const Node& node, std::size_t nodeIndex, const Matrix<float, 4>& transform)
+        {
+            const auto& attributes = primitiveValue["attributes"];
+
+            Primitive primitive;
+            primitive.node = nodeIndex;
+            primitive.skin = node.skin;
+            primitive.material = getMember<std::size_t>(primitiveValue, "material", none);
+
+            const auto positions = document.getAccessor(attributes["POSITION"].as<std::size_t>());
+            if (positions.componentCount != 3)
+                throw ParseError("Invalid position accessor");
+
+            auto& vertices = primitive.vertices;
+            vertices.resize(positions.count);
+
+            // the skinned primitives are transformed by their joints
+            const bool transformed = node.skin == none;
+            const auto normalMatrix = [&transform]() {
+                Matrix<float, 4> result = transform;
+                result.invert();
+                result.transpose();
+                return result;
+            }();
+
+            forEachElement(positions, [&vertices, &primitive, &transform, transformed](std::size_t i, const float* values) {
+                auto& vertex = vertices[i];
+                vertex.position = Vector<float, 3>{values[0], values[1], values[2]};
+                if (transformed) transform.transformPoint(vertex.position);
+                vertex.color = Color::white();
+                primitive.boundingBox.insertPoint(vertex.position);
+            });
+
+            const auto checkCount = [&positions](const Accessor& accessor) {
+                if (accessor.count != positions.count)
+                    throw ParseError("Attribute count does not match the vertex count");
+            };
+
+            if (attributes.hasMember("NORMAL"))
+            {
+                const auto normals = document.getAccessor(attributes["NORMAL"].as<std::size_t>());
+                checkCount(normals);
+
+                forEachElement(normals, [&vertices, &normalMatrix, transformed](std::size_t i, const float* values) {
+                    auto& normal = vertices[i].normal;
+                    normal = Vector<float, 3>{values[0], values[1], values[2]};
+                    if (transformed)
+                    {
+                        normalMatrix.transformVector(normal);
+                        normal.normalize();
+                    }
+                });
+            }
+
+            if (attributes.hasMember("TEXCOORD_0"))
+            {
+                const auto texCoords = document.getAccessor(attributes["TEXCOORD_0"].as<std::size_t>());
+                checkCount(texCoords);
+
+                forEachElement(texCoords, [&vertices](std::size_t i, const float* values) {
+                    vertices[i].texCoords[0] = Vector<float, 2>{values[0], values[1]};
+                });
+            }
+
+            if (attributes.hasMember("TEXCOORD_1"))
+            {
+                const auto texCoords = document.getAccessor(attributes["TEXCOORD_1"].as<std::size_t>());
+                checkCount(texCoords);
+
+                forEachElement(texCoords, [&vertices](std::size_t i, const float* values) {
+                    vertices[i].texCoords[1] = Vector<float, 2>{values[0], values[1]};
+                });
+            }
+
+            if (attributes.hasMember("COLOR_0"))
+            {
+                const auto colors = document.getAccessor(attributes["COLOR_0"].as<std::size_t>());
+                checkCount(colors);
+
+                const auto hasAlpha = colors.componentCount == 4;
+                forEachElement(colors, [&vertices, hasAlpha](std::size_t i, const float* values) {
+                    vertices[i].color = Color{values[0], values[1], values[2], hasAlpha ? values[3] : 1.0F};
+                });
+            }
+
+            if (attributes.hasMember("JOINTS_0") && attributes.hasMember("WEIGHTS_0"))
+            {
+                const auto joints = document.getAccessor(attributes["JOINTS_0"].as<std::size_t>());
+                const auto weights = document.getAccessor(attributes["WEIGHTS_0"].as<std::size_t>());
+                checkCount(joints);
+                checkCount(weights);
+
+                if (joints.componentCount != 4 || weights.componentCount != 4)
+                    throw ParseError("Invalid skin accessor");
+
+                primitive.joints.resize(joints.count);
+                forEachElement(joints, [&primitive](std::size_t i, const float* values) {
+                    for (std::size_t c = 0; c < 4; ++c)
+                        primitive.joints[i][c] = static_cast<std::uint16_t>(values[c]);
+                });
+
+                primitive.weights.resize(weights.count);
+                forEachElement(weights, [&primitive](std::size_t i, const float* values) {
+                    for (std::size_t c = 0; c < 4; ++c)
+                        primitive.weights[i][c] = values[c];
+                });
+            }
+
+            readIndices(document, primitiveValue, vertices.size(), primitive);
+
+            return primitive;
+        }
+
+        inline std::vector<float> readFloats(const Document& document, std::size_t accessorIndex)
+        {
+            const auto accessor = document.getAccessor(accessorIndex);
+
+            std::vector<float> result(accessor.count * accessor.componentCount);
+            forEachElement(accessor, [&result, &accessor](std::size_t i, const float* values) {
+                std::copy(values, values + accessor.componentCount, result.begin() + static_cast<std::ptrdiff_t>(i * accessor.componentCount));
+            });
+
+            return result;
+        }
+    }
+
+    inline Model load(const Document& document)
+    {
+        const auto& json = document.json.getRoot();
+
+        Model model;
+
+        if (json.hasMember("nodes"))
+            for (const auto& nodeValue : json["nodes"])
+            {
+                Node node;
+                node.name = getMember<std::string>(nodeValue, "name", {});
+                node.mesh = getMember<std::size_t>(nodeValue, "mesh", none);
+                node.skin = getMember<std::size_t>(nodeValue, "skin", none);
+
+                if (nodeValue.hasMember("matrix"))
+                {
+                    // glTF matrices are column-major, which is the memory layout of Matrix
+                    Matrix<float, 4> matrix;
+                    for (std::size_t i = 0; i < 16; ++i)
+                        matrix.m[i] = nodeValue["matrix"][i].as<float>();
+
+                    node.translation = matrix.getTranslation();
+                    node.scale = matrix.getScale();
+                    node.rotation = matrix.getRotation();
+                }
+                else
+                {
+                    if (nodeValue.hasMember("translation"))
+                        for (std::size_t i = 0; i < 3; ++i)
+                            node.translation.v[i] = nodeValue["translation"][i].as<float>();
+
+                    if (nodeValue.hasMember("rotation"))
+                        for (std::size_t i = 0; i < 4; ++i)
+                            node.rotation.v[i] = nodeValue["rotation"][i].as<float>();
+
+                    if (nodeValue.hasMember("scale"))
+                        for (std::size_t i = 0; i < 3; ++i)
+                            node.scale.v[i] = nodeValue["scale"][i].as<float>();
+                }
+
+                model.nodes.push_back(node);
+            }
+
+        for (std::size_t i = 0; i < model.nodes.size(); ++i)
+        {
+            const auto& nodeValue = json["nodes"][i];
+            if (nodeValue.hasMember("children"))
+                for (const auto& child : nodeValue["children"])
+                {
+                    const auto childIndex = child.as<std::size_t>();
+                    if (childIndex >= model.nodes.size() || model.nodes[childIndex].parent != none)
+                        throw ParseError("Invalid node hierarchy");
+                    model.nodes[childIndex].parent = i;
+                }
+        }
+
+        if (json.hasMember("skins"))
+            for (const auto& skinValue : json["skins"])
+            {
+                Skin skin;
+                for (const auto& joint : skinValue["joints"])
+                {
+                    const auto jointIndex = joint.as<std::size_t>();
+                    if (jointIndex >= model.nodes.size())
+                        throw ParseError("Invalid joint index");
+                    skin.joints.push_back(jointIndex);
+                }
+
+                skin.inverseBindMatrices.resize(skin.joints.size(), Matrix<float, 4>::identity());
+
+                if (skinValue.hasMember("inverseBindMatrices"))
+                {
+                    const auto matrices = document.getAccessor(skinValue["inverseBindMatrices"].as<std::size_t>());
+                    if (matrices.componentCount != 16 || matrices.count < skin.joints.size())
+                        throw ParseError("Invalid inverse bind matrices");
+
+                    forEachElement(matrices, [&skin](std::size_t i, const float* values) {
+                        if (i < skin.inverseBindMatrices.size())
+                            std::copy(values, values + 16, skin.inverseBindMatrices[i].m.begin());
+                    });
+                }
+
+                model.skins.push_back(std::move(skin));
+            }
+
+        if (json.hasMember("images"))
+            for (const auto& imageValue : json["images"])
+            {
+                Image image;
+                image.mimeType = getMember<std::string>(imageValue, "mimeType", {});
+
+                if (imageValue.hasMember("bufferView"))
+                    image.data = document.getBufferView(imageValue["bufferView"].as<std::size_t>());
+                else
+                    image.uri = imageValue["uri"].as<std::string>();
+
+                model.images.push_back(std::move(image));
+            }
+
+        if (json.hasMember("materials"))
+            for (const auto& materialValue : json["materials"])
+            {
+                Material material;
+                material.name = getMember<std::string>(materialValue, "name", {});
+                material.doubleSided = getMember<bool>(materialValue, "doubleSided", false);
+                material.blend = getMember<std::string>(materialValue, "alphaMode", "OPAQUE") == "BLEND";
+
+                if (materialValue.hasMember("pbrMetallicRoughness"))
+                {
+                    const auto& pbrValue = materialValue["pbrMetallicRoughness"];
+
+                    if (pbrValue.hasMember("baseColorFactor"))
+                    {
+                        const auto& factor = pbrValue["baseColorFactor"];
+                        material.baseColor = Color{factor[0].as<float>(), factor[1].as<float>(), factor[2].as<float>(), 1.0F};
+                        material.opacity = factor[3].as<float>();
+                    }
+
+                    if (pbrValue.hasMember("baseColorTexture"))
+                    {
+                        const auto& textureValue = json["textures"][pbrValue["baseColorTexture"]["index"].as<std::size_t>()];
+                        material.baseColorImage = getMember<std::size_t>(textureValue, "source", none);
+                        if (material.baseColorImage != none && material.baseColorImage >= model.images.size())
+                            throw ParseError("Invalid image index");
+                    }
+                }
+
+                model.materials.push_back(std::move(material));
+            }
+
+        if (json.hasMember("animations"))
+            for (const auto& animationValue : json["animations"])
+            {
+                Animation animation;
+                animation.name = getMember<std::string>(animationValue, "name", {});
+
+                const auto& samplers = animationValue["samplers"];
+
+                for (const auto& channelValue : animationValue["channels"])
+                {
+                    const auto& target = channelValue["target"];
+                    if (!target.hasMember("node")) continue;
+
+                    Channel channel;
+                    channel.node = target["node"].as<std::size_t>();
+                    if (channel.node >= model.nodes.size())
+                        throw ParseError("Invalid animation target");
+
+                    const auto& path = target["path"].as<std::string>();
+                    if (path == "translation") channel.path = Channel::Path::translation;
+                    else if (path == "rotation") channel.path = Channel::Path::rotation;
+                    else if (path == "scale") channel.path = Channel::Path::scale;
+                    else continue; // morph target weights are not supported
+
+                    const auto& samplerValue = samplers[channelValue["sampler"].as<std::size_t>()];
+                    const auto interpolation = getMember<std::string>(samplerValue, "interpolation", "LINEAR");
+                    if (interpolation == "STEP") channel.interpolation = Channel::Interpolation::step;
+                    else if (interpolation == "CUBICSPLINE") channel.interpolation = Channel::Interpolation::cubicSpline;
+
+                    channel.times = readFloats(document, samplerValue["input"].as<std::size_t>());
+                    channel.values = readFloats(document, samplerValue["output"].as<std::size_t>());
+
+                    if (!channel.times.empty())
+                        animation.duration = std::max(animation.duration, channel.times.back());
+
+                    animation.channels.push_back(std::move(channel));
+                }
+
+                model.animations.push_back(std::move(animation));
+            }
+
+        // the nodes of the default scene or all root nodes
+        std::vector<std::size_t> roots;
+        if (json.hasMember("scenes") && json["scenes"].getSize() > 0)
+        {
+            const auto& sceneValue = json["scenes"][getMember<std::size_t>(json, "scene", 0)];
+            if (sceneValue.hasMember("nodes"))
+                for (const auto& node : sceneValue["nodes"])
+                    roots.push_back(node.as<std::size_t>());
+        }
+        else
+            for (std::size_t i = 0; i < model.nodes.size(); ++i)
+                if (model.nodes[i].parent == none) roots.push_back(i);
+
+        class Entry final
+        {
+        public:
+            std::size_t node;
+            Matrix<float, 4> transform;
+        };
+
+        std::vector<Entry> stack;
+        for (auto i = roots.rbegin(); i != roots.rend(); ++i)
+        {
+            if (*i >= model.nodes.size())
+                throw ParseError("Invalid node index");
+            stack.push_back(Entry{*i, model.nodes[*i].getLocalTransform()});
+        }
+
+        while (!stack.empty())
+        {
+            const auto entry = stack.back();
+            stack.pop_back();
+
+            const auto& node = model.nodes[entry.node];
+
+            if (node.mesh != none)
+                for (const auto& primitiveValue : json["meshes"][node.mesh]["primitives"])
+                {
+                    auto primitive = readPrimitive(document, primitiveValue, node, entry.node, entry.transform);
+                    if (primitive.material != none && primitive.material >= model.materials.size())
+                        throw ParseError("Invalid material index");
+                    if (primitive.skin != none && primitive.skin >= model.skins.size())
+                        throw ParseError("Invalid skin index");
+                    model.primitives.push_back(std::move(primitive));
+                }
+
+            const auto& nodeValue = json["nodes"][entry.node];
+            if (nodeValue.hasMember("children"))
+            {
+                const auto& children = nodeValue["children"];
+                for (std::size_t i = children.getSize(); i > 0; --i)
+                {
+                    const auto child = children[i - 1].as<std::size_t>();
+                    stack.push_back(Entry{child, entry.transform * model.nodes[child].getLocalTransform()});
+                }
+            }
+        }
+
+        return model;
+    }
+}
+
+#endif // OUZEL_FORMATS_GLTF_HPP
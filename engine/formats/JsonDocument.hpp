@@ -0,0 +1,673 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_FORMATS_JSONDOCUMENT_HPP
+#define OUZEL_FORMATS_JSONDOCUMENT_HPP
+
+#if defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#elif defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Json.hpp"
+#include "../utils/Span.hpp"
+
+namespace ouzel::json
+{
+    class Member;
+
+    // Read-only JSON value owned by a Document, strings are views of the input or of the document arena
+    class Element final
+    {
+    public:
+        using Type = Value::Type;
+
+        Type getType() const noexcept { return type; }
+        bool isNull() const noexcept { return type == Type::null; }
+
+        template <typename T, typename std::enable_if_t<std::is_same_v<T, std::string_view>>* = nullptr>
+        T as() const
+        {
+            if (type != Type::string) throw TypeError("Wrong type");
+            return std::string_view{stringValue, size};
+        }
+
+        template <typename T, typename std::enable_if_t<std::is_same_v<T, std::string>>* = nullptr>
+        T as() const
+        {
+            if (type != Type::string) throw TypeError("Wrong type");
+            return std::string{stringValue, size};
+        }
+
+        template <typename T, typename std::enable_if_t<std::is_same_v<T, bool>>* = nullptr>
+        T as() const
+        {
+            if (type == Type::boolean) return boolValue;
+            else if (type == Type::number) return numberValue != 0.0;
+            else throw TypeError("Wrong type");
+        }
+
+        template <typename T, typename std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>* = nullptr>
+        T as() const
+        {
+            if (type == Type::number) return static_cast<T>(numberValue);
+            else if (type == Type::boolean) return boolValue;
+            else throw TypeError("Wrong type");
+        }
+
+        const Element* begin() const
+        {
+            if (type != Type::array) throw TypeError("Wrong type");
+            return elements;
+        }
+
+        const Element* end() const
+        {
+            if (type != Type::array) throw TypeError("Wrong type");
+            return elements + size;
+        }
+
+        // The number of elements of an array or members of an object
+        std::size_t getSize() const
+        {
+            if (type != Type::array && type != Type::object) throw TypeError("Wrong type");
+            return size;
+        }
+
+        // The members are sorted by their keys
+        Span<const Member> getMembers() const
+        {
+            if (type != Type::object) throw TypeError("Wrong type");
+            return Span<const Member>{members, size};
+        }
+
+        // Returns nullptr if the member does not exist
+        const Element* find(std::string_view member) const;
+
+        bool hasMember(std::string_view member) const
+        {
+            if (type != Type::object) throw TypeError("Wrong type");
+            return find(member) != nullptr;
+        }
+
+        const Element& operator[](std::string_view member) const
+        {
+            if (type != Type::object) throw TypeError("Wrong type");
+
+            if (const auto element = find(member))
+                return *element;
+            else
+                throw RangeError("Member does not exist");
+        }
+
+        const Element& operator[](std::size_t index) const
+        {
+            if (type != Type::array) throw TypeError("Wrong type");
+
+            if (index < size)
+                return elements[index];
+            else
+                throw RangeError("Index out of range");
+        }
+
+    private:
+        friend class DocumentParser;
+
+        Type type = Type::null;
+        std::uint32_t size = 0;
+        union
+        {
+            bool boolValue = false;
+            double numberValue;
+            const char* stringValue;
+            const Element* elements;
+            const Member* members;
+        };
+    };
+
+    class Member final
+    {
+    public:
+        std::string_view key;
+        Element value;
+    };
+
+    inline const Element* Element::find(std::string_view member) const
+    {
+        if (type != Type::object) return nullptr;
+
+        const auto membersEnd = members + size;
+        const auto i = std::lower_bound(members, membersEnd, member,
+                                        [](const Member& m, std::string_view key) noexcept {
+                                            return m.key < key;
+                                        });
+
+        return (i != membersEnd && i->key == member) ? &i->value : nullptr;
+    }
+
+    inline namespace detail
+    {
+        // Bump allocator for trivially destructible data, the blocks are freed together
+        class Arena final
+        {
+        public:
+            explicit Arena(std::size_t initBlockSize = 4096) noexcept:
+                blockSize{initBlockSize}
+            {
+            }
+
+            template <class T>
+            T* allocate(std::size_t count)
+            {
+                static_assert(std::is_trivially_destructible_v<T>);
+
+                const auto bytes = count * sizeof(T);
+                auto padding = (alignof(T) - reinterpret_cast<std::uintptr_t>(current) % alignof(T)) % alignof(T);
+
+                if (bytes + padding > remaining)
+                {
+                    const auto size = std::max(blockSize, bytes + alignof(T));
+                    blocks.push_back(std::make_unique<std::byte[]>(size));
+                    current = blocks.back().get();
+                    remaining = size;
+                    totalSize += size;
+                    padding = (alignof(T) - reinterpret_cast<std::uintptr_t>(current) % alignof(T)) % alignof(T);
+                    blockSize *= 2;
+                }
+
+                const auto result = reinterpret_cast<T*>(current + padding);
+                current += padding + bytes;
+                remaining -= padding + bytes;
+                return result;
+            }
+
+            std::size_t getSize() const noexcept { return totalSize; }
+
+        private:
+            std::vector<std::unique_ptr<std::byte[]>> blocks;
+            std::byte* current = nullptr;
+            std::size_t remaining = 0;
+            std::size_t blockSize;
+            std::size_t totalSize = 0;
+        };
+
+        constexpr bool isWhitespace(const char c) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        inline const char* skipWhitespaces(const char* iterator, const char* end) noexcept
+        {
+            // values are usually separated by at most one character of whitespace
+            if (iterator == end || !isWhitespace(*iterator)) return iterator;
+            if (++iterator == end || !isWhitespace(*iterator)) return iterator;
+
+#if defined(__ARM_NEON__)
+            while (end - iterator >= 16)
+            {
+                const auto chars = vld1q_u8(reinterpret_cast<const std::uint8_t*>(iterator));
+                const auto whitespace = vorrq_u8(vorrq_u8(vceqq_u8(chars, vdupq_n_u8(' ')),
+                                                          vceqq_u8(chars, vdupq_n_u8('\n'))),
+                                                 vorrq_u8(vceqq_u8(chars, vdupq_n_u8('\r')),
+                                                          vceqq_u8(chars, vdupq_n_u8('\t'))));
+                // four bits per character
+                const auto mask = ~vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(whitespace), 4)), 0);
+                if (mask) return iterator + (__builtin_ctzll(mask) >> 2);
+                iterator += 16;
+            }
+#elif defined(__SSE2__)
+            while (end - iterator >= 16)
+            {
+                const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iterator));
+                const auto whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')),
+                                                                  _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n'))),
+                                                     _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')),
+                                                                  _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t'))));
+                const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(whitespace)) ^ 0xFFFFU;
+                if (mask) return iterator + __builtin_ctz(mask);
+                iterator += 16;
+            }
+#endif
+
+            while (iterator != end && isWhitespace(*iterator)) ++iterator;
+            return iterator;
+        }
+
+        // Returns the first quote, backslash or control character
+        inline const char* findStringEnd(const char* iterator, const char* end) noexcept
+        {
+#if defined(__ARM_NEON__)
+            while (end - iterator >= 16)
+            {
+                const auto chars = vld1q_u8(reinterpret_cast<const std::uint8_t*>(iterator));
+                const auto special = vorrq_u8(vorrq_u8(vceqq_u8(chars, vdupq_n_u8('"')),
+                                                       vceqq_u8(chars, vdupq_n_u8('\\'))),
+                                              vcltq_u8(chars, vdupq_n_u8(0x20)));
+                const auto mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+                if (mask) return iterator + (__builtin_ctzll(mask) >> 2);
+                iterator += 16;
+            }
+#elif defined(__SSE2__)
+            while (end - iterator >= 16)
+            {
+                const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iterator));
+                const auto control = _mm_cmpeq_epi8(_mm_min_epu8(chars, _mm_set1_epi8(0x1F)), chars);
+                const auto special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('"')),
+                                                               _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\'))),
+                                                  control);
+                const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(special));
+                if (mask) return iterator + __builtin_ctz(mask);
+                iterator += 16;
+            }
+#endif
+
+            while (iterator != end &&
+                   *iterator != '"' && *iterator != '\\' &&
+                   static_cast<std::uint8_t>(*iterator) > 0x1F)
+                ++iterator;
+            return iterator;
+        }
+
+        constexpr double powersOf10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+    }
+
+    class DocumentParser;
+
+    // JSON document with all of the elements allocated from one arena.
+    // Unescaped strings point into the parsed data, so it must outlive the document.
+    class Document final
+    {
+    public:
+        Document() = default;
+
+        Document(const Document&) = delete;
+        Document& operator=(const Document&) = delete;
+
+        Document(Document&&) noexcept = default;
+        Document& operator=(Document&&) noexcept = default;
+
+        const Element& getRoot() const noexcept { return root; }
+        std::size_t getArenaSize() const noexcept { return arena.getSize(); }
+
+    private:
+        friend class DocumentParser;
+
+        Element root;
+        Arena arena;
+    };
+
+    class DocumentParser final
+    {
+    public:
+        static Document parse(const char* begin, const char* end)
+        {
+            if (end - begin >= 3 &&
+                static_cast<std::uint8_t>(begin[0]) == utf8ByteOrderMark[0] &&
+                static_cast<std::uint8_t>(begin[1]) == utf8ByteOrderMark[1] &&
+                static_cast<std::uint8_t>(begin[2]) == utf8ByteOrderMark[2])
+                begin += 3;
+
+            Document document;
+            // the elements take about as much memory as the text
+            document.arena = Arena{std::max(static_cast<std::size_t>(end - begin), std::size_t{4096})};
+
+            DocumentParser parser{document.arena, end};
+            auto iterator = parser.parseValue(skipWhitespaces(begin, end), document.root);
+
+            if (skipWhitespaces(iterator, end) != end)
+                throw ParseError("Unexpected data");
+
+            return document;
+        }
+
+    private:
+        DocumentParser(Arena& initArena, const char* initEnd) noexcept:
+            arena{initArena}, end{initEnd}
+        {
+        }
+
+        const char* parseValue(const char* iterator, Element& result)
+        {
+            if (iterator == end)
+                throw ParseError("Unexpected end of data");
+
+            switch (*iterator)
+            {
+                case '{': return parseObject(iterator + 1, result);
+                case '[': return parseArray(iterator + 1, result);
+                case '"':
+                {
+                    std::string_view value;
+                    iterator = parseString(iterator, value);
+                    result.type = Element::Type::string;
+                    result.stringValue = value.data();
+                    result.size = static_cast<std::uint32_t>(value.size());
+                    return iterator;
+                }
+                case 't': return parseLiteral(iterator, "true", result, Element::Type::boolean, true);
+                case 'f': return parseLiteral(iterator, "false", result, Element::Type::boolean, false);
+                case 'n': return parseLiteral(iterator, "null", result, Element::Type::null, false);
+                default:
+                    if (*iterator == '-' || (*iterator >= '0' && *iterator <= '9'))
+                        return parseNumber(iterator, result);
+
+                    throw ParseError("Unexpected identifier");
+            }
+        }
+
+        const char* parseLiteral(const char* iterator, std::string_view literal,
+                                 Element& result, Element::Type type, bool value)
+        {
+            if (static_cast<std::size_t>(end - iterator) < literal.size() ||
+                std::string_view{iterator, literal.size()} != literal)
+                throw ParseError("Unexpected identifier");
+
+            result.type = type;
+            result.boolValue = value;
+            return iterator + literal.size();
+        }
+
+        const char* parseObject(const char* iterator, Element& result)
+        {
+            // the members of the nested values are pushed on the same stack and popped before this object is done
+            const auto first = memberStack.size();
+
+            iterator = skipWhitespaces(iterator, end);
+
+            if (iterator != end && *iterator != '}')
+                for (;;)
+                {
+                    if (iterator == end || *iterator != '"')
+                        throw ParseError("Invalid object");
+
+                    std::string_view key;
+                    iterator = skipWhitespaces(parseString(iterator, key), end);
+
+                    if (iterator == end || *iterator != ':')
+                        throw ParseError("Invalid object");
+
+                    Element value;
+                    iterator = skipWhitespaces(parseValue(skipWhitespaces(iterator + 1, end), value), end);
+                    memberStack.push_back(Member{key, value});
+
+                    if (iterator == end)
+                        throw ParseError("Invalid object");
+                    else if (*iterator == ',')
+                        iterator = skipWhitespaces(iterator + 1, end);
+                    else
+                        break;
+                }
+
+            if (iterator == end || *iterator != '}')
+                throw ParseError("Invalid object");
+
+            const auto membersBegin = memberStack.begin() + static_cast<std::ptrdiff_t>(first);
+            std::stable_sort(membersBegin, memberStack.end(), [](const Member& a, const Member& b) noexcept {
+                return a.key < b.key;
+            });
+
+            // the last of the duplicate keys wins
+            const auto count = static_cast<std::size_t>(std::distance(membersBegin, memberStack.end()));
+            const auto members = arena.allocate<Member>(count);
+            std::size_t size = 0;
+            for (auto i = membersBegin; i != memberStack.end(); ++i)
+                if (i + 1 == memberStack.end() || (i + 1)->key != i->key)
+                    members[size++] = *i;
+
+            memberStack.resize(first);
+
+            result.type = Element::Type::object;
+            result.members = members;
+            result.size = static_cast<std::uint32_t>(size);
+            return iterator + 1;
+        }
+
+        const char* parseArray(const char* iterator, Element& result)
+        {
+            const auto first = elementStack.size();
+
+            iterator = skipWhitespaces(iterator, end);
+
+            if (iterator != end && *iterator != ']')
+                for (;;)
+                {
+                    Element value;
+                    iterator = skipWhitespaces(parseValue(iterator, value), end);
+                    elementStack.push_back(value);
+
+                    if (iterator == end)
+                        throw ParseError("Invalid array");
+                    else if (*iterator == ',')
+                        iterator = skipWhitespaces(iterator + 1, end);
+                    else
+                        break;
+                }
+
+            if (iterator == end || *iterator != ']')
+                throw ParseError("Invalid array");
+
+            const auto count = elementStack.size() - first;
+            const auto elements = arena.allocate<Element>(count);
+            std::copy(elementStack.begin() + static_cast<std::ptrdiff_t>(first), elementStack.end(), elements);
+            elementStack.resize(first);
+
+            result.type = Element::Type::array;
+            result.elements = elements;
+            result.size = static_cast<std::uint32_t>(count);
+            return iterator + 1;
+        }
+
+        const char* parseNumber(const char* iterator, Element& result)
+        {
+            const auto numberBegin = iterator;
+            const bool negative = *iterator == '-';
+            if (negative) ++iterator;
+
+            if (iterator == end || *iterator < '0' || *iterator > '9')
+                throw ParseError("Invalid number");
+
+            std::uint64_t mantissa = 0;
+            std::int32_t exponent = 0;
+            std::size_t digits = 0;
+
+            for (; iterator != end && *iterator >= '0' && *iterator <= '9'; ++iterator)
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*iterator - '0');
+                    if (mantissa) ++digits;
+                }
+                else
+                    ++exponent;
+
+            if (iterator != end && *iterator == '.')
+            {
+                ++iterator;
+                for (; iterator != end && *iterator >= '0' && *iterator <= '9'; ++iterator)
+                    if (digits < 19)
+                    {
+                        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*iterator - '0');
+                        if (mantissa) ++digits;
+                        --exponent;
+                    }
+            }
+
+            if (iterator != end && (*iterator == 'e' || *iterator == 'E'))
+            {
+                if (++iterator == end)
+                    throw ParseError("Invalid exponent");
+
+                const bool negativeExponent = *iterator == '-';
+                if (*iterator == '+' || *iterator == '-') ++iterator;
+
+                if (iterator == end || *iterator < '0' || *iterator > '9')
+                    throw ParseError("Invalid exponent");
+
+                std::int32_t value = 0;
+                for (; iterator != end && *iterator >= '0' && *iterator <= '9'; ++iterator)
+                    if (value < 100000) value = value * 10 + (*iterator - '0');
+
+                exponent += negativeExponent ? -value : value;
+            }
+
+            result.type = Element::Type::number;
+
+            // exact if the mantissa and the power of ten are both representable as doubles
+            if (mantissa <= (std::uint64_t{1} << 53) && exponent >= -22 && exponent <= 22)
+            {
+                const auto value = static_cast<double>(mantissa);
+                result.numberValue = exponent < 0 ? value / powersOf10[-exponent] : value * powersOf10[exponent];
+                if (negative) result.numberValue = -result.numberValue;
+            }
+            else
+                result.numberValue = std::strtod(std::string{numberBegin, iterator}.c_str(), nullptr);
+
+            return iterator;
+        }
+
+        static std::uint32_t parseHex(const char* iterator)
+        {
+            std::uint32_t result = 0;
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                const auto c = iterator[i];
+                if (c >= '0' && c <= '9') result = (result << 4) | static_cast<std::uint32_t>(c - '0');
+                else if (c >= 'a' && c <= 'f') result = (result << 4) | static_cast<std::uint32_t>(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F') result = (result << 4) | static_cast<std::uint32_t>(c - 'A' + 10);
+                else throw ParseError("Invalid character code");
+            }
+            return result;
+        }
+
+        static void appendUtf8(std::string& str, std::uint32_t c)
+        {
+            if (c <= 0x7F)
+                str.push_back(static_cast<char>(c));
+            else if (c <= 0x7FF)
+            {
+                str.push_back(static_cast<char>(0xC0 | ((c >> 6) & 0x1F)));
+                str.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+            else if (c <= 0xFFFF)
+            {
+                str.push_back(static_cast<char>(0xE0 | ((c >> 12) & 0x0F)));
+                str.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                str.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+            else
+            {
+                str.push_back(static_cast<char>(0xF0 | ((c >> 18) & 0x07)));
+                str.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+                str.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                str.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+        }
+
+        // Strings without escape sequences are not copied
+        const char* parseString(const char* iterator, std::string_view& result)
+        {
+            const auto stringBegin = ++iterator;
+            iterator = findStringEnd(iterator, end);
+
+            if (iterator != end && *iterator == '"')
+            {
+                result = std::string_view{stringBegin, static_cast<std::size_t>(iterator - stringBegin)};
+                return iterator + 1;
+            }
+
+            unescaped.assign(stringBegin, iterator);
+
+            for (;;)
+            {
+                if (iterator == end)
+                    throw ParseError("Unterminated string literal");
+                else if (*iterator == '"')
+                    break;
+                else if (*iterator != '\\') // control character
+                    throw ParseError("Unterminated string literal");
+
+                if (++iterator == end)
+                    throw ParseError("Unterminated string literal");
+
+                switch (*iterator++)
+                {
+                    case '"': unescaped.push_back('"'); break;
+                    case '\\': unescaped.push_back('\\'); break;
+                    case '/': unescaped.push_back('/'); break;
+                    case 'b': unescaped.push_back('\b'); break;
+                    case 'f': unescaped.push_back('\f'); break;
+                    case 'n': unescaped.push_back('\n'); break;
+                    case 'r': unescaped.push_back('\r'); break;
+                    case 't': unescaped.push_back('\t'); break;
+                    case 'u':
+                    {
+                        if (end - iterator < 4)
+                            throw ParseError("Unexpected end of data");
+
+                        auto c = parseHex(iterator);
+                        iterator += 4;
+
+                        // surrogate pair
+                        if (c >= 0xD800 && c <= 0xDBFF && end - iterator >= 6 &&
+                            iterator[0] == '\\' && iterator[1] == 'u')
+                        {
+                            const auto low = parseHex(iterator + 2);
+                            if (low >= 0xDC00 && low <= 0xDFFF)
+                            {
+                                c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                                iterator += 6;
+                            }
+                        }
+
+                        appendUtf8(unescaped, c);
+                        break;
+                    }
+                    default:
+                        throw ParseError("Unrecognized escape character");
+                }
+
+                const auto chunkBegin = iterator;
+                iterator = findStringEnd(iterator, end);
+                unescaped.append(chunkBegin, iterator);
+            }
+
+            const auto data = arena.allocate<char>(unescaped.size());
+            std::copy(unescaped.begin(), unescaped.end(), data);
+            result = std::string_view{data, unescaped.size()};
+            return iterator + 1;
+        }
+
+        Arena& arena;
+        const char* end;
+        std::vector<Element> elementStack;
+        std::vector<Member> memberStack;
+        std::string unescaped;
+    };
+
+    inline Document parseDocument(const char* begin, const char* end)
+    {
+        return DocumentParser::parse(begin, end);
+    }
+
+    inline Document parseDocument(Span<const std::byte> data)
+    {
+        const auto begin = reinterpret_cast<const char*>(data.data());
+        return DocumentParser::parse(begin, begin + data.size());
+    }
+
+    inline Document parseDocument(std::string_view data)
+    {
+        return DocumentParser::parse(data.data(), data.data() + data.size());
+    }
+}
+
+#endif // OUZEL_FORMATS_JSONDOCUMENT_HPP
@@ -0,0 +1,819 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_FORMATS_OBJ_HPP
+#define OUZEL_FORMATS_OBJ_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "../graphics/Vertex.hpp"
+#include "../math/Box.hpp"
+#include "../thread/JobSystem.hpp"
+#include "../utils/Span.hpp"
+
+namespace ouzel::obj
+{
+    class ParseError final: public std::logic_error
+    {
+    public:
+        explicit ParseError(const std::string& str): std::logic_error(str) {}
+        explicit ParseError(const char* str): std::logic_error(str) {}
+    };
+
+    class Object final
+    {
+    public:
+        std::string name; // empty for the geometry before the first object statement
+        std::string material;
+        std::vector<graphics::Vertex> vertices;
+        std::vector<std::uint32_t> indices;
+        Box<float, 3> boundingBox;
+    };
+
+    class Data final
+    {
+    public:
+        std::vector<std::string> materialLibraries;
+        std::vector<Object> objects;
+    };
+
+    inline namespace detail
+    {
+        // files smaller than this are not split between threads
+        constexpr std::size_t minChunkSize = 4 * 1024 * 1024;
+
+        constexpr auto isWhitespace(std::byte c) noexcept
+        {
+            return static_cast<char>(c) == ' ' ||
+                static_cast<char>(c) == '\t';
+        }
+
+        constexpr auto isNewline(std::byte c) noexcept
+        {
+            return static_cast<char>(c) == '\r' ||
+                static_cast<char>(c) == '\n';
+        }
+
+        constexpr auto isControlChar(std::byte c) noexcept
+        {
+            return static_cast<std::uint8_t>(c) <= 0x1F;
+        }
+
+        constexpr auto isDigit(std::byte c) noexcept
+        {
+            return static_cast<char>(c) >= '0' &&
+                static_cast<char>(c) <= '9';
+        }
+
+        constexpr auto getDigit(std::byte c) noexcept
+        {
+            return static_cast<std::uint32_t>(static_cast<char>(c) - '0');
+        }
+
+        inline void skipWhitespaces(const std::byte*& iterator,
+                                    const std::byte* end) noexcept
+        {
+            while (iterator != end)
+                if (isWhitespace(*iterator))
+                    ++iterator;
+                else
+                    break;
+        }
+
+        inline void skipLine(const std::byte*& iterator,
+                             const std::byte* end) noexcept
+        {
+            const auto newline = std::memchr(iterator, '\n', static_cast<std::size_t>(end - iterator));
+            iterator = newline ? static_cast<const std::byte*>(newline) + 1 : end;
+        }
+
+        inline std::string_view parseString(const std::byte*& iterator,
+                                            const std::byte* end)
+        {
+            const auto begin = iterator;
+
+            while (iterator != end && !isControlChar(*iterator) && !isWhitespace(*iterator))
+                ++iterator;
+
+            if (iterator == begin)
+                throw ParseError("Invalid string");
+
+            return std::string_view{reinterpret_cast<const char*>(begin), static_cast<std::size_t>(iterator - begin)};
+        }
+
+        inline std::int32_t parseInt32(const std::byte*& iterator,
+                                       const std::byte* end)
+        {
+            bool negative = false;
+
+            if (iterator != end &&
+                static_cast<char>(*iterator) == '-')
+            {
+                negative = true;
+                ++iterator;
+            }
+
+            if (iterator == end || !isDigit(*iterator))
+                throw ParseError("Invalid integer");
+
+            std::int64_t value = 0;
+
+            while (iterator != end && isDigit(*iterator))
+            {
+                value = value * 10 + getDigit(*iterator);
+                if (value > std::numeric_limits<std::int32_t>::max())
+                    throw ParseError("Integer out of range");
+
+                ++iterator;
+            }
+
+            return static_cast<std::int32_t>(negative ? -value : value);
+        }
+
+        // Parses the digits into an integer mantissa and a decimal exponent without copying them to a string.
+        // If both are exactly representable as floats, a single float multiplication or division gives
+        // the correctly rounded result, otherwise the number is converted with from_chars (or strtof).
+        inline float parseFloat(const std::byte*& iterator,
+                                const std::byte* end)
+        {
+            constexpr float powers[] = {1e0F, 1e1F, 1e2F, 1e3F, 1e4F, 1e5F, 1e6F, 1e7F, 1e8F, 1e9F, 1e10F};
+            constexpr std::int32_t maxExponent = 10;
+            constexpr std::uint64_t maxMantissa = 1U << std::numeric_limits<float>::digits;
+            constexpr std::uint64_t maxDigits = 100000000000000000ULL; // 18 significant digits
+
+            bool negative = false;
+
+            if (iterator != end &&
+                (static_cast<char>(*iterator) == '-' ||
+                 static_cast<char>(*iterator) == '+'))
+            {
+                negative = static_cast<char>(*iterator) == '-';
+                ++iterator;
+            }
+
+            const auto begin = iterator;
+            std::uint64_t mantissa = 0;
+            std::int32_t exponent = 0;
+            bool hasDigits = false;
+            bool truncated = false;
+
+            while (iterator != end && isDigit(*iterator))
+            {
+                if (mantissa < maxDigits)
+                    mantissa = mantissa * 10 + getDigit(*iterator);
+                else
+                {
+                    ++exponent;
+                    truncated = true;
+                }
+
+                hasDigits = true;
+                ++iterator;
+            }
+
+            if (iterator != end &&
+                static_cast<char>(*iterator) == '.')
+            {
+                ++iterator;
+
+                while (iterator != end && isDigit(*iterator))
+                {
+                    if (mantissa < maxDigits)
+                    {
+                        mantissa = mantissa * 10 + getDigit(*iterator);
+                        --exponent;
+                    }
+                    else
+                        truncated = true;
+
+                    hasDigits = true;
+                    ++iterator;
+                }
+            }
+
+            if (!hasDigits)
+                throw ParseError("Invalid float");
+
+            // parse exponent
+            if (iterator != end &&
+                (static_cast<char>(*iterator) == 'e' ||
+                 static_cast<char>(*iterator) == 'E'))
+            {
+                if (++iterator == end)
+                    throw ParseError("Invalid exponent");
+
+                bool negativeExponent = false;
+                if (static_cast<char>(*iterator) == '+' ||
+                    static_cast<char>(*iterator) == '-')
+                    negativeExponent = static_cast<char>(*iterator++) == '-';
+
+                if (iterator == end || !isDigit(*iterator))
+                    throw ParseError("Invalid exponent");
+
+                std::int32_t value = 0;
+                while (iterator != end && isDigit(*iterator))
+                {
+                    if (value < 10000) value = value * 10 + static_cast<std::int32_t>(getDigit(*iterator));
+                    ++iterator;
+                }
+
+                exponent += negativeExponent ? -value : value;
+            }
+
+            // trailing zeros of fixed notation, e.g. 150.000000
+            while (mantissa > maxMantissa && mantissa % 10 == 0)
+            {
+                mantissa /= 10;
+                ++exponent;
+            }
+
+            float result;
+
+            if (mantissa == 0)
+                result = 0.0F;
+            else if (!truncated && mantissa <= maxMantissa &&
+                     exponent >= -maxExponent && exponent <= maxExponent)
+                result = exponent < 0 ?
+                    static_cast<float>(mantissa) / powers[-exponent] :
+                    static_cast<float>(mantissa) * powers[exponent];
+            else
+            {
+#if defined(__cpp_lib_to_chars)
+                const auto [pointer, error] = std::from_chars(reinterpret_cast<const char*>(begin),
+                                                              reinterpret_cast<const char*>(iterator),
+                                                              result);
+                if (error == std::errc::invalid_argument)
+                    throw ParseError("Invalid float");
+                if (error == std::errc::result_out_of_range)
+                    result = exponent < 0 ? 0.0F : std::numeric_limits<float>::infinity();
+#else
+                const std::string number{reinterpret_cast<const char*>(begin), static_cast<std::size_t>(iterator - begin)};
+                result = std::strtof(number.c_str(), nullptr);
+#endif
+            }
+
+            return negative ? -result : result;
+        }
+
+        inline bool parseToken(const std::byte*& iterator,
+                               const std::byte* end,
+                               char token) noexcept
+        {
+            if (iterator == end || static_cast<char>(*iterator) != token) return false;
+
+            ++iterator;
+
+            return true;
+        }
+
+        // Indices as they are written in the file, zero if the element is missing
+        class Corner final
+        {
+        public:
+            std::int32_t position = 0;
+            std::int32_t texCoord = 0;
+            std::int32_t normal = 0;
+        };
+
+        class Face final
+        {
+        public:
+            std::uint32_t cornerBegin = 0;
+            std::uint32_t cornerCount = 0;
+
+            // the attribute counts of the chunk before the face, needed to resolve negative indices
+            std::uint32_t positionCount = 0;
+            std::uint32_t texCoordCount = 0;
+            std::uint32_t normalCount = 0;
+        };
+
+        class Statement final
+        {
+        public:
+            enum class Type
+            {
+                object,
+                material,
+                materialLibrary
+            };
+
+            Type type;
+            std::string value;
+            std::size_t faceIndex; // number of the faces of the chunk before the statement
+        };
+
+        // Part of the file that starts at a line boundary, parsed independently of the other chunks
+        class Chunk final
+        {
+        public:
+            std::vector<Vector<float, 3>> positions;
+            std::vector<Vector<float, 2>> texCoords;
+            std::vector<Vector<float, 3>> normals;
+            std::vector<Corner> corners;
+            std::vector<Face> faces;
+            std::vector<Statement> statements;
+            bool hasGeometry = false;
+        };
+
+        // Counts the lines of the chunk first, so that the arrays are allocated only once
+        inline void reserve(Chunk& chunk, const std::byte* iterator, const std::byte* end)
+        {
+            std::size_t positionCount = 0;
+            std::size_t texCoordCount = 0;
+            std::size_t normalCount = 0;
+            std::size_t faceCount = 0;
+            std::size_t cornerCount = 0;
+
+            while (iterator != end)
+            {
+                const auto lineEnd = static_cast<const std::byte*>(std::memchr(iterator, '\n', static_cast<std::size_t>(end - iterator)));
+                const auto next = lineEnd ? lineEnd + 1 : end;
+
+                if (next - iterator >= 2)
+                {
+                    const auto first = static_cast<char>(iterator[0]);
+                    const auto second = static_cast<char>(iterator[1]);
+
+                    if (first == 'v')
+                    {
+                        if (second == ' ' || second == '\t') ++positionCount;
+                        else if (second == 't') ++texCoordCount;
+                        else if (second == 'n') ++normalCount;
+                    }
+                    else if (first == 'f' && (second == ' ' || second == '\t'))
+                    {
+                        ++faceCount;
+                        for (auto i = iterator + 1; i != next; ++i)
+                            if (isWhitespace(*i) && i + 1 != next && !isWhitespace(i[1]) && !isNewline(i[1]))
+                                ++cornerCount;
+                    }
+                }
+
+                iterator = next;
+            }
+
+            chunk.positions.reserve(positionCount);
+            chunk.texCoords.reserve(texCoordCount);
+            chunk.normals.reserve(normalCount);
+            chunk.faces.reserve(faceCount);
+            chunk.corners.reserve(cornerCount);
+        }
+
+        inline void parseChunk(Chunk& chunk, const std::byte* iterator, const std::byte* end)
+        {
+            reserve(chunk, iterator, end);
+
+            while (iterator != end)
+            {
+                if (isNewline(*iterator))
+                {
+                    // skip empty lines
+                    ++iterator;
+                    continue;
+                }
+
+                skipWhitespaces(iterator, end);
+                if (iterator == end) break;
+
+                if (isNewline(*iterator) || static_cast<char>(*iterator) == '#')
+                {
+                    // skip the comment
+                    skipLine(iterator, end);
+                    continue;
+                }
+
+                const auto keyword = parseString(iterator, end);
+
+                if (keyword == "v")
+                {
+                    Vector<float, 3> position;
+
+                    skipWhitespaces(iterator, end);
+                    position.v[0] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    position.v[1] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    position.v[2] = parseFloat(iterator, end);
+
+                    chunk.positions.push_back(position);
+                }
+                else if (keyword == "vt")
+                {
+                    Vector<float, 2> texCoord;
+
+                    skipWhitespaces(iterator, end);
+                    texCoord.v[0] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    texCoord.v[1] = parseFloat(iterator, end);
+
+                    chunk.texCoords.push_back(texCoord);
+                }
+                else if (keyword == "vn")
+                {
+                    Vector<float, 3> normal;
+
+                    skipWhitespaces(iterator, end);
+                    normal.v[0] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    normal.v[1] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    normal.v[2] = parseFloat(iterator, end);
+
+                    chunk.normals.push_back(normal);
+                }
+                else if (keyword == "f")
+                {
+                    Face face;
+                    face.cornerBegin = static_cast<std::uint32_t>(chunk.corners.size());
+                    face.positionCount = static_cast<std::uint32_t>(chunk.positions.size());
+                    face.texCoordCount = static_cast<std::uint32_t>(chunk.texCoords.size());
+                    face.normalCount = static_cast<std::uint32_t>(chunk.normals.size());
+
+                    for (;;)
+                    {
+                        skipWhitespaces(iterator, end);
+                        if (iterator == end || isNewline(*iterator) || static_cast<char>(*iterator) == '#') break;
+
+                        Corner corner;
+                        corner.position = parseInt32(iterator, end);
+
+                        // has texture coordinates
+                        if (parseToken(iterator, end, '/'))
+                        {
+                            // two slashes in a row indicates no texture coordinates
+                            if (iterator != end &&
+                                static_cast<char>(*iterator) != '/')
+                                corner.texCoord = parseInt32(iterator, end);
+
+                            // has normal
+                            if (parseToken(iterator, end, '/'))
+                                corner.normal = parseInt32(iterator, end);
+                        }
+
+                        if (corner.position == 0)
+                            throw ParseError("Invalid position index");
+
+                        chunk.corners.push_back(corner);
+                    }
+
+                    face.cornerCount = static_cast<std::uint32_t>(chunk.corners.size()) - face.cornerBegin;
+                    if (face.cornerCount < 3)
+                        throw ParseError("Invalid face count");
+
+                    chunk.faces.push_back(face);
+                }
+                else if (keyword == "o")
+                {
+                    skipWhitespaces(iterator, end);
+                    chunk.statements.push_back(Statement{Statement::Type::object, std::string{parseString(iterator, end)}, chunk.faces.size()});
+                }
+                else if (keyword == "usemtl")
+                {
+                    skipWhitespaces(iterator, end);
+                    chunk.statements.push_back(Statement{Statement::Type::material, std::string{parseString(iterator, end)}, chunk.faces.size()});
+                }
+                else if (keyword == "mtllib")
+                {
+                    skipWhitespaces(iterator, end);
+                    chunk.statements.push_back(Statement{Statement::Type::materialLibrary, std::string{parseString(iterator, end)}, chunk.faces.size()});
+                }
+
+                // skip the rest of the line and all unknown commands
+                skipLine(iterator, end);
+            }
+        }
+
+        // Open addressing map from the position, texture coordinate and normal indices to the vertex index
+        class VertexCache final
+        {
+        public:
+            void reset(std::size_t vertexCount)
+            {
+                std::size_t capacity = 16;
+                while (capacity < vertexCount * 2) capacity *= 2;
+
+                entries.assign(capacity, Entry{});
+                count = 0;
+            }
+
+            // Returns the index of the vertex and true if it was inserted
+            std::pair<std::uint32_t, bool> insert(std::uint32_t position, std::uint32_t texCoord,
+                                                  std::uint32_t normal, std::uint32_t index)
+            {
+                if ((count + 1) * 2 > entries.size())
+                    rehash(entries.size() * 2);
+
+                const auto mask = entries.size() - 1;
+                for (auto i = getIndex(position, texCoord, normal) & mask;; i = (i + 1) & mask)
+                {
+                    auto& entry = entries[i];
+                    if (entry.index == empty)
+                    {
+                        entry = Entry{position, texCoord, normal, index};
+                        ++count;
+                        return {index, true};
+                    }
+                    else if (entry.position == position &&
+                             entry.texCoord == texCoord &&
+                             entry.normal == normal)
+                        return {entry.index, false};
+                }
+            }
+
+        private:
+            static constexpr auto empty = std::numeric_limits<std::uint32_t>::max();
+
+            class Entry final
+            {
+            public:
+                std::uint32_t position = 0;
+                std::uint32_t texCoord = 0;
+                std::uint32_t normal = 0;
+                std::uint32_t index = empty;
+            };
+
+            static std::size_t getIndex(std::uint32_t position, std::uint32_t texCoord, std::uint32_t normal) noexcept
+            {
+                auto hash = (static_cast<std::uint64_t>(position) * 0x9E3779B97F4A7C15ULL) ^
+                    (static_cast<std::uint64_t>(texCoord) * 0xC2B2AE3D27D4EB4FULL) ^
+                    (static_cast<std::uint64_t>(normal) * 0x165667B19E3779F9ULL);
+                hash ^= hash >> 32;
+                return static_cast<std::size_t>(hash);
+            }
+
+            void rehash(std::size_t capacity)
+            {
+                std::vector<Entry> oldEntries(capacity);
+                entries.swap(oldEntries);
+
+                const auto mask = entries.size() - 1;
+                for (const auto& entry : oldEntries)
+                    if (entry.index != empty)
+                    {
+                        auto i = getIndex(entry.position, entry.texCoord, entry.normal) & mask;
+                        while (entries[i].index != empty) i = (i + 1) & mask;
+                        entries[i] = entry;
+                    }
+            }
+
+            std::vector<Entry> entries;
+            std::size_t count = 0;
+        };
+
+        // Converts a one-based or negative index of the file to a zero-based index of the whole file
+        inline std::uint32_t resolveIndex(std::int32_t index, std::size_t chunkBase,
+                                          std::uint32_t countBefore, std::size_t total,
+                                          const char* error)
+        {
+            const auto result = index > 0 ?
+                static_cast<std::int64_t>(index) - 1 :
+                static_cast<std::int64_t>(chunkBase + countBefore) + index;
+
+            if (result < 0 || result >= static_cast<std::int64_t>(total))
+                throw ParseError(error);
+
+            return static_cast<std::uint32_t>(result);
+        }
+
+        // Large files are split into at most maxChunkCount chunks at line boundaries, runChunks(chunkCount, parseChunkAt)
+        // must call parseChunkAt for every chunk index, the faces are then turned into indexed vertices
+        // of the objects in the order of the file
+        template <class RunChunks>
+        Data parseChunked(Span<const std::byte> data, std::size_t maxChunkCount, RunChunks runChunks)
+        {
+            const auto chunkCount = std::clamp(data.size() / minChunkSize, std::size_t{1}, std::max(maxChunkCount, std::size_t{1}));
+            std::vector<Chunk> chunks(chunkCount);
+
+            std::vector<const std::byte*> boundaries{data.begin()};
+            for (std::size_t i = 1; i < chunkCount; ++i)
+            {
+                auto boundary = std::max(data.begin() + data.size() * i / chunkCount, boundaries.back());
+                if (boundary != data.begin() && !isNewline(boundary[-1]))
+                    skipLine(boundary, data.end());
+                boundaries.push_back(boundary);
+            }
+            boundaries.push_back(data.end());
+
+            std::vector<std::exception_ptr> errors(chunkCount);
+            const auto parseChunkAt = [&chunks, &boundaries, &errors](std::size_t i) noexcept {
+                try
+                {
+                    parseChunk(chunks[i], boundaries[i], boundaries[i + 1]);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            };
+
+            runChunks(chunkCount, parseChunkAt);
+
+            for (const auto& error : errors)
+                if (error) std::rethrow_exception(error);
+
+            // the attributes of all chunks have to be known before the faces can be resolved
+            class Base final
+            {
+            public:
+                std::size_t position = 0;
+                std::size_t texCoord = 0;
+                std::size_t normal = 0;
+            };
+
+            std::vector<Base> bases(chunkCount);
+            std::vector<Vector<float, 3>> positions;
+            std::vector<Vector<float, 2>> texCoords;
+            std::vector<Vector<float, 3>> normals;
+
+            if (chunkCount == 1)
+            {
+                positions = std::move(chunks.front().positions);
+                texCoords = std::move(chunks.front().texCoords);
+                normals = std::move(chunks.front().normals);
+            }
+            else
+            {
+                Base total;
+                for (std::size_t i = 0; i < chunkCount; ++i)
+                {
+                    bases[i] = total;
+                    total.position += chunks[i].positions.size();
+                    total.texCoord += chunks[i].texCoords.size();
+                    total.normal += chunks[i].normals.size();
+                }
+
+                positions.reserve(total.position);
+                texCoords.reserve(total.texCoord);
+                normals.reserve(total.normal);
+
+                for (auto& chunk : chunks)
+                {
+                    positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+                    texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+                    normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+                    chunk.positions = {};
+                    chunk.texCoords = {};
+                    chunk.normals = {};
+                }
+            }
+
+            Data result;
+            Object object;
+            bool hasObject = false;
+            VertexCache vertexCache;
+
+            const auto finishObject = [&result, &object, &hasObject]() {
+                if (hasObject || !object.indices.empty())
+                    result.objects.push_back(std::move(object));
+                object = Object{};
+            };
+
+            // reserves the arrays of the object for the faces up to the next object statement
+            const auto reserveObject = [&chunks, &object, &vertexCache, &positions](std::size_t chunkIndex,
+                                                                                    std::size_t faceBegin,
+                                                                                    std::size_t statementBegin) {
+                std::size_t indexCount = 0;
+
+                for (auto c = chunkIndex; c < chunks.size(); ++c, faceBegin = 0, statementBegin = 0)
+                {
+                    const auto& chunk = chunks[c];
+                    auto faceEnd = chunk.faces.size();
+                    bool objectEnd = false;
+
+                    for (auto s = statementBegin; s < chunk.statements.size(); ++s)
+                        if (chunk.statements[s].type == Statement::Type::object)
+                        {
+                            faceEnd = chunk.statements[s].faceIndex;
+                            objectEnd = true;
+                            break;
+                        }
+
+                    for (auto f = faceBegin; f < faceEnd; ++f)
+                        indexCount += (chunk.faces[f].cornerCount - 2) * 3;
+
+                    if (objectEnd) break;
+                }
+
+                const auto vertexCount = std::min(indexCount, positions.size());
+                object.indices.reserve(indexCount);
+                object.vertices.reserve(vertexCount);
+                vertexCache.reset(vertexCount);
+            };
+
+            reserveObject(0, 0, 0);
+
+            std::vector<std::uint32_t> faceIndices;
+
+            for (std::size_t c = 0; c < chunks.size(); ++c)
+            {
+                auto& chunk = chunks[c];
+                std::size_t statementIndex = 0;
+
+                for (std::size_t f = 0; f <= chunk.faces.size(); ++f)
+                {
+                    for (; statementIndex < chunk.statements.size() && chunk.statements[statementIndex].faceIndex == f; ++statementIndex)
+                    {
+                        auto& statement = chunk.statements[statementIndex];
+
+                        switch (statement.type)
+                        {
+                            case Statement::Type::object:
+                                finishObject();
+                                object.name = std::move(statement.value);
+                                hasObject = true;
+                                reserveObject(c, f, statementIndex + 1);
+                                break;
+                            case Statement::Type::material:
+                                object.material = std::move(statement.value);
+                                break;
+                            case Statement::Type::materialLibrary:
+                                result.materialLibraries.push_back(std::move(statement.value));
+                                break;
+                        }
+                    }
+
+                    if (f == chunk.faces.size()) break;
+
+                    const auto& face = chunk.faces[f];
+                    faceIndices.clear();
+
+                    for (auto i = face.cornerBegin; i < face.cornerBegin + face.cornerCount; ++i)
+                    {
+                        const auto& corner = chunk.corners[i];
+
+                        const auto position = resolveIndex(corner.position, bases[c].position, face.positionCount,
+                                                           positions.size(), "Invalid position index") + 1;
+                        const auto texCoord = corner.texCoord == 0 ? 0 :
+                            resolveIndex(corner.texCoord, bases[c].texCoord, face.texCoordCount,
+                                         texCoords.size(), "Invalid texture coordinate index") + 1;
+                        const auto normal = corner.normal == 0 ? 0 :
+                            resolveIndex(corner.normal, bases[c].normal, face.normalCount,
+                                         normals.size(), "Invalid normal index") + 1;
+
+                        const auto [index, inserted] = vertexCache.insert(position, texCoord, normal,
+                                                                          static_cast<std::uint32_t>(object.vertices.size()));
+                        if (inserted)
+                        {
+                            graphics::Vertex vertex;
+                            vertex.position = positions[position - 1];
+                            if (texCoord >= 1) vertex.texCoords[0] = texCoords[texCoord - 1];
+                            vertex.color = Color::white();
+                            if (normal >= 1) vertex.normal = normals[normal - 1];
+                            object.vertices.push_back(vertex);
+                            object.boundingBox.insertPoint(vertex.position);
+                        }
+
+                        faceIndices.push_back(index);
+                    }
+
+                    for (std::size_t index = 0; index < faceIndices.size() - 2; ++index)
+                    {
+                        object.indices.push_back(faceIndices[0]);
+                        object.indices.push_back(faceIndices[index + 1]);
+                        object.indices.push_back(faceIndices[index + 2]);
+                    }
+                }
+
+                chunk = Chunk{};
+            }
+
+            // geometry before the first object statement forms an unnamed object
+            finishObject();
+
+            return result;
+        }
+    }
+
+    // runs the chunks on up to threadCount threads
+    inline Data parse(Span<const std::byte> data, std::size_t threadCount = 1)
+    {
+        return parseChunked(data, threadCount, [](std::size_t chunkCount, const auto& parseChunkAt) {
+            std::vector<std::thread> threads;
+            for (std::size_t i = 1; i < chunkCount; ++i)
+                threads.emplace_back(parseChunkAt, i);
+            parseChunkAt(0);
+            for (auto& thread : threads) thread.join();
+        });
+    }
+
+    // runs the chunks as jobs, one chunk for every worker and the calling thread
+    inline Data parse(Span<const std::byte> data, thread::JobSystem& jobSystem)
+    {
+        return parseChunked(data, jobSystem.getWorkerCount() + 1, [&jobSystem](std::size_t chunkCount, const auto& parseChunkAt) {
+            jobSystem.parallelFor(0, chunkCount, 1, [&parseChunkAt](std::size_t begin, std::size_t end) {
+                for (auto i = begin; i < end; ++i) parseChunkAt(i);
+            });
+        });
+    }
+}
+
+#endif // OUZEL_FORMATS_OBJ_HPP
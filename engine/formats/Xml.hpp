@@ -3,9 +3,14 @@
 #ifndef OUZEL_FORMATS_XML_HPP
 #define OUZEL_FORMATS_XML_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "../utils/Utf8.hpp"
 
@@ -689,6 +694,359 @@ namespace ouzel::xml
                      preserveProcessingInstructions);
     }
 
+    // Decodes the entities of raw text or attribute values returned by Reader
+    inline std::string decode(std::string_view str)
+    {
+        std::string result;
+        result.reserve(str.size());
+
+        for (std::size_t i = 0; i < str.size();)
+        {
+            if (str[i] != '&')
+            {
+                result.push_back(str[i++]);
+                continue;
+            }
+
+            const auto semicolon = str.find(';', i);
+            if (semicolon == std::string_view::npos)
+                throw ParseError("Unexpected end of data");
+
+            const auto entity = str.substr(i + 1, semicolon - i - 1);
+            i = semicolon + 1;
+
+            if (entity == "quot") result.push_back('"');
+            else if (entity == "amp") result.push_back('&');
+            else if (entity == "apos") result.push_back('\'');
+            else if (entity == "lt") result.push_back('<');
+            else if (entity == "gt") result.push_back('>');
+            else if (entity.size() >= 2 && entity[0] == '#')
+            {
+                char32_t c = 0;
+
+                if (entity[1] == 'x') // hex value
+                {
+                    if (entity.size() == 2)
+                        throw ParseError("Invalid entity");
+
+                    for (std::size_t j = 2; j < entity.size(); ++j)
+                    {
+                        const auto digit = entity[j];
+                        if (digit >= '0' && digit <= '9') c = (c << 4) | static_cast<char32_t>(digit - '0');
+                        else if (digit >= 'a' && digit <= 'f') c = (c << 4) | static_cast<char32_t>(digit - 'a' + 10);
+                        else if (digit >= 'A' && digit <= 'F') c = (c << 4) | static_cast<char32_t>(digit - 'A' + 10);
+                        else throw ParseError("Invalid character code");
+                    }
+                }
+                else
+                    for (std::size_t j = 1; j < entity.size(); ++j)
+                    {
+                        const auto digit = entity[j];
+                        if (digit < '0' || digit > '9')
+                            throw ParseError("Invalid character code");
+                        c = c * 10 + static_cast<char32_t>(digit - '0');
+                    }
+
+                result += utf8::fromUtf32(c);
+            }
+            else
+                throw ParseError("Invalid entity");
+        }
+
+        return result;
+    }
+
+    // Pull parser that returns the events of a document as views of the input buffer without
+    // building a tree. Text and attribute values are raw, entities are decoded by decode().
+    class Reader final
+    {
+    public:
+        enum class Event
+        {
+            startElement, // getName returns the tag, followed by the attribute events
+            attribute, // getName and getValue return the attribute of the last element or processing instruction
+            endElement, // also returned for self-closing tags
+            text,
+            characterData,
+            comment,
+            processingInstruction, // getName returns the target
+            end
+        };
+
+        Reader(const char* begin, const char* end, bool initPreserveWhitespaces = false):
+            iterator{begin}, dataEnd{end}, preserveWhitespaces{initPreserveWhitespaces}
+        {
+            if (dataEnd - iterator >= 3 &&
+                static_cast<std::uint8_t>(iterator[0]) == utf8ByteOrderMark[0] &&
+                static_cast<std::uint8_t>(iterator[1]) == utf8ByteOrderMark[1] &&
+                static_cast<std::uint8_t>(iterator[2]) == utf8ByteOrderMark[2])
+                iterator += 3;
+        }
+
+        template <class T>
+        explicit Reader(const T& data, bool initPreserveWhitespaces = false):
+            Reader{reinterpret_cast<const char*>(std::data(data)),
+                   reinterpret_cast<const char*>(std::data(data)) + std::size(data),
+                   initPreserveWhitespaces}
+        {
+        }
+
+        Event next()
+        {
+            if (inTag)
+            {
+                skipWhitespaces();
+
+                if (inProcessingInstruction && startsWith("?>"))
+                {
+                    iterator += 2;
+                    inTag = inProcessingInstruction = false;
+                }
+                else if (!inProcessingInstruction && startsWith(">"))
+                {
+                    ++iterator;
+                    inTag = false;
+                }
+                else if (!inProcessingInstruction && startsWith("/>"))
+                {
+                    iterator += 2;
+                    inTag = false;
+                    name = openElements.back();
+                    value = {};
+                    openElements.pop_back();
+                    return event = Event::endElement;
+                }
+                else
+                {
+                    name = parseName();
+                    skipWhitespaces();
+
+                    if (!startsWith("="))
+                        throw ParseError("Expected an equal sign");
+
+                    ++iterator;
+                    skipWhitespaces();
+                    value = parseString();
+
+                    return event = Event::attribute;
+                }
+            }
+
+            for (;;)
+            {
+                if (iterator == dataEnd)
+                {
+                    if (!openElements.empty())
+                        throw ParseError("Unexpected end of data");
+                    if (!rootTagFound)
+                        throw ParseError("No root tag found");
+
+                    name = value = {};
+                    return event = Event::end;
+                }
+
+                if (*iterator != '<')
+                {
+                    const auto textBegin = iterator;
+                    const auto tagStart = std::memchr(iterator, '<', static_cast<std::size_t>(dataEnd - iterator));
+                    iterator = tagStart ? static_cast<const char*>(tagStart) : dataEnd;
+
+                    // text inside an element is always followed by a tag
+                    if (!tagStart && !openElements.empty())
+                        throw ParseError("Unexpected end of data");
+
+                    value = std::string_view{textBegin, static_cast<std::size_t>(iterator - textBegin)};
+
+                    if (!preserveWhitespaces &&
+                        std::all_of(value.begin(), value.end(), isWhitespace))
+                        continue;
+
+                    name = {};
+                    return event = Event::text;
+                }
+
+                if (startsWith("</"))
+                {
+                    iterator += 2;
+                    name = parseName();
+                    value = {};
+                    skipWhitespaces();
+
+                    if (!startsWith(">"))
+                        throw ParseError("Expected a right angle bracket");
+                    ++iterator;
+
+                    if (openElements.empty() || openElements.back() != name)
+                        throw ParseError("Tag not closed properly");
+
+                    openElements.pop_back();
+                    return event = Event::endElement;
+                }
+                else if (startsWith("<!--"))
+                {
+                    iterator += 4;
+                    value = parseUntil("-->");
+
+                    if (value.find("--") != std::string_view::npos)
+                        throw ParseError("Unexpected double-hyphen inside comment");
+
+                    name = {};
+                    return event = Event::comment;
+                }
+                else if (startsWith("<![CDATA["))
+                {
+                    iterator += 9;
+                    value = parseUntil("]]>");
+                    name = {};
+                    return event = Event::characterData;
+                }
+                else if (startsWith("<!"))
+                    throw ParseError("Type declarations are not supported");
+                else if (startsWith("<?"))
+                {
+                    iterator += 2;
+                    name = parseName();
+                    value = {};
+                    inTag = inProcessingInstruction = true;
+                    return event = Event::processingInstruction;
+                }
+                else
+                {
+                    ++iterator;
+                    name = parseName();
+                    value = {};
+
+                    if (openElements.empty())
+                    {
+                        if (rootTagFound)
+                            throw ParseError("Multiple root tags found");
+                        rootTagFound = true;
+                    }
+
+                    openElements.push_back(name);
+                    inTag = true;
+                    return event = Event::startElement;
+                }
+            }
+        }
+
+        // Skips the rest of the element that was started by the last startElement event
+        void skipElement()
+        {
+            const auto depth = openElements.size();
+            while (openElements.size() >= depth)
+                if (next() == Event::end)
+                    throw ParseError("Unexpected end of data");
+        }
+
+        Event getEvent() const noexcept { return event; }
+        std::string_view getName() const noexcept { return name; }
+        std::string_view getValue() const noexcept { return value; }
+
+        // The innermost open element, empty outside of the root element
+        std::string_view getElement() const noexcept
+        {
+            return openElements.empty() ? std::string_view{} : openElements.back();
+        }
+
+        std::size_t getDepth() const noexcept { return openElements.size(); }
+
+    private:
+        static constexpr bool isWhitespace(const char c) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        // the bytes of multibyte UTF-8 sequences are accepted as name characters
+        static constexpr bool isNameStartChar(const char c) noexcept
+        {
+            return (c >= 'a' && c <= 'z') ||
+                (c >= 'A' && c <= 'Z') ||
+                c == ':' || c == '_' ||
+                static_cast<std::uint8_t>(c) >= 0x80;
+        }
+
+        static constexpr bool isNameChar(const char c) noexcept
+        {
+            return isNameStartChar(c) ||
+                c == '-' || c == '.' ||
+                (c >= '0' && c <= '9');
+        }
+
+        bool startsWith(std::string_view prefix) const noexcept
+        {
+            return static_cast<std::size_t>(dataEnd - iterator) >= prefix.size() &&
+                std::equal(prefix.begin(), prefix.end(), iterator);
+        }
+
+        void skipWhitespaces() noexcept
+        {
+            while (iterator != dataEnd && isWhitespace(*iterator))
+                ++iterator;
+        }
+
+        std::string_view parseName()
+        {
+            if (iterator == dataEnd)
+                throw ParseError("Unexpected end of data");
+
+            if (!isNameStartChar(*iterator))
+                throw ParseError("Invalid name start");
+
+            const auto nameBegin = iterator;
+            while (iterator != dataEnd && isNameChar(*iterator))
+                ++iterator;
+
+            if (iterator == dataEnd)
+                throw ParseError("Unexpected end of data");
+
+            return std::string_view{nameBegin, static_cast<std::size_t>(iterator - nameBegin)};
+        }
+
+        std::string_view parseString()
+        {
+            if (iterator == dataEnd)
+                throw ParseError("Unexpected end of data");
+
+            if (*iterator != '"' && *iterator != '\'')
+                throw ParseError("Expected quotes");
+
+            const auto quotes = *iterator++;
+            const auto stringBegin = iterator;
+            const auto stringEnd = std::memchr(iterator, quotes, static_cast<std::size_t>(dataEnd - iterator));
+
+            if (!stringEnd)
+                throw ParseError("Unexpected end of data");
+
+            iterator = static_cast<const char*>(stringEnd) + 1;
+            return std::string_view{stringBegin, static_cast<std::size_t>(iterator - 1 - stringBegin)};
+        }
+
+        std::string_view parseUntil(std::string_view terminator)
+        {
+            const std::string_view rest{iterator, static_cast<std::size_t>(dataEnd - iterator)};
+            const auto position = rest.find(terminator);
+
+            if (position == std::string_view::npos)
+                throw ParseError("Unexpected end of data");
+
+            iterator += position + terminator.size();
+            return rest.substr(0, position);
+        }
+
+        const char* iterator;
+        const char* dataEnd;
+        bool preserveWhitespaces;
+
+        Event event = Event::end;
+        std::string_view name;
+        std::string_view value;
+        std::vector<std::string_view> openElements;
+        bool rootTagFound = false;
+        bool inTag = false;
+        bool inProcessingInstruction = false;
+    };
+
     inline std::string encode(const Data& data, bool whitespaces = false, bool byteOrderMark = false)
     {
         class Encoder final
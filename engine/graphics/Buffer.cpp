@@ -69,6 +69,23 @@ namespace ouzel::graphics
                                                                     initSize));
     }
 
+    Buffer::Buffer(Graphics& initGraphics,
+                   BufferType initType,
+                   Flags initFlags,
+                   std::vector<std::uint8_t>&& initData):
+        graphics(&initGraphics),
+        resource(*initGraphics.getDevice()),
+        type(initType),
+        flags(initFlags),
+        size(static_cast<std::uint32_t>(initData.size()))
+    {
+        initGraphics.addCommand(std::make_unique<InitBufferCommand>(resource,
+                                                                    initType,
+                                                                    initFlags,
+                                                                    std::move(initData),
+                                                                    size));
+    }
+
     void Buffer::setData(const void* newData, std::uint32_t newSize)
     {
         if (resource)
@@ -32,6 +32,10 @@ namespace ouzel::graphics
                Flags initFlags,
                const std::vector<std::uint8_t>& initData,
                std::uint32_t initSize);
+        Buffer(Graphics& initGraphics,
+               BufferType initType,
+               Flags initFlags,
+               std::vector<std::uint8_t>&& initData);
 
         void setData(const void* newData, std::uint32_t newSize);
         void setData(const std::vector<std::uint8_t>& newData);
@@ -5,6 +5,8 @@
 
 #include <queue>
 #include <string>
+#include <utility>
+#include <vector>
 #include "BlendFactor.hpp"
 #include "BlendOperation.hpp"
 #include "BufferType.hpp"
@@ -349,13 +351,13 @@ namespace ouzel::graphics
         InitBufferCommand(ResourceId initBuffer,
                           BufferType initBufferType,
                           Flags initFlags,
-                          const std::vector<std::uint8_t>& initData,
-                          std::uint32_t initSize) noexcept(false):
+                          std::vector<std::uint8_t> initData,
+                          std::uint32_t initSize) noexcept:
             Command(Command::Type::initBuffer),
             buffer(initBuffer),
             bufferType(initBufferType),
             flags(initFlags),
-            data(initData),
+            data(std::move(initData)),
             size(initSize)
         {
         }
@@ -371,10 +373,10 @@ namespace ouzel::graphics
     {
     public:
         SetBufferDataCommand(ResourceId initBuffer,
-                             const std::vector<std::uint8_t>& initData) noexcept(false):
+                             std::vector<std::uint8_t> initData) noexcept:
             Command(Command::Type::setBufferData),
             buffer(initBuffer),
-            data(initData)
+            data(std::move(initData))
         {
         }
 
@@ -3,6 +3,8 @@
 #ifndef OUZEL_GRAPHICS_PIXELFORMAT_HPP
 #define OUZEL_GRAPHICS_PIXELFORMAT_HPP
 
+#include <cstdint>
+
 namespace ouzel::graphics
 {
     enum class PixelFormat
@@ -17,6 +17,7 @@
 #include "../../core/Window.hpp"
 #include "../../core/windows/NativeWindowWin.hpp"
 #include "../../utils/Log.hpp"
+#include "../../utils/Profiler.hpp"
 #include "stb_image_write.h"
 
 namespace ouzel::graphics::d3d11
@@ -318,6 +319,8 @@ namespace ouzel::graphics::d3d11
 
     void RenderDevice::process()
     {
+        OUZEL_PROFILE_SCOPE("RenderDevice::process");
+
         graphics::RenderDevice::process();
         executeAll();
 
@@ -17,8 +17,34 @@ namespace ouzel::graphics::empty
         {
         }
 
-    private:
-        void process() final {}
+        // discards the submitted commands and counts the draw calls of the last frame,
+        // there is no render thread, so the owner of the device calls this once per frame
+        void process() final
+        {
+            graphics::RenderDevice::process();
+            executeAll();
+
+            std::uint32_t frameDrawCallCount = 0;
+
+            std::unique_lock lock(commandQueueMutex);
+            while (!commandQueue.empty())
+            {
+                auto commandBuffer = std::move(commandQueue.front());
+                commandQueue.pop();
+
+                while (!commandBuffer.isEmpty())
+                {
+                    const auto command = commandBuffer.popCommand();
+                    if (command->type == Command::Type::draw)
+                        ++frameDrawCallCount;
+                    else if (command->type == Command::Type::present)
+                    {
+                        drawCallCount = frameDrawCallCount;
+                        frameDrawCallCount = 0;
+                    }
+                }
+            }
+        }
     };
 }
 
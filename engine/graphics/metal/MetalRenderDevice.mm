@@ -18,6 +18,7 @@
 #include "../../core/Engine.hpp"
 #include "../../events/EventDispatcher.hpp"
 #include "../../utils/Log.hpp"
+#include "../../utils/Profiler.hpp"
 #include "../../utils/Utils.hpp"
 #include "stb_image_write.h"
 
@@ -166,6 +167,8 @@ namespace ouzel::graphics::metal
 
     void RenderDevice::process()
     {
+        OUZEL_PROFILE_SCOPE("RenderDevice::process");
+
         graphics::RenderDevice::process();
         executeAll();
 
@@ -42,6 +42,7 @@
 #include "../../core/Engine.hpp"
 #include "../../core/Window.hpp"
 #include "../../utils/Log.hpp"
+#include "../../utils/Profiler.hpp"
 #include "stb_image_write.h"
 
 namespace ouzel::graphics::opengl
@@ -727,6 +728,8 @@ namespace ouzel::graphics::opengl
 
     void RenderDevice::process()
     {
+        OUZEL_PROFILE_SCOPE("RenderDevice::process");
+
         graphics::RenderDevice::process();
         executeAll();
 
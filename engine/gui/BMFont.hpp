@@ -4,25 +4,13 @@
 #define OUZEL_GUI_BMFONT_HPP
 
 #include "Font.hpp"
+#include "../utils/Span.hpp"
 
 namespace ouzel::gui
 {
     class BMFont final: public Font
     {
     public:
-        BMFont() = default;
-        explicit BMFont(const std::vector<std::byte>& data);
-
-        RenderData getRenderData(const std::string& text,
-                                 Color color,
-                                 float fontSize,
-                                 const Vector<float, 2>& anchor) const final;
-
-        float getStringWidth(const std::string& text) const;
-
-    private:
-        std::int16_t getKerningPair(char32_t, char32_t) const;
-
         struct CharDescriptor final
         {
             std::int16_t x = 0;
@@ -35,6 +23,40 @@ namespace ouzel::gui
             std::int16_t page = 0;
         };
 
+        BMFont() = default;
+        explicit BMFont(Span<const std::byte> data);
+        BMFont(std::uint16_t initLineHeight,
+               std::uint16_t initBase,
+               std::uint16_t initWidth,
+               std::uint16_t initHeight,
+               std::uint16_t initPages,
+               std::uint16_t initOutline,
+               std::unordered_map<char32_t, CharDescriptor> initChars,
+               std::map<std::pair<char32_t, char32_t>, std::int16_t> initKern,
+               std::shared_ptr<graphics::Texture> initFontTexture):
+            lineHeight(initLineHeight),
+            base(initBase),
+            width(initWidth),
+            height(initHeight),
+            pages(initPages),
+            outline(initOutline),
+            kernCount(static_cast<std::uint16_t>(initKern.size())),
+            chars(std::move(initChars)),
+            kern(std::move(initKern)),
+            fontTexture(std::move(initFontTexture))
+        {
+        }
+
+        RenderData getRenderData(const std::string& text,
+                                 Color color,
+                                 float fontSize,
+                                 const Vector<float, 2>& anchor) const final;
+
+        float getStringWidth(const std::string& text) const;
+
+    private:
+        std::int16_t getKerningPair(char32_t, char32_t) const;
+
         std::uint16_t lineHeight = 0;
         std::uint16_t base = 0;
         std::uint16_t width = 0;
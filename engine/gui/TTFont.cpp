@@ -27,8 +27,8 @@
 
 namespace ouzel::gui
 {
-    TTFont::TTFont(const std::vector<std::byte>& initData, bool initMipmaps):
-        data(initData),
+    TTFont::TTFont(Span<const std::byte> initData, bool initMipmaps):
+        data(initData.begin(), initData.end()),
         mipmaps(initMipmaps)
     {
         const auto offset = stbtt_GetFontOffsetForIndex(reinterpret_cast<const unsigned char*>(data.data()), 0);
@@ -4,6 +4,7 @@
 #define OUZEL_GUI_TTFONT_HPP
 
 #include "../gui/Font.hpp"
+#include "../utils/Span.hpp"
 
 struct stbtt_fontinfo;
 
@@ -13,7 +14,7 @@ namespace ouzel::gui
     {
     public:
         TTFont() = default;
-        TTFont(const std::vector<std::byte>& newData, bool newMipmaps = true);
+        TTFont(Span<const std::byte> newData, bool newMipmaps = true);
 
         RenderData getRenderData(const std::string& text,
                                  Color color,
@@ -5,6 +5,8 @@
 #endif
 #include <algorithm>
 #include <functional>
+#include <iomanip>
+#include <sstream>
 #include "Widgets.hpp"
 #include "BMFont.hpp"
 #include "../core/Engine.hpp"
@@ -12,6 +14,7 @@
 #include "../events/EventDispatcher.hpp"
 #include "../math/Color.hpp"
 #include "../scene/Layer.hpp"
+#include "../utils/Profiler.hpp"
 #include "../scene/Camera.hpp"
 
 namespace ouzel::gui
@@ -598,6 +601,59 @@ namespace ouzel::gui
         return false;
     }
 
+    ProfilerOverlay::ProfilerOverlay(const std::string& fontFile,
+                                     float fontSize,
+                                     Color color,
+                                     std::size_t initFrameCount):
+        Label("", fontFile, fontSize, color, Vector<float, 2>{0.0F, 1.0F}),
+        frameCount(initFrameCount)
+    {
+        eventHandler.updateHandler = std::bind(&ProfilerOverlay::handleUpdate, this, std::placeholders::_1);
+
+        pickable = false;
+    }
+
+    void ProfilerOverlay::enter()
+    {
+        Label::enter();
+
+        engine->getEventDispatcher().addEventHandler(eventHandler);
+    }
+
+    void ProfilerOverlay::leave()
+    {
+        Label::leave();
+
+        eventHandler.remove();
+    }
+
+    bool ProfilerOverlay::handleUpdate(const UpdateEvent&)
+    {
+        // refresh once per summarized period, so that the text is readable
+        if (++updateCount < frameCount) return false;
+        updateCount = 0;
+
+        std::ostringstream summaryText;
+        summaryText << std::fixed << std::setprecision(2);
+
+        const std::string* threadName = nullptr;
+        for (const auto& summary : profiler.getSummary(frameCount))
+        {
+            if (!threadName || *threadName != summary.threadName)
+                summaryText << summary.threadName << '\n';
+            threadName = &summary.threadName;
+
+            summaryText << std::string(summary.depth * 2 + 2, ' ') << summary.name << ' ' <<
+                std::chrono::duration<float, std::milli>(summary.averageTime).count() << " ms (max " <<
+                std::chrono::duration<float, std::milli>(summary.maximumTime).count() << " ms, " <<
+                summary.callCount << " calls)\n";
+        }
+
+        setText(summaryText.str());
+
+        return false;
+    }
+
     RadioButton::RadioButton()
     {
         pickable = true;
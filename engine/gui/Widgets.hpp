@@ -164,6 +164,27 @@ namespace ouzel::gui
         EventHandler eventHandler;
     };
 
+    // shows the average time per frame spent in the profiler scopes during the last frames
+    class ProfilerOverlay: public Label
+    {
+    public:
+        ProfilerOverlay(const std::string& fontFile,
+                        float fontSize = 1.0F,
+                        Color color = Color::white(),
+                        std::size_t initFrameCount = 60);
+
+    protected:
+        void enter() override;
+        void leave() override;
+
+        bool handleUpdate(const UpdateEvent& event);
+
+        std::size_t frameCount;
+        std::size_t updateCount = 0;
+
+        EventHandler eventHandler;
+    };
+
     class RadioButton: public Widget
     {
     public:
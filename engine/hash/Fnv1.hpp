@@ -3,6 +3,7 @@
 #ifndef OUZEL_HASH_FNV1_HPP
 #define OUZEL_HASH_FNV1_HPP
 
+#include <cstddef>
 #include <cstdint>
 
 namespace ouzel::hash::fnv1
@@ -30,6 +31,16 @@ namespace ouzel::hash::fnv1
     {
         return (i < sizeof(Value)) ? hash<Result>(value, i + 1, (result * Constants<Result>::prime) ^ ((value >> (i * 8)) & 0xFF)) : result;
     }
+
+    // Hashes a sequence of bytes, e.g. a string literal at compile time
+    template <typename Result>
+    constexpr Result hashBytes(const char* data, const std::size_t size,
+                               Result result = Constants<Result>::offsetBasis) noexcept
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            result = (result * Constants<Result>::prime) ^ static_cast<std::uint8_t>(data[i]);
+        return result;
+    }
 }
 
 #endif // OUZEL_HASH_FNV1_HPP
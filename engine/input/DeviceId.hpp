@@ -15,6 +15,11 @@ namespace ouzel::input
         {
             return value == other.value;
         }
+
+        constexpr bool operator!=(DeviceId other) const noexcept
+        {
+            return value != other.value;
+        }
     };
 }
 
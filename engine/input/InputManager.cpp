@@ -16,6 +16,44 @@
 
 namespace ouzel::input
 {
+    namespace
+    {
+        bool isCoalescable(InputSystem::Event::Type type) noexcept
+        {
+            return type == InputSystem::Event::Type::mouseMove ||
+                type == InputSystem::Event::Type::mouseRelativeMove ||
+                type == InputSystem::Event::Type::mouseScroll ||
+                type == InputSystem::Event::Type::touchMove;
+        }
+
+        bool coalesce(InputSystem::Event& event, const InputSystem::Event& nextEvent) noexcept
+        {
+            if (event.type != nextEvent.type || event.deviceId != nextEvent.deviceId)
+                return false;
+
+            switch (nextEvent.type)
+            {
+                case InputSystem::Event::Type::mouseMove:
+                    event.position = nextEvent.position;
+                    return true;
+                case InputSystem::Event::Type::mouseRelativeMove:
+                    event.position += nextEvent.position;
+                    return true;
+                case InputSystem::Event::Type::mouseScroll:
+                    event.position = nextEvent.position;
+                    event.scroll += nextEvent.scroll;
+                    return true;
+                case InputSystem::Event::Type::touchMove:
+                    if (event.touchId != nextEvent.touchId) return false;
+                    event.position = nextEvent.position;
+                    event.force = nextEvent.force;
+                    return true;
+                default:
+                    return false;
+            }
+        }
+    }
+
     InputManager::InputManager():
 #if TARGET_OS_IOS
         inputSystem(std::bind(&InputManager::eventCallback, this, std::placeholders::_1))
@@ -39,30 +77,63 @@ namespace ouzel::input
 
     void InputManager::update()
     {
-        std::pair<std::promise<bool>, InputSystem::Event> p;
+        eventQueue.popAll([this](QueuedEvent& queuedEvent) {
+            receivedEvents.push_back(std::move(queuedEvent));
+        });
+
+        receivedEventCount += receivedEvents.size();
+        if (rawHistoryEnabled) rawHistory.clear();
 
-        for (;;)
+        for (auto& [event, promise] : receivedEvents)
         {
-            std::unique_lock lock(eventQueueMutex);
-            if (eventQueue.empty()) break;
+            const auto coalescable = isCoalescable(event.type);
+            if (rawHistoryEnabled && coalescable) rawHistory.push_back(event);
+
+            if (!coalescedPromises.empty() && coalesce(coalescedEvent, event))
+            {
+                coalescedPromises.push_back(std::move(*promise));
+                continue;
+            }
 
-            p = std::move(eventQueue.front());
-            eventQueue.pop();
-            lock.unlock();
+            dispatchCoalescedEvent();
 
-            p.first.set_value(handleEvent(p.second));
+            if (coalescing && coalescable)
+            {
+                coalescedEvent = event;
+                coalescedPromises.push_back(std::move(*promise));
+            }
+            else
+            {
+                ++dispatchedEventCount;
+                promise->set_value(handleEvent(event));
+            }
         }
+
+        dispatchCoalescedEvent();
+        receivedEvents.clear();
+    }
+
+    void InputManager::dispatchCoalescedEvent()
+    {
+        if (coalescedPromises.empty()) return;
+
+        ++dispatchedEventCount;
+        const auto handled = handleEvent(coalescedEvent);
+
+        for (auto& promise : coalescedPromises)
+            promise.set_value(handled);
+
+        coalescedPromises.clear();
     }
 
     std::future<bool> InputManager::eventCallback(const InputSystem::Event& event)
     {
-        std::pair<std::promise<bool>, InputSystem::Event> p(std::promise<bool>(), event);
-        std::future<bool> f = p.first.get_future();
+        std::promise<bool> promise;
+        std::future<bool> future = promise.get_future();
 
-        std::lock_guard lock(eventQueueMutex);
-        eventQueue.push(std::move(p));
+        eventQueue.push(QueuedEvent{event, std::move(promise)});
 
-        return f;
+        return future;
     }
 
     bool InputManager::handleEvent(const InputSystem::Event& event)
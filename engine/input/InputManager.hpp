@@ -6,12 +6,15 @@
 #if defined(__APPLE__)
 #  include <TargetConditionals.h>
 #endif
+#include <cstddef>
+#include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <vector>
 #include <unordered_map>
 #include "../math/Vector.hpp"
+#include "../thread/OverflowMpscQueue.hpp"
 
 #if TARGET_OS_IOS
 #  include "ios/InputSystemIOS.hpp"
@@ -63,12 +66,49 @@ namespace ouzel::input
         void showVirtualKeyboard();
         void hideVirtualKeyboard();
 
+        // merges consecutive mouse moves, scrolls and touch moves of the same device
+        // into one event per update, the positions are taken from the last event and the deltas are summed
+        auto isCoalescing() const noexcept { return coalescing; }
+        void setCoalescing(bool newCoalescing) noexcept { coalescing = newCoalescing; }
+
+        // raw mouse move, scroll and touch move events received during the last update
+        auto isRawHistoryEnabled() const noexcept { return rawHistoryEnabled; }
+        void setRawHistoryEnabled(bool enabled)
+        {
+            rawHistoryEnabled = enabled;
+            if (!enabled) rawHistory.clear();
+        }
+        auto& getRawHistory() const noexcept { return rawHistory; }
+
+        auto getReceivedEventCount() const noexcept { return receivedEventCount; }
+        auto getDispatchedEventCount() const noexcept { return dispatchedEventCount; }
+
     private:
+        struct QueuedEvent final
+        {
+            InputSystem::Event event;
+            std::optional<std::promise<bool>> promise;
+        };
+
         std::future<bool> eventCallback(const InputSystem::Event& event);
         bool handleEvent(const InputSystem::Event& event);
+        void dispatchCoalescedEvent();
+
+        // events are sent from the platform input threads
+        static constexpr std::size_t eventQueueCapacity = 1024;
+        thread::OverflowMpscQueue<QueuedEvent> eventQueue{eventQueueCapacity};
+
+        std::vector<QueuedEvent> receivedEvents;
+
+        bool coalescing = false;
+        InputSystem::Event coalescedEvent;
+        std::vector<std::promise<bool>> coalescedPromises;
+
+        bool rawHistoryEnabled = false;
+        std::vector<InputSystem::Event> rawHistory;
 
-        std::mutex eventQueueMutex;
-        std::queue<std::pair<std::promise<bool>, InputSystem::Event>> eventQueue;
+        std::size_t receivedEventCount = 0;
+        std::size_t dispatchedEventCount = 0;
 
 #if TARGET_OS_IOS
         ios::InputSystem inputSystem;
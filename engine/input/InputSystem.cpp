@@ -23,11 +23,13 @@ namespace ouzel::input
 
     void InputSystem::addInputDevice(InputDevice& inputDevice)
     {
+        std::lock_guard lock(inputDevicesMutex);
         inputDevices.insert(std::pair(inputDevice.getId(), &inputDevice));
     }
 
     void InputSystem::removeInputDevice(const InputDevice& inputDevice)
     {
+        std::lock_guard lock(inputDevicesMutex);
         const auto i = inputDevices.find(inputDevice.getId());
 
         if (i != inputDevices.end())
@@ -36,6 +38,7 @@ namespace ouzel::input
 
     InputDevice* InputSystem::getInputDevice(DeviceId id)
     {
+        std::lock_guard lock(inputDevicesMutex);
         const auto i = inputDevices.find(id);
 
         if (i != inputDevices.end())
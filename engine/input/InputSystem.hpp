@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <future>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -160,6 +161,9 @@ namespace ouzel::input
         virtual void executeCommand(const Command&) {}
 
         std::function<std::future<bool>(const Event&)> callback;
+
+        // devices can be added and removed on a platform input thread
+        std::mutex inputDevicesMutex;
         std::unordered_map<DeviceId, InputDevice*> inputDevices;
 
         std::size_t lastResourceId = 0;
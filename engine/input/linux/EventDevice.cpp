@@ -224,7 +224,7 @@ namespace ouzel::input::linux
     EventDevice::EventDevice(InputSystem& inputSystem, const std::string& initFilename):
         filename(initFilename)
     {
-        while ((fd = open(filename.c_str(), O_RDONLY)) == -1)
+        while ((fd = open(filename.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC)) == -1)
             if (errno != EINTR)
                 throw std::system_error(errno, std::system_category(), "Failed to open device file");
 
@@ -409,7 +409,10 @@ namespace ouzel::input::linux
             bytesRead = read(fd, buffer + bufferSize, sizeof(buffer) - bufferSize);
 
         if (bytesRead == -1)
+        {
+            if (errno == EAGAIN) return;
             throw std::system_error(errno, std::system_category(), "Failed to read from " + filename);
+        }
 
         bufferSize += static_cast<std::size_t>(bytesRead);
 
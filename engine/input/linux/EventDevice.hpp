@@ -37,6 +37,7 @@ namespace ouzel::input::linux
         void update();
 
         auto getFd() const noexcept { return fd; }
+        auto& getFilename() const noexcept { return filename; }
 
     private:
         void handleAxisChange(std::int32_t oldValue, std::int32_t newValue,
@@ -1,6 +1,8 @@
 // Ouzel by Elviss Strazdins
 
 #include "../../core/Setup.h"
+#include <array>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <system_error>
@@ -8,6 +10,9 @@
 #include <dirent.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include <linux/joystick.h>
 #if OUZEL_SUPPORTS_X11
 #  include <X11/cursorfont.h>
@@ -16,9 +21,30 @@
 #include "CursorLinux.hpp"
 #include "../../core/linux/EngineLinux.hpp"
 #include "../../core/linux/NativeWindowLinux.hpp"
+#include "../../utils/Log.hpp"
+#include "../../utils/Utils.hpp"
 
 namespace ouzel::input::linux
 {
+    namespace
+    {
+        constexpr const char* inputDirectory = "/dev/input";
+
+        bool isEventDeviceName(const char* name) noexcept
+        {
+            return std::strncmp("event", name, 5) == 0;
+        }
+
+        void addToEpoll(int epollFd, int fd)
+        {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1)
+                throw std::system_error(errno, std::system_category(), "Failed to add file descriptor to epoll");
+        }
+    }
+
     InputSystem::InputSystem(const std::function<std::future<bool>(const Event&)>& initCallback):
 #if OUZEL_SUPPORTS_X11
         input::InputSystem(initCallback),
@@ -46,30 +72,57 @@ namespace ouzel::input::linux
         }
 #endif
 
-        using CloseDirFunction = int(*)(DIR*);
-        std::unique_ptr<DIR, CloseDirFunction> dir(opendir("/dev/input"), closedir);
-        if (!dir)
-            throw std::system_error(errno, std::system_category(), "Failed to open directory");
+        try
+        {
+            epollFd = epoll_create1(EPOLL_CLOEXEC);
+            if (epollFd == -1)
+                throw std::system_error(errno, std::system_category(), "Failed to create epoll instance");
 
-        while (const dirent* ent = readdir(dir.get()))
+            wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (wakeFd == -1)
+                throw std::system_error(errno, std::system_category(), "Failed to create eventfd");
+
+            addToEpoll(epollFd, wakeFd);
+
+            notifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+            if (notifyFd == -1)
+                throw std::system_error(errno, std::system_category(), "Failed to initialize inotify");
+
+            // device nodes are readable only after udev has set their permissions, so watch for attribute changes too
+            if (inotify_add_watch(notifyFd, inputDirectory, IN_CREATE | IN_ATTRIB | IN_DELETE) == -1)
+                throw std::system_error(errno, std::system_category(), "Failed to watch input directory");
+
+            addToEpoll(epollFd, notifyFd);
+
+            scanDevices();
+        }
+        catch (...)
         {
-            if (std::strncmp("event", ent->d_name, 5) == 0)
-            {
-                try
-                {
-                    std::string filename = std::string("/dev/input/") + ent->d_name;
-                    auto eventDevice = std::make_unique<EventDevice>(*this, filename);
-                    eventDevices.insert(std::pair(eventDevice->getFd(), std::move(eventDevice)));
-                }
-                catch (const std::exception&)
-                {
-                }
-            }
+            eventDevices.clear();
+            closeDescriptors();
+            throw;
         }
+
+        running = true;
+        inputThread = thread::Thread{&InputSystem::run, this};
     }
 
     InputSystem::~InputSystem()
     {
+        running = false;
+
+        if (inputThread.isJoinable())
+        {
+            const std::uint64_t value = 1;
+            if (write(wakeFd, &value, sizeof(value)) == -1)
+                logger.log(Log::Level::error) << "Failed to wake the input thread";
+
+            inputThread.join();
+        }
+
+        eventDevices.clear();
+        closeDescriptors();
+
 #if OUZEL_SUPPORTS_X11
         auto engineLinux = static_cast<core::linux::Engine*>(engine);
         if (emptyCursor != None) XFreeCursor(engineLinux->getDisplay(), emptyCursor);
@@ -81,10 +134,15 @@ namespace ouzel::input::linux
         switch (command.type)
         {
             case Command::Type::startDeviceDiscovery:
-                discovering = true;
+            {
+                // new devices are found through inotify, but rescan the ones that could not be opened before
+                rescan = true;
+                const std::uint64_t value = 1;
+                if (write(wakeFd, &value, sizeof(value)) == -1)
+                    throw std::system_error(errno, std::system_category(), "Failed to wake the input thread");
                 break;
+            }
             case Command::Type::stopDeviceDiscovery:
-                discovering = false;
                 break;
             case Command::Type::setPlayerIndex:
             {
@@ -176,74 +234,153 @@ namespace ouzel::input::linux
         }
     }
 
-    void InputSystem::update()
+    void InputSystem::run()
     {
-        fd_set rfds;
-        struct timeval tv;
-        tv.tv_sec = 0;
-        tv.tv_usec = 0;
+        thread::setCurrentThreadName("Input");
 
-        FD_ZERO(&rfds);
+        std::array<epoll_event, 16> events;
 
-        int maxFd = 0;
-
-        for (const auto& i : eventDevices)
+        while (running)
         {
-            FD_SET(i.first, &rfds);
-            if (i.first > maxFd) maxFd = i.first;
-        }
+            const auto eventCount = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
 
-        int retval;
-        if ((retval = select(maxFd + 1, &rfds, nullptr, nullptr, &tv)) == -1)
-            throw std::system_error(errno, std::system_category(), "Select failed");
+            if (eventCount == -1)
+            {
+                if (errno == EINTR) continue;
+                logger.log(Log::Level::error) << "Failed to wait for input events";
+                break;
+            }
 
-        if (retval > 0)
-        {
-            for (auto i = eventDevices.begin(); i != eventDevices.end();)
+            for (int i = 0; i < eventCount; ++i)
             {
-                if (FD_ISSET(i->first, &rfds))
+                const auto fd = events[static_cast<std::size_t>(i)].data.fd;
+
+                if (fd == wakeFd)
+                {
+                    std::uint64_t value;
+                    while (read(wakeFd, &value, sizeof(value)) == -1 && errno == EINTR);
+                }
+                else if (fd == notifyFd)
                 {
                     try
                     {
-                        i->second->update();
-                        ++i;
+                        handleNotifyEvents();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        logger.log(Log::Level::error) << e.what();
+                    }
+                }
+                else if (const auto eventDevice = eventDevices.find(fd); eventDevice != eventDevices.end())
+                {
+                    try
+                    {
+                        eventDevice->second->update();
                     }
                     catch (const std::exception&)
                     {
-                        i = eventDevices.erase(i);
+                        removeEventDevice(fd);
                     }
                 }
-                else
-                    ++i;
             }
+
+            if (rescan.exchange(false))
+            {
+                try
+                {
+                    scanDevices();
+                }
+                catch (const std::exception& e)
+                {
+                    logger.log(Log::Level::error) << e.what();
+                }
+            }
+        }
+    }
+
+    void InputSystem::scanDevices()
+    {
+        using CloseDirFunction = int(*)(DIR*);
+        std::unique_ptr<DIR, CloseDirFunction> dir(opendir(inputDirectory), closedir);
+
+        if (!dir)
+            throw std::system_error(errno, std::system_category(), "Failed to open directory");
+
+        while (const dirent* ent = readdir(dir.get()))
+            if (isEventDeviceName(ent->d_name))
+                addEventDevice(std::string(inputDirectory) + '/' + ent->d_name);
+    }
+
+    void InputSystem::addEventDevice(const std::string& filename)
+    {
+        for (const auto& i : eventDevices)
+            if (i.second->getFilename() == filename)
+                return;
+
+        try
+        {
+            auto eventDevice = std::make_unique<EventDevice>(*this, filename);
+            addToEpoll(epollFd, eventDevice->getFd());
+            eventDevices.insert(std::pair(eventDevice->getFd(), std::move(eventDevice)));
+        }
+        catch (const std::exception&)
+        {
         }
+    }
 
-        if (discovering)
+    void InputSystem::removeEventDevice(int fd)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        eventDevices.erase(fd);
+    }
+
+    void InputSystem::handleNotifyEvents()
+    {
+        alignas(inotify_event) char buffer[4096];
+
+        for (;;)
         {
-            using CloseDirFunction = int(*)(DIR*);
-            std::unique_ptr<DIR, CloseDirFunction> dir(opendir("/dev/input"), closedir);
+            const auto bytesRead = read(notifyFd, buffer, sizeof(buffer));
 
-            if (!dir)
-                throw std::system_error(errno, std::system_category(), "Failed to open directory");
+            if (bytesRead == -1)
+            {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN) break;
+                throw std::system_error(errno, std::system_category(), "Failed to read inotify events");
+            }
 
-            while (const dirent* ent = readdir(dir.get()))
+            for (auto i = buffer; i < buffer + bytesRead;)
             {
-                if (std::strncmp("event", ent->d_name, 5) == 0)
+                const auto& event = *bitCast<const inotify_event*>(i);
+                i += sizeof(inotify_event) + event.len;
+
+                if (!event.len || !isEventDeviceName(event.name)) continue;
+
+                const auto filename = std::string(inputDirectory) + '/' + event.name;
+
+                if (event.mask & IN_DELETE)
                 {
-                    try
-                    {
-                        std::string filename = std::string("/dev/input/") + ent->d_name;
-                        auto eventDevice = std::make_unique<EventDevice>(*this, filename);
-                        eventDevices.insert(std::pair(eventDevice->getFd(), std::move(eventDevice)));
-                    }
-                    catch (const std::exception&)
-                    {
-                    }
+                    for (const auto& eventDevice : eventDevices)
+                        if (eventDevice.second->getFilename() == filename)
+                        {
+                            removeEventDevice(eventDevice.first);
+                            break;
+                        }
                 }
+                else
+                    addEventDevice(filename);
             }
         }
     }
 
+    void InputSystem::closeDescriptors() noexcept
+    {
+        if (notifyFd != -1) close(notifyFd);
+        if (wakeFd != -1) close(wakeFd);
+        if (epollFd != -1) close(epollFd);
+        notifyFd = wakeFd = epollFd = -1;
+    }
+
 #if OUZEL_SUPPORTS_X11
     void InputSystem::updateCursor() const
     {
@@ -3,7 +3,9 @@
 #ifndef OUZEL_INPUT_INPUTSYSTEMLINUX_HPP
 #define OUZEL_INPUT_INPUTSYSTEMLINUX_HPP
 
+#include <atomic>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include "../../core/Setup.h"
 #if OUZEL_SUPPORTS_X11
@@ -14,6 +16,7 @@
 #include "EventDevice.hpp"
 #include "KeyboardDeviceLinux.hpp"
 #include "MouseDeviceLinux.hpp"
+#include "../../thread/Thread.hpp"
 
 namespace ouzel::input::linux
 {
@@ -35,17 +38,22 @@ namespace ouzel::input::linux
             return lastDeviceId;
         }
 
-        void update();
-
     private:
         void executeCommand(const Command& command) final;
 
+        // event devices are read on the input thread, which sleeps in epoll_wait until
+        // a device has data, a device node is created in /dev/input or the system is destroyed
+        void run();
+        void scanDevices();
+        void addEventDevice(const std::string& filename);
+        void removeEventDevice(int fd);
+        void handleNotifyEvents();
+        void closeDescriptors() noexcept;
+
 #if OUZEL_SUPPORTS_X11
         void updateCursor() const;
 #endif
 
-        bool discovering = false;
-
         DeviceId lastDeviceId;
         std::unique_ptr<KeyboardDevice> keyboardDevice;
         std::unique_ptr<MouseDevice> mouseDevice;
@@ -54,6 +62,13 @@ namespace ouzel::input::linux
         std::unordered_map<int, std::unique_ptr<EventDevice>> eventDevices;
         std::vector<std::unique_ptr<Cursor>> cursors;
 
+        int epollFd = -1;
+        int notifyFd = -1;
+        int wakeFd = -1; // eventfd used to wake the input thread
+        std::atomic<bool> rescan{false};
+        std::atomic<bool> running{false};
+        thread::Thread inputThread;
+
 #if OUZEL_SUPPORTS_X11
         ::Cursor emptyCursor = None;
 #endif
@@ -22,9 +22,14 @@ LOCAL_SRC_FILES := ../assets/BmfLoader.cpp \
     ../assets/Bundle.cpp \
     ../assets/Cache.cpp \
     ../assets/ColladaLoader.cpp \
+    ../assets/CookedFontLoader.cpp \
+    ../assets/CookedMeshLoader.cpp \
+    ../assets/CookedSpriteLoader.cpp \
+    ../assets/CookedTextureLoader.cpp \
     ../assets/CueLoader.cpp \
     ../assets/GltfLoader.cpp \
     ../assets/ImageLoader.cpp \
+    ../assets/LoadTask.cpp \
     ../assets/MtlLoader.cpp \
     ../assets/ObjLoader.cpp \
     ../assets/ParticleSystemLoader.cpp \
@@ -34,6 +39,12 @@ LOCAL_SRC_FILES := ../assets/BmfLoader.cpp \
     ../assets/WaveLoader.cpp \
     ../audio/mixer/Bus.cpp \
     ../audio/mixer/Mixer.cpp \
+    ../audio/mixer/VoiceManager.cpp \
+    ../audio/mixer/Graph.cpp \
+    ../audio/offline/OfflineAudioDevice.cpp \
+    ../audio/dsp/PitchShifter.cpp \
+    ../audio/dsp/FeedbackDelayNetwork.cpp \
+    ../audio/dsp/Biquad.cpp \
     ../audio/opensl/OSLAudioDevice.cpp \
     ../audio/Audio.cpp \
     ../audio/AudioDevice.cpp \
@@ -55,6 +66,8 @@ LOCAL_SRC_FILES := ../assets/BmfLoader.cpp \
     ../core/android/NativeWindowAndroid.cpp \
     ../core/android/SystemAndroid.cpp \
     ../core/Engine.cpp \
+    ../core/FrameScheduler.cpp \
+    ../core/headless/EngineHeadless.cpp \
     ../core/NativeWindow.cpp \
     ../core/System.cpp \
     ../core/Window.cpp \
@@ -115,7 +128,11 @@ LOCAL_SRC_FILES := ../assets/BmfLoader.cpp \
     ../scene/StaticMeshRenderer.cpp \
     ../scene/TextRenderer.cpp \
     ../storage/FileSystem.cpp \
-    ../utils/Log.cpp
+    ../storage/Inflate.cpp \
+    ../storage/Archive.cpp \
+    ../thread/JobSystem.cpp \
+    ../utils/Log.cpp \
+    ../utils/Profiler.cpp
 
 include $(BUILD_STATIC_LIBRARY)
 $(call import-module, android/cpufeatures)
\ No newline at end of file
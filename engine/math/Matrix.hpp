@@ -758,11 +758,11 @@ namespace ouzel
 
         void transpose(Matrix& dst) const noexcept
         {
-            const std::array<T, C * R> t;
+            std::array<T, C * R> t;
 
             for (std::size_t column = 0; column < C; ++column)
-                for (std::size_t row = 0; row < C; ++row)
-                    t[row * C + column] = t[column * R + row];
+                for (std::size_t row = 0; row < R; ++row)
+                    t[row * C + column] = m[column * R + row];
 
             std::copy(t.begin(), t.end(), dst.m.begin());
         }
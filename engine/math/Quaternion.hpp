@@ -175,7 +175,7 @@ namespace ouzel
 
         constexpr void invert() noexcept
         {
-            constexpr T squared = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]; // norm squared
+            const T squared = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]; // norm squared
             if (squared <= std::numeric_limits<T>::min())
                 return;
 
@@ -198,7 +198,7 @@ namespace ouzel
 
         void normalize() noexcept
         {
-            constexpr T squared = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
+            const T squared = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
             if (squared == T(1)) // already normalized
                 return;
 
@@ -215,7 +215,7 @@ namespace ouzel
 
         Quaternion normalized() const noexcept
         {
-            constexpr T squared = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
+            const T squared = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
             if (squared == T(1)) // already normalized
                 return *this;
 
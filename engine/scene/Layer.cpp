@@ -10,6 +10,7 @@
 #include "../core/Engine.hpp"
 #include "../graphics/Graphics.hpp"
 #include "../math/Matrix.hpp"
+#include "../utils/Profiler.hpp"
 
 namespace ouzel::scene
 {
@@ -29,8 +30,13 @@ namespace ouzel::scene
         {
             std::vector<Actor*> drawQueue;
 
-            for (const auto actor : children)
-                actor->visit(drawQueue, Matrix<float, 4>::identity(), false, camera, 0, false);
+            {
+                OUZEL_PROFILE_SCOPE("Layer::visit");
+                for (const auto actor : children)
+                    actor->visit(drawQueue, Matrix<float, 4>::identity(), false, camera, 0, false);
+            }
+
+            OUZEL_PROFILE_SCOPE("Layer::draw");
 
             engine->getGraphics()->setRenderTarget(camera->getRenderTarget() ? camera->getRenderTarget()->getResource() : 0);
             engine->getGraphics()->setViewport(camera->getRenderViewport());
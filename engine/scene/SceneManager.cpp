@@ -5,6 +5,7 @@
 #include "SceneManager.hpp"
 #include "Scene.hpp"
 #include "Actor.hpp"
+#include "../utils/Profiler.hpp"
 
 namespace ouzel::scene
 {
@@ -55,6 +56,8 @@ namespace ouzel::scene
 
     void SceneManager::draw()
     {
+        OUZEL_PROFILE_SCOPE("SceneManager::draw");
+
         while (scenes.size() > 1)
             removeScene(*scenes.front());
 
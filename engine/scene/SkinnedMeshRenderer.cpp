@@ -10,7 +10,8 @@ namespace ouzel::scene
         whitePixelTexture = engine->getCache().getTexture(textureWhitePixel);
     }
 
-    SkinnedMeshRenderer::SkinnedMeshRenderer(const SkinnedMeshData& meshData)
+    SkinnedMeshRenderer::SkinnedMeshRenderer(const SkinnedMeshData& meshData):
+        SkinnedMeshRenderer()
     {
         init(meshData);
     }
@@ -19,6 +20,7 @@ namespace ouzel::scene
     {
         boundingBox = meshData.boundingBox;
         material = meshData.material;
+        parts = &meshData.parts;
     }
 
     void SkinnedMeshRenderer::draw(const Matrix<float, 4>& transformMatrix,
@@ -30,5 +32,56 @@ namespace ouzel::scene
                         opacity,
                         renderViewProjection,
                         wireframe);
+
+        if (!parts) return;
+
+        const auto modelViewProj = renderViewProjection * transformMatrix;
+
+        std::vector<std::vector<float>> vertexShaderConstants(1);
+        vertexShaderConstants[0] = {std::begin(modelViewProj.m), std::end(modelViewProj.m)};
+
+        auto& cache = engine->getCache();
+
+        // the parts are drawn in the bind pose
+        for (const auto& part : *parts)
+        {
+            const auto partMaterial = material ? material.get() : part.material.get();
+
+            const auto diffuseColor = partMaterial ? partMaterial->diffuseColor : Color::white();
+            const float colorVector[] = {
+                diffuseColor.normR(),
+                diffuseColor.normG(),
+                diffuseColor.normB(),
+                diffuseColor.normA() * opacity * (partMaterial ? partMaterial->opacity : 1.0F)
+            };
+
+            std::vector<std::vector<float>> fragmentShaderConstants(1);
+            fragmentShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
+
+            std::vector<std::size_t> textures;
+            if (partMaterial)
+                for (const std::shared_ptr<graphics::Texture>& texture : partMaterial->textures)
+                    textures.push_back(texture ? texture->getResource() : 0);
+            else
+                textures.push_back(whitePixelTexture ? whitePixelTexture->getResource() : 0);
+
+            const auto blendState = partMaterial ? partMaterial->blendState : cache.getBlendState(blendAlpha);
+            const auto shader = partMaterial ? partMaterial->shader : cache.getShader(shaderTexture);
+            if (!blendState || !shader) continue;
+
+            engine->getGraphics()->setPipelineState(blendState->getResource(),
+                                                    shader->getResource(),
+                                                    partMaterial ? partMaterial->cullMode : graphics::CullMode::back,
+                                                    wireframe ? graphics::FillMode::wireframe : graphics::FillMode::solid);
+            engine->getGraphics()->setShaderConstants(fragmentShaderConstants,
+                                                      vertexShaderConstants);
+            engine->getGraphics()->setTextures(textures);
+            engine->getGraphics()->draw(part.indexBuffer.getResource(),
+                                        part.indexCount,
+                                        part.indexSize,
+                                        part.vertexBuffer.getResource(),
+                                        graphics::DrawMode::triangleList,
+                                        0);
+        }
     }
 }
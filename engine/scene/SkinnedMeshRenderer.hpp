@@ -3,8 +3,12 @@
 #ifndef OUZEL_SCENE_SKINNEDMESHRENDERER_HPP
 #define OUZEL_SCENE_SKINNEDMESHRENDERER_HPP
 
+#include <array>
+#include <limits>
+#include <string>
 #include <vector>
 #include "../scene/Component.hpp"
+#include "../graphics/Buffer.hpp"
 #include "../graphics/Material.hpp"
 
 namespace ouzel::scene
@@ -12,11 +16,63 @@ namespace ouzel::scene
     class SkinnedMeshData final
     {
     public:
+        static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
         struct Bone final
         {
-            Bone* parent = nullptr;
+            std::string name;
+            std::size_t parent = none;
             Vector<float, 3> position;
-            Quaternion<float> rotation;
+            Quaternion<float> rotation = Quaternion<float>::identity();
+            Vector<float, 3> scale{1.0F, 1.0F, 1.0F};
+        };
+
+        struct Skin final
+        {
+            std::vector<std::size_t> bones;
+            std::vector<Matrix<float, 4>> inverseBindMatrices;
+        };
+
+        struct Part final
+        {
+            std::uint32_t indexCount = 0;
+            std::uint32_t indexSize = 0;
+            graphics::Buffer indexBuffer;
+            graphics::Buffer vertexBuffer;
+            std::shared_ptr<graphics::Material> material;
+            std::size_t skin = none;
+            std::vector<std::array<std::uint16_t, 4>> joints;
+            std::vector<std::array<float, 4>> weights;
+        };
+
+        struct Channel final
+        {
+            enum class Path
+            {
+                position,
+                rotation,
+                scale
+            };
+
+            enum class Interpolation
+            {
+                linear,
+                step,
+                cubicSpline
+            };
+
+            std::size_t bone = none;
+            Path path = Path::position;
+            Interpolation interpolation = Interpolation::linear;
+            std::vector<float> times;
+            std::vector<float> values;
+        };
+
+        struct Animation final
+        {
+            std::string name;
+            float duration = 0.0F;
+            std::vector<Channel> channels;
         };
 
         SkinnedMeshData() = default;
@@ -29,6 +85,10 @@ namespace ouzel::scene
 
         Box<float, 3> boundingBox;
         std::shared_ptr<graphics::Material> material;
+        std::vector<Bone> bones;
+        std::vector<Skin> skins;
+        std::vector<Part> parts;
+        std::vector<Animation> animations;
     };
 
     class SkinnedMeshRenderer: public Component
@@ -50,6 +110,7 @@ namespace ouzel::scene
     private:
         std::shared_ptr<graphics::Material> material;
         std::shared_ptr<graphics::Texture> whitePixelTexture;
+        const std::vector<SkinnedMeshData::Part>* parts = nullptr;
     };
 }
 
@@ -148,6 +148,27 @@ namespace ouzel::scene
                                                           static_cast<std::uint32_t>(getVectorSize(vertices)));
     }
 
+    SpriteData::Frame::Frame(const std::string& frameName,
+                             const Box<float, 2>& initBoundingBox,
+                             Span<const std::byte> indexData,
+                             Span<const std::byte> vertexData):
+        name(frameName),
+        boundingBox(initBoundingBox),
+        indexCount(static_cast<std::uint32_t>(indexData.size() / sizeof(std::uint16_t)))
+    {
+        indexBuffer = std::make_shared<graphics::Buffer>(*engine->getGraphics(),
+                                                         graphics::BufferType::index,
+                                                         graphics::Flags::none,
+                                                         indexData.data(),
+                                                         static_cast<std::uint32_t>(indexData.size()));
+
+        vertexBuffer = std::make_shared<graphics::Buffer>(*engine->getGraphics(),
+                                                          graphics::BufferType::vertex,
+                                                          graphics::Flags::none,
+                                                          vertexData.data(),
+                                                          static_cast<std::uint32_t>(vertexData.size()));
+    }
+
     SpriteRenderer::SpriteRenderer()
     {
         updateHandler.updateHandler = [this](const UpdateEvent& event) {
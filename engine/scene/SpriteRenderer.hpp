@@ -19,6 +19,7 @@
 #include "../graphics/Shader.hpp"
 #include "../graphics/Texture.hpp"
 #include "../graphics/Vertex.hpp"
+#include "../utils/Span.hpp"
 
 namespace ouzel::scene
 {
@@ -48,6 +49,12 @@ namespace ouzel::scene
                   const Vector<float, 2>& sourceOffset,
                   const Vector<float, 2>& pivot);
 
+            // Index (16-bit) and vertex data that is ready to be uploaded, e.g. from a cooked sprite
+            Frame(const std::string& frameName,
+                  const Box<float, 2>& initBoundingBox,
+                  Span<const std::byte> indexData,
+                  Span<const std::byte> vertexData);
+
             auto& getName() const noexcept { return name; }
 
             auto& getBoundingBox() const noexcept { return boundingBox; }
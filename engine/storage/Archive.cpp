@@ -0,0 +1,404 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include "Archive.hpp"
+#include "Inflate.hpp"
+#include "../utils/Utils.hpp"
+
+namespace ouzel::storage
+{
+    namespace
+    {
+        constexpr std::uint32_t localHeaderSignature = 0x04034B50U;
+        constexpr std::uint32_t centralDirectorySignature = 0x02014B50U;
+        constexpr std::uint32_t endOfCentralDirectorySignature = 0x06054B50U;
+        constexpr std::uint32_t zip64EndOfCentralDirectorySignature = 0x06064B50U;
+        constexpr std::uint32_t zip64LocatorSignature = 0x07064B50U;
+        constexpr std::uint16_t zip64ExtraFieldId = 0x0001U;
+
+        constexpr std::size_t localHeaderSize = 30;
+        constexpr std::size_t centralDirectoryHeaderSize = 46;
+        constexpr std::size_t endOfCentralDirectorySize = 22;
+        constexpr std::size_t zip64EndOfCentralDirectorySize = 56;
+        constexpr std::size_t zip64LocatorSize = 20;
+        constexpr std::size_t maxCommentSize = 0xFFFF;
+
+        constexpr std::uint16_t encryptedFlag = 0x0001U;
+        constexpr std::uint16_t storedCompression = 0;
+        constexpr std::uint16_t deflateCompression = 8;
+
+        std::size_t toSize(std::uint64_t size)
+        {
+            if (size > std::numeric_limits<std::size_t>::max())
+                throw std::runtime_error("Archive entry too big");
+            return static_cast<std::size_t>(size);
+        }
+    }
+
+    Archive::Archive(const Path& path)
+    {
+        try
+        {
+            mappedFile = MappedFile{path};
+            fileSize = mappedFile.getSize();
+        }
+        catch (const std::system_error&)
+        {
+            // fall back to positional reads
+#if defined(_WIN32)
+            file = CreateFileW(path.getNative().c_str(), GENERIC_READ, FILE_SHARE_READ,
+                               nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw std::system_error(GetLastError(), std::system_category(), "Failed to open file");
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size))
+            {
+                const auto error = GetLastError();
+                closeFile();
+                throw std::system_error(error, std::system_category(), "Failed to get file size");
+            }
+
+            fileSize = static_cast<std::uint64_t>(size.QuadPart);
+#else
+            file = open(path.getNative().c_str(), O_RDONLY | O_CLOEXEC);
+            if (file == -1)
+                throw std::system_error(errno, std::system_category(), "Failed to open file");
+
+            struct stat buf;
+            if (fstat(file, &buf) == -1)
+            {
+                const auto error = errno;
+                closeFile();
+                throw std::system_error(error, std::system_category(), "Failed to get file size");
+            }
+
+            fileSize = static_cast<std::uint64_t>(buf.st_size);
+#endif
+        }
+
+        try
+        {
+            readCentralDirectory();
+        }
+        catch (...)
+        {
+            closeFile();
+            throw;
+        }
+    }
+
+    Archive::~Archive()
+    {
+        closeFile();
+    }
+
+    Archive::Archive(Archive&& other) noexcept:
+        mappedFile(std::move(other.mappedFile)),
+        file(other.file),
+        fileSize(other.fileSize),
+        entries(std::move(other.entries)),
+        slots(std::move(other.slots)),
+        slotMask(other.slotMask)
+    {
+#if defined(_WIN32)
+        other.file = INVALID_HANDLE_VALUE;
+#else
+        other.file = -1;
+#endif
+        other.fileSize = 0;
+        other.slotMask = 0;
+    }
+
+    Archive& Archive::operator=(Archive&& other) noexcept
+    {
+        if (&other == this) return *this;
+
+        closeFile();
+
+        mappedFile = std::move(other.mappedFile);
+        file = other.file;
+        fileSize = other.fileSize;
+        entries = std::move(other.entries);
+        slots = std::move(other.slots);
+        slotMask = other.slotMask;
+
+#if defined(_WIN32)
+        other.file = INVALID_HANDLE_VALUE;
+#else
+        other.file = -1;
+#endif
+        other.fileSize = 0;
+        other.slotMask = 0;
+
+        return *this;
+    }
+
+    void Archive::closeFile() noexcept
+    {
+#if defined(_WIN32)
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (file != -1) close(file);
+        file = -1;
+#endif
+    }
+
+    void Archive::read(std::uint64_t offset, std::size_t size, std::byte* destination) const
+    {
+        if (offset > fileSize || size > fileSize - offset)
+            throw std::runtime_error("Read past the end of the archive");
+
+        if (size == 0) return;
+
+        if (mappedFile.isMapped())
+        {
+            std::memcpy(destination, mappedFile.getData() + offset, size);
+            return;
+        }
+
+        // positional reads do not share a file position, so they can run concurrently
+        while (size > 0)
+        {
+#if defined(_WIN32)
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFU);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+            DWORD bytesRead;
+            if (!ReadFile(file, destination, static_cast<DWORD>(std::min(size, std::size_t{0x40000000U})),
+                          &bytesRead, &overlapped))
+                throw std::system_error(GetLastError(), std::system_category(), "Failed to read from file");
+#else
+            const auto bytesRead = pread(file, destination, size, static_cast<off_t>(offset));
+            if (bytesRead == -1)
+            {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::system_category(), "Failed to read from file");
+            }
+#endif
+            if (bytesRead == 0)
+                throw std::runtime_error("Unexpected end of file");
+
+            destination += bytesRead;
+            offset += static_cast<std::uint64_t>(bytesRead);
+            size -= static_cast<std::size_t>(bytesRead);
+        }
+    }
+
+    void Archive::readCentralDirectory()
+    {
+        if (fileSize < endOfCentralDirectorySize)
+            throw std::runtime_error("Not a zip archive");
+
+        // the end of central directory record is at the end of the file, followed only by a comment
+        const auto tailSize = static_cast<std::size_t>(std::min(fileSize, std::uint64_t{endOfCentralDirectorySize + maxCommentSize}));
+        const auto tailOffset = fileSize - tailSize;
+        std::vector<std::byte> tail(tailSize);
+        read(tailOffset, tailSize, tail.data());
+
+        auto recordOffset = tailSize - endOfCentralDirectorySize;
+        while (decodeLittleEndian<std::uint32_t>(tail.data() + recordOffset) != endOfCentralDirectorySignature)
+        {
+            if (recordOffset == 0)
+                throw std::runtime_error("Failed to find the end of central directory");
+            --recordOffset;
+        }
+
+        const std::byte* record = tail.data() + recordOffset;
+        std::uint64_t entryCount = decodeLittleEndian<std::uint16_t>(record + 10);
+        std::uint64_t directorySize = decodeLittleEndian<std::uint32_t>(record + 12);
+        std::uint64_t directoryOffset = decodeLittleEndian<std::uint32_t>(record + 16);
+
+        if (entryCount == 0xFFFFU || directorySize == 0xFFFFFFFFU || directoryOffset == 0xFFFFFFFFU)
+        {
+            const auto recordPosition = tailOffset + recordOffset;
+            if (recordPosition < zip64LocatorSize)
+                throw std::runtime_error("Failed to find the zip64 end of central directory locator");
+
+            std::byte locator[zip64LocatorSize];
+            read(recordPosition - zip64LocatorSize, sizeof(locator), locator);
+            if (decodeLittleEndian<std::uint32_t>(locator) != zip64LocatorSignature)
+                throw std::runtime_error("Failed to find the zip64 end of central directory locator");
+
+            std::byte zip64Record[zip64EndOfCentralDirectorySize];
+            read(decodeLittleEndian<std::uint64_t>(locator + 8), sizeof(zip64Record), zip64Record);
+            if (decodeLittleEndian<std::uint32_t>(zip64Record) != zip64EndOfCentralDirectorySignature)
+                throw std::runtime_error("Invalid zip64 end of central directory");
+
+            entryCount = decodeLittleEndian<std::uint64_t>(zip64Record + 32);
+            directorySize = decodeLittleEndian<std::uint64_t>(zip64Record + 40);
+            directoryOffset = decodeLittleEndian<std::uint64_t>(zip64Record + 48);
+        }
+
+        if (directoryOffset > fileSize || directorySize > fileSize - directoryOffset)
+            throw std::runtime_error("Invalid central directory");
+
+        // read the central directory straight from the mapping if possible
+        std::vector<std::byte> directoryBuffer;
+        const std::byte* directory = nullptr;
+        const auto size = toSize(directorySize);
+
+        if (mappedFile.isMapped())
+            directory = mappedFile.getData() + directoryOffset;
+        else
+        {
+            directoryBuffer.resize(size);
+            read(directoryOffset, size, directoryBuffer.data());
+            directory = directoryBuffer.data();
+        }
+
+        entries.reserve(static_cast<std::size_t>(std::min(entryCount, std::uint64_t{size / centralDirectoryHeaderSize})));
+
+        std::size_t offset = 0;
+        for (std::uint64_t i = 0; i < entryCount; ++i)
+        {
+            if (size - offset < centralDirectoryHeaderSize)
+                throw std::runtime_error("Invalid central directory");
+
+            const std::byte* header = directory + offset;
+            if (decodeLittleEndian<std::uint32_t>(header) != centralDirectorySignature)
+                throw std::runtime_error("Bad signature");
+
+            Entry entry;
+            entry.flags = decodeLittleEndian<std::uint16_t>(header + 8);
+            entry.compression = decodeLittleEndian<std::uint16_t>(header + 10);
+            entry.compressedSize = decodeLittleEndian<std::uint32_t>(header + 20);
+            entry.uncompressedSize = decodeLittleEndian<std::uint32_t>(header + 24);
+            const std::size_t nameLength = decodeLittleEndian<std::uint16_t>(header + 28);
+            const std::size_t extraLength = decodeLittleEndian<std::uint16_t>(header + 30);
+            const std::size_t commentLength = decodeLittleEndian<std::uint16_t>(header + 32);
+            entry.localHeaderOffset = decodeLittleEndian<std::uint32_t>(header + 42);
+
+            if (size - offset - centralDirectoryHeaderSize < nameLength + extraLength + commentLength)
+                throw std::runtime_error("Invalid central directory");
+
+            entry.name.assign(reinterpret_cast<const char*>(header + centralDirectoryHeaderSize), nameLength);
+
+            // the zip64 extra field holds only the values that did not fit into 32 bits
+            const std::byte* extra = header + centralDirectoryHeaderSize + nameLength;
+            for (std::size_t extraOffset = 0; extraOffset + 4 <= extraLength;)
+            {
+                const auto id = decodeLittleEndian<std::uint16_t>(extra + extraOffset);
+                const std::size_t fieldSize = decodeLittleEndian<std::uint16_t>(extra + extraOffset + 2);
+                if (extraOffset + 4 + fieldSize > extraLength) break;
+
+                if (id == zip64ExtraFieldId)
+                {
+                    const std::byte* field = extra + extraOffset + 4;
+                    std::size_t fieldOffset = 0;
+
+                    for (std::uint64_t* value : {&entry.uncompressedSize, &entry.compressedSize, &entry.localHeaderOffset})
+                        if (*value == 0xFFFFFFFFU)
+                        {
+                            if (fieldOffset + 8 > fieldSize)
+                                throw std::runtime_error("Invalid zip64 extra field");
+                            *value = decodeLittleEndian<std::uint64_t>(field + fieldOffset);
+                            fieldOffset += 8;
+                        }
+                }
+
+                extraOffset += 4 + fieldSize;
+            }
+
+            offset += centralDirectoryHeaderSize + nameLength + extraLength + commentLength;
+
+            // directories have no contents
+            if (!entry.name.empty() && entry.name.back() == '/')
+                continue;
+
+            entry.hash = std::hash<std::string_view>{}(entry.name);
+            entries.push_back(std::move(entry));
+        }
+
+        std::size_t slotCount = 16;
+        while (slotCount < entries.size() * 2) slotCount *= 2;
+        slots.assign(slotCount, 0);
+        slotMask = slotCount - 1;
+
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            auto slot = entries[i].hash & slotMask;
+            while (slots[slot] != 0 && entries[slots[slot] - 1].name != entries[i].name)
+                slot = (slot + 1) & slotMask;
+
+            // a later entry with the same name replaces the earlier one
+            slots[slot] = static_cast<std::uint32_t>(i + 1);
+        }
+    }
+
+    const Archive::Entry* Archive::findEntry(std::string_view name) const noexcept
+    {
+        if (slots.empty()) return nullptr;
+
+        const auto hash = std::hash<std::string_view>{}(name);
+
+        for (auto slot = hash & slotMask; slots[slot] != 0; slot = (slot + 1) & slotMask)
+        {
+            const Entry& entry = entries[slots[slot] - 1];
+            if (entry.hash == hash && entry.name == name)
+                return &entry;
+        }
+
+        return nullptr;
+    }
+
+    std::vector<std::byte> Archive::readFile(const std::string& filename) const
+    {
+        const Entry* entry = findEntry(filename);
+
+        if (!entry)
+            throw std::runtime_error("File " + filename + " does not exist");
+
+        if (entry->flags & encryptedFlag)
+            throw std::runtime_error("File " + filename + " is encrypted");
+
+        std::byte localHeader[localHeaderSize];
+        read(entry->localHeaderOffset, sizeof(localHeader), localHeader);
+
+        if (decodeLittleEndian<std::uint32_t>(localHeader) != localHeaderSignature)
+            throw std::runtime_error("Bad signature");
+
+        // the extra field of the local header may differ from the one in the central directory
+        const auto dataOffset = entry->localHeaderOffset + localHeaderSize +
+            decodeLittleEndian<std::uint16_t>(localHeader + 26) +
+            decodeLittleEndian<std::uint16_t>(localHeader + 28);
+
+        if (dataOffset > fileSize || entry->compressedSize > fileSize - dataOffset)
+            throw std::runtime_error("File " + filename + " is truncated");
+
+        std::vector<std::byte> data(toSize(entry->uncompressedSize));
+
+        switch (entry->compression)
+        {
+            case storedCompression:
+                if (entry->compressedSize != entry->uncompressedSize)
+                    throw std::runtime_error("File " + filename + " has a size mismatch");
+
+                read(dataOffset, data.size(), data.data());
+                break;
+            case deflateCompression:
+                if (mappedFile.isMapped())
+                    inflate(mappedFile.getData() + dataOffset, toSize(entry->compressedSize),
+                            data.data(), data.size());
+                else
+                {
+                    std::vector<std::byte> compressed(toSize(entry->compressedSize));
+                    read(dataOffset, compressed.size(), compressed.data());
+                    inflate(compressed.data(), compressed.size(), data.data(), data.size());
+                }
+                break;
+            default:
+                throw std::runtime_error("Unsupported compression");
+        }
+
+        return data;
+    }
+}
@@ -4,110 +4,69 @@
 #define OUZEL_STORAGE_ARCHIVE_HPP
 
 #include <cstdint>
-#include <fstream>
-#include <map>
-#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "MappedFile.hpp"
 #include "Path.hpp"
-#include "../utils/Utils.hpp"
 
 namespace ouzel::storage
 {
+    // Zip archive (including zip64) with stored and deflated entries. The archive is
+    // mapped into memory (or read with positional reads if it can not be mapped), so
+    // files can be read from several threads at the same time.
     class Archive final
     {
     public:
         Archive() = default;
+        explicit Archive(const Path& path);
+        ~Archive();
 
-        explicit Archive(const Path& path):
-            file{path, std::ios::binary}
-        {
-            constexpr std::uint32_t centralDirectory = 0x02014B50U;
-            constexpr std::uint32_t headerSignature = 0x04034B50U;
-
-            for (;;)
-            {
-                std::uint8_t signatureData[4];
-                file.read(reinterpret_cast<char*>(signatureData), sizeof(signatureData));
-
-                if (decodeLittleEndian<std::uint32_t>(signatureData) == centralDirectory)
-                    break;
-
-                if (decodeLittleEndian<std::uint32_t>(signatureData) != headerSignature)
-                    throw std::runtime_error("Bad signature");
-
-                file.seekg(2, std::ios::cur); // skip version
-                file.seekg(2, std::ios::cur); // skip flags
-
-                std::uint8_t compressionData[2];
-                file.read(reinterpret_cast<char*>(&compressionData), sizeof(compressionData));
-
-                if (decodeLittleEndian<std::uint16_t>(compressionData) != 0x00)
-                    throw std::runtime_error("Unsupported compression");
-
-                file.seekg(2, std::ios::cur); // skip modification time
-                file.seekg(2, std::ios::cur); // skip modification date
-                file.seekg(4, std::ios::cur); // skip CRC-32
-
-                std::uint8_t compressedSizeData[4];
-                file.read(reinterpret_cast<char*>(compressedSizeData), sizeof(compressedSizeData));
-
-                std::uint8_t uncompressedSizeData[4];
-                file.read(reinterpret_cast<char*>(uncompressedSizeData), sizeof(uncompressedSizeData));
-                const size_t uncompressedSize = decodeLittleEndian<std::uint32_t>(uncompressedSizeData);
-
-                std::uint8_t fileNameLengthData[2];
-                file.read(reinterpret_cast<char*>(fileNameLengthData), sizeof(fileNameLengthData));
-                const size_t fileNameLength = decodeLittleEndian<std::uint16_t>(fileNameLengthData);
-
-                std::uint8_t extraFieldLengthData[2];
-                file.read(reinterpret_cast<char*>(extraFieldLengthData), sizeof(extraFieldLengthData));
-                const size_t extraFieldLength = decodeLittleEndian<std::uint16_t>(extraFieldLengthData);
-
-                auto name = std::make_unique<char[]>(fileNameLength + 1); // +1 for null character
+        Archive(const Archive&) = delete;
+        Archive& operator=(const Archive&) = delete;
 
-                file.read(name.get(), static_cast<std::streamsize>(fileNameLength));
+        Archive(Archive&& other) noexcept;
+        Archive& operator=(Archive&& other) noexcept;
 
-                file.seekg(static_cast<std::streamoff>(extraFieldLength),
-                           std::ios::cur); // skip extra field
-
-                entries[name.get()] = {file.tellg(), uncompressedSize};
-
-                file.seekg(static_cast<std::streamoff>(uncompressedSize),
-                           std::ios::cur); // skip uncompressed size
-            }
-        }
-
-        std::vector<std::byte> readFile(const std::string& filename)
-        {
-            const auto i = entries.find(filename);
-
-            if (i == entries.end())
-                throw std::runtime_error("File " + filename + " does not exist");
-
-            file.seekg(i->second.offset, std::ios::beg);
-
-            std::vector<std::byte> data(i->second.size);
-            file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(i->second.size));
-
-            return data;
-        }
+        std::vector<std::byte> readFile(const std::string& filename) const;
 
         bool fileExists(const std::string& filename) const
         {
-            return entries.find(filename) != entries.end();
+            return findEntry(filename) != nullptr;
         }
 
-    private:
-        std::ifstream file;
+        auto getFileCount() const noexcept { return entries.size(); }
 
-        struct Entry final
+    private:
+        class Entry final
         {
-            std::streamoff offset;
-            std::size_t size;
+        public:
+            std::string name;
+            std::size_t hash = 0;
+            std::uint64_t localHeaderOffset = 0;
+            std::uint64_t compressedSize = 0;
+            std::uint64_t uncompressedSize = 0;
+            std::uint16_t flags = 0;
+            std::uint16_t compression = 0;
         };
 
-        std::map<std::string, Entry> entries;
+        void read(std::uint64_t offset, std::size_t size, std::byte* destination) const;
+        void readCentralDirectory();
+        const Entry* findEntry(std::string_view name) const noexcept;
+        void closeFile() noexcept;
+
+        MappedFile mappedFile;
+#if defined(_WIN32)
+        HANDLE file = INVALID_HANDLE_VALUE; // only used if the archive could not be mapped
+#else
+        int file = -1; // only used if the archive could not be mapped
+#endif
+        std::uint64_t fileSize = 0;
+
+        std::vector<Entry> entries;
+        // open addressing index of the entries, 0 marks an empty slot
+        std::vector<std::uint32_t> slots;
+        std::size_t slotMask = 0;
     };
 }
 
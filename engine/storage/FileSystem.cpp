@@ -305,9 +305,13 @@ namespace ouzel::storage
     std::vector<std::byte> FileSystem::readFile(const Path& filename, const bool searchResources)
     {
         if (searchResources)
-            for (auto& archive : archives)
+        {
+            std::shared_lock lock(archiveMutex);
+
+            for (const auto& archive : archives)
                 if (archive.second.fileExists(filename))
                     return archive.second.readFile(filename);
+        }
 
 #if defined(__ANDROID__)
         if (!filename.isAbsolute())
@@ -362,6 +366,39 @@ namespace ouzel::storage
         return data;
     }
 
+    MappedFile FileSystem::mapFile(const Path& filename, const bool searchResources)
+    {
+        if (searchResources)
+        {
+            std::shared_lock lock(archiveMutex);
+
+            for (const auto& archive : archives)
+                if (archive.second.fileExists(filename))
+                    return MappedFile{archive.second.readFile(filename)};
+        }
+
+#if defined(__ANDROID__)
+        if (!filename.isAbsolute())
+            return MappedFile{readFile(filename, searchResources)};
+#endif
+
+        const auto path = getPath(filename, searchResources);
+
+        // file does not exist
+        if (path.isEmpty())
+            throw std::runtime_error("Failed to find file " + std::string(filename));
+
+        try
+        {
+            return MappedFile{path};
+        }
+        catch (const std::system_error&)
+        {
+            // not every file system supports mapping
+            return MappedFile{readFile(path, false)};
+        }
+    }
+
     bool FileSystem::resourceFileExists(const Path& filename) const
     {
         if (filename.isAbsolute())
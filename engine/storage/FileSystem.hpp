@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -31,6 +33,7 @@
 #  include <unistd.h>
 #endif
 #include "Archive.hpp"
+#include "MappedFile.hpp"
 #include "Path.hpp"
 
 namespace ouzel::core
@@ -235,6 +238,9 @@ namespace ouzel::storage
 
         std::vector<std::byte> readFile(const Path& filename, const bool searchResources = true);
 
+        // Maps the file into memory if possible and reads it into a buffer otherwise
+        MappedFile mapFile(const Path& filename, const bool searchResources = true);
+
         bool resourceFileExists(const Path& filename) const;
 
         Path getPath(const Path& filename, const bool searchResources = true) const
@@ -285,11 +291,13 @@ namespace ouzel::storage
 
         void addArchive(const std::string& name, Archive&& archive)
         {
+            std::lock_guard lock(archiveMutex);
             archives.emplace_back(name, std::move(archive));
         }
 
         void removeArchive(const std::string& name)
         {
+            std::lock_guard lock(archiveMutex);
             for (auto i = archives.begin(); i != archives.end();)
                 if (i->first == name)
                     i = archives.erase(i);
@@ -602,6 +610,7 @@ namespace ouzel::storage
         Path appPath;
         std::vector<Path> resourcePaths;
         std::vector<std::pair<std::string, Archive>> archives;
+        std::shared_mutex archiveMutex; // guards the archive list, the archives can be read concurrently
     };
 }
 
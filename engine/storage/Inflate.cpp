@@ -0,0 +1,396 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include "Inflate.hpp"
+
+namespace ouzel::storage
+{
+    namespace
+    {
+        constexpr std::uint32_t maxCodeLength = 15;
+        constexpr std::uint32_t fastBits = 10;
+        constexpr std::uint32_t fastMask = (1U << fastBits) - 1U;
+
+        constexpr std::uint16_t lengthBase[29] = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+        };
+
+        constexpr std::uint8_t lengthExtraBits[29] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+        };
+
+        constexpr std::uint16_t distanceBase[30] = {
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+        };
+
+        constexpr std::uint8_t distanceExtraBits[30] = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+            7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+        };
+
+        constexpr std::uint8_t codeLengthOrder[19] = {
+            16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+        };
+
+        constexpr std::uint32_t reverseBits(std::uint32_t code, std::uint32_t length) noexcept
+        {
+            std::uint32_t result = 0;
+            for (std::uint32_t i = 0; i < length; ++i, code >>= 1)
+                result = (result << 1) | (code & 1U);
+            return result;
+        }
+
+        // Canonical Huffman code, the codes up to fastBits long are decoded with a single
+        // table lookup and the longer ones bit by bit
+        class Huffman final
+        {
+        public:
+            void init(const std::uint8_t* lengths, std::uint32_t symbolCount)
+            {
+                std::fill(std::begin(counts), std::end(counts), std::uint16_t{0});
+                std::fill(std::begin(fast), std::end(fast), std::uint16_t{0});
+
+                for (std::uint32_t symbol = 0; symbol < symbolCount; ++symbol)
+                    ++counts[lengths[symbol]];
+                counts[0] = 0;
+
+                // incomplete codes are allowed, the unused codes fail to decode
+                std::int32_t left = 1;
+                for (std::uint32_t length = 1; length <= maxCodeLength; ++length)
+                {
+                    left = (left << 1) - counts[length];
+                    if (left < 0)
+                        throw InflateError("Over-subscribed Huffman code");
+                }
+
+                std::uint16_t offsets[maxCodeLength + 1];
+                offsets[1] = 0;
+                for (std::uint32_t length = 1; length < maxCodeLength; ++length)
+                    offsets[length + 1] = static_cast<std::uint16_t>(offsets[length] + counts[length]);
+
+                for (std::uint32_t symbol = 0; symbol < symbolCount; ++symbol)
+                    if (lengths[symbol])
+                        symbols[offsets[lengths[symbol]]++] = static_cast<std::uint16_t>(symbol);
+
+                std::uint32_t code = 0;
+                std::uint32_t index = 0;
+                for (std::uint32_t length = 1; length <= fastBits; ++length, code <<= 1)
+                    for (std::uint32_t i = 0; i < counts[length]; ++i, ++code, ++index)
+                        for (std::uint32_t entry = reverseBits(code, length); entry <= fastMask; entry += 1U << length)
+                            fast[entry] = static_cast<std::uint16_t>((length << 9) | symbols[index]);
+            }
+
+            std::uint16_t fast[1U << fastBits]; // length << 9 | symbol, 0 for the longer codes
+            std::uint16_t counts[maxCodeLength + 1];
+            std::uint16_t symbols[288];
+        };
+
+        class BitReader final
+        {
+        public:
+            BitReader(const std::uint8_t* initData, std::size_t size) noexcept:
+                data(initData), end(initData + size)
+            {
+            }
+
+            void refill()
+            {
+                if (end - data >= 8)
+                {
+                    // load whole 8 bytes and advance by the bytes that fit, the bits above
+                    // bitCount are reloaded with the same values next time
+                    std::uint64_t value = 0;
+                    for (std::uint32_t i = 0; i < 8; ++i)
+                        value |= static_cast<std::uint64_t>(data[i]) << (i * 8);
+
+                    bits |= value << bitCount;
+                    data += (63 - bitCount) >> 3;
+                    bitCount |= 56;
+                    return;
+                }
+
+                while (bitCount <= 56)
+                {
+                    // zeros are shifted in past the end, using them is detected by finish()
+                    if (data != end)
+                        bits |= static_cast<std::uint64_t>(*data++) << bitCount;
+                    else if (++padding > 8)
+                        throw InflateError("Unexpected end of data");
+
+                    bitCount += 8;
+                }
+            }
+
+            void consume(std::uint32_t count) noexcept
+            {
+                bits >>= count;
+                bitCount -= count;
+            }
+
+            std::uint32_t get(std::uint32_t count)
+            {
+                if (bitCount < count) refill();
+                const auto result = static_cast<std::uint32_t>(bits & ((std::uint64_t{1} << count) - 1U));
+                consume(count);
+                return result;
+            }
+
+            std::uint32_t decode(const Huffman& huffman)
+            {
+                if (bitCount < maxCodeLength) refill();
+
+                const auto entry = huffman.fast[bits & fastMask];
+                if (entry)
+                {
+                    consume(entry >> 9);
+                    return entry & 0x1FFU;
+                }
+
+                std::int32_t code = 0;
+                std::int32_t first = 0;
+                std::int32_t index = 0;
+                for (std::uint32_t length = 1; length <= maxCodeLength; ++length)
+                {
+                    code |= static_cast<std::int32_t>((bits >> (length - 1)) & 1U);
+                    const std::int32_t count = huffman.counts[length];
+                    if (code - count < first)
+                    {
+                        consume(length);
+                        return huffman.symbols[index + (code - first)];
+                    }
+
+                    index += count;
+                    first = (first + count) << 1;
+                    code <<= 1;
+                }
+
+                throw InflateError("Invalid Huffman code");
+            }
+
+            void alignToByte() noexcept
+            {
+                consume(bitCount & 7U);
+            }
+
+            void readBytes(std::uint8_t* output, std::size_t count)
+            {
+                // whole bytes that are already in the bit buffer go first
+                for (; count > 0 && bitCount >= 8 + padding * 8; --count)
+                    *output++ = static_cast<std::uint8_t>(get(8));
+
+                if (count == 0) return;
+
+                if (static_cast<std::size_t>(end - data) < count)
+                    throw InflateError("Unexpected end of data");
+
+                std::memcpy(output, data, count);
+                data += count;
+
+                // the bit buffer is empty, drop the bytes preloaded from before the copied ones
+                bits = 0;
+            }
+
+            void finish() const
+            {
+                if (padding * 8 > bitCount)
+                    throw InflateError("Unexpected end of data");
+            }
+
+        private:
+            const std::uint8_t* data;
+            const std::uint8_t* end;
+            std::uint64_t bits = 0;
+            std::uint32_t bitCount = 0;
+            std::uint32_t padding = 0;
+        };
+
+        const Huffman& getFixedLiteralCodes()
+        {
+            static const Huffman codes = [] {
+                std::uint8_t lengths[288];
+                std::fill(lengths, lengths + 144, std::uint8_t{8});
+                std::fill(lengths + 144, lengths + 256, std::uint8_t{9});
+                std::fill(lengths + 256, lengths + 280, std::uint8_t{7});
+                std::fill(lengths + 280, lengths + 288, std::uint8_t{8});
+
+                Huffman result;
+                result.init(lengths, 288);
+                return result;
+            }();
+
+            return codes;
+        }
+
+        const Huffman& getFixedDistanceCodes()
+        {
+            static const Huffman codes = [] {
+                std::uint8_t lengths[30];
+                std::fill(std::begin(lengths), std::end(lengths), std::uint8_t{5});
+
+                Huffman result;
+                result.init(lengths, 30);
+                return result;
+            }();
+
+            return codes;
+        }
+
+        void readDynamicCodes(BitReader& reader, Huffman& literals, Huffman& distances)
+        {
+            const auto literalCount = reader.get(5) + 257;
+            const auto distanceCount = reader.get(5) + 1;
+            const auto codeLengthCount = reader.get(4) + 4;
+
+            if (literalCount > 286 || distanceCount > 30)
+                throw InflateError("Invalid code counts");
+
+            std::uint8_t codeLengthLengths[19] = {};
+            for (std::uint32_t i = 0; i < codeLengthCount; ++i)
+                codeLengthLengths[codeLengthOrder[i]] = static_cast<std::uint8_t>(reader.get(3));
+
+            Huffman codeLengths;
+            codeLengths.init(codeLengthLengths, 19);
+
+            std::uint8_t lengths[286 + 30] = {};
+            for (std::uint32_t index = 0; index < literalCount + distanceCount;)
+            {
+                const auto symbol = reader.decode(codeLengths);
+
+                if (symbol < 16)
+                {
+                    lengths[index++] = static_cast<std::uint8_t>(symbol);
+                    continue;
+                }
+
+                std::uint8_t value = 0;
+                std::uint32_t repeat = 0;
+
+                if (symbol == 16)
+                {
+                    if (index == 0)
+                        throw InflateError("Repeated code length without a previous length");
+                    value = lengths[index - 1];
+                    repeat = 3 + reader.get(2);
+                }
+                else if (symbol == 17)
+                    repeat = 3 + reader.get(3);
+                else
+                    repeat = 11 + reader.get(7);
+
+                if (index + repeat > literalCount + distanceCount)
+                    throw InflateError("Too many code lengths");
+
+                std::fill(lengths + index, lengths + index + repeat, value);
+                index += repeat;
+            }
+
+            if (lengths[256] == 0)
+                throw InflateError("Missing end of block code");
+
+            literals.init(lengths, literalCount);
+            distances.init(lengths + literalCount, distanceCount);
+        }
+
+        void decodeBlock(BitReader& reader, const Huffman& literals, const Huffman& distances,
+                         std::uint8_t* output, std::size_t& position, std::size_t outputSize)
+        {
+            for (;;)
+            {
+                const auto symbol = reader.decode(literals);
+
+                if (symbol < 256)
+                {
+                    if (position == outputSize)
+                        throw InflateError("Output overflow");
+                    output[position++] = static_cast<std::uint8_t>(symbol);
+                }
+                else if (symbol == 256)
+                    return;
+                else
+                {
+                    const auto lengthSymbol = symbol - 257;
+                    if (lengthSymbol >= 29)
+                        throw InflateError("Invalid length symbol");
+                    const std::size_t length = lengthBase[lengthSymbol] + reader.get(lengthExtraBits[lengthSymbol]);
+
+                    const auto distanceSymbol = reader.decode(distances);
+                    if (distanceSymbol >= 30)
+                        throw InflateError("Invalid distance symbol");
+                    const std::size_t distance = distanceBase[distanceSymbol] + reader.get(distanceExtraBits[distanceSymbol]);
+
+                    if (distance > position)
+                        throw InflateError("Distance too far back");
+                    if (length > outputSize - position)
+                        throw InflateError("Output overflow");
+
+                    std::uint8_t* destination = output + position;
+                    const std::uint8_t* source = destination - distance;
+
+                    // overlapping copies repeat the last distance bytes
+                    if (distance >= length)
+                        std::memcpy(destination, source, length);
+                    else
+                        for (std::size_t i = 0; i < length; ++i)
+                            destination[i] = source[i];
+
+                    position += length;
+                }
+            }
+        }
+    }
+
+    void inflate(const std::byte* data, std::size_t size,
+                 std::byte* output, std::size_t outputSize)
+    {
+        BitReader reader{reinterpret_cast<const std::uint8_t*>(data), size};
+        auto outputBytes = reinterpret_cast<std::uint8_t*>(output);
+        std::size_t position = 0;
+
+        Huffman literals;
+        Huffman distances;
+
+        for (bool last = false; !last;)
+        {
+            last = reader.get(1) != 0;
+
+            switch (reader.get(2))
+            {
+                case 0: // stored
+                {
+                    reader.alignToByte();
+                    const auto length = reader.get(16);
+                    const auto lengthComplement = reader.get(16);
+                    if (length != (~lengthComplement & 0xFFFFU))
+                        throw InflateError("Invalid stored block length");
+                    if (length > outputSize - position)
+                        throw InflateError("Output overflow");
+
+                    reader.readBytes(outputBytes + position, length);
+                    position += length;
+                    break;
+                }
+                case 1: // fixed Huffman codes
+                    decodeBlock(reader, getFixedLiteralCodes(), getFixedDistanceCodes(),
+                                outputBytes, position, outputSize);
+                    break;
+                case 2: // dynamic Huffman codes
+                    readDynamicCodes(reader, literals, distances);
+                    decodeBlock(reader, literals, distances, outputBytes, position, outputSize);
+                    break;
+                default:
+                    throw InflateError("Invalid block type");
+            }
+        }
+
+        reader.finish();
+
+        if (position != outputSize)
+            throw InflateError("Size mismatch");
+    }
+}
@@ -0,0 +1,24 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_STORAGE_INFLATE_HPP
+#define OUZEL_STORAGE_INFLATE_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace ouzel::storage
+{
+    class InflateError final: public std::runtime_error
+    {
+    public:
+        explicit InflateError(const std::string& str): std::runtime_error(str) {}
+        explicit InflateError(const char* str): std::runtime_error(str) {}
+    };
+
+    // Decompresses a raw deflate stream (RFC 1951) that must expand to exactly outputSize bytes
+    void inflate(const std::byte* data, std::size_t size,
+                 std::byte* output, std::size_t outputSize);
+}
+
+#endif // OUZEL_STORAGE_INFLATE_HPP
@@ -0,0 +1,189 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_STORAGE_MAPPEDFILE_HPP
+#define OUZEL_STORAGE_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <system_error>
+#include <vector>
+#if defined(_WIN32)
+#  pragma push_macro("WIN32_LEAN_AND_MEAN")
+#  pragma push_macro("NOMINMAX")
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <Windows.h>
+#  pragma pop_macro("WIN32_LEAN_AND_MEAN")
+#  pragma pop_macro("NOMINMAX")
+#elif defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+#include "Path.hpp"
+#include "../utils/Span.hpp"
+
+namespace ouzel::storage
+{
+    // Read-only contents of a file, either mapped into memory or, if that is not
+    // possible (files in archives or Android assets), read into a buffer
+    class MappedFile final
+    {
+    public:
+        MappedFile() noexcept = default;
+
+        explicit MappedFile(const Path& path)
+        {
+#if defined(_WIN32)
+            const auto file = CreateFileW(path.getNative().c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                          nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw std::system_error(GetLastError(), std::system_category(), "Failed to open file");
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize))
+            {
+                const auto error = GetLastError();
+                CloseHandle(file);
+                throw std::system_error(error, std::system_category(), "Failed to get file size");
+            }
+
+            // an empty file can not be mapped
+            if (fileSize.QuadPart == 0)
+            {
+                CloseHandle(file);
+                return;
+            }
+
+            const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            const auto mappingError = GetLastError();
+            CloseHandle(file);
+
+            if (!mapping)
+                throw std::system_error(mappingError, std::system_category(), "Failed to create file mapping");
+
+            // the view keeps the mapping alive
+            const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            const auto viewError = GetLastError();
+            CloseHandle(mapping);
+
+            if (!view)
+                throw std::system_error(viewError, std::system_category(), "Failed to map file");
+
+            data = static_cast<const std::byte*>(view);
+            size = static_cast<std::size_t>(fileSize.QuadPart);
+            mapped = true;
+#elif defined(__unix__) || defined(__APPLE__)
+            const auto file = open(path.getNative().c_str(), O_RDONLY | O_CLOEXEC);
+            if (file == -1)
+                throw std::system_error(errno, std::system_category(), "Failed to open file");
+
+            struct stat buf;
+            if (fstat(file, &buf) == -1)
+            {
+                const auto error = errno;
+                close(file);
+                throw std::system_error(error, std::system_category(), "Failed to get file size");
+            }
+
+            // an empty file can not be mapped
+            if (buf.st_size == 0)
+            {
+                close(file);
+                return;
+            }
+
+            // the mapping stays valid after the descriptor is closed
+            const auto address = mmap(nullptr, static_cast<std::size_t>(buf.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            const auto error = errno;
+            close(file);
+
+            if (address == MAP_FAILED)
+                throw std::system_error(error, std::system_category(), "Failed to map file");
+
+            data = static_cast<const std::byte*>(address);
+            size = static_cast<std::size_t>(buf.st_size);
+            mapped = true;
+#else
+            throw std::system_error(std::make_error_code(std::errc::not_supported), "File mapping not supported");
+#endif
+        }
+
+        explicit MappedFile(std::vector<std::byte>&& initBuffer) noexcept:
+            buffer(std::move(initBuffer)),
+            data(buffer.data()),
+            size(buffer.size())
+        {
+        }
+
+        ~MappedFile()
+        {
+            unmap();
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept:
+            buffer(std::move(other.buffer)),
+            data(other.mapped ? other.data : buffer.data()),
+            size(other.size),
+            mapped(other.mapped)
+        {
+            other.data = nullptr;
+            other.size = 0;
+            other.mapped = false;
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (&other == this) return *this;
+
+            unmap();
+
+            buffer = std::move(other.buffer);
+            data = other.mapped ? other.data : buffer.data();
+            size = other.size;
+            mapped = other.mapped;
+
+            other.data = nullptr;
+            other.size = 0;
+            other.mapped = false;
+
+            return *this;
+        }
+
+        auto getData() const noexcept { return data; }
+        auto getSize() const noexcept { return size; }
+        auto isMapped() const noexcept { return mapped; }
+
+        Span<const std::byte> getSpan() const noexcept { return Span<const std::byte>{data, size}; }
+
+        auto begin() const noexcept { return data; }
+        auto end() const noexcept { return data + size; }
+
+    private:
+        void unmap() noexcept
+        {
+            if (!mapped) return;
+
+#if defined(_WIN32)
+            UnmapViewOfFile(data);
+#elif defined(__unix__) || defined(__APPLE__)
+            munmap(const_cast<std::byte*>(data), size);
+#endif
+            mapped = false;
+        }
+
+        std::vector<std::byte> buffer;
+        const std::byte* data = nullptr;
+        std::size_t size = 0;
+        bool mapped = false;
+    };
+}
+
+#endif // OUZEL_STORAGE_MAPPEDFILE_HPP
@@ -0,0 +1,254 @@
+// Ouzel by Elviss Strazdins
+
+#include <string>
+#include "JobSystem.hpp"
+#include "../utils/Profiler.hpp"
+
+namespace ouzel::thread
+{
+    namespace
+    {
+        // the job system and the index of the worker that is running on the current thread
+        thread_local const JobSystem* currentJobSystem = nullptr;
+        thread_local std::size_t currentWorkerIndex = 0;
+
+        // idle workers spin this many times before going to sleep
+        constexpr std::size_t spinCount = 64;
+    }
+
+    JobSystem::JobSystem(std::size_t initWorkerCount, bool setAffinity):
+        workerCount{initWorkerCount},
+        workers{std::make_unique<Worker[]>(initWorkerCount + 1)}
+    {
+        try
+        {
+            for (std::size_t i = 0; i < workerCount; ++i)
+            {
+                workers[i].thread = Thread{&JobSystem::workerMain, this, i};
+
+                if (setAffinity)
+                {
+                    try
+                    {
+                        workers[i].thread.setAffinity((i + 1) % std::max(std::thread::hardware_concurrency(), 1U));
+                    }
+                    catch (const std::system_error&)
+                    {
+                        // affinity is only a hint, the core may not be available to the process
+                    }
+                }
+            }
+        }
+        catch (...)
+        {
+            std::unique_lock lock(sleepMutex);
+            running = false;
+            sleepCondition.notify_all();
+            lock.unlock();
+            throw;
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        std::unique_lock lock(sleepMutex);
+        running = false;
+        sleepCondition.notify_all();
+        lock.unlock();
+
+        for (std::size_t i = 0; i < workerCount; ++i)
+            if (workers[i].thread.isJoinable())
+                workers[i].thread.join();
+    }
+
+    void JobSystem::run(std::function<void()> function, Counter& counter)
+    {
+        counter.value.fetch_add(1, std::memory_order_relaxed);
+        push(Job{std::move(function), &counter});
+    }
+
+    void JobSystem::run(std::function<void()> function, Counter& counter, Counter& dependency)
+    {
+        counter.value.fetch_add(1, std::memory_order_relaxed);
+
+        std::unique_lock lock(dependency.mutex);
+        if (dependency.value.load(std::memory_order_acquire) != 0)
+        {
+            dependency.continuations.emplace_back(std::move(function), &counter);
+            return;
+        }
+        lock.unlock();
+
+        push(Job{std::move(function), &counter});
+    }
+
+    void JobSystem::wait(Counter& counter)
+    {
+        const auto workerIndex = getCurrentWorkerIndex();
+
+        while (!counter.isDone())
+        {
+            Job job;
+            if (findJob(workerIndex, job))
+                execute(workerIndex, job);
+            else
+                std::this_thread::yield();
+        }
+
+        // the thread that finished the last job may still hold the mutex of the counter
+        std::lock_guard lock(counter.mutex);
+    }
+
+    std::vector<JobSystem::Statistics> JobSystem::getStatistics() const
+    {
+        std::vector<Statistics> result(workerCount + 1);
+
+        for (std::size_t i = 0; i <= workerCount; ++i)
+        {
+            result[i].jobCount = workers[i].jobCount.load(std::memory_order_relaxed);
+            result[i].stealCount = workers[i].stealCount.load(std::memory_order_relaxed);
+            result[i].busyTime = std::chrono::nanoseconds{workers[i].busyTime.load(std::memory_order_relaxed)};
+        }
+
+        return result;
+    }
+
+    void JobSystem::resetStatistics() noexcept
+    {
+        for (std::size_t i = 0; i <= workerCount; ++i)
+        {
+            workers[i].jobCount.store(0, std::memory_order_relaxed);
+            workers[i].stealCount.store(0, std::memory_order_relaxed);
+            workers[i].busyTime.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t JobSystem::getCurrentWorkerIndex() const noexcept
+    {
+        return currentJobSystem == this ? currentWorkerIndex : workerCount;
+    }
+
+    void JobSystem::push(Job job)
+    {
+        auto& worker = workers[getCurrentWorkerIndex()];
+
+        std::unique_lock lock(worker.mutex);
+        worker.jobs.push_back(std::move(job));
+        lock.unlock();
+
+        // the sleeping worker count is checked after the pending job count is incremented and the
+        // worker checks the pending job count after incrementing the sleeping worker count,
+        // so at least one of them sees the change of the other
+        pendingJobCount.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepingWorkerCount.load(std::memory_order_seq_cst) != 0)
+        {
+            std::lock_guard sleepLock(sleepMutex);
+            sleepCondition.notify_one();
+        }
+    }
+
+    bool JobSystem::findJob(std::size_t workerIndex, Job& job)
+    {
+        if (pendingJobCount.load(std::memory_order_relaxed) == 0)
+            return false;
+
+        auto& worker = workers[workerIndex];
+
+        std::unique_lock lock(worker.mutex);
+        if (!worker.jobs.empty())
+        {
+            job = std::move(worker.jobs.back());
+            worker.jobs.pop_back();
+            lock.unlock();
+
+            pendingJobCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        lock.unlock();
+
+        // steal the oldest job, starting from the next worker so that the thieves spread out
+        for (std::size_t i = 1; i <= workerCount; ++i)
+        {
+            auto& victim = workers[(workerIndex + i) % (workerCount + 1)];
+
+            std::unique_lock victimLock(victim.mutex);
+            if (!victim.jobs.empty())
+            {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                victimLock.unlock();
+
+                pendingJobCount.fetch_sub(1, std::memory_order_relaxed);
+                worker.stealCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::execute(std::size_t workerIndex, Job& job)
+    {
+        auto& worker = workers[workerIndex];
+
+        const auto startTime = std::chrono::steady_clock::now();
+        {
+            OUZEL_PROFILE_SCOPE("JobSystem::execute");
+            job.function();
+        }
+        const auto busyTime = std::chrono::steady_clock::now() - startTime;
+
+        worker.jobCount.fetch_add(1, std::memory_order_relaxed);
+        worker.busyTime.fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(busyTime).count()),
+                                  std::memory_order_relaxed);
+
+        finish(*job.counter);
+    }
+
+    void JobSystem::finish(Counter& counter)
+    {
+        std::vector<std::pair<std::function<void()>, Counter*>> continuations;
+
+        std::unique_lock lock(counter.mutex);
+        if (counter.value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            continuations.swap(counter.continuations);
+        lock.unlock();
+
+        for (auto& [function, continuationCounter] : continuations)
+            push(Job{std::move(function), continuationCounter});
+    }
+
+    void JobSystem::workerMain(std::size_t workerIndex)
+    {
+        setCurrentThreadName("Worker " + std::to_string(workerIndex));
+
+        currentJobSystem = this;
+        currentWorkerIndex = workerIndex;
+
+        while (running.load(std::memory_order_relaxed))
+        {
+            Job job;
+            bool found = false;
+
+            for (std::size_t i = 0; i < spinCount && !found; ++i)
+            {
+                found = findJob(workerIndex, job);
+                if (!found) std::this_thread::yield();
+            }
+
+            if (found)
+            {
+                execute(workerIndex, job);
+                continue;
+            }
+
+            std::unique_lock lock(sleepMutex);
+            sleepingWorkerCount.fetch_add(1, std::memory_order_seq_cst);
+            sleepCondition.wait(lock, [this]() noexcept {
+                return !running.load(std::memory_order_relaxed) ||
+                    pendingJobCount.load(std::memory_order_seq_cst) != 0;
+            });
+            sleepingWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
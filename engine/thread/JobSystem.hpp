@@ -0,0 +1,154 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_THREAD_JOBSYSTEM_HPP
+#define OUZEL_THREAD_JOBSYSTEM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Thread.hpp"
+
+namespace ouzel::thread
+{
+    // Work-stealing job scheduler. Every worker has its own deque, it runs the jobs it
+    // has pushed itself in LIFO order and steals the oldest jobs of the other workers
+    // when its deque is empty. Threads that are not workers (e.g. the main thread) push
+    // to a shared deque and help to run jobs while they wait for a counter.
+    // Jobs must not throw.
+    class JobSystem final
+    {
+    public:
+        // number of jobs that have been started and not yet finished, the counter must
+        // outlive its jobs, which is guaranteed by waiting for it
+        class Counter final
+        {
+            friend JobSystem;
+        public:
+            Counter() = default;
+
+            Counter(const Counter&) = delete;
+            Counter& operator=(const Counter&) = delete;
+            Counter(Counter&&) = delete;
+            Counter& operator=(Counter&&) = delete;
+
+            bool isDone() const noexcept { return value.load(std::memory_order_acquire) == 0; }
+
+        private:
+            std::atomic<std::size_t> value{0};
+            std::mutex mutex;
+            std::vector<std::pair<std::function<void()>, Counter*>> continuations;
+        };
+
+        struct Statistics final
+        {
+            std::uint64_t jobCount = 0;
+            std::uint64_t stealCount = 0;
+            std::chrono::nanoseconds busyTime{0};
+        };
+
+        // one worker less than the number of hardware threads, because the thread that
+        // waits for the jobs runs them too
+        static std::size_t getDefaultWorkerCount() noexcept
+        {
+#if defined(__EMSCRIPTEN__)
+            return 0;
+#else
+            return std::max(std::thread::hardware_concurrency(), 2U) - 1U;
+#endif
+        }
+
+        // with setAffinity, worker i is pinned to the core i + 1, the core 0 is left for the main thread
+        explicit JobSystem(std::size_t initWorkerCount = getDefaultWorkerCount(), bool setAffinity = false);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator=(JobSystem&&) = delete;
+
+        auto getWorkerCount() const noexcept { return workerCount; }
+
+        void run(std::function<void()> function, Counter& counter);
+        // the job is started after all the jobs of the dependency have finished
+        void run(std::function<void()> function, Counter& counter, Counter& dependency);
+
+        // runs jobs on the calling thread until the counter reaches zero
+        void wait(Counter& counter);
+
+        // calls function(begin, end) for ranges of at most grainSize elements and returns
+        // after all of them have finished, the range is split in halves, so that a thief steals big chunks
+        template <class Function>
+        void parallelFor(std::size_t first, std::size_t last, std::size_t grainSize, const Function& function)
+        {
+            Counter counter;
+            splitRange(first, last, std::max(grainSize, std::size_t{1}), function, counter);
+            wait(counter);
+        }
+
+        // the last entry is for the threads that are not workers
+        std::vector<Statistics> getStatistics() const;
+        void resetStatistics() noexcept;
+
+    private:
+        struct Job final
+        {
+            std::function<void()> function;
+            Counter* counter = nullptr;
+        };
+
+        struct alignas(64) Worker final
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+
+            std::atomic<std::uint64_t> jobCount{0};
+            std::atomic<std::uint64_t> stealCount{0};
+            std::atomic<std::uint64_t> busyTime{0};
+
+            Thread thread;
+        };
+
+        template <class Function>
+        void splitRange(std::size_t first, std::size_t last, std::size_t grainSize,
+                        const Function& function, Counter& counter)
+        {
+            while (last - first > grainSize)
+            {
+                const auto middle = first + (last - first) / 2;
+                run([this, middle, last, grainSize, &function, &counter]() {
+                    splitRange(middle, last, grainSize, function, counter);
+                }, counter);
+                last = middle;
+            }
+
+            function(first, last);
+        }
+
+        std::size_t getCurrentWorkerIndex() const noexcept;
+        void push(Job job);
+        bool findJob(std::size_t workerIndex, Job& job);
+        void execute(std::size_t workerIndex, Job& job);
+        void finish(Counter& counter);
+        void workerMain(std::size_t workerIndex);
+
+        std::size_t workerCount;
+        // the workers and the shared deque of the other threads at index workerCount
+        std::unique_ptr<Worker[]> workers;
+
+        std::atomic<std::size_t> pendingJobCount{0};
+        std::atomic<std::size_t> sleepingWorkerCount{0};
+        std::mutex sleepMutex;
+        std::condition_variable sleepCondition;
+        std::atomic<bool> running{true};
+    };
+}
+
+#endif // OUZEL_THREAD_JOBSYSTEM_HPP
@@ -0,0 +1,111 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_THREAD_MPSCQUEUE_HPP
+#define OUZEL_THREAD_MPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace ouzel::thread
+{
+    // Bounded lock-free multi-producer single-consumer queue.
+    // Values are stored in preallocated slots, so pushing and popping never allocates.
+    template <class T>
+    class MpscQueue final
+    {
+    public:
+        explicit MpscQueue(std::size_t capacity):
+            mask{capacity - 1},
+            slots{std::make_unique<Slot[]>(capacity)}
+        {
+            if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+                throw std::invalid_argument{"Queue capacity must be a power of two"};
+
+            for (std::size_t i = 0; i < capacity; ++i)
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+        MpscQueue(MpscQueue&&) = delete;
+        MpscQueue& operator=(MpscQueue&&) = delete;
+
+        auto getCapacity() const noexcept { return mask + 1; }
+
+        // the number of slots claimed by the producers
+        auto getPushCount() const noexcept { return pushPosition.load(std::memory_order_relaxed); }
+
+        // must be called only from the consumer thread
+        auto getPopCount() const noexcept { return popPosition; }
+
+        // can be called from any thread, returns false if the queue is full
+        template <class... Args>
+        bool tryPush(Args&&... args)
+        {
+            auto position = pushPosition.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                auto& slot = slots[position & mask];
+                const auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+                if (sequence == position)
+                {
+                    if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        slot.value = T(std::forward<Args>(args)...);
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (sequence < position)
+                    return false; // the consumer has not yet released the slot
+                else
+                    position = pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        // must be called only from the consumer thread, returns false if the queue is empty
+        // waits for the producers that have claimed a slot but not yet written it,
+        // so that the values of each producer are popped in the order they were pushed
+        bool tryPop(T& value)
+        {
+            auto& slot = slots[popPosition & mask];
+
+            while (slot.sequence.load(std::memory_order_acquire) != popPosition + 1)
+            {
+                if (pushPosition.load(std::memory_order_relaxed) == popPosition)
+                    return false;
+
+                std::this_thread::yield();
+            }
+
+            value = std::move(slot.value);
+            slot.sequence.store(popPosition + mask + 1, std::memory_order_release);
+            ++popPosition;
+
+            return true;
+        }
+
+    private:
+        struct Slot final
+        {
+            std::atomic<std::size_t> sequence{0};
+            T value{};
+        };
+
+        static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>);
+
+        const std::size_t mask;
+        std::unique_ptr<Slot[]> slots;
+        alignas(64) std::atomic<std::size_t> pushPosition{0};
+        alignas(64) std::size_t popPosition = 0;
+    };
+}
+
+#endif // OUZEL_THREAD_MPSCQUEUE_HPP
@@ -0,0 +1,83 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_THREAD_OVERFLOWMPSCQUEUE_HPP
+#define OUZEL_THREAD_OVERFLOWMPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "MpscQueue.hpp"
+
+namespace ouzel::thread
+{
+    // Multi-producer single-consumer queue that never drops values.
+    // Values go to a bounded lock-free queue, and only when it is full they go to a locked overflow list.
+    // Once the queue has overflowed, all values go to the overflow list until it is popped,
+    // so that the values of every producer stay in order.
+    template <class T>
+    class OverflowMpscQueue final
+    {
+    public:
+        explicit OverflowMpscQueue(std::size_t capacity):
+            queue{capacity}
+        {
+        }
+
+        OverflowMpscQueue(const OverflowMpscQueue&) = delete;
+        OverflowMpscQueue& operator=(const OverflowMpscQueue&) = delete;
+        OverflowMpscQueue(OverflowMpscQueue&&) = delete;
+        OverflowMpscQueue& operator=(OverflowMpscQueue&&) = delete;
+
+        // can be called from any thread
+        void push(T&& value)
+        {
+            if (!overflowing.load(std::memory_order_acquire) &&
+                queue.tryPush(std::move(value)))
+                return;
+
+            std::lock_guard lock(overflowMutex);
+            overflowValues.push_back(std::move(value));
+            overflowing.store(true, std::memory_order_release);
+        }
+
+        // must be called only from the consumer thread, calls the function for every value in the order they were pushed
+        // the function can push new values
+        template <class Function>
+        void popAll(Function function)
+        {
+            T value;
+
+            if (overflowing.load(std::memory_order_acquire))
+            {
+                std::vector<T> values;
+
+                std::unique_lock lock(overflowMutex);
+                values.swap(overflowValues);
+                // the slots claimed before the overflow was taken hold values pushed before it
+                const auto overflowPosition = queue.getPushCount();
+                overflowing.store(false, std::memory_order_release);
+                lock.unlock();
+
+                while (queue.getPopCount() != overflowPosition && queue.tryPop(value))
+                    function(value);
+
+                for (auto& overflowValue : values)
+                    function(overflowValue);
+            }
+
+            while (queue.tryPop(value))
+                function(value);
+        }
+
+    private:
+        MpscQueue<T> queue;
+
+        std::atomic<bool> overflowing{false};
+        std::mutex overflowMutex;
+        std::vector<T> overflowValues;
+    };
+}
+
+#endif // OUZEL_THREAD_OVERFLOWMPSCQUEUE_HPP
@@ -3,6 +3,7 @@
 #ifndef OUZEL_UTILS_THREAD_HPP
 #define OUZEL_UTILS_THREAD_HPP
 
+#include <string>
 #include <system_error>
 #include <thread>
 #if defined(_WIN32)
@@ -19,6 +20,10 @@
 #  pragma pop_macro("NOMINMAX")
 #elif defined(__unix__) || defined(__APPLE__)
 #  include <pthread.h>
+#  if defined(__APPLE__)
+#    include <mach/mach.h>
+#    include <mach/thread_policy.h>
+#  endif
 #endif
 #include "../utils/Utils.hpp"
 
@@ -100,12 +105,52 @@ namespace ouzel::thread
 #endif
         }
 
+        // asks the scheduler to run the thread on the given CPU core, on Apple platforms
+        // this is only a hint that threads with different cores should not share caches
+        void setAffinity(std::size_t cpu)
+        {
+#if defined(_WIN32)
+            if (!SetThreadAffinityMask(t.native_handle(), static_cast<DWORD_PTR>(1) << cpu))
+                throw std::system_error(GetLastError(), std::system_category(), "Failed to set thread affinity");
+#elif defined(__APPLE__)
+            thread_affinity_policy_data_t policy{static_cast<integer_t>(cpu + 1)};
+            const auto error = thread_policy_set(pthread_mach_thread_np(t.native_handle()),
+                                                 THREAD_AFFINITY_POLICY,
+                                                 bitCast<thread_policy_t>(&policy),
+                                                 THREAD_AFFINITY_POLICY_COUNT);
+            if (error != KERN_SUCCESS)
+                throw std::system_error(error, std::system_category(), "Failed to set thread affinity");
+#elif defined(__linux__) && !defined(__ANDROID__)
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(cpu, &cpuSet);
+            const auto error = pthread_setaffinity_np(t.native_handle(), sizeof(cpuSet), &cpuSet);
+            if (error != 0)
+                throw std::system_error(error, std::system_category(), "Failed to set thread affinity");
+#else
+            static_cast<void>(cpu);
+#endif
+        }
+
     private:
         std::thread t;
     };
 
+    inline namespace detail
+    {
+        inline thread_local std::string currentThreadName;
+    }
+
+    // the name that was set with setCurrentThreadName, empty if no name was set
+    inline const std::string& getCurrentThreadName() noexcept
+    {
+        return currentThreadName;
+    }
+
     inline void setCurrentThreadName(const std::string& name)
     {
+        currentThreadName = name;
+
 #if defined(_MSC_VER)
         constexpr DWORD MS_VC_EXCEPTION = 0x406D1388;
 #  pragma pack(push,8)
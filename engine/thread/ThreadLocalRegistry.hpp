@@ -0,0 +1,128 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_THREAD_THREADLOCALREGISTRY_HPP
+#define OUZEL_THREAD_THREADLOCALREGISTRY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ouzel::thread
+{
+    // Gives every thread its own instance of T, which is constructed from the index of the thread
+    // in the registry on the first get call of the thread and can be read by the other threads.
+    // When the thread exits, the instance stays registered until the owner releases it, so that
+    // its data can be read one last time, and it is freed with the last pointer that refers to it.
+    template <class T>
+    class ThreadLocalRegistry final
+    {
+    public:
+        ThreadLocalRegistry() = default;
+
+        ThreadLocalRegistry(const ThreadLocalRegistry&) = delete;
+        ThreadLocalRegistry& operator=(const ThreadLocalRegistry&) = delete;
+        ThreadLocalRegistry(ThreadLocalRegistry&&) = delete;
+        ThreadLocalRegistry& operator=(ThreadLocalRegistry&&) = delete;
+
+        // the instance of the calling thread
+        T& get()
+        {
+            auto& threadEntries = getThreadEntries();
+
+            for (const auto& [registryId, entry] : threadEntries.entries)
+                if (registryId == id) return entry->value;
+
+            std::lock_guard lock(mutex);
+            auto entry = std::make_shared<Entry>(nextIndex++);
+            entries.push_back(entry);
+            threadEntries.entries.emplace_back(id, entry);
+            return entry->value;
+        }
+
+        // the instances of all the registered threads
+        std::vector<std::shared_ptr<T>> getAll() const
+        {
+            std::lock_guard lock(mutex);
+
+            std::vector<std::shared_ptr<T>> result;
+            result.reserve(entries.size());
+            for (const auto& entry : entries)
+                result.emplace_back(entry, &entry->value);
+            return result;
+        }
+
+        // same as getAll, but the instances of the exited threads are removed from the registry,
+        // they are still returned, so that the caller can read them after their threads have finished writing
+        std::vector<std::shared_ptr<T>> collect()
+        {
+            std::lock_guard lock(mutex);
+
+            std::vector<std::shared_ptr<T>> result;
+            result.reserve(entries.size());
+            for (const auto& entry : entries)
+                result.emplace_back(entry, &entry->value);
+
+            removeExited();
+            return result;
+        }
+
+        // removes the instances of the exited threads from the registry
+        void releaseExited() noexcept
+        {
+            std::lock_guard lock(mutex);
+            removeExited();
+        }
+
+    private:
+        struct Entry final
+        {
+            explicit Entry(std::size_t index): value{index} {}
+
+            T value;
+            std::atomic<bool> exited{false};
+        };
+
+        // the entries of a thread in all the registries of T, marked as exited when the thread exits
+        struct ThreadEntries final
+        {
+            ThreadEntries() = default;
+            ThreadEntries(const ThreadEntries&) = delete;
+            ThreadEntries& operator=(const ThreadEntries&) = delete;
+
+            ~ThreadEntries()
+            {
+                for (const auto& [registryId, entry] : entries)
+                    entry->exited.store(true, std::memory_order_release);
+            }
+
+            std::vector<std::pair<std::size_t, std::shared_ptr<Entry>>> entries;
+        };
+
+        static ThreadEntries& getThreadEntries()
+        {
+            static thread_local ThreadEntries threadEntries;
+            return threadEntries;
+        }
+
+        void removeExited() noexcept
+        {
+            entries.erase(std::remove_if(entries.begin(), entries.end(), [](const std::shared_ptr<Entry>& entry) noexcept {
+                return entry->exited.load(std::memory_order_acquire);
+            }), entries.end());
+        }
+
+        // an id instead of the address, because a new registry can be created at the address of a destroyed one
+        inline static std::atomic<std::size_t> nextId{0};
+        const std::size_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+
+        mutable std::mutex mutex;
+        std::vector<std::shared_ptr<Entry>> entries;
+        std::size_t nextIndex = 0;
+    };
+}
+
+#endif // OUZEL_THREAD_THREADLOCALREGISTRY_HPP
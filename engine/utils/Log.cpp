@@ -27,12 +27,314 @@
 #  include <emscripten.h>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
 #include "Log.hpp"
+#include "../thread/Thread.hpp"
 
 namespace ouzel
 {
     Logger logger;
 
+#if !defined(__EMSCRIPTEN__)
+    namespace
+    {
+        struct RecordHeader final
+        {
+            std::int64_t timestamp;
+            std::uint32_t size; // of the message that follows the header
+            Log::Level level;
+        };
+
+        struct Record final
+        {
+            std::int64_t timestamp;
+            Log::Level level;
+            std::string message;
+        };
+
+        std::int64_t getTime() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        std::string getRepeatMessage(std::size_t threadIndex, std::size_t suppressedCount)
+        {
+            return "Last message of thread " + std::to_string(threadIndex) +
+                " repeated " + std::to_string(suppressedCount) + " more times";
+        }
+    }
+
+    // single producer, single consumer ring of records
+    class Logger::ThreadBuffer final
+    {
+    public:
+        explicit ThreadBuffer(std::size_t initIndex) noexcept:
+            index{initIndex}
+        {
+        }
+
+        bool push(const RecordHeader& header, const char* message) noexcept
+        {
+            const auto recordSize = sizeof(header) + header.size;
+            const auto write = writeIndex.load(std::memory_order_relaxed);
+            const auto read = readIndex.load(std::memory_order_acquire);
+
+            if (bufferCapacity - (write - read) < recordSize)
+            {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            copyIn(write, &header, sizeof(header));
+            copyIn(write + sizeof(header), message, header.size);
+            writeIndex.store(write + recordSize, std::memory_order_release);
+            return true;
+        }
+
+        void pop(std::vector<Record>& records)
+        {
+            auto read = readIndex.load(std::memory_order_relaxed);
+            const auto write = writeIndex.load(std::memory_order_acquire);
+
+            while (read != write)
+            {
+                RecordHeader header;
+                copyOut(read, &header, sizeof(header));
+
+                Record record{header.timestamp, header.level, std::string(header.size, '\0')};
+                copyOut(read + sizeof(header), record.message.data(), header.size);
+                records.push_back(std::move(record));
+
+                read += sizeof(header) + header.size;
+            }
+
+            readIndex.store(read, std::memory_order_release);
+        }
+
+        const std::size_t index;
+        std::atomic<std::uint64_t> droppedCount{0};
+        std::uint64_t reportedDroppedCount = 0; // accessed only by the writer thread
+
+        // the last message for the rate limiting, accessed only by the thread that owns the buffer
+        std::size_t lastHash = 0;
+        std::int64_t repeatStartTime = 0;
+        std::size_t repeatCount = 0;
+        // also taken by the writer thread, so that the count is written even if no other message follows
+        std::atomic<Log::Level> lastLevel{Log::Level::off};
+        std::atomic<std::size_t> suppressedCount{0};
+
+    private:
+        static_assert((bufferCapacity & (bufferCapacity - 1)) == 0);
+        static_assert(sizeof(RecordHeader) + maxMessageSize <= bufferCapacity);
+
+        void copyIn(std::size_t position, const void* source, std::size_t size) noexcept
+        {
+            const auto offset = position & (bufferCapacity - 1);
+            const auto first = std::min(size, bufferCapacity - offset);
+            std::memcpy(data.data() + offset, source, first);
+            std::memcpy(data.data(), static_cast<const std::byte*>(source) + first, size - first);
+        }
+
+        void copyOut(std::size_t position, void* destination, std::size_t size) const noexcept
+        {
+            const auto offset = position & (bufferCapacity - 1);
+            const auto first = std::min(size, bufferCapacity - offset);
+            std::memcpy(destination, data.data() + offset, first);
+            std::memcpy(static_cast<std::byte*>(destination) + first, data.data(), size - first);
+        }
+
+        std::array<std::byte, bufferCapacity> data;
+        // total bytes written and read, the producer and the consumer are on separate cache lines
+        alignas(64) std::atomic<std::size_t> writeIndex{0};
+        alignas(64) std::atomic<std::size_t> readIndex{0};
+    };
+#endif
+
+    Logger::Logger(Log::Level initThreshold):
+        threshold{initThreshold}
+    {
+#if !defined(__EMSCRIPTEN__)
+        writerThread = std::make_unique<thread::Thread>(&Logger::writerMain, this);
+#endif
+    }
+
+    Logger::~Logger()
+    {
+#if !defined(__EMSCRIPTEN__)
+        std::unique_lock lock(writerMutex);
+        running = false;
+        lock.unlock();
+        writerCondition.notify_all();
+
+        writerThread.reset(); // joins the thread after it has written the remaining messages
+#endif
+    }
+
+    void Logger::log(const std::string& str, const Log::Level level) const
+    {
+        if (!isEnabled(level))
+            return;
+
+#if defined(__EMSCRIPTEN__)
+        logString(str, level);
+#else
+        auto& buffer = threadBuffers.get();
+        const auto timestamp = getTime();
+        const auto hash = std::hash<std::string>{}(str);
+
+        if (hash == buffer.lastHash && level == buffer.lastLevel.load(std::memory_order_relaxed) &&
+            timestamp - buffer.repeatStartTime < std::chrono::nanoseconds(repeatInterval).count())
+        {
+            if (++buffer.repeatCount > repeatLimit)
+            {
+                buffer.suppressedCount.fetch_add(1);
+                return;
+            }
+        }
+        else
+        {
+            // the count of the suppressed messages that the writer has not taken yet
+            if (const auto suppressedCount = buffer.suppressedCount.exchange(0))
+                push(buffer, getRepeatMessage(buffer.index, suppressedCount),
+                     buffer.lastLevel.load(std::memory_order_relaxed), timestamp);
+
+            buffer.lastHash = hash;
+            buffer.lastLevel.store(level);
+            buffer.repeatStartTime = timestamp;
+            buffer.repeatCount = 1;
+        }
+
+        if (level == Log::Level::error)
+        {
+            // written after the earlier messages before returning, so that it is not lost if the application crashes
+            flush();
+            std::lock_guard lock(outputMutex);
+            logString(str, level);
+        }
+        else
+            push(buffer, str, level, timestamp);
+#endif
+    }
+
+    void Logger::flush() const
+    {
+#if !defined(__EMSCRIPTEN__)
+        std::unique_lock lock(writerMutex);
+        if (!running) return; // the writer is writing the remaining messages before exiting
+
+        const auto request = ++flushRequestCount;
+        writerCondition.notify_one();
+        flushCondition.wait(lock, [this, request]() noexcept { return flushCount >= request; });
+#endif
+    }
+
+    std::uint64_t Logger::getDroppedCount() const noexcept
+    {
+#if defined(__EMSCRIPTEN__)
+        return 0;
+#else
+        return droppedCount.load(std::memory_order_relaxed);
+#endif
+    }
+
+#if !defined(__EMSCRIPTEN__)
+    void Logger::push(ThreadBuffer& buffer, const std::string& str, const Log::Level level, std::int64_t timestamp) const
+    {
+        const RecordHeader header{
+            timestamp,
+            static_cast<std::uint32_t>(std::min(str.size(), maxMessageSize)),
+            level
+        };
+
+        if (buffer.push(header, str.data()))
+            notifyWriter();
+        else
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Logger::notifyWriter() const
+    {
+        // only the first message after the writer has started draining wakes it up
+        if (!pending.exchange(true, std::memory_order_acq_rel))
+        {
+            // locking prevents the notification from being lost while the writer is checking the predicate
+            std::lock_guard lock(writerMutex);
+            writerCondition.notify_one();
+        }
+    }
+
+    void Logger::writerMain() const
+    {
+        thread::setCurrentThreadName("Log");
+
+        std::unique_lock lock(writerMutex);
+
+        for (;;)
+        {
+            // wakes up at least once per interval to write the counts of the suppressed messages
+            // and to release the buffers of the exited threads
+            writerCondition.wait_for(lock, repeatInterval, [this]() noexcept {
+                return !running ||
+                    flushCount != flushRequestCount ||
+                    pending.load(std::memory_order_relaxed);
+            });
+
+            const auto request = flushRequestCount;
+            const auto stop = !running;
+            lock.unlock();
+
+            pending.exchange(false, std::memory_order_acq_rel);
+            writeBuffered();
+
+            lock.lock();
+            flushCount = request;
+            flushCondition.notify_all();
+
+            if (stop) break;
+        }
+    }
+
+    void Logger::writeBuffered() const
+    {
+        // the buffers of the exited threads are freed after this last read
+        const auto buffers = threadBuffers.collect();
+
+        std::vector<Record> records;
+
+        for (const auto& buffer : buffers)
+        {
+            buffer->pop(records);
+
+            const auto level = buffer->lastLevel.load();
+            if (const auto suppressedCount = buffer->suppressedCount.exchange(0))
+                records.push_back(Record{getTime(), level, getRepeatMessage(buffer->index, suppressedCount)});
+
+            const auto bufferDroppedCount = buffer->droppedCount.load(std::memory_order_relaxed);
+            if (bufferDroppedCount != buffer->reportedDroppedCount)
+            {
+                records.push_back(Record{
+                    getTime(),
+                    Log::Level::warning,
+                    "Dropped " + std::to_string(bufferDroppedCount - buffer->reportedDroppedCount) +
+                        " log messages of thread " + std::to_string(buffer->index)
+                });
+                buffer->reportedDroppedCount = bufferDroppedCount;
+            }
+        }
+
+        std::stable_sort(records.begin(), records.end(), [](const Record& a, const Record& b) noexcept {
+            return a.timestamp < b.timestamp;
+        });
+
+        std::lock_guard lock(outputMutex);
+        for (const auto& record : records)
+            logString(record.message, record.level);
+    }
+#endif
+
     void Logger::logString(const std::string& str, Log::Level level)
     {
 #if defined(__ANDROID__)
@@ -4,10 +4,17 @@
 #define OUZEL_UTILS_LOG_HPP
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <cstring>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <type_traits>
+#include <vector>
+#include "../core/Setup.h"
+#include "../thread/ThreadLocalRegistry.hpp"
 #include "../math/Matrix.hpp"
 #include "../math/Quaternion.hpp"
 #include "../math/Size.hpp"
@@ -19,6 +26,11 @@ namespace ouzel
 {
     class Logger;
 
+    namespace thread
+    {
+        class Thread;
+    }
+
     template<typename T, typename = void>
     struct isContainer: std::false_type {};
 
@@ -42,14 +54,17 @@ namespace ouzel
             all
         };
 
-        explicit Log(const Logger& initLogger, Level initLevel = Level::info):
-            logger(initLogger), level(initLevel)
+        // a disabled log ignores everything written to it, so the formatting of the messages
+        // that are filtered out by the level is skipped
+        explicit Log(const Logger& initLogger, Level initLevel = Level::info, bool initEnabled = true):
+            logger(initLogger), level(initLevel), enabled(initEnabled)
         {
         }
 
         Log(const Log& other):
             logger(other.logger),
             level(other.level),
+            enabled(other.enabled),
             s(other.s)
         {
         }
@@ -57,9 +72,11 @@ namespace ouzel
         Log(Log&& other) noexcept:
             logger(other.logger),
             level(other.level),
+            enabled(other.enabled),
             s(std::move(other.s))
         {
             other.level = Level::info;
+            other.enabled = false;
         }
 
         Log& operator=(const Log& other)
@@ -67,6 +84,7 @@ namespace ouzel
             if (&other == this) return *this;
 
             level = other.level;
+            enabled = other.enabled;
             s = other.s;
 
             return *this;
@@ -77,7 +95,9 @@ namespace ouzel
             if (&other == this) return *this;
 
             level = other.level;
+            enabled = other.enabled;
             other.level = Level::info;
+            other.enabled = false;
             s = std::move(other.s);
 
             return *this;
@@ -87,18 +107,24 @@ namespace ouzel
 
         Log& operator<<(const bool val)
         {
+            if (!enabled) return *this;
+
             s += val ? "true" : "false";
             return *this;
         }
 
         Log& operator<<(char val)
         {
+            if (!enabled) return *this;
+
             s += val;
             return *this;
         }
 
         Log& operator<<(const std::uint8_t val)
         {
+            if (!enabled) return *this;
+
             constexpr char digits[] = "0123456789abcdef";
             s.push_back(digits[(val >> 4) & 0x0F]);
             s.push_back(digits[(val >> 0) & 0x0F]);
@@ -110,18 +136,24 @@ namespace ouzel
             !std::is_same_v<T, std::uint8_t>>* = nullptr>
         Log& operator<<(const T val)
         {
+            if (!enabled) return *this;
+
             s += std::to_string(val);
             return *this;
         }
 
         Log& operator<<(const std::string& val)
         {
+            if (!enabled) return *this;
+
             s += val;
             return *this;
         }
 
         Log& operator<<(const char* val)
         {
+            if (!enabled) return *this;
+
             s += val;
             return *this;
         }
@@ -129,6 +161,8 @@ namespace ouzel
         template <typename T, std::enable_if_t<!std::is_same_v<T, char>>* = nullptr>
         Log& operator<<(const T* val)
         {
+            if (!enabled) return *this;
+
             constexpr char digits[] = "0123456789abcdef";
 
             const auto ptrValue = bitCast<std::uintptr_t>(val);
@@ -142,6 +176,8 @@ namespace ouzel
         template <typename T, std::enable_if_t<isContainerV<T> || std::is_array_v<T>>* = nullptr>
         Log& operator<<(const T& val)
         {
+            if (!enabled) return *this;
+
             bool first = true;
             for (const auto& i : val)
             {
@@ -156,55 +192,86 @@ namespace ouzel
     private:
         const Logger& logger;
         Level level = Level::info;
+        bool enabled = true;
         std::string s;
     };
 
+    // Producers copy the formatted messages to ring buffers of their threads without locking and
+    // a background thread writes them to the output. When the buffer of a thread is full, the
+    // message is dropped and counted. Errors are written before log returns, so that they are not
+    // lost if the application crashes. Messages above OUZEL_LOG_LEVEL are compiled out.
     class Logger final
     {
+        class ThreadBuffer;
     public:
-        explicit Logger(Log::Level initThreshold = Log::Level::all):
-            threshold(initThreshold)
-        {
-        }
+        static constexpr Log::Level compileTimeThreshold = static_cast<Log::Level>(OUZEL_LOG_LEVEL);
+        static constexpr std::size_t bufferCapacity = 65536; // bytes per thread, must be a power of two
+        static constexpr std::size_t maxMessageSize = 4096; // longer messages are truncated
+        // identical messages of a thread after this count within the interval are suppressed
+        static constexpr std::size_t repeatLimit = 10;
+        static constexpr std::chrono::seconds repeatInterval{1};
+
+        explicit Logger(Log::Level initThreshold = Log::Level::all);
+        ~Logger();
 
         Logger(const Logger&) = delete;
         Logger& operator=(const Logger&) = delete;
         Logger(Logger&&) = delete;
         Logger& operator=(Logger&&) = delete;
 
-        Log log(const Log::Level level = Log::Level::info) const
+        bool isEnabled(const Log::Level level) const noexcept
         {
-            return Log(*this, level);
+            return level <= compileTimeThreshold && level <= threshold.load(std::memory_order_relaxed);
         }
 
-        void log(const std::string& str, const Log::Level level = Log::Level::info) const
+        Log::Level getThreshold() const noexcept { return threshold.load(std::memory_order_relaxed); }
+        void setThreshold(const Log::Level newThreshold) noexcept { threshold.store(newThreshold, std::memory_order_relaxed); }
+
+        Log log(const Log::Level level = Log::Level::info) const
         {
-            if (level <= threshold)
-            {
-#if !defined(__EMSCRIPTEN__)
-                std::scoped_lock lock(logMutex);
-#endif
-                logString(str, level);
-            }
+            return Log(*this, level, isEnabled(level));
         }
 
+        void log(const std::string& str, const Log::Level level = Log::Level::info) const;
+
+        // blocks until the messages logged before the call have been written
+        void flush() const;
+
+        // messages lost because the buffer of their thread was full
+        std::uint64_t getDroppedCount() const noexcept;
+
     private:
         static void logString(const std::string& str, const Log::Level level = Log::Level::info);
 
-#ifdef DEBUG
-        std::atomic<Log::Level> threshold{Log::Level::all};
-#else
-        std::atomic<Log::Level> threshold{Log::Level::info};
-#endif
+        std::atomic<Log::Level> threshold;
 
 #if !defined(__EMSCRIPTEN__)
-        mutable std::mutex logMutex;
+        void push(ThreadBuffer& buffer, const std::string& str, const Log::Level level, std::int64_t timestamp) const;
+        void notifyWriter() const;
+        void writerMain() const;
+        void writeBuffered() const;
+
+        // the buffers of the exited threads are released after the writer has drained them
+        mutable thread::ThreadLocalRegistry<ThreadBuffer> threadBuffers;
+
+        mutable std::mutex writerMutex;
+        mutable std::condition_variable writerCondition;
+        mutable std::condition_variable flushCondition;
+        mutable std::atomic<bool> pending{false};
+        mutable std::atomic<std::uint64_t> droppedCount{0};
+        mutable bool running = true;
+        mutable std::uint64_t flushRequestCount = 0;
+        mutable std::uint64_t flushCount = 0;
+        std::unique_ptr<thread::Thread> writerThread; // started by the constructor
+
+        // serializes the output of the writer thread and of the errors written by the logging thread
+        mutable std::mutex outputMutex;
 #endif
     };
 
     inline Log::~Log()
     {
-        if (!s.empty())
+        if (enabled && !s.empty())
             logger.log(s, level);
     }
 
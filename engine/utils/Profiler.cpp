@@ -0,0 +1,219 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string_view>
+#include <tuple>
+#include "Profiler.hpp"
+#include "../formats/Json.hpp"
+#include "../thread/Thread.hpp"
+
+namespace ouzel
+{
+    Profiler profiler;
+
+    namespace
+    {
+        std::int64_t getTime(std::chrono::steady_clock::time_point timePoint) noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+        }
+
+        std::chrono::steady_clock::time_point getTimePoint(std::int64_t time) noexcept
+        {
+            return std::chrono::steady_clock::time_point{std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds{time})};
+        }
+    }
+
+    Profiler::Scope::Scope(const char* initName):
+        name{initName}
+    {
+        if (profiler.isEnabled())
+        {
+            buffer = &profiler.threadBuffers.get();
+            ++buffer->depth;
+            startTime = std::chrono::steady_clock::now();
+        }
+    }
+
+    Profiler::Scope::~Scope()
+    {
+        if (buffer)
+        {
+            const auto endTime = std::chrono::steady_clock::now();
+            --buffer->depth;
+            buffer->push(name, buffer->depth, getTime(startTime), getTime(endTime));
+        }
+    }
+
+    Profiler::ThreadBuffer::ThreadBuffer(std::size_t initIndex):
+        index{initIndex}, name{thread::getCurrentThreadName()}
+    {
+    }
+
+    void Profiler::ThreadBuffer::push(const char* sampleName, std::uint32_t sampleDepth,
+                                      std::int64_t sampleStartTime, std::int64_t sampleEndTime) noexcept
+    {
+        const auto entryIndex = writeIndex.load(std::memory_order_relaxed);
+        claimIndex.store(entryIndex + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto& entry = entries[entryIndex % bufferCapacity];
+        entry.name.store(sampleName, std::memory_order_relaxed);
+        entry.depth.store(sampleDepth, std::memory_order_relaxed);
+        entry.startTime.store(sampleStartTime, std::memory_order_relaxed);
+        entry.endTime.store(sampleEndTime, std::memory_order_relaxed);
+
+        writeIndex.store(entryIndex + 1, std::memory_order_release);
+    }
+
+    void Profiler::ThreadBuffer::read(std::int64_t fromTime, std::int64_t toTime, std::vector<Sample>& samples) const
+    {
+        const auto end = writeIndex.load(std::memory_order_acquire);
+        const auto begin = end > bufferCapacity ? end - bufferCapacity : 0;
+
+        std::vector<std::pair<std::size_t, Sample>> result;
+
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto& entry = entries[i % bufferCapacity];
+            const auto endTime = entry.endTime.load(std::memory_order_relaxed);
+
+            if (endTime > fromTime && endTime <= toTime)
+                result.emplace_back(i, Sample{
+                    entry.name.load(std::memory_order_relaxed),
+                    index,
+                    entry.depth.load(std::memory_order_relaxed),
+                    getTimePoint(entry.startTime.load(std::memory_order_relaxed)),
+                    getTimePoint(endTime)
+                });
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto claimed = claimIndex.load(std::memory_order_relaxed);
+
+        for (const auto& [i, sample] : result)
+            if (i + bufferCapacity >= claimed)
+                samples.push_back(sample);
+    }
+
+    void Profiler::markFrame() noexcept
+    {
+        const auto index = frameIndex.load(std::memory_order_relaxed);
+        frameTimes[index % frameCapacity].store(getTime(std::chrono::steady_clock::now()), std::memory_order_relaxed);
+        frameIndex.store(index + 1, std::memory_order_release);
+
+        threadBuffers.releaseExited();
+    }
+
+    std::vector<Profiler::Sample> Profiler::getSamples(std::size_t frameCount) const
+    {
+        std::vector<Sample> result;
+
+        const auto index = frameIndex.load(std::memory_order_acquire);
+        if (index < 2 || frameCount == 0) return result;
+
+        // leave a margin, because the thread that marks the frames may overwrite the oldest frame times
+        const auto count = std::min({frameCount, index - 1, frameCapacity - 2});
+        const auto fromTime = frameTimes[(index - 1 - count) % frameCapacity].load(std::memory_order_relaxed);
+        const auto toTime = frameTimes[(index - 1) % frameCapacity].load(std::memory_order_relaxed);
+
+        for (const auto& buffer : threadBuffers.getAll())
+            buffer->read(fromTime, toTime, result);
+
+        return result;
+    }
+
+    std::vector<Profiler::Summary> Profiler::getSummary(std::size_t frameCount) const
+    {
+        auto samples = getSamples(frameCount);
+        std::sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) noexcept {
+            return std::tie(a.threadIndex, a.startTime) < std::tie(b.threadIndex, b.startTime);
+        });
+
+        const auto index = frameIndex.load(std::memory_order_acquire);
+        const auto count = static_cast<std::int64_t>(std::max(std::min({frameCount, index - 1, frameCapacity - 2}), std::size_t{1}));
+
+        std::vector<Summary> result;
+        std::vector<std::chrono::nanoseconds> totalTimes;
+        std::map<std::tuple<std::size_t, std::string_view, std::uint32_t>, std::size_t> summaryIndices;
+
+        for (const auto& sample : samples)
+        {
+            const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(sample.endTime - sample.startTime);
+
+            const auto [iterator, inserted] = summaryIndices.emplace(std::make_tuple(sample.threadIndex, std::string_view{sample.name}, sample.depth),
+                                                                     result.size());
+            if (inserted)
+            {
+                result.push_back(Summary{getThreadName(sample.threadIndex), sample.name, sample.depth,
+                                         0, std::chrono::nanoseconds{0}, std::chrono::nanoseconds{0}});
+                totalTimes.push_back(std::chrono::nanoseconds{0});
+            }
+
+            auto& summary = result[iterator->second];
+            ++summary.callCount;
+            summary.maximumTime = std::max(summary.maximumTime, time);
+            totalTimes[iterator->second] += time;
+        }
+
+        for (std::size_t i = 0; i < result.size(); ++i)
+            result[i].averageTime = totalTimes[i] / count;
+
+        return result;
+    }
+
+    std::string Profiler::getThreadName(std::size_t threadIndex) const
+    {
+        for (const auto& buffer : threadBuffers.getAll())
+            if (buffer->index == threadIndex)
+                return buffer->name;
+
+        return std::string{};
+    }
+
+    std::string Profiler::exportChromeTrace() const
+    {
+        std::vector<Sample> samples;
+        const auto buffers = threadBuffers.getAll();
+        for (const auto& buffer : buffers)
+            buffer->read(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(), samples);
+
+        auto baseTime = std::chrono::steady_clock::time_point::max();
+        for (const auto& sample : samples)
+            baseTime = std::min(baseTime, sample.startTime);
+
+        json::Value events = json::Value::Array{};
+
+        for (const auto& buffer : buffers)
+        {
+            json::Value event = json::Value::Object{};
+            event["name"] = "thread_name";
+            event["ph"] = "M";
+            event["pid"] = 0;
+            event["tid"] = buffer->index;
+            event["args"] = json::Value::Object{};
+            event["args"]["name"] = buffer->name.empty() ? "Thread " + std::to_string(buffer->index) : buffer->name;
+            events.pushBack(event);
+        }
+
+        for (const auto& sample : samples)
+        {
+            json::Value event = json::Value::Object{};
+            event["name"] = sample.name;
+            event["ph"] = "X";
+            event["pid"] = 0;
+            event["tid"] = sample.threadIndex;
+            event["ts"] = std::chrono::duration<double, std::micro>(sample.startTime - baseTime).count();
+            event["dur"] = std::chrono::duration<double, std::micro>(sample.endTime - sample.startTime).count();
+            events.pushBack(event);
+        }
+
+        json::Value result = json::Value::Object{};
+        result["traceEvents"] = events;
+        result["displayTimeUnit"] = "ms";
+
+        return json::encode(result);
+    }
+}
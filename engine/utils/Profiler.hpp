@@ -0,0 +1,139 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_UTILS_PROFILER_HPP
+#define OUZEL_UTILS_PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../core/Setup.h"
+#include "../thread/ThreadLocalRegistry.hpp"
+
+namespace ouzel
+{
+    // Records the time spent in scopes marked with OUZEL_PROFILE_SCOPE. Every thread writes
+    // its samples to its own ring buffer, so recording does not lock and the oldest samples
+    // are overwritten when the buffer is full. Recording is disabled by default.
+    class Profiler final
+    {
+        class ThreadBuffer;
+    public:
+        static constexpr std::size_t bufferCapacity = 16384; // samples per thread
+        static constexpr std::size_t frameCapacity = 256;
+
+        struct Sample final
+        {
+            const char* name;
+            std::size_t threadIndex;
+            std::uint32_t depth;
+            std::chrono::steady_clock::time_point startTime;
+            std::chrono::steady_clock::time_point endTime;
+        };
+
+        struct Summary final
+        {
+            std::string threadName;
+            const char* name;
+            std::uint32_t depth;
+            std::size_t callCount;
+            std::chrono::nanoseconds averageTime; // per frame
+            std::chrono::nanoseconds maximumTime; // of a single call
+        };
+
+        class Scope final
+        {
+        public:
+            explicit Scope(const char* initName);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+            Scope(Scope&&) = delete;
+            Scope& operator=(Scope&&) = delete;
+
+        private:
+            const char* name;
+            ThreadBuffer* buffer = nullptr;
+            std::chrono::steady_clock::time_point startTime;
+        };
+
+        Profiler() = default;
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+        Profiler(Profiler&&) = delete;
+        Profiler& operator=(Profiler&&) = delete;
+
+        bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+        void setEnabled(bool newEnabled) noexcept { enabled.store(newEnabled, std::memory_order_relaxed); }
+
+        // must be called from one thread at the start of every frame
+        void markFrame() noexcept;
+
+        // samples of all the threads that ended within the last frameCount finished frames
+        std::vector<Sample> getSamples(std::size_t frameCount) const;
+        // samples grouped by thread, name and depth in the order they were first started
+        std::vector<Summary> getSummary(std::size_t frameCount) const;
+
+        std::string getThreadName(std::size_t threadIndex) const;
+
+        // all the buffered samples in the Chrome trace event format, which can be opened
+        // with chrome://tracing or Perfetto
+        std::string exportChromeTrace() const;
+
+    private:
+        class ThreadBuffer final
+        {
+        public:
+            explicit ThreadBuffer(std::size_t initIndex);
+
+            void push(const char* sampleName, std::uint32_t sampleDepth,
+                      std::int64_t sampleStartTime, std::int64_t sampleEndTime) noexcept;
+            void read(std::int64_t fromTime, std::int64_t toTime, std::vector<Sample>& samples) const;
+
+            const std::size_t index;
+            const std::string name;
+            std::uint32_t depth = 0; // accessed only by the thread that owns the buffer
+
+        private:
+            // the fields are atomic, so that they can be read while the owner overwrites them
+            struct Entry final
+            {
+                std::atomic<const char*> name{nullptr};
+                std::atomic<std::uint32_t> depth{0};
+                std::atomic<std::int64_t> startTime{0};
+                std::atomic<std::int64_t> endTime{0};
+            };
+
+            std::array<Entry, bufferCapacity> entries;
+            // the index of the entry that is being written and the number of entries written,
+            // the reader discards the entries that have been claimed again while it was reading
+            std::atomic<std::size_t> claimIndex{0};
+            std::atomic<std::size_t> writeIndex{0};
+        };
+
+        std::atomic<bool> enabled{false};
+
+        // the buffers of the exited threads are released at the next frame
+        thread::ThreadLocalRegistry<ThreadBuffer> threadBuffers;
+
+        std::array<std::atomic<std::int64_t>, frameCapacity> frameTimes{};
+        std::atomic<std::size_t> frameIndex{0};
+    };
+
+    extern Profiler profiler;
+}
+
+#if OUZEL_ENABLE_PROFILER
+#  define OUZEL_PROFILE_CONCAT_IMPL(a, b) a##b
+#  define OUZEL_PROFILE_CONCAT(a, b) OUZEL_PROFILE_CONCAT_IMPL(a, b)
+#  define OUZEL_PROFILE_SCOPE(name) const ouzel::Profiler::Scope OUZEL_PROFILE_CONCAT(profileScope, __LINE__){name}
+#else
+#  define OUZEL_PROFILE_SCOPE(name)
+#endif
+
+#endif // OUZEL_UTILS_PROFILER_HPP
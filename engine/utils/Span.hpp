@@ -0,0 +1,81 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_UTILS_SPAN_HPP
+#define OUZEL_UTILS_SPAN_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ouzel
+{
+    // Non-owning view of contiguous elements (a subset of C++20 std::span)
+    template <class T>
+    class Span final
+    {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using pointer = T*;
+        using reference = T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        constexpr Span() noexcept = default;
+
+        constexpr Span(T* initData, std::size_t initSize) noexcept:
+            d(initData), s(initSize)
+        {
+        }
+
+        constexpr Span(T* first, T* last) noexcept:
+            d(first), s(static_cast<std::size_t>(last - first))
+        {
+        }
+
+        Span(std::vector<value_type>& vector) noexcept:
+            d(vector.data()), s(vector.size())
+        {
+        }
+
+        template <class U = T, std::enable_if_t<std::is_const_v<U>>* = nullptr>
+        Span(const std::vector<value_type>& vector) noexcept:
+            d(vector.data()), s(vector.size())
+        {
+        }
+
+        template <class U, std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>* = nullptr>
+        constexpr Span(const Span<U>& other) noexcept:
+            d(other.data()), s(other.size())
+        {
+        }
+
+        constexpr T* data() const noexcept { return d; }
+        constexpr std::size_t size() const noexcept { return s; }
+        constexpr bool empty() const noexcept { return s == 0; }
+
+        constexpr T* begin() const noexcept { return d; }
+        constexpr T* end() const noexcept { return d + s; }
+
+        constexpr T& operator[](std::size_t index) const noexcept { return d[index]; }
+
+        constexpr T& front() const noexcept { return d[0]; }
+        constexpr T& back() const noexcept { return d[s - 1]; }
+
+        Span subspan(std::size_t offset, std::size_t count) const
+        {
+            if (offset > s || count > s - offset)
+                throw std::out_of_range("Span out of range");
+
+            return Span{d + offset, count};
+        }
+
+    private:
+        T* d = nullptr;
+        std::size_t s = 0;
+    };
+}
+
+#endif // OUZEL_UTILS_SPAN_HPP
@@ -3,6 +3,9 @@
 #ifndef OUZEL_ASSET_HPP
 #define OUZEL_ASSET_HPP
 
+#include <stdexcept>
+#include <string>
+#include "graphics/PixelFormat.hpp"
 #include "storage/Path.hpp"
 
 namespace ouzel
@@ -27,16 +30,22 @@ namespace ouzel
         Asset(const storage::Path& initPath,
               const std::string& initName,
               Type initType,
-              bool initMipmaps):
+              bool initMipmaps,
+              graphics::PixelFormat initPixelFormat = graphics::PixelFormat::rgba8UnsignedNorm,
+              float initFontSize = 32.0F):
             path(initPath),
             name(initName),
             type(initType),
-            mipmaps(initMipmaps) {}
+            mipmaps(initMipmaps),
+            pixelFormat(initPixelFormat),
+            fontSize(initFontSize) {}
 
-        const storage::Path path;
+        const storage::Path path; // relative to the assets directory
         const std::string name;
         const Type type = Type::empty;
         const bool mipmaps = false;
+        const graphics::PixelFormat pixelFormat = graphics::PixelFormat::rgba8UnsignedNorm; // textures are cooked to this format
+        const float fontSize = 32.0F; // pixel height of the glyphs baked from TrueType fonts
     };
 
     inline Asset::Type stringToAssetType(const std::string& s)
@@ -64,6 +73,22 @@ namespace ouzel
         else
             throw std::runtime_error("Invalid asset type");
     }
+
+    inline graphics::PixelFormat stringToPixelFormat(const std::string& s)
+    {
+        if (s == "rgba8")
+            return graphics::PixelFormat::rgba8UnsignedNorm;
+        else if (s == "rgba8_srgb")
+            return graphics::PixelFormat::rgba8UnsignedNormSRGB;
+        else if (s == "rg8")
+            return graphics::PixelFormat::rg8UnsignedNorm;
+        else if (s == "r8")
+            return graphics::PixelFormat::r8UnsignedNorm;
+        else if (s == "a8")
+            return graphics::PixelFormat::a8UnsignedNorm;
+        else
+            throw std::runtime_error("Invalid pixel format");
+    }
 }
 
 #endif // OUZEL_ASSET_HPP
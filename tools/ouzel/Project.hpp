@@ -3,9 +3,11 @@
 #ifndef OUZEL_OUZELPROJECT_HPP
 #define OUZEL_OUZELPROJECT_HPP
 
+#include <algorithm>
 #include <fstream>
 #include "Asset.hpp"
 #include "Target.hpp"
+#include "cooker/Cooker.hpp"
 #include "storage/FileSystem.hpp"
 #include "formats/Json.hpp"
 
@@ -58,16 +60,21 @@ namespace ouzel
 
             for (const auto& assetObject : j["assets"])
             {
-                const auto assetPath(assetsPath / assetObject["path"].as<std::string>());
+                const storage::Path assetPath = assetObject["path"].as<std::string>();
+                // the engine uses the filename as the name of the asset if it was not given
                 const auto assetName = assetObject.hasMember("name") ?
-                    assetObject["name"].as<std::string>() : std::string(assetPath.getStem());
+                    assetObject["name"].as<std::string>() : assetPath.getGeneric();
 
                 const auto assetType = stringToAssetType(assetObject["type"].as<std::string>());
 
                 assets.emplace_back(assetPath,
                                     assetName,
                                     assetType,
-                                    assetObject.hasMember("mipmaps") ? assetObject["mipmaps"].as<bool>() : false);
+                                    assetObject.hasMember("mipmaps") ? assetObject["mipmaps"].as<bool>() : false,
+                                    assetObject.hasMember("pixelFormat") ?
+                                        stringToPixelFormat(assetObject["pixelFormat"].as<std::string>()) :
+                                        graphics::PixelFormat::rgba8UnsignedNorm,
+                                    assetObject.hasMember("fontSize") ? assetObject["fontSize"].as<float>() : 32.0F);
             }
         }
 
@@ -84,26 +91,18 @@ namespace ouzel
 
         void exportAssets(const std::string& targetName) const
         {
-            for (const auto& asset : assets)
-            {
-                const storage::Path assetPath = assetsPath / asset.path;
-
-                storage::Path resourceName = asset.path;
-                resourceName.replaceExtension("otexture");
-                const storage::Path resourcePath = assetPath / resourceName;
-
-                const auto targetIterator = std::find_if(targets.begin(), targets.end(),
-                                                         [targetName](const auto& target) noexcept {
-                    return target.name == targetName;
-                });
-
-                if (targetIterator == targets.end())
-                    throw std::runtime_error("Target not found");
-
-                // TODO: check if input file exists
-                // TODO: check if output file exists and is older than the input file
-                // TODO: export input file to output file
-            }
+            const auto targetIterator = std::find_if(targets.begin(), targets.end(),
+                                                     [&targetName](const auto& target) noexcept {
+                return target.name == targetName;
+            });
+
+            if (targetIterator == targets.end())
+                throw std::runtime_error("Target not found");
+
+            const auto directory = path.getDirectory();
+            cooker::Cooker cooker{assetsPath.isAbsolute() ? assetsPath : directory / assetsPath,
+                                  directory / "export" / targetIterator->name};
+            cooker.cook(assets);
         }
 
     private:
@@ -0,0 +1,430 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_COOKER_COOKER_HPP
+#define OUZEL_COOKER_COOKER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <set>
+#include <thread>
+#include "Job.hpp"
+#include "FontCooker.hpp"
+#include "MeshCooker.hpp"
+#include "SpriteCooker.hpp"
+#include "TextureCooker.hpp"
+#include "assets/Loader.hpp"
+#include "formats/Json.hpp"
+
+namespace ouzel::cooker
+{
+    // Converts the project assets to the engine-native formats in formats/Cooked.hpp
+    // and writes the assets.json manifest that can be passed to Bundle::loadAssets.
+    // Jobs whose inputs did not change since the last run (by time and size or,
+    // failing that, by content hash) are skipped.
+    class Cooker final
+    {
+    public:
+        Cooker(const storage::Path& initAssetsDirectory,
+               const storage::Path& initOutputDirectory):
+            assetsDirectory{initAssetsDirectory},
+            outputDirectory{initOutputDirectory}
+        {
+        }
+
+        void cook(const std::vector<Asset>& assets)
+        {
+            loadCache();
+
+            json::Value manifestAssets{json::Value::Type::array};
+            std::vector<Job> pending;
+
+            for (const auto& asset : assets)
+            {
+                if (asset.type == Asset::Type::empty ||
+                    asset.type == Asset::Type::shader)
+                    continue;
+
+                auto job = createJob(asset);
+
+                json::Value manifestAsset{json::Value::Type::object};
+                manifestAsset["type"] = static_cast<std::uint32_t>(getLoaderType(asset.type));
+                manifestAsset["name"] = asset.name;
+                manifestAsset["filename"] = job.output.getGeneric();
+                manifestAsset["mipmaps"] = asset.mipmaps;
+                manifestAssets.pushBack(manifestAsset);
+
+                pending.push_back(std::move(job));
+            }
+
+            std::set<std::string> outputs;
+            std::vector<std::string> errors;
+            std::size_t cookedCount = 0;
+            std::size_t skippedCount = 0;
+
+            // cook the dependencies found in one pass in the next one
+            while (!pending.empty())
+            {
+                std::vector<Job> jobs;
+                for (auto& job : pending)
+                    if (outputs.insert(job.output.getGeneric()).second)
+                        jobs.push_back(std::move(job));
+                pending.clear();
+
+                std::vector<Entry> entries(jobs.size());
+                std::vector<std::string> jobErrors(jobs.size());
+                std::vector<char> skipped(jobs.size(), 0);
+                std::atomic<std::size_t> nextJob{0};
+
+                const auto worker = [&]() {
+                    for (std::size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+                        try
+                        {
+                            skipped[i] = isUpToDate(jobs[i], entries[i]) ? 1 : 0;
+                            if (!skipped[i]) entries[i] = run(jobs[i]);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            jobErrors[i] = std::string(jobs[i].source) + ": " + e.what();
+                        }
+                };
+
+                const auto threadCount = std::min(static_cast<std::size_t>(std::max(std::thread::hardware_concurrency(), 1U)),
+                                                  jobs.size());
+                std::vector<std::thread> threads;
+                for (std::size_t i = 1; i < threadCount; ++i)
+                    threads.emplace_back(worker);
+                worker();
+                for (auto& thread : threads)
+                    thread.join();
+
+                for (std::size_t i = 0; i < jobs.size(); ++i)
+                {
+                    const auto output = jobs[i].output.getGeneric();
+
+                    if (!jobErrors[i].empty())
+                    {
+                        errors.push_back(jobErrors[i]);
+                        cache.erase(output);
+                        continue;
+                    }
+
+                    if (skipped[i])
+                        ++skippedCount;
+                    else
+                        ++cookedCount;
+
+                    pending.insert(pending.end(), entries[i].dependencies.begin(), entries[i].dependencies.end());
+                    cache[output] = std::move(entries[i]);
+                }
+            }
+
+            saveCache();
+
+            json::Value manifest{json::Value::Type::object};
+            manifest["assets"] = manifestAssets;
+            const auto manifestData = json::encode(manifest, true);
+            const auto manifestBytes = reinterpret_cast<const std::byte*>(manifestData.data());
+            writeFile(outputDirectory / "assets.json",
+                      std::vector<std::byte>(manifestBytes, manifestBytes + manifestData.size()));
+
+            std::cout << "Cooked " << cookedCount << ", up to date " << skippedCount << ", failed " << errors.size() << '\n';
+
+            for (const auto& error : errors)
+                std::cerr << error << '\n';
+
+            if (!errors.empty())
+                throw CookError("Failed to cook " + std::to_string(errors.size()) + " assets");
+        }
+
+    private:
+        class Input final
+        {
+        public:
+            std::string path;
+            std::int64_t time = 0;
+            std::uint64_t size = 0;
+            std::uint64_t hash = 0;
+        };
+
+        class Entry final
+        {
+        public:
+            std::string key;
+            std::vector<Input> inputs;
+            std::vector<std::string> outputs;
+            std::vector<Job> dependencies;
+        };
+
+        Job createJob(const Asset& asset) const
+        {
+            Job job;
+            job.name = asset.name;
+            job.source = asset.path;
+            job.output = asset.path;
+            job.pixelFormat = asset.pixelFormat;
+            job.mipmaps = asset.mipmaps;
+            job.fontSize = asset.fontSize;
+
+            const auto extension = std::string(asset.path.getExtension());
+
+            switch (asset.type)
+            {
+                case Asset::Type::texture:
+                    job.action = Job::Action::texture;
+                    job.output.replaceExtension("otexture");
+                    break;
+                case Asset::Type::mesh:
+                    // glTF and COLLADA are loaded from the source files
+                    if (extension == "obj")
+                    {
+                        job.action = Job::Action::mesh;
+                        job.output.replaceExtension("omesh");
+                    }
+                    break;
+                case Asset::Type::sprite:
+                    if (extension == "json")
+                    {
+                        job.action = Job::Action::sprite;
+                        job.output.replaceExtension("osprite");
+                    }
+                    break;
+                case Asset::Type::font:
+                    job.action = Job::Action::font;
+                    job.output.replaceExtension("ofont");
+                    break;
+                default:
+                    break;
+            }
+
+            return job;
+        }
+
+        static assets::Loader::Type getLoaderType(Asset::Type type)
+        {
+            switch (type)
+            {
+                case Asset::Type::font: return assets::Loader::Type::font;
+                case Asset::Type::mesh: return assets::Loader::Type::staticMesh;
+                case Asset::Type::texture: return assets::Loader::Type::image;
+                case Asset::Type::material: return assets::Loader::Type::material;
+                case Asset::Type::particleSystem: return assets::Loader::Type::particleSystem;
+                case Asset::Type::sprite: return assets::Loader::Type::sprite;
+                case Asset::Type::sound: return assets::Loader::Type::sound;
+                case Asset::Type::cue: return assets::Loader::Type::cue;
+                default: throw CookError("Asset type has no loader");
+            }
+        }
+
+        static std::string getKey(const Job& job)
+        {
+            return std::to_string(static_cast<int>(job.action)) + ':' +
+                std::to_string(cooked::version) + ':' +
+                std::to_string(static_cast<int>(job.pixelFormat)) + ':' +
+                std::to_string(job.mipmaps) + ':' +
+                std::to_string(job.fontSize) + ':' +
+                job.name + ':' +
+                job.source.getGeneric();
+        }
+
+        Input getInput(const storage::Path& path, bool withHash) const
+        {
+            const auto fullPath = assetsDirectory / path;
+            const std::chrono::system_clock::time_point time = storage::FileSystem::getModifyTime(fullPath);
+
+            Input input;
+            input.path = path.getGeneric();
+            input.time = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+            input.size = storage::FileSystem::getFileSize(fullPath);
+            if (withHash) input.hash = hashData(readFile(fullPath));
+            return input;
+        }
+
+        bool isUpToDate(const Job& job, Entry& result) const
+        {
+            const auto i = cache.find(job.output.getGeneric());
+            if (i == cache.end() || i->second.key != getKey(job))
+                return false;
+
+            auto entry = i->second;
+
+            for (const auto& output : entry.outputs)
+                if (storage::FileSystem::getFileType(outputDirectory / output) != storage::FileType::regular)
+                    return false;
+
+            for (auto& input : entry.inputs)
+            {
+                if (storage::FileSystem::getFileType(assetsDirectory / input.path) != storage::FileType::regular)
+                    return false;
+
+                auto current = getInput(input.path, false);
+                if (current.time == input.time && current.size == input.size)
+                    continue;
+
+                // the file was touched, but its contents might be the same
+                current.hash = hashData(readFile(assetsDirectory / input.path));
+                if (current.hash != input.hash)
+                    return false;
+
+                input = current;
+            }
+
+            result = std::move(entry);
+            return true;
+        }
+
+        Entry run(const Job& job) const
+        {
+            Result result;
+
+            switch (job.action)
+            {
+                case Job::Action::copy:
+                    result.inputs.push_back(job.source);
+                    result.outputs.emplace_back(job.output, readFile(assetsDirectory / job.source));
+                    break;
+                case Job::Action::texture:
+                    result = cookTexture(job, assetsDirectory);
+                    break;
+                case Job::Action::mesh:
+                    result = cookMesh(job, assetsDirectory);
+                    break;
+                case Job::Action::sprite:
+                    result = cookSprite(job, assetsDirectory);
+                    break;
+                case Job::Action::font:
+                    result = cookFont(job, assetsDirectory);
+                    break;
+            }
+
+            Entry entry;
+            entry.key = getKey(job);
+
+            for (const auto& input : result.inputs)
+                entry.inputs.push_back(getInput(input, true));
+
+            for (const auto& [path, data] : result.outputs)
+            {
+                writeFile(outputDirectory / path, data);
+                entry.outputs.push_back(path.getGeneric());
+            }
+
+            entry.dependencies = std::move(result.dependencies);
+            return entry;
+        }
+
+        void loadCache()
+        {
+            cache.clear();
+
+            const auto cachePath = outputDirectory / "cache.json";
+            if (storage::FileSystem::getFileType(cachePath) != storage::FileType::regular)
+                return;
+
+            try
+            {
+                const auto data = json::parse(readFile(cachePath));
+
+                for (const auto& [output, entryObject] : data.as<json::Value::Object>())
+                {
+                    Entry entry;
+                    entry.key = entryObject["key"].as<std::string>();
+
+                    for (const auto& inputObject : entryObject["inputs"])
+                    {
+                        Input input;
+                        input.path = inputObject["path"].as<std::string>();
+                        input.time = std::stoll(inputObject["time"].as<std::string>());
+                        input.size = std::stoull(inputObject["size"].as<std::string>());
+                        input.hash = std::stoull(inputObject["hash"].as<std::string>(), nullptr, 16);
+                        entry.inputs.push_back(input);
+                    }
+
+                    for (const auto& outputObject : entryObject["outputs"])
+                        entry.outputs.push_back(outputObject.as<std::string>());
+
+                    for (const auto& dependencyObject : entryObject["dependencies"])
+                    {
+                        Job dependency;
+                        dependency.action = static_cast<Job::Action>(dependencyObject["action"].as<std::uint32_t>());
+                        dependency.name = dependencyObject["name"].as<std::string>();
+                        dependency.source = dependencyObject["source"].as<std::string>();
+                        dependency.output = dependencyObject["output"].as<std::string>();
+                        dependency.pixelFormat = static_cast<graphics::PixelFormat>(dependencyObject["pixelFormat"].as<std::uint32_t>());
+                        dependency.mipmaps = dependencyObject["mipmaps"].as<bool>();
+                        dependency.fontSize = dependencyObject["fontSize"].as<float>();
+                        entry.dependencies.push_back(dependency);
+                    }
+
+                    cache[output] = std::move(entry);
+                }
+            }
+            catch (const std::exception&)
+            {
+                // cook everything if the cache can not be read
+                cache.clear();
+            }
+        }
+
+        void saveCache() const
+        {
+            json::Value data{json::Value::Type::object};
+
+            for (const auto& [output, entry] : cache)
+            {
+                json::Value entryObject{json::Value::Type::object};
+                entryObject["key"] = entry.key;
+
+                json::Value inputsArray{json::Value::Type::array};
+                for (const auto& input : entry.inputs)
+                {
+                    char hash[17];
+                    std::snprintf(hash, sizeof(hash), "%016llX", static_cast<unsigned long long>(input.hash));
+
+                    json::Value inputObject{json::Value::Type::object};
+                    inputObject["path"] = input.path;
+                    inputObject["time"] = std::to_string(input.time);
+                    inputObject["size"] = std::to_string(input.size);
+                    inputObject["hash"] = std::string(hash);
+                    inputsArray.pushBack(inputObject);
+                }
+                entryObject["inputs"] = inputsArray;
+
+                json::Value outputsArray{json::Value::Type::array};
+                for (const auto& entryOutput : entry.outputs)
+                    outputsArray.pushBack(entryOutput);
+                entryObject["outputs"] = outputsArray;
+
+                json::Value dependenciesArray{json::Value::Type::array};
+                for (const auto& dependency : entry.dependencies)
+                {
+                    json::Value dependencyObject{json::Value::Type::object};
+                    dependencyObject["action"] = static_cast<std::uint32_t>(dependency.action);
+                    dependencyObject["name"] = dependency.name;
+                    dependencyObject["source"] = dependency.source.getGeneric();
+                    dependencyObject["output"] = dependency.output.getGeneric();
+                    dependencyObject["pixelFormat"] = static_cast<std::uint32_t>(dependency.pixelFormat);
+                    dependencyObject["mipmaps"] = dependency.mipmaps;
+                    dependencyObject["fontSize"] = dependency.fontSize;
+                    dependenciesArray.pushBack(dependencyObject);
+                }
+                entryObject["dependencies"] = dependenciesArray;
+
+                data[output] = entryObject;
+            }
+
+            const auto encoded = json::encode(data, true);
+            const auto bytes = reinterpret_cast<const std::byte*>(encoded.data());
+            writeFile(outputDirectory / "cache.json", std::vector<std::byte>(bytes, bytes + encoded.size()));
+        }
+
+        storage::Path assetsDirectory;
+        storage::Path outputDirectory;
+        std::map<std::string, Entry> cache;
+    };
+}
+
+#endif // OUZEL_COOKER_COOKER_HPP
@@ -0,0 +1,330 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_COOKER_FONTCOOKER_HPP
+#define OUZEL_COOKER_FONTCOOKER_HPP
+
+#include <cmath>
+#include <map>
+#include <utility>
+#include "Job.hpp"
+#include "TextureCooker.hpp"
+#include "formats/Cooked.hpp"
+#include "stb_truetype.h"
+
+namespace ouzel::cooker
+{
+    inline namespace detail
+    {
+        class FontChar final
+        {
+        public:
+            std::int16_t x = 0;
+            std::int16_t y = 0;
+            std::int16_t width = 0;
+            std::int16_t height = 0;
+            std::int16_t xOffset = 0;
+            std::int16_t yOffset = 0;
+            std::int16_t xAdvance = 0;
+            std::int16_t page = 0;
+        };
+
+        class FontData final
+        {
+        public:
+            std::string textureName;
+            std::string textureFilename;
+            std::uint16_t lineHeight = 0;
+            std::uint16_t base = 0;
+            std::uint16_t width = 0;
+            std::uint16_t height = 0;
+            std::uint16_t pages = 0;
+            std::uint16_t outline = 0;
+            std::map<char32_t, FontChar> chars;
+            std::map<std::pair<char32_t, char32_t>, std::int16_t> kern;
+        };
+
+        inline std::vector<std::byte> writeFont(const FontData& font)
+        {
+            cooked::Writer writer{cooked::fontMagic};
+            writer.writeString(font.textureName);
+            writer.writeString(font.textureFilename);
+            writer.writeUint16(font.lineHeight);
+            writer.writeUint16(font.base);
+            writer.writeUint16(font.width);
+            writer.writeUint16(font.height);
+            writer.writeUint16(font.pages);
+            writer.writeUint16(font.outline);
+
+            writer.writeUint32(static_cast<std::uint32_t>(font.chars.size()));
+            for (const auto& [id, c] : font.chars)
+            {
+                writer.writeUint32(static_cast<std::uint32_t>(id));
+                writer.writeInt16(c.x);
+                writer.writeInt16(c.y);
+                writer.writeInt16(c.width);
+                writer.writeInt16(c.height);
+                writer.writeInt16(c.xOffset);
+                writer.writeInt16(c.yOffset);
+                writer.writeInt16(c.xAdvance);
+                writer.writeInt16(c.page);
+            }
+
+            writer.writeUint32(static_cast<std::uint32_t>(font.kern.size()));
+            for (const auto& [pair, amount] : font.kern)
+            {
+                writer.writeUint32(static_cast<std::uint32_t>(pair.first));
+                writer.writeUint32(static_cast<std::uint32_t>(pair.second));
+                writer.writeInt16(amount);
+            }
+
+            return writer.getData();
+        }
+
+        // Splits a BMFont text line into the keyword and its key=value pairs
+        inline std::pair<std::string, std::map<std::string, std::string>> parseFntLine(const std::string& line)
+        {
+            std::pair<std::string, std::map<std::string, std::string>> result;
+
+            std::size_t position = line.find_first_not_of(" \t");
+            if (position == std::string::npos) return result;
+
+            auto end = line.find_first_of(" \t", position);
+            result.first = line.substr(position, end - position);
+            position = end;
+
+            while (position != std::string::npos &&
+                   (position = line.find_first_not_of(" \t", position)) != std::string::npos)
+            {
+                const auto equals = line.find('=', position);
+                if (equals == std::string::npos)
+                    throw CookError("Invalid font line");
+
+                const auto key = line.substr(position, equals - position);
+                std::string value;
+
+                if (equals + 1 < line.size() && line[equals + 1] == '"')
+                {
+                    const auto quote = line.find('"', equals + 2);
+                    if (quote == std::string::npos)
+                        throw CookError("Unterminated string");
+
+                    value = line.substr(equals + 2, quote - equals - 2);
+                    position = quote + 1;
+                }
+                else
+                {
+                    end = line.find_first_of(" \t", equals + 1);
+                    value = line.substr(equals + 1, end - equals - 1);
+                    position = end;
+                }
+
+                result.second[key] = value;
+            }
+
+            return result;
+        }
+
+        inline std::int16_t getInt16(const std::map<std::string, std::string>& values, const std::string& key)
+        {
+            const auto i = values.find(key);
+            return i == values.end() ? std::int16_t{0} : static_cast<std::int16_t>(std::stoi(i->second));
+        }
+
+        inline Result cookFntFont(const Job& job, const std::vector<std::byte>& data)
+        {
+            Result result;
+            result.inputs.push_back(job.source);
+
+            FontData font;
+
+            std::string line;
+            for (auto iterator = data.begin(); iterator != data.end(); ++iterator)
+            {
+                const auto c = static_cast<char>(*iterator);
+                if (c != '\r' && c != '\n')
+                    line.push_back(c);
+
+                if (c != '\n' && iterator + 1 != data.end())
+                    continue;
+
+                const auto [keyword, values] = parseFntLine(line);
+                line.clear();
+
+                if (keyword == "page")
+                {
+                    const auto i = values.find("file");
+                    if (i == values.end()) continue;
+
+                    // the engine looks the page texture up by its filename
+                    Job textureJob;
+                    textureJob.action = Job::Action::texture;
+                    textureJob.name = i->second;
+                    textureJob.source = i->second;
+                    textureJob.output = storage::Path{i->second}.replaceExtension("otexture");
+                    textureJob.mipmaps = job.mipmaps;
+                    result.dependencies.push_back(textureJob);
+                    result.inputs.push_back(textureJob.source);
+
+                    font.textureName = textureJob.name;
+                    font.textureFilename = textureJob.output.getGeneric();
+                }
+                else if (keyword == "common")
+                {
+                    font.lineHeight = static_cast<std::uint16_t>(getInt16(values, "lineHeight"));
+                    font.base = static_cast<std::uint16_t>(getInt16(values, "base"));
+                    font.width = static_cast<std::uint16_t>(getInt16(values, "scaleW"));
+                    font.height = static_cast<std::uint16_t>(getInt16(values, "scaleH"));
+                    font.pages = static_cast<std::uint16_t>(getInt16(values, "pages"));
+                    font.outline = static_cast<std::uint16_t>(getInt16(values, "outline"));
+                }
+                else if (keyword == "char")
+                {
+                    FontChar fontChar;
+                    fontChar.x = getInt16(values, "x");
+                    fontChar.y = getInt16(values, "y");
+                    fontChar.width = getInt16(values, "width");
+                    fontChar.height = getInt16(values, "height");
+                    fontChar.xOffset = getInt16(values, "xoffset");
+                    fontChar.yOffset = getInt16(values, "yoffset");
+                    fontChar.xAdvance = getInt16(values, "xadvance");
+                    fontChar.page = getInt16(values, "page");
+                    font.chars[static_cast<char32_t>(std::stoul(values.at("id")))] = fontChar;
+                }
+                else if (keyword == "kerning")
+                {
+                    const auto first = static_cast<char32_t>(std::stoul(values.at("first")));
+                    const auto second = static_cast<char32_t>(std::stoul(values.at("second")));
+                    font.kern[std::pair(first, second)] = getInt16(values, "amount");
+                }
+            }
+
+            if (font.textureName.empty())
+                throw CookError("Font has no pages");
+
+            result.outputs.emplace_back(job.output, writeFont(font));
+            return result;
+        }
+
+        // Bakes the Latin-1 glyphs into an atlas that is as small as possible
+        inline Result cookTrueTypeFont(const Job& job, const std::vector<std::byte>& data)
+        {
+            const auto fontData = reinterpret_cast<const unsigned char*>(data.data());
+
+            stbtt_fontinfo fontInfo;
+            if (!stbtt_InitFont(&fontInfo, fontData, stbtt_GetFontOffsetForIndex(fontData, 0)))
+                throw CookError("Failed to load font");
+
+            const std::pair<int, int> ranges[] = {{32, 126 - 32 + 1}, {160, 255 - 160 + 1}};
+            std::vector<stbtt_packedchar> packedChars(95 + 96);
+
+            std::uint32_t atlasSize = 256;
+            std::vector<std::uint8_t> coverage;
+
+            for (;;)
+            {
+                coverage.assign(static_cast<std::size_t>(atlasSize) * atlasSize, 0);
+
+                stbtt_pack_context context;
+                if (!stbtt_PackBegin(&context, coverage.data(),
+                                     static_cast<int>(atlasSize), static_cast<int>(atlasSize),
+                                     0, 1, nullptr))
+                    throw CookError("Failed to pack font");
+
+                bool packed = true;
+                std::size_t offset = 0;
+                for (const auto& [first, count] : ranges)
+                {
+                    if (!stbtt_PackFontRange(&context, fontData, 0, job.fontSize, first, count, &packedChars[offset]))
+                        packed = false;
+                    offset += static_cast<std::size_t>(count);
+                }
+
+                stbtt_PackEnd(&context);
+
+                if (packed) break;
+                if (atlasSize >= 4096)
+                    throw CookError("Font does not fit into the atlas");
+                atlasSize *= 2;
+            }
+
+            const auto scale = stbtt_ScaleForPixelHeight(&fontInfo, job.fontSize);
+            int ascent;
+            int descent;
+            int lineGap;
+            stbtt_GetFontVMetrics(&fontInfo, &ascent, &descent, &lineGap);
+
+            storage::Path textureOutput = job.output;
+            textureOutput.replaceExtension("otexture");
+
+            FontData font;
+            font.textureName = textureOutput.getGeneric();
+            font.textureFilename = textureOutput.getGeneric();
+            font.lineHeight = static_cast<std::uint16_t>(std::lround(static_cast<float>(ascent - descent + lineGap) * scale));
+            font.base = static_cast<std::uint16_t>(std::lround(static_cast<float>(ascent) * scale));
+            font.width = static_cast<std::uint16_t>(atlasSize);
+            font.height = static_cast<std::uint16_t>(atlasSize);
+            font.pages = 1;
+
+            std::size_t offset = 0;
+            for (const auto& [first, count] : ranges)
+                for (int i = 0; i < count; ++i, ++offset)
+                {
+                    const auto& packedChar = packedChars[offset];
+
+                    FontChar fontChar;
+                    fontChar.x = static_cast<std::int16_t>(packedChar.x0);
+                    fontChar.y = static_cast<std::int16_t>(packedChar.y0);
+                    fontChar.width = static_cast<std::int16_t>(packedChar.x1 - packedChar.x0);
+                    fontChar.height = static_cast<std::int16_t>(packedChar.y1 - packedChar.y0);
+                    fontChar.xOffset = static_cast<std::int16_t>(std::lround(packedChar.xoff));
+                    // the offset is relative to the baseline in stb_truetype and to the top in BMFont
+                    fontChar.yOffset = static_cast<std::int16_t>(std::lround(packedChar.yoff) + font.base);
+                    fontChar.xAdvance = static_cast<std::int16_t>(std::lround(packedChar.xadvance));
+                    font.chars[static_cast<char32_t>(first + i)] = fontChar;
+                }
+
+            for (const auto& first : font.chars)
+                for (const auto& second : font.chars)
+                {
+                    const auto amount = std::lround(static_cast<float>(stbtt_GetCodepointKernAdvance(&fontInfo,
+                                                                                                     static_cast<int>(first.first),
+                                                                                                     static_cast<int>(second.first))) * scale);
+                    if (amount != 0)
+                        font.kern[std::pair(first.first, second.first)] = static_cast<std::int16_t>(amount);
+                }
+
+            // white glyphs, so that the text can be tinted with the vertex color
+            std::vector<std::uint8_t> rgba(coverage.size() * 4);
+            for (std::size_t i = 0; i < coverage.size(); ++i)
+            {
+                rgba[i * 4 + 0] = 255;
+                rgba[i * 4 + 1] = 255;
+                rgba[i * 4 + 2] = 255;
+                rgba[i * 4 + 3] = coverage[i];
+            }
+
+            Result result;
+            result.inputs.push_back(job.source);
+            result.outputs.emplace_back(job.output, writeFont(font));
+            result.outputs.emplace_back(textureOutput,
+                                        cookTexture(rgba, Size<std::uint32_t, 2>{atlasSize, atlasSize},
+                                                    graphics::PixelFormat::rgba8UnsignedNorm, job.mipmaps));
+            return result;
+        }
+    }
+
+    inline Result cookFont(const Job& job, const storage::Path& assetsDirectory)
+    {
+        const auto data = readFile(assetsDirectory / job.source);
+        const auto extension = std::string(job.source.getExtension());
+
+        if (extension == "fnt")
+            return cookFntFont(job, data);
+        else if (extension == "ttf" || extension == "otf")
+            return cookTrueTypeFont(job, data);
+        else
+            throw CookError("Unsupported font format " + extension);
+    }
+}
+
+#endif // OUZEL_COOKER_FONTCOOKER_HPP
@@ -0,0 +1,109 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_COOKER_JOB_HPP
+#define OUZEL_COOKER_JOB_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "../Asset.hpp"
+#include "hash/Fnv1.hpp"
+#include "storage/FileSystem.hpp"
+#include "storage/Path.hpp"
+
+namespace ouzel::cooker
+{
+    class CookError final: public std::runtime_error
+    {
+    public:
+        explicit CookError(const std::string& str): std::runtime_error(str) {}
+        explicit CookError(const char* str): std::runtime_error(str) {}
+    };
+
+    class Job final
+    {
+    public:
+        enum class Action
+        {
+            copy,
+            texture,
+            mesh,
+            sprite,
+            font
+        };
+
+        Action action = Action::copy;
+        std::string name;
+        storage::Path source; // relative to the assets directory
+        storage::Path output; // relative to the output directory
+        graphics::PixelFormat pixelFormat = graphics::PixelFormat::rgba8UnsignedNorm;
+        bool mipmaps = false;
+        float fontSize = 32.0F;
+    };
+
+    // Jobs that are found while cooking (e.g. the texture of a sprite sheet)
+    // are returned as dependencies and cooked after the current pass
+    class Result final
+    {
+    public:
+        std::vector<std::pair<storage::Path, std::vector<std::byte>>> outputs;
+        std::vector<storage::Path> inputs;
+        std::vector<Job> dependencies;
+    };
+
+    inline std::vector<std::byte> readFile(const storage::Path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw CookError("Failed to open " + std::string(path));
+
+        std::vector<char> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        const auto bytes = reinterpret_cast<const std::byte*>(data.data());
+        return std::vector<std::byte>(bytes, bytes + data.size());
+    }
+
+    inline void createDirectories(const storage::Path& path)
+    {
+        if (path.isEmpty() ||
+            storage::FileSystem::getFileType(path) == storage::FileType::directory)
+            return;
+
+        createDirectories(path.getDirectory());
+
+        try
+        {
+            storage::FileSystem::createDirectory(path);
+        }
+        catch (const std::system_error&)
+        {
+            // another job might have created it in the meantime
+            if (storage::FileSystem::getFileType(path) != storage::FileType::directory)
+                throw;
+        }
+    }
+
+    inline void writeFile(const storage::Path& path, const std::vector<std::byte>& data)
+    {
+        createDirectories(path.getDirectory());
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            throw CookError("Failed to create " + std::string(path));
+
+        file.write(reinterpret_cast<const char*>(data.data()),
+                   static_cast<std::streamsize>(data.size()));
+    }
+
+    inline std::uint64_t hashData(const std::vector<std::byte>& data) noexcept
+    {
+        return hash::fnv1::hashBytes<std::uint64_t>(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+}
+
+#endif // OUZEL_COOKER_JOB_HPP
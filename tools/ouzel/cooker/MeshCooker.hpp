@@ -0,0 +1,120 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_COOKER_MESHCOOKER_HPP
+#define OUZEL_COOKER_MESHCOOKER_HPP
+
+#include <algorithm>
+#include "Job.hpp"
+#include "formats/Cooked.hpp"
+#include "formats/Obj.hpp"
+
+namespace ouzel::cooker
+{
+    inline namespace detail
+    {
+        // Returns the texture maps referenced by the material library
+        inline std::vector<std::string> getMaterialTextures(const std::vector<std::byte>& data)
+        {
+            std::vector<std::string> result;
+
+            std::string line;
+            for (auto iterator = data.begin(); iterator != data.end(); ++iterator)
+            {
+                const auto c = static_cast<char>(*iterator);
+                if (c != '\r' && c != '\n')
+                    line.push_back(c);
+
+                if (c == '\r' || c == '\n' || iterator + 1 == data.end())
+                {
+                    const auto start = line.find_first_not_of(" \t");
+                    if (start != std::string::npos &&
+                        (line.compare(start, 7, "map_Ka ") == 0 ||
+                         line.compare(start, 7, "map_Kd ") == 0 ||
+                         line.compare(start, 7, "map_Ka\t") == 0 ||
+                         line.compare(start, 7, "map_Kd\t") == 0))
+                    {
+                        const auto filenameStart = line.find_first_not_of(" \t", start + 7);
+                        const auto filenameEnd = line.find_first_of(" \t", filenameStart);
+                        if (filenameStart != std::string::npos)
+                            result.push_back(line.substr(filenameStart, filenameEnd - filenameStart));
+                    }
+
+                    line.clear();
+                }
+            }
+
+            return result;
+        }
+    }
+
+    // The material libraries and their textures are referenced by their filenames,
+    // so they are copied next to the cooked mesh
+    inline Result cookMesh(const Job& job, const storage::Path& assetsDirectory)
+    {
+        const auto data = readFile(assetsDirectory / job.source);
+        const auto objData = obj::parse(Span<const std::byte>{data.data(), data.size()});
+
+        Result result;
+        result.inputs.push_back(job.source);
+
+        cooked::Writer writer{cooked::staticMeshMagic};
+
+        writer.writeUint32(static_cast<std::uint32_t>(objData.materialLibraries.size()));
+        for (const auto& filename : objData.materialLibraries)
+        {
+            writer.writeString(filename);
+
+            Job libraryJob;
+            libraryJob.source = filename;
+            libraryJob.output = filename;
+            result.dependencies.push_back(libraryJob);
+
+            for (const auto& textureFilename : getMaterialTextures(readFile(assetsDirectory / filename)))
+            {
+                Job textureJob;
+                textureJob.source = textureFilename;
+                textureJob.output = textureFilename;
+                result.dependencies.push_back(textureJob);
+            }
+
+            result.inputs.push_back(filename);
+        }
+
+        writer.writeUint32(static_cast<std::uint32_t>(objData.objects.size()));
+        for (const auto& object : objData.objects)
+        {
+            writer.writeString(object.name.empty() ? job.name : object.name);
+            writer.writeString(object.material);
+
+            for (std::size_t c = 0; c < 3; ++c) writer.writeFloat(object.boundingBox.min.v[c]);
+            for (std::size_t c = 0; c < 3; ++c) writer.writeFloat(object.boundingBox.max.v[c]);
+
+            const auto maxIndex = object.indices.empty() ? 0U :
+                *std::max_element(object.indices.begin(), object.indices.end());
+
+            if (maxIndex <= 0xFFFFU)
+            {
+                std::vector<std::uint16_t> indices;
+                indices.reserve(object.indices.size());
+                for (const auto index : object.indices)
+                    indices.push_back(static_cast<std::uint16_t>(index));
+
+                writer.writeUint32(sizeof(std::uint16_t));
+                writer.writeBlob(indices.data(), indices.size() * sizeof(std::uint16_t));
+            }
+            else
+            {
+                writer.writeUint32(sizeof(std::uint32_t));
+                writer.writeBlob(object.indices.data(), object.indices.size() * sizeof(std::uint32_t));
+            }
+
+            writer.writeUint32(sizeof(graphics::Vertex));
+            writer.writeBlob(object.vertices.data(), object.vertices.size() * sizeof(graphics::Vertex));
+        }
+
+        result.outputs.emplace_back(job.output, writer.getData());
+        return result;
+    }
+}
+
+#endif // OUZEL_COOKER_MESHCOOKER_HPP
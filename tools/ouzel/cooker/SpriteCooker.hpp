@@ -0,0 +1,204 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_COOKER_SPRITECOOKER_HPP
+#define OUZEL_COOKER_SPRITECOOKER_HPP
+
+#include <algorithm>
+#include "Job.hpp"
+#include "TextureCooker.hpp"
+#include "formats/Cooked.hpp"
+#include "formats/Json.hpp"
+#include "graphics/Vertex.hpp"
+#include "math/Rect.hpp"
+
+namespace ouzel::cooker
+{
+    inline namespace detail
+    {
+        inline void writeFrame(cooked::Writer& writer,
+                               const std::string& name,
+                               const std::vector<std::uint16_t>& indices,
+                               const std::vector<graphics::Vertex>& vertices)
+        {
+            Box<float, 2> boundingBox;
+            for (const auto& vertex : vertices)
+                boundingBox.insertPoint(Vector<float, 2>(vertex.position));
+
+            writer.writeString(name);
+            for (std::size_t c = 0; c < 2; ++c) writer.writeFloat(boundingBox.min.v[c]);
+            for (std::size_t c = 0; c < 2; ++c) writer.writeFloat(boundingBox.max.v[c]);
+            writer.writeBlob(indices.data(), indices.size() * sizeof(std::uint16_t));
+            writer.writeBlob(vertices.data(), vertices.size() * sizeof(graphics::Vertex));
+        }
+    }
+
+    // Bakes the frames of a TexturePacker sprite sheet the same way as SpriteData::Frame does
+    inline Result cookSprite(const Job& job, const storage::Path& assetsDirectory)
+    {
+        const auto data = readFile(assetsDirectory / job.source);
+        const json::Value d = json::parse(data);
+
+        const json::Value& metaObject = d["meta"];
+        const auto imageFilename = metaObject["image"].as<std::string>();
+
+        const auto imageSize = getImageSize(readFile(assetsDirectory / imageFilename));
+        const Size<float, 2> textureSize{
+            static_cast<float>(imageSize.v[0]),
+            static_cast<float>(imageSize.v[1])
+        };
+
+        Job textureJob;
+        textureJob.action = Job::Action::texture;
+        textureJob.name = imageFilename;
+        textureJob.source = imageFilename;
+        textureJob.output = storage::Path{imageFilename}.replaceExtension("otexture");
+        textureJob.pixelFormat = job.pixelFormat;
+        textureJob.mipmaps = job.mipmaps;
+
+        Result result;
+        result.inputs.push_back(job.source);
+        result.inputs.push_back(imageFilename);
+        result.dependencies.push_back(textureJob);
+
+        cooked::Writer writer{cooked::spriteMagic};
+        writer.writeString(imageFilename);
+        writer.writeString(textureJob.output.getGeneric());
+
+        const json::Value& framesArray = d["frames"];
+
+        writer.writeUint32(1);
+        writer.writeString("");
+        writer.writeFloat(0.1F);
+        writer.writeUint32(static_cast<std::uint32_t>(framesArray.getSize()));
+
+        for (const json::Value& frameObject : framesArray)
+        {
+            const auto filename = frameObject["filename"].as<std::string>();
+
+            const json::Value& frameRectangleObject = frameObject["frame"];
+
+            const Rect<float> frameRectangle{
+                frameRectangleObject["x"].as<float>(),
+                frameRectangleObject["y"].as<float>(),
+                frameRectangleObject["w"].as<float>(),
+                frameRectangleObject["h"].as<float>()
+            };
+
+            const json::Value& sourceSizeObject = frameObject["sourceSize"];
+
+            const Size<float, 2> sourceSize{
+                sourceSizeObject["w"].as<float>(),
+                sourceSizeObject["h"].as<float>()
+            };
+
+            const json::Value& spriteSourceSizeObject = frameObject["spriteSourceSize"];
+
+            const Vector<float, 2> sourceOffset{
+                spriteSourceSizeObject["x"].as<float>(),
+                spriteSourceSizeObject["y"].as<float>()
+            };
+
+            const json::Value& pivotObject = frameObject["pivot"];
+
+            const Vector<float, 2> pivot{
+                pivotObject["x"].as<float>(),
+                pivotObject["y"].as<float>()
+            };
+
+            const Vector<float, 2> finalOffset{
+                -sourceSize.v[0] * pivot.v[0] + sourceOffset.v[0],
+                -sourceSize.v[1] * pivot.v[1] + (sourceSize.v[1] - frameRectangle.size.v[1] - sourceOffset.v[1])
+            };
+
+            std::vector<std::uint16_t> indices;
+            std::vector<graphics::Vertex> vertices;
+
+            if (frameObject.hasMember("vertices") &&
+                frameObject.hasMember("verticesUV") &&
+                frameObject.hasMember("triangles"))
+            {
+                for (const json::Value& triangleObject : frameObject["triangles"])
+                    for (const json::Value& indexObject : triangleObject)
+                        indices.push_back(static_cast<std::uint16_t>(indexObject.as<std::uint32_t>()));
+
+                // reverse the vertices, so that they are counterclockwise
+                std::reverse(indices.begin(), indices.end());
+
+                const json::Value& verticesObject = frameObject["vertices"];
+                const json::Value& verticesUVObject = frameObject["verticesUV"];
+
+                for (std::size_t vertexIndex = 0; vertexIndex < verticesObject.getSize(); ++vertexIndex)
+                {
+                    const json::Value& vertexObject = verticesObject[vertexIndex];
+                    const json::Value& vertexUVObject = verticesUVObject[vertexIndex];
+
+                    vertices.emplace_back(Vector<float, 3>{static_cast<float>(vertexObject[0].as<std::int32_t>()) + finalOffset.v[0],
+                                                           -static_cast<float>(vertexObject[1].as<std::int32_t>()) - finalOffset.v[1], 0.0F},
+                                          Color::white(),
+                                          Vector<float, 2>{static_cast<float>(vertexUVObject[0].as<std::int32_t>()) / textureSize.v[0],
+                                                           static_cast<float>(vertexUVObject[1].as<std::int32_t>()) / textureSize.v[1]},
+                                          Vector<float, 3>{0.0F, 0.0F, -1.0F});
+                }
+            }
+            else
+            {
+                indices = {0, 1, 2, 1, 3, 2};
+
+                Vector<float, 2> textCoords[4];
+
+                if (!frameObject["rotated"].as<bool>())
+                {
+                    const Vector<float, 2> leftTop{
+                        frameRectangle.position.v[0] / textureSize.v[0],
+                        frameRectangle.position.v[1] / textureSize.v[1]
+                    };
+
+                    const Vector<float, 2> rightBottom{
+                        (frameRectangle.position.v[0] + frameRectangle.size.v[0]) / textureSize.v[0],
+                        (frameRectangle.position.v[1] + frameRectangle.size.v[1]) / textureSize.v[1]
+                    };
+
+                    textCoords[0] = Vector<float, 2>(leftTop.v[0], rightBottom.v[1]);
+                    textCoords[1] = Vector<float, 2>(rightBottom.v[0], rightBottom.v[1]);
+                    textCoords[2] = Vector<float, 2>(leftTop.v[0], leftTop.v[1]);
+                    textCoords[3] = Vector<float, 2>(rightBottom.v[0], leftTop.v[1]);
+                }
+                else
+                {
+                    const Vector<float, 2> leftTop{
+                        frameRectangle.position.v[0] / textureSize.v[0],
+                        frameRectangle.position.v[1] / textureSize.v[1]
+                    };
+
+                    const Vector<float, 2> rightBottom{
+                        (frameRectangle.position.v[0] + frameRectangle.size.v[1]) / textureSize.v[0],
+                        (frameRectangle.position.v[1] + frameRectangle.size.v[0]) / textureSize.v[1]
+                    };
+
+                    textCoords[0] = Vector<float, 2>(leftTop.v[0], leftTop.v[1]);
+                    textCoords[1] = Vector<float, 2>(leftTop.v[0], rightBottom.v[1]);
+                    textCoords[2] = Vector<float, 2>(rightBottom.v[0], leftTop.v[1]);
+                    textCoords[3] = Vector<float, 2>(rightBottom.v[0], rightBottom.v[1]);
+                }
+
+                vertices = {
+                    graphics::Vertex(Vector<float, 3>{finalOffset.v[0], finalOffset.v[1], 0.0F}, Color::white(),
+                                     textCoords[0], Vector<float, 3>{0.0F, 0.0F, -1.0F}),
+                    graphics::Vertex(Vector<float, 3>{finalOffset.v[0] + frameRectangle.size.v[0], finalOffset.v[1], 0.0F}, Color::white(),
+                                     textCoords[1], Vector<float, 3>{0.0F, 0.0F, -1.0F}),
+                    graphics::Vertex(Vector<float, 3>{finalOffset.v[0], finalOffset.v[1] + frameRectangle.size.v[1], 0.0F}, Color::white(),
+                                     textCoords[2], Vector<float, 3>{0.0F, 0.0F, -1.0F}),
+                    graphics::Vertex(Vector<float, 3>{finalOffset.v[0] + frameRectangle.size.v[0], finalOffset.v[1] + frameRectangle.size.v[1], 0.0F}, Color::white(),
+                                     textCoords[3], Vector<float, 3>{0.0F, 0.0F, -1.0F})
+                };
+            }
+
+            writeFrame(writer, filename, indices, vertices);
+        }
+
+        result.outputs.emplace_back(job.output, writer.getData());
+        return result;
+    }
+}
+
+#endif // OUZEL_COOKER_SPRITECOOKER_HPP
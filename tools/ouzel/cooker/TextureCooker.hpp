@@ -0,0 +1,116 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_COOKER_TEXTURECOOKER_HPP
+#define OUZEL_COOKER_TEXTURECOOKER_HPP
+
+#include <algorithm>
+#include <memory>
+#include "Job.hpp"
+#include "formats/Cooked.hpp"
+#include "graphics/MipMaps.hpp"
+#include "stb_image.h"
+
+namespace ouzel::cooker
+{
+    inline Size<std::uint32_t, 2> getImageSize(const std::vector<std::byte>& data)
+    {
+        int width;
+        int height;
+        int comp;
+        if (!stbi_info_from_memory(reinterpret_cast<const stbi_uc*>(data.data()),
+                                   static_cast<int>(data.size()),
+                                   &width, &height, &comp))
+            throw CookError("Failed to read image info, reason: " + std::string(stbi_failure_reason()));
+
+        return Size<std::uint32_t, 2>{static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height)};
+    }
+
+    // Writes the RGBA pixels in the given pixel format with all the mip levels
+    inline std::vector<std::byte> cookTexture(const std::vector<std::uint8_t>& rgba,
+                                              const Size<std::uint32_t, 2>& size,
+                                              graphics::PixelFormat pixelFormat,
+                                              bool mipmaps,
+                                              bool opaque = false)
+    {
+        const auto pixelCount = static_cast<std::size_t>(size.v[0]) * size.v[1];
+        const auto pixelSize = graphics::getPixelSize(pixelFormat);
+
+        std::vector<std::uint8_t> data(pixelCount * pixelSize);
+
+        for (std::size_t i = 0; i < pixelCount; ++i)
+        {
+            const auto source = &rgba[i * 4];
+            const auto destination = &data[i * pixelSize];
+
+            switch (pixelFormat)
+            {
+                case graphics::PixelFormat::a8UnsignedNorm:
+                    // images without an alpha channel are used as masks
+                    destination[0] = opaque ? source[0] : source[3];
+                    break;
+                case graphics::PixelFormat::r8UnsignedNorm:
+                    destination[0] = source[0];
+                    break;
+                case graphics::PixelFormat::rg8UnsignedNorm:
+                    destination[0] = source[0];
+                    destination[1] = source[1];
+                    break;
+                case graphics::PixelFormat::rgba8UnsignedNorm:
+                case graphics::PixelFormat::rgba8UnsignedNormSRGB:
+                    std::copy(source, source + 4, destination);
+                    break;
+                default:
+                    throw CookError("Unsupported pixel format");
+            }
+        }
+
+        const auto levels = graphics::generateMipMaps(size, data, mipmaps ? 0 : 1, pixelFormat);
+
+        cooked::Writer writer{cooked::textureMagic};
+        writer.writeUint32(static_cast<std::uint32_t>(pixelFormat));
+        writer.writeUint32(size.v[0]);
+        writer.writeUint32(size.v[1]);
+        writer.writeUint32(static_cast<std::uint32_t>(levels.size()));
+
+        for (const auto& [levelSize, levelData] : levels)
+        {
+            writer.writeUint32(levelSize.v[0]);
+            writer.writeUint32(levelSize.v[1]);
+            writer.writeBlob(levelData.data(), levelData.size());
+        }
+
+        return writer.getData();
+    }
+
+    inline Result cookTexture(const Job& job, const storage::Path& assetsDirectory)
+    {
+        const auto data = readFile(assetsDirectory / job.source);
+
+        int width;
+        int height;
+        int comp;
+
+        using ImageFreeFunction = void(*)(void*);
+        std::unique_ptr<stbi_uc, ImageFreeFunction> image{
+            stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(data.data()),
+                                  static_cast<int>(data.size()),
+                                  &width, &height,
+                                  &comp, STBI_rgb_alpha),
+            stbi_image_free
+        };
+
+        if (!image)
+            throw CookError("Failed to load texture, reason: " + std::string(stbi_failure_reason()));
+
+        const Size<std::uint32_t, 2> size{static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height)};
+        const std::vector<std::uint8_t> rgba(image.get(), image.get() + static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+
+        Result result;
+        result.inputs.push_back(job.source);
+        result.outputs.emplace_back(job.output, cookTexture(rgba, size, job.pixelFormat, job.mipmaps,
+                                                            comp == STBI_grey || comp == STBI_rgb));
+        return result;
+    }
+}
+
+#endif // OUZEL_COOKER_TEXTURECOOKER_HPP